@@ -79,3 +79,16 @@ function linkGoogleTest()
 
     filter{}
 end
+
+-- Link Google Benchmark
+function linkGoogleBenchmark()
+    links { "benchmark_main", "benchmark" }
+
+    filter { "system:windows" }
+        links { "shlwapi" }
+
+    filter { "system:linux" }
+        links { "pthread" }
+
+    filter{}
+end
@@ -22,11 +22,12 @@ public:
   Game()
       : window("Pong 3D", 800, 600, eventSystem), backend(window),
         renderer(assetManager.getRegistry(), window,
-                 backend.createDefaultDevice()),
+                 backend.createDefaultDevice(), jobSystem),
         presenter(renderer.getShaderLibrary(), renderer.getRegistry()),
         physicsSystem(eventSystem),
         assetManager(std::filesystem::current_path()),
-        scriptingSystem(eventSystem, assetManager.getRegistry()) {
+        scriptingSystem(eventSystem, assetManager.getRegistry()),
+        sceneUpdater(jobSystem) {
 
     assetManager.preloadAssets(renderer.getRegistry());
 
@@ -260,6 +261,7 @@ private:
   liquid::AssetManager assetManager;
   liquid::Window window;
   liquid::rhi::VulkanRenderBackend backend;
+  liquid::JobSystem jobSystem;
   liquid::Renderer renderer;
   liquid::Presenter presenter;
   liquid::PhysicsSystem physicsSystem;
@@ -292,6 +294,8 @@ private:
 int main() {
   liquid::Engine::setAssetsPath(
       std::filesystem::path("./engine/assets").string());
+  liquid::Engine::setUserDataPath(
+      std::filesystem::path("./engine/user-data").string());
   Game game;
   return game.run();
 }
@@ -235,6 +235,28 @@ loadTextures(const tinygltf::Model &model, const std::filesystem::path &path,
              liquid::AssetManager &assetManager) {
   std::map<size_t, liquid::TextureAssetHandle> map;
 
+  // Color usage is set last because color
+  // data must stay in sRGB even if the texture
+  // is also used for other purposes
+  std::map<int, liquid::TextureAssetUsage> usages;
+  for (auto &gltfMaterial : model.materials) {
+    usages.insert_or_assign(
+        gltfMaterial.pbrMetallicRoughness.metallicRoughnessTexture.index,
+        liquid::TextureAssetUsage::Data);
+    usages.insert_or_assign(gltfMaterial.occlusionTexture.index,
+                            liquid::TextureAssetUsage::Data);
+    usages.insert_or_assign(gltfMaterial.normalTexture.index,
+                            liquid::TextureAssetUsage::Normal);
+  }
+
+  for (auto &gltfMaterial : model.materials) {
+    usages.insert_or_assign(
+        gltfMaterial.pbrMetallicRoughness.baseColorTexture.index,
+        liquid::TextureAssetUsage::Color);
+    usages.insert_or_assign(gltfMaterial.emissiveTexture.index,
+                            liquid::TextureAssetUsage::Color);
+  }
+
   for (size_t i = 0; i < model.textures.size(); ++i) {
     // TODO: Support creating different samplers
     auto &image = model.images.at(model.textures.at(i).source);
@@ -247,6 +269,11 @@ loadTextures(const tinygltf::Model &model, const std::filesystem::path &path,
     texture.data.width = image.width;
     texture.data.height = image.height;
 
+    auto usage = usages.find(static_cast<int>(i));
+    if (usage != usages.end()) {
+      texture.data.usage = usage->second;
+    }
+
     auto &&texturePath = assetManager.createTextureFromAsset(texture);
     auto handle = assetManager.loadTextureFromFile(texturePath.getData());
     map.insert_or_assign(i, handle.getData());
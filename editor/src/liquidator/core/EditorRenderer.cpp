@@ -182,23 +182,23 @@ void EditorRenderer::updateFrameData(liquid::EntityDatabase &entityDatabase,
 
   mRenderStorage.setEditorGrid(editorGrid.getData());
 
-  entityDatabase.iterateEntities<liquid::WorldTransformComponent,
-                                 liquid::SkeletonDebugComponent>(
-      [this](auto entity, liquid::WorldTransformComponent &worldTransform,
-             liquid::SkeletonDebugComponent &skeleton) {
+  entityDatabase.iterateEntities<const liquid::WorldTransformComponent,
+                                 const liquid::SkeletonDebugComponent>(
+      [this](auto entity, const liquid::WorldTransformComponent &worldTransform,
+             const liquid::SkeletonDebugComponent &skeleton) {
         mRenderStorage.addSkeleton(worldTransform.worldTransform,
                                    skeleton.boneTransforms);
       });
 
-  entityDatabase.iterateEntities<liquid::WorldTransformComponent,
-                                 liquid::DirectionalLightComponent>(
+  entityDatabase.iterateEntities<const liquid::WorldTransformComponent,
+                                 const liquid::DirectionalLightComponent>(
       [this](auto entity, const auto &world, const auto &light) {
         mRenderStorage.addGizmo(mIconRegistry.getIcon(EditorIcon::Sun),
                                 world.worldTransform);
       });
 
-  entityDatabase.iterateEntities<liquid::WorldTransformComponent,
-                                 liquid::PerspectiveLensComponent>(
+  entityDatabase.iterateEntities<const liquid::WorldTransformComponent,
+                                 const liquid::PerspectiveLensComponent>(
       [this](auto entity, const auto &world, const auto &camera) {
         static constexpr float NINETY_DEGREES_IN_RADIANS =
             glm::pi<float>() / 2.0f;
@@ -1,4 +1,5 @@
 #include "liquid/core/Base.h"
+#include "liquid/renderer/RenderStorage.h"
 #include "EditorRendererStorage.h"
 
 namespace liquidator {
@@ -8,7 +9,7 @@ EditorRendererStorage::EditorRendererStorage(size_t reservedSpace)
   mSkeletonTransforms.reserve(mReservedSpace);
   mNumBones.reserve(mReservedSpace);
   mGizmoTransforms.reserve(reservedSpace);
-  mSkeletonVector.reset(new glm::mat4[mReservedSpace * MAX_NUM_BONES]);
+  mSkeletonVector.reserve(mReservedSpace * MAX_NUM_BONES);
 }
 
 void EditorRendererStorage::addSkeleton(
@@ -17,12 +18,11 @@ void EditorRendererStorage::addSkeleton(
   mSkeletonTransforms.push_back(worldTransform);
   mNumBones.push_back(static_cast<uint32_t>(boneTransforms.size()));
 
-  auto *currentSkeleton =
-      mSkeletonVector.get() + (mLastSkeleton * MAX_NUM_BONES);
+  // Every skeleton takes maximum number of bones
   size_t dataSize = std::min(boneTransforms.size(), MAX_NUM_BONES);
-  memcpy(currentSkeleton, boneTransforms.data(), dataSize * sizeof(glm::mat4));
-
-  mLastSkeleton++;
+  mSkeletonVector.insert(mSkeletonVector.end(), boneTransforms.begin(),
+                         boneTransforms.begin() + dataSize);
+  mSkeletonVector.resize(mSkeletonVector.size() + MAX_NUM_BONES - dataSize);
 }
 
 void EditorRendererStorage::setActiveCamera(
@@ -43,46 +43,41 @@ void EditorRendererStorage::setEditorGrid(const EditorGridData &data) {
 void EditorRendererStorage::updateBuffers(
     liquid::rhi::ResourceRegistry &registry) {
 
-  mCameraBuffer =
-      registry.setBuffer({liquid::rhi::BufferType::Uniform,
-                          sizeof(liquid::CameraComponent), &mCameraData},
-                         mCameraBuffer);
+  mCameraBuffer = registry.setBuffer(
+      {liquid::rhi::BufferType::Uniform, sizeof(liquid::CameraComponent),
+       &mCameraData, 0, true},
+      mCameraBuffer);
 
-  mEditorGridBuffer =
-      registry.setBuffer({liquid::rhi::BufferType::Uniform,
-                          sizeof(EditorGridData), &mEditorGridData},
-                         mEditorGridBuffer);
+  mEditorGridBuffer = registry.setBuffer(
+      {liquid::rhi::BufferType::Uniform, sizeof(EditorGridData),
+       &mEditorGridData, 0, true},
+      mEditorGridBuffer);
 
+  // Only the added items are uploaded
   if (!mSkeletonTransforms.empty()) {
-    mSkeletonTransformsBuffer = registry.setBuffer(
-        {
-            liquid::rhi::BufferType::Storage,
-            mReservedSpace * sizeof(glm::mat4),
-            mSkeletonTransforms.data(),
-        },
-        mSkeletonTransformsBuffer);
-
-    mSkeletonBoneTransformsBuffer = registry.setBuffer(
-        {
-            liquid::rhi::BufferType::Storage,
-            mReservedSpace * MAX_NUM_BONES * sizeof(glm::mat4),
-            mSkeletonVector.get(),
-        },
-        mSkeletonBoneTransformsBuffer);
+    mSkeletonTransformsBuffer = liquid::RenderStorage::setStorageBuffer(
+        registry, mSkeletonTransformsBuffer, mSkeletonTransforms.data(),
+        mSkeletonTransforms.size() * sizeof(glm::mat4),
+        mReservedSpace * sizeof(glm::mat4));
+
+    mSkeletonBoneTransformsBuffer = liquid::RenderStorage::setStorageBuffer(
+        registry, mSkeletonBoneTransformsBuffer, mSkeletonVector.data(),
+        mSkeletonVector.size() * sizeof(glm::mat4),
+        mReservedSpace * MAX_NUM_BONES * sizeof(glm::mat4));
   }
 
-  mGizmoTransformsBuffer = registry.setBuffer(
-      {liquid::rhi::BufferType::Storage, sizeof(glm::mat4) * mReservedSpace,
-       mGizmoTransforms.data()},
-      mGizmoTransformsBuffer);
+  mGizmoTransformsBuffer = liquid::RenderStorage::setStorageBuffer(
+      registry, mGizmoTransformsBuffer, mGizmoTransforms.data(),
+      mGizmoTransforms.size() * sizeof(glm::mat4),
+      mReservedSpace * sizeof(glm::mat4));
 }
 
 void EditorRendererStorage::clear() {
   mSkeletonTransforms.clear();
   mGizmoTransforms.clear();
+  mSkeletonVector.clear();
   mNumBones.clear();
   mGizmoCounts.clear();
-  mLastSkeleton = 0;
 }
 
 } // namespace liquidator
@@ -149,9 +149,8 @@ private:
   liquid::rhi::BufferHandle mEditorGridBuffer{0};
 
   // Skeleton bones
-  size_t mLastSkeleton = 0;
   std::vector<glm::mat4> mSkeletonTransforms;
-  std::unique_ptr<glm::mat4> mSkeletonVector;
+  std::vector<glm::mat4> mSkeletonVector;
   std::vector<uint32_t> mNumBones;
   liquid::rhi::BufferHandle mSkeletonTransformsBuffer{0};
   liquid::rhi::BufferHandle mSkeletonBoneTransformsBuffer{0};
@@ -6,11 +6,16 @@ namespace liquidator {
 EditorSimulator::EditorSimulator(liquid::EventSystem &eventSystem,
                                  liquid::Window &window,
                                  liquid::AssetRegistry &assetRegistry,
-                                 EditorCamera &editorCamera)
-    : mCameraAspectRatioUpdater(window),
+                                 EditorCamera &editorCamera,
+                                 liquid::JobSystem &jobSystem)
+    : mCameraAspectRatioUpdater(window), mJobSystem(jobSystem),
+      mSkeletonUpdater(mJobSystem), mEditorSceneUpdater(mJobSystem),
+      mSimulationSceneUpdater(mJobSystem),
       mScriptingSystem(eventSystem, assetRegistry),
-      mAnimationSystem(assetRegistry), mPhysicsSystem(eventSystem),
+      mAnimationSystem(assetRegistry, mJobSystem), mPhysicsSystem(eventSystem),
       mEditorCamera(editorCamera), mAudioSystem(assetRegistry) {
+  createEditorGraph();
+  createSimulationGraph();
   useEditorUpdate();
 }
 
@@ -37,32 +42,127 @@ void EditorSimulator::useEditorUpdate() {
   };
 }
 
-void EditorSimulator::updateEditor(float dt,
-                                   liquid::EntityDatabase &entityDatabase) {
-  mCameraAspectRatioUpdater.update(entityDatabase);
-  mEditorCamera.update();
+void EditorSimulator::createEditorGraph() {
+  using Graph = liquid::TaskGraph;
+
+  mEditorGraph.addTask(
+      "CameraAspectRatioUpdater",
+      Graph::Reads<liquid::AutoAspectRatioComponent>{},
+      Graph::Writes<liquid::PerspectiveLensComponent>{},
+      [this](float dt, liquid::EntityDatabase &entityDatabase) {
+        mCameraAspectRatioUpdater.update(entityDatabase);
+      });
+
+  mEditorGraph.addTask(
+      "EditorCamera",
+      [this](float dt, liquid::EntityDatabase &entityDatabase) {
+        mEditorCamera.update();
+      });
+
+  mEditorGraph.addTask(
+      "SkeletonUpdater", Graph::Reads<>{},
+      Graph::Writes<liquid::SkeletonComponent,
+                    liquid::SkeletonDebugComponent>{},
+      [this](float dt, liquid::EntityDatabase &entityDatabase) {
+        mSkeletonUpdater.update(entityDatabase);
+      });
 
-  mSkeletonUpdater.update(entityDatabase);
-  mSceneUpdater.update(entityDatabase);
+  mEditorGraph.addTask(
+      "SceneUpdater",
+      Graph::Reads<liquid::LocalTransformComponent, liquid::ParentComponent,
+                   liquid::PerspectiveLensComponent>{},
+      Graph::Writes<liquid::WorldTransformComponent, liquid::CameraComponent,
+                    liquid::DirectionalLightComponent>{},
+      [this](float dt, liquid::EntityDatabase &entityDatabase) {
+        mEditorSceneUpdater.update(entityDatabase);
+      });
 
-  mEntityDeleter.update(entityDatabase);
+  mEditorGraph.addTask(
+      "EntityDeleter",
+      [this](float dt, liquid::EntityDatabase &entityDatabase) {
+        mEntityDeleter.update(entityDatabase);
+      });
 }
 
-void EditorSimulator::updateSimulation(float dt,
-                                       liquid::EntityDatabase &entityDatabase) {
-  mCameraAspectRatioUpdater.update(entityDatabase);
+void EditorSimulator::createSimulationGraph() {
+  using Graph = liquid::TaskGraph;
+
+  mSimulationGraph.addTask(
+      "CameraAspectRatioUpdater",
+      Graph::Reads<liquid::AutoAspectRatioComponent>{},
+      Graph::Writes<liquid::PerspectiveLensComponent>{},
+      [this](float dt, liquid::EntityDatabase &entityDatabase) {
+        mCameraAspectRatioUpdater.update(entityDatabase);
+      });
+
+  // Scripts can access any component
+  mSimulationGraph.addTask(
+      "ScriptingSystem",
+      [this](float dt, liquid::EntityDatabase &entityDatabase) {
+        mScriptingSystem.start(entityDatabase);
+        mScriptingSystem.update(dt, entityDatabase);
+      });
+
+  mSimulationGraph.addTask(
+      "AnimationSystem", Graph::Reads<>{},
+      Graph::Writes<liquid::LocalTransformComponent, liquid::AnimatorComponent,
+                    liquid::SkeletonComponent>{},
+      [this](float dt, liquid::EntityDatabase &entityDatabase) {
+        mAnimationSystem.update(dt, entityDatabase);
+      });
 
-  mScriptingSystem.start(entityDatabase);
-  mScriptingSystem.update(dt, entityDatabase);
-  mAnimationSystem.update(dt, entityDatabase);
+  mSimulationGraph.addTask(
+      "SkeletonUpdater", Graph::Reads<>{},
+      Graph::Writes<liquid::SkeletonComponent,
+                    liquid::SkeletonDebugComponent>{},
+      [this](float dt, liquid::EntityDatabase &entityDatabase) {
+        mSkeletonUpdater.update(entityDatabase);
+      });
 
-  mSkeletonUpdater.update(entityDatabase);
-  mSceneUpdater.update(entityDatabase);
+  mSimulationGraph.addTask(
+      "SceneUpdater",
+      Graph::Reads<liquid::LocalTransformComponent, liquid::ParentComponent,
+                   liquid::PerspectiveLensComponent>{},
+      Graph::Writes<liquid::WorldTransformComponent, liquid::CameraComponent,
+                    liquid::DirectionalLightComponent>{},
+      [this](float dt, liquid::EntityDatabase &entityDatabase) {
+        mSimulationSceneUpdater.update(entityDatabase);
+      });
 
-  mPhysicsSystem.update(dt, entityDatabase);
-  mAudioSystem.output(entityDatabase);
+  mSimulationGraph.addTask(
+      "PhysicsSystem", Graph::Reads<liquid::ParentComponent>{},
+      Graph::Writes<liquid::RigidBodyComponent, liquid::CollidableComponent,
+                    liquid::ForceComponent, liquid::TorqueComponent,
+                    liquid::LocalTransformComponent,
+                    liquid::WorldTransformComponent>{},
+      [this](float dt, liquid::EntityDatabase &entityDatabase) {
+        mPhysicsSystem.update(dt, entityDatabase);
+      });
 
-  mEntityDeleter.update(entityDatabase);
+  mSimulationGraph.addTask(
+      "AudioSystem",
+      Graph::Reads<liquid::AudioSourceComponent, liquid::DeleteComponent>{},
+      Graph::Writes<liquid::AudioStartComponent,
+                    liquid::AudioStatusComponent>{},
+      [this](float dt, liquid::EntityDatabase &entityDatabase) {
+        mAudioSystem.output(entityDatabase);
+      });
+
+  mSimulationGraph.addTask(
+      "EntityDeleter",
+      [this](float dt, liquid::EntityDatabase &entityDatabase) {
+        mEntityDeleter.update(entityDatabase);
+      });
+}
+
+void EditorSimulator::updateEditor(float dt,
+                                   liquid::EntityDatabase &entityDatabase) {
+  mEditorGraph.execute(dt, entityDatabase, mJobSystem);
+}
+
+void EditorSimulator::updateSimulation(float dt,
+                                       liquid::EntityDatabase &entityDatabase) {
+  mSimulationGraph.execute(dt, entityDatabase, mJobSystem);
 }
 
 } // namespace liquidator
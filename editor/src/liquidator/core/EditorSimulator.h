@@ -3,6 +3,7 @@
 #include "liquid/asset/AssetRegistry.h"
 
 #include "liquid/core/EntityDeleter.h"
+#include "liquid/core/TaskGraph.h"
 #include "liquid/scene/SceneUpdater.h"
 #include "liquid/scene/SkeletonUpdater.h"
 #include "liquid/scene/CameraAspectRatioUpdater.h"
@@ -31,10 +32,11 @@ public:
    * @param window Window
    * @param assetRegistry Asset registry
    * @param editorCamera Editor camera
+   * @param jobSystem Job system
    */
   EditorSimulator(liquid::EventSystem &eventSystem, liquid::Window &window,
                   liquid::AssetRegistry &assetRegistry,
-                  EditorCamera &editorCamera);
+                  EditorCamera &editorCamera, liquid::JobSystem &jobSystem);
 
   /**
    * @brief Main update function
@@ -72,6 +74,16 @@ public:
   inline liquid::PhysicsSystem &getPhysicsSystem() { return mPhysicsSystem; }
 
 private:
+  /**
+   * @brief Add editor systems to editor task graph
+   */
+  void createEditorGraph();
+
+  /**
+   * @brief Add simulation systems to simulation task graph
+   */
+  void createSimulationGraph();
+
   /**
    * @brief Editor updater
    *
@@ -94,12 +106,22 @@ private:
   EditorCamera &mEditorCamera;
   liquid::CameraAspectRatioUpdater mCameraAspectRatioUpdater;
   liquid::EntityDeleter mEntityDeleter;
+  liquid::JobSystem &mJobSystem;
   liquid::SkeletonUpdater mSkeletonUpdater;
-  liquid::SceneUpdater mSceneUpdater;
+
+  // Scene updaters keep the transform hierarchy of
+  // the database they update; so, every graph that
+  // runs on its own database has its own updater
+  liquid::SceneUpdater mEditorSceneUpdater;
+  liquid::SceneUpdater mSimulationSceneUpdater;
+
   liquid::AnimationSystem mAnimationSystem;
   liquid::ScriptingSystem mScriptingSystem;
   liquid::PhysicsSystem mPhysicsSystem;
   liquid::AudioSystem<liquid::DefaultAudioBackend> mAudioSystem;
+
+  liquid::TaskGraph mEditorGraph;
+  liquid::TaskGraph mSimulationGraph;
 };
 
 } // namespace liquidator
@@ -202,10 +202,21 @@ bool EntityManager::loadScene() {
 
   std::map<uint64_t, liquid::Entity> newEntityMap;
 
+  auto entities = getActiveEntityDatabase().createEntities(mapping.size());
+
+  std::vector<liquid::IdComponent> ids;
+  ids.reserve(mapping.size());
   for (auto &[id, node] : mapping) {
-    auto entity = getActiveEntityDatabase().createEntity();
-    liquid::IdComponent idComponent = {node["id"].as<uint64_t>()};
-    getActiveEntityDatabase().setComponent(entity, idComponent);
+    ids.push_back({node["id"].as<uint64_t>()});
+  }
+  getActiveEntityDatabase().setComponents(entities, ids);
+
+  size_t index = 0;
+  for (auto &[id, node] : mapping) {
+    auto entity = entities.at(index);
+    const auto &idComponent = ids.at(index);
+    index++;
+
     newEntityMap.insert_or_assign(idComponent.id, entity);
 
     mLastId = std::max(idComponent.id, mLastId);
@@ -604,7 +615,6 @@ liquid::Entity EntityManager::spawnEntity(EditorCamera &camera,
 }
 
 void EntityManager::updateSimulationEntityDatabase() {
-  mSimulationEntityDatabase.destroy();
   mEntityDatabase.duplicate(mSimulationEntityDatabase);
 }
 
@@ -33,8 +33,10 @@ namespace liquidator {
 
 EditorScreen::EditorScreen(liquid::Window &window,
                            liquid::EventSystem &eventSystem,
-                           liquid::rhi::RenderDevice *device)
-    : mWindow(window), mEventSystem(eventSystem), mDevice(device) {}
+                           liquid::rhi::RenderDevice *device,
+                           liquid::JobSystem &jobSystem)
+    : mWindow(window), mEventSystem(eventSystem), mDevice(device),
+      mJobSystem(jobSystem) {}
 
 void EditorScreen::start(const Project &project) {
   liquid::FPSCounter fpsCounter;
@@ -43,7 +45,12 @@ void EditorScreen::start(const Project &project) {
   auto statePath = project.settingsPath / "state.lqstate";
 
   liquid::AssetManager assetManager(project.assetsPath);
-  liquid::Renderer renderer(assetManager.getRegistry(), mWindow, mDevice);
+  assetManager.setTextureFormatSupport([this](uint32_t format) {
+    return mDevice->isTextureFormatSupported(format);
+  });
+
+  liquid::Renderer renderer(assetManager.getRegistry(), mWindow, mDevice,
+                            mJobSystem);
 
   liquid::Presenter presenter(renderer.getShaderLibrary(),
                               renderer.getRegistry());
@@ -88,6 +95,7 @@ void EditorScreen::start(const Project &project) {
   liquid::ImguiDebugLayer debugLayer(mDevice->getDeviceInformation(),
                                      mDevice->getDeviceStats(),
                                      renderer.getRegistry(), fpsCounter);
+  debugLayer.setAssetRegistry(assetManager.getRegistry());
 
   liquidator::UIRoot ui(entityManager, assetLoader);
   ui.getIconRegistry().loadIcons(renderer.getRegistry(),
@@ -116,6 +124,7 @@ void EditorScreen::start(const Project &project) {
 
   renderer.getSceneRenderer().attachText(graph, scenePassGroup);
 
+  graph.setOutput(imguiPassGroup.imguiColor);
   graph.setFramebufferExtent(mWindow.getFramebufferSize());
 
   mWindow.addResizeHandler([&graph](auto width, auto height) {
@@ -138,8 +147,9 @@ void EditorScreen::start(const Project &project) {
   ui.getAssetBrowser().setOnCreateEntry(
       [&assetManager](auto path) { assetManager.loadAsset(path); });
 
-  liquidator::EditorSimulator simulator(
-      mEventSystem, mWindow, assetManager.getRegistry(), editorCamera);
+  liquidator::EditorSimulator simulator(mEventSystem, mWindow,
+                                        assetManager.getRegistry(),
+                                        editorCamera, mJobSystem);
 
   mainLoop.setUpdateFn(
       [&editorCamera, &entityManager, &simulator, this](float dt) mutable {
@@ -168,6 +178,7 @@ void EditorScreen::start(const Project &project) {
       widgets::MainMenuBar::end();
     }
 
+    debugLayer.setEntityDatabase(entityManager.getActiveEntityDatabase());
     debugLayer.render();
 
     if (Toolbar::begin()) {
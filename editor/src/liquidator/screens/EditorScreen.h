@@ -1,5 +1,6 @@
 #pragma once
 
+#include "liquid/core/JobSystem.h"
 #include "liquid/events/EventSystem.h"
 #include "liquid/window/Window.h"
 #include "liquid/rhi/RenderDevice.h"
@@ -22,9 +23,10 @@ public:
    * @param window Window
    * @param eventSystem Event system
    * @param device Render device
+   * @param jobSystem Job system
    */
   EditorScreen(liquid::Window &window, liquid::EventSystem &eventSystem,
-               liquid::rhi::RenderDevice *device);
+               liquid::rhi::RenderDevice *device, liquid::JobSystem &jobSystem);
 
   /**
    * @brief Start editor screen
@@ -37,6 +39,7 @@ private:
   liquid::Window &mWindow;
   liquid::EventSystem &mEventSystem;
   liquid::rhi::RenderDevice *mDevice;
+  liquid::JobSystem &mJobSystem;
 };
 
 } // namespace liquidator
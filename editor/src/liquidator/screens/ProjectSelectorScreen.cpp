@@ -16,14 +16,16 @@ namespace liquidator {
 
 ProjectSelectorScreen::ProjectSelectorScreen(liquid::Window &window,
                                              liquid::EventSystem &eventSystem,
-                                             liquid::rhi::RenderDevice *device)
-    : mWindow(window), mEventSystem(eventSystem), mDevice(device) {}
+                                             liquid::rhi::RenderDevice *device,
+                                             liquid::JobSystem &jobSystem)
+    : mWindow(window), mEventSystem(eventSystem), mDevice(device),
+      mJobSystem(jobSystem) {}
 
 std::optional<Project> ProjectSelectorScreen::start() {
   liquid::EntityDatabase entityDatabase;
   liquid::AssetRegistry assetRegistry;
 
-  liquid::Renderer renderer(assetRegistry, mWindow, mDevice);
+  liquid::Renderer renderer(assetRegistry, mWindow, mDevice, mJobSystem);
   liquid::Presenter presenter(renderer.getShaderLibrary(),
                               renderer.getRegistry());
 
@@ -52,6 +54,7 @@ std::optional<Project> ProjectSelectorScreen::start() {
   liquid::rhi::RenderGraph graph;
   auto imguiPassData = renderer.getImguiRenderer().attach(graph);
 
+  graph.setOutput(imguiPassData.imguiColor);
   graph.setFramebufferExtent(mWindow.getFramebufferSize());
 
   auto resizeHandler = mWindow.addResizeHandler(
@@ -177,8 +177,12 @@ void EntityPanel::renderCamera(EditorManager &editorManager) {
         mEntityManager.getActiveEntityDatabase()
             .getComponent<liquid::PerspectiveLensComponent>(mSelectedEntity);
 
+    // Lens is edited in place, so it is only marked
+    // as changed when one of its inputs is edited
+    bool changed = false;
+
     ImGui::Text("FOV");
-    ImGui::InputFloat("###InputFOV", &component.fovY);
+    changed |= ImGui::InputFloat("###InputFOV", &component.fovY);
     if (component.fovY < 0.0f) {
       component.fovY = 0.0f;
     }
@@ -187,7 +191,7 @@ void EntityPanel::renderCamera(EditorManager &editorManager) {
     }
 
     ImGui::Text("Near");
-    ImGui::InputFloat("###InputNear", &component.near);
+    changed |= ImGui::InputFloat("###InputNear", &component.near);
     if (component.near < 0.0f) {
       component.near = 0.0f;
     }
@@ -196,7 +200,7 @@ void EntityPanel::renderCamera(EditorManager &editorManager) {
     }
 
     ImGui::Text("Far");
-    ImGui::InputFloat("###InputFar", &component.far);
+    changed |= ImGui::InputFloat("###InputFar", &component.far);
     if (component.far < 0.0f) {
       component.far = 0.0f;
     }
@@ -234,16 +238,22 @@ void EntityPanel::renderCamera(EditorManager &editorManager) {
 
     if (!hasViewportAspectRatio) {
       ImGui::Text("Custom aspect ratio");
-      if (ImGui::DragFloat("###CustomAspectRatio", &component.aspectRatio,
-                           MIN_CUSTOM_ASPECT_RATIO, MIN_CUSTOM_ASPECT_RATIO,
-                           MAX_CUSTOM_ASPECT_RATIO, "%.2f")) {
-      }
+      changed |= ImGui::DragFloat(
+          "###CustomAspectRatio", &component.aspectRatio,
+          MIN_CUSTOM_ASPECT_RATIO, MIN_CUSTOM_ASPECT_RATIO,
+          MAX_CUSTOM_ASPECT_RATIO, "%.2f");
 
       if (ImGui::IsItemDeactivatedAfterEdit()) {
         mEntityManager.save(mSelectedEntity);
       }
     }
 
+    if (changed) {
+      mEntityManager.getActiveEntityDatabase()
+          .markComponentChanged<liquid::PerspectiveLensComponent>(
+              mSelectedEntity);
+    }
+
     if (!editorManager.isUsingCamera(mSelectedEntity) &&
         ImGui::Button("Set as active camera")) {
       editorManager.setActiveCamera(mSelectedEntity);
@@ -268,10 +278,15 @@ void EntityPanel::renderTransform() {
         mEntityManager.getActiveEntityDatabase()
             .getComponent<liquid::WorldTransformComponent>(mSelectedEntity);
 
+    // Transform is edited in place, so it is only marked
+    // as changed when one of its inputs is edited
+    bool changed = false;
+
     ImGui::Text("Position");
 
     if (liquid::imgui::input("###InputTransformPosition",
                              component.localPosition)) {
+      changed = true;
       mEntityManager.save(mSelectedEntity);
     }
 
@@ -281,6 +296,7 @@ void EntityPanel::renderTransform() {
     if (ImGui::InputFloat3("###InputTransformRotation", imguiRotation.data())) {
       component.localRotation = glm::quat(glm::vec3(
           imguiRotation.at(0), imguiRotation.at(1), imguiRotation.at(2)));
+      changed = true;
     }
 
     if (ImGui::IsItemDeactivatedAfterEdit()) {
@@ -289,9 +305,16 @@ void EntityPanel::renderTransform() {
 
     ImGui::Text("Scale");
     if (liquid::imgui::input("###InputTransformScale", component.localScale)) {
+      changed = true;
       mEntityManager.save(mSelectedEntity);
     }
 
+    if (changed) {
+      mEntityManager.getActiveEntityDatabase()
+          .markComponentChanged<liquid::LocalTransformComponent>(
+              mSelectedEntity);
+    }
+
     ImGui::Text("World Transform");
     if (ImGui::BeginTable("table-transformWorld", 4,
                           ImGuiTableFlags_Borders |
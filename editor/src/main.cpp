@@ -10,6 +10,7 @@ int main() {
   static constexpr uint32_t INITIAL_HEIGHT = 768;
 
   liquid::Engine::setAssetsPath(liquid::Path("./engine/assets").string());
+  liquid::Engine::setUserDataPath(liquid::Path("./engine/user-data").string());
 
   liquid::EventSystem eventSystem;
   liquid::Window window("Liquidator", INITIAL_WIDTH, INITIAL_HEIGHT,
@@ -18,15 +19,17 @@ int main() {
   liquid::rhi::VulkanRenderBackend backend(window);
   auto *device = backend.createDefaultDevice();
 
-  liquidator::ProjectSelectorScreen projectSelector(window, eventSystem,
-                                                    device);
+  liquid::JobSystem jobSystem;
+
+  liquidator::ProjectSelectorScreen projectSelector(window, eventSystem, device,
+                                                    jobSystem);
 
   auto project = projectSelector.start();
 
   device->waitForIdle();
   device->destroyResources();
   if (project.has_value()) {
-    liquidator::EditorScreen editor(window, eventSystem, device);
+    liquidator::EditorScreen editor(window, eventSystem, device, jobSystem);
     editor.start(project.value());
     device->waitForIdle();
   }
@@ -31,8 +31,14 @@ layout(std140, set = 1, binding = 0) readonly buffer ObjectData {
 }
 uObjectData;
 
+layout(std430, set = 1, binding = 1) readonly buffer InstanceData {
+  uint items[];
+}
+uInstanceData;
+
 void main() {
-  mat4 modelMatrix = uObjectData.items[gl_BaseInstance].modelMatrix;
+  uint itemIndex = uInstanceData.items[gl_InstanceIndex];
+  mat4 modelMatrix = uObjectData.items[itemIndex].modelMatrix;
 
   vec4 worldPosition =
       uCameraData.viewProj * modelMatrix * vec4(inPosition, 1.0f);
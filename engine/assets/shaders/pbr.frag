@@ -198,10 +198,15 @@ vec3 getNormal() {
   }
 
   if (uMaterialData.normalTexture >= 0) {
-    vec3 n = texture(uTextures[uMaterialData.normalTexture],
-                     inTextureCoord[uMaterialData.normalTextureCoord])
-                 .rgb *
-             uMaterialData.normalScale;
+    // Normal maps can be stored in two channels;
+    // so, Z is reconstructed from X and Y
+    vec2 xy = texture(uTextures[uMaterialData.normalTexture],
+                      inTextureCoord[uMaterialData.normalTextureCoord])
+                      .rg *
+                  2.0 -
+              1.0;
+    vec3 n = vec3(xy * uMaterialData.normalScale,
+                  sqrt(max(1.0 - dot(xy, xy), 0.0)));
     return normalize(tbn * n);
   } else {
     return normalize(tbn[2]);
@@ -27,8 +27,14 @@ uObjectData;
 layout(push_constant) uniform PushConstants { ivec4 index; }
 pcLightRef;
 
+layout(std430, set = 1, binding = 1) readonly buffer InstanceData {
+  uint items[];
+}
+uInstanceData;
+
 void main() {
-  mat4 modelMatrix = uObjectData.items[gl_BaseInstance].modelMatrix;
+  uint itemIndex = uInstanceData.items[gl_InstanceIndex];
+  mat4 modelMatrix = uObjectData.items[itemIndex].modelMatrix;
 
   gl_Position = uLightData.items[pcLightRef.index.x].lightMatrix * modelMatrix *
                 vec4(inPosition, 1.0);
@@ -42,9 +42,15 @@ layout(std140, set = 1, binding = 1) readonly buffer SkeletonData {
 }
 uSkeletonData;
 
+layout(std430, set = 1, binding = 2) readonly buffer InstanceData {
+  uint items[];
+}
+uInstanceData;
+
 void main() {
-  mat4 modelMatrix = uObjectData.items[gl_BaseInstance].modelMatrix;
-  SkeletonItem item = uSkeletonData.items[gl_BaseInstance];
+  uint itemIndex = uInstanceData.items[gl_InstanceIndex];
+  mat4 modelMatrix = uObjectData.items[itemIndex].modelMatrix;
+  SkeletonItem item = uSkeletonData.items[itemIndex];
 
   mat4 skinMatrix = inWeights.x * item.joints[inJoints.x] +
                     inWeights.y * item.joints[inJoints.y] +
@@ -22,7 +22,7 @@ struct ObjectItem {
 };
 
 struct SkeletonItem {
-  mat4 joints[16];
+  mat4 joints[32];
 };
 
 layout(std140, set = 1, binding = 0) readonly buffer ObjectData {
@@ -38,9 +38,15 @@ uSkeletonData;
 layout(push_constant) uniform PushConstants { ivec4 index; }
 pcLightRef;
 
+layout(std430, set = 1, binding = 2) readonly buffer InstanceData {
+  uint items[];
+}
+uInstanceData;
+
 void main() {
-  mat4 modelMatrix = uObjectData.items[gl_BaseInstance].modelMatrix;
-  SkeletonItem item = uSkeletonData.items[gl_BaseInstance];
+  uint itemIndex = uInstanceData.items[gl_InstanceIndex];
+  mat4 modelMatrix = uObjectData.items[itemIndex].modelMatrix;
+  SkeletonItem item = uSkeletonData.items[itemIndex];
 
   mat4 skinMatrix = inWeights.x * item.joints[inJoints.x] +
                     inWeights.y * item.joints[inJoints.y] +
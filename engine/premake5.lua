@@ -14,7 +14,8 @@ function copyEngineAssets(assetsPath, outputPath)
         "glslc "..assetsPath.."/shaders/text.vert -o"..outputPath.."/shaders/text.vert.spv",
         "glslc "..assetsPath.."/shaders/text.frag -o"..outputPath.."/shaders/text.frag.spv",
         "glslc "..assetsPath.."/shaders/fullscreenQuad.frag -o"..outputPath.."/shaders/fullscreenQuad.frag.spv",
-        "glslc "..assetsPath.."/shaders/fullscreenQuad.vert -o"..outputPath.."/shaders/fullscreenQuad.vert.spv"
+        "glslc "..assetsPath.."/shaders/fullscreenQuad.vert -o"..outputPath.."/shaders/fullscreenQuad.vert.spv",
+        "glslc "..assetsPath.."/shaders/cullMeshes.comp -o"..outputPath.."/shaders/cullMeshes.comp.spv"
     }
 end
 
@@ -57,6 +58,7 @@ project "LiquidEngineTest"
 
     removefiles {
         "src/liquid/rhi/vulkan/VmaImpl.cpp",
+        "tests/**.bench.cpp"
     }
 
     setupTestingOptions{}
@@ -76,3 +78,31 @@ project "LiquidEngineTest"
         "{COPYFILE} ../../engine/tests/fixtures/valid-audio.wav %{cfg.buildtarget.directory}/valid-audio.wav",
         "{COPYFILE} ../../engine/tests/fixtures/valid-audio.mp3 %{cfg.buildtarget.directory}/valid-audio.mp3"
     }
+
+project "LiquidEngineBenchmark"
+    basedir "../workspace/engine-benchmark"
+    kind "ConsoleApp"
+
+    includedirs {
+        "../engine/tests",
+        "../engine/src"
+    }
+
+    pchheader "../../engine/src/liquid/core/Base.h"
+
+    filter { "toolset:msc-*" }
+        pchheader "liquid/core/Base.h"
+        pchsource "src/liquid/core/Base.cpp"
+
+    filter{}
+
+    files {
+        "tests/**.bench.cpp",
+        "src/liquid/core/Base.cpp"
+    }
+
+    setupTestingOptions{}
+    links { "LiquidEngine", "LiquidEngineRHICore" }
+    linkGoogleBenchmark{}
+    linkDependenciesWithoutVulkan{}
+    linkProfilerDependencies{}
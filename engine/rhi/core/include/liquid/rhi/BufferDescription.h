@@ -2,7 +2,27 @@
 
 namespace liquid::rhi {
 
-enum class BufferType { Vertex, Index, Uniform, Storage, Transfer };
+enum class BufferType { Vertex, Index, Uniform, Storage, Transfer, Indirect };
+
+/**
+ * @brief Range of data that is uploaded to buffer
+ */
+struct BufferUploadRange {
+  /**
+   * Offset of range in data
+   */
+  size_t dataOffset = 0;
+
+  /**
+   * Offset of range in buffer
+   */
+  size_t bufferOffset = 0;
+
+  /**
+   * Range size
+   */
+  size_t size = 0;
+};
 
 /**
  * @brief Buffer description
@@ -22,6 +42,65 @@ struct BufferDescription {
    * Buffer data
    */
   void *data = nullptr;
+
+  /**
+   * Size of data that is uploaded
+   *
+   * Data is uploaded to the data offset of
+   * the buffer. Whole buffer is uploaded if zero.
+   */
+  size_t dataSize = 0;
+
+  /**
+   * Buffer is updated every frame
+   *
+   * Dynamic buffer has a separate region for
+   * every frame in flight. Updates are written
+   * to the next region, so that frames that are
+   * still rendered keep reading their own data.
+   *
+   * Static buffers are stored in device local
+   * memory and are written through staging buffers.
+   */
+  bool dynamic = false;
+
+  /**
+   * Offset in buffer where data is uploaded
+   */
+  size_t dataOffset = 0;
+
+  /**
+   * Ranges of data that are uploaded
+   *
+   * If not empty, every range of data is uploaded
+   * to its own offset in the buffer instead of
+   * data size and data offset. Ranges are uploaded
+   * in order and must not overlap in the buffer.
+   */
+  std::vector<BufferUploadRange> uploadRanges;
+
+  /**
+   * Keep contents when buffer is resized
+   *
+   * Contents of a resized device local buffer
+   * are copied to the new buffer on the device
+   * before data is uploaded
+   */
+  bool keepContents = false;
 };
 
+/**
+ * @brief Check if buffer is stored in device local memory
+ *
+ * Dynamic buffers and transfer buffers
+ * are written directly by the host
+ *
+ * @param description Buffer description
+ * @retval true Buffer is device local
+ * @retval false Buffer is host visible
+ */
+inline bool isDeviceLocalBuffer(const BufferDescription &description) {
+  return !description.dynamic && description.type != BufferType::Transfer;
+}
+
 } // namespace liquid::rhi
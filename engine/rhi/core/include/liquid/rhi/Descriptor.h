@@ -32,6 +32,10 @@ struct DescriptorBinding {
  * int the CPU and is used by
  * descriptor manager to get the hash
  * data
+ *
+ * Hash is updated on every bind; so,
+ * descriptors with the same bindings
+ * in the same order have equal hashes
  */
 class Descriptor {
 public:
@@ -70,11 +74,35 @@ public:
    *
    * @return Hash code
    */
-  inline const String &getHashCode() const { return hashCode; }
+  inline uint64_t getHashCode() const { return hashCode; }
 
 private:
   std::map<uint32_t, DescriptorBinding> bindings;
-  String hashCode;
+  uint64_t hashCode = 0;
 };
 
+/**
+ * @brief Check if descriptor bindings are equal
+ *
+ * @param lhs Descriptor binding
+ * @param rhs Descriptor binding
+ * @retval true Bindings are equal
+ * @retval false Bindings are not equal
+ */
+bool operator==(const DescriptorBinding &lhs, const DescriptorBinding &rhs);
+
+/**
+ * @brief Check if descriptors are equal
+ *
+ * Descriptors with different bindings can
+ * have the same hash; so, descriptors must
+ * be compared when hashes are equal.
+ *
+ * @param lhs Descriptor
+ * @param rhs Descriptor
+ * @retval true Descriptors have equal bindings
+ * @retval false Descriptors have different bindings
+ */
+bool operator==(const Descriptor &lhs, const Descriptor &rhs);
+
 } // namespace liquid::rhi
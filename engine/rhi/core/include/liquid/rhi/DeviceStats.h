@@ -13,9 +13,13 @@ public:
   /**
    * @brief Add draw call
    *
-   * @param primitiveCount Number of primitives
+   * Every instance after the first one is
+   * counted as a saved draw call
+   *
+   * @param primitiveCount Number of primitives per instance
+   * @param instanceCount Number of instances
    */
-  void addDrawCall(size_t primitiveCount);
+  void addDrawCall(size_t primitiveCount, uint32_t instanceCount = 1);
 
   /**
    * @brief Resets calls
@@ -27,6 +31,17 @@ public:
    */
   void addCommandCall();
 
+  /**
+   * @brief Add calls of other stats
+   *
+   * Command lists that are recorded in parallel
+   * collect their own stats that are added to
+   * device stats when the lists are executed
+   *
+   * @param stats Other stats
+   */
+  void addCalls(const DeviceStats &stats);
+
   /**
    * @brief Get number of draw calls
    *
@@ -34,6 +49,15 @@ public:
    */
   inline uint32_t getDrawCallsCount() const { return mDrawCallsCount; }
 
+  /**
+   * @brief Get number of saved draw calls
+   *
+   * @return Number of draw calls saved by instancing
+   */
+  inline uint32_t getSavedDrawCallsCount() const {
+    return mSavedDrawCallsCount;
+  }
+
   /**
    * @brief Get number of drawn primitives
    *
@@ -52,6 +76,7 @@ public:
 
 private:
   uint32_t mDrawCallsCount = 0;
+  uint32_t mSavedDrawCallsCount = 0;
   size_t mDrawnPrimitivesCount = 0;
   uint32_t mCommandCallsCount = 0;
 };
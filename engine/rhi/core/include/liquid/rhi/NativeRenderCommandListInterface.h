@@ -8,6 +8,8 @@
 
 namespace liquid::rhi {
 
+class RenderCommandList;
+
 /**
  * @brief Native render command list interface
  */
@@ -39,11 +41,13 @@ public:
    * @param framebuffer Framebuffer
    * @param renderAreaOffset Render area offset
    * @param renderAreaSize Render area size
+   * @param contents Render pass contents
    */
   virtual void beginRenderPass(rhi::RenderPassHandle renderPass,
                                FramebufferHandle framebuffer,
                                const glm::ivec2 &renderAreaOffset,
-                               const glm::uvec2 &renderAreaSize) = 0;
+                               const glm::uvec2 &renderAreaSize,
+                               VkSubpassContents contents) = 0;
 
   /**
    * @brief End render pass
@@ -119,6 +123,38 @@ public:
                            int32_t vertexOffset, uint32_t instanceCount,
                            uint32_t firstInstance) = 0;
 
+  /**
+   * @brief Draw with parameters from buffer
+   *
+   * @param buffer Buffer with draw commands
+   * @param offset Offset of first command
+   * @param drawCount Number of draws
+   * @param stride Stride between commands
+   */
+  virtual void drawIndirect(BufferHandle buffer, size_t offset,
+                            uint32_t drawCount, uint32_t stride) = 0;
+
+  /**
+   * @brief Draw indexed with parameters from buffer
+   *
+   * @param buffer Buffer with draw commands
+   * @param offset Offset of first command
+   * @param drawCount Number of draws
+   * @param stride Stride between commands
+   */
+  virtual void drawIndexedIndirect(BufferHandle buffer, size_t offset,
+                                   uint32_t drawCount, uint32_t stride) = 0;
+
+  /**
+   * @brief Dispatch compute work
+   *
+   * @param groupCountX Number of workgroups in X dimension
+   * @param groupCountY Number of workgroups in Y dimension
+   * @param groupCountZ Number of workgroups in Z dimension
+   */
+  virtual void dispatch(uint32_t groupCountX, uint32_t groupCountY,
+                        uint32_t groupCountZ) = 0;
+
   /**
    * @brief Set viewport
    *
@@ -149,6 +185,67 @@ public:
   pipelineBarrier(VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage,
                   const std::vector<MemoryBarrier> &memoryBarriers,
                   const std::vector<ImageBarrier> &imageBarriers) = 0;
+
+  /**
+   * @brief Signal event
+   *
+   * @param event Event index
+   * @param stage Pipeline stage that signals the event
+   */
+  virtual void setEvent(size_t event, VkPipelineStageFlags stage) = 0;
+
+  /**
+   * @brief Unsignal event
+   *
+   * @param event Event index
+   * @param stage Pipeline stage that unsignals the event
+   */
+  virtual void resetEvent(size_t event, VkPipelineStageFlags stage) = 0;
+
+  /**
+   * @brief Wait for events
+   *
+   * @param events Event indices
+   * @param srcStage Source pipeline stage
+   * @param dstStage Destination pipeline stage
+   * @param memoryBarriers Memory barriers
+   * @param imageBarriers Image barriers
+   */
+  virtual void waitEvents(const std::vector<size_t> &events,
+                          VkPipelineStageFlags srcStage,
+                          VkPipelineStageFlags dstStage,
+                          const std::vector<MemoryBarrier> &memoryBarriers,
+                          const std::vector<ImageBarrier> &imageBarriers) = 0;
+
+  /**
+   * @brief Get secondary command list
+   *
+   * @param index Secondary command list index
+   * @return Secondary command list
+   */
+  virtual RenderCommandList &getSecondaryCommandList(size_t index) = 0;
+
+  /**
+   * @brief Begin recording secondary command list
+   *
+   * @param renderPass Render pass that commands are executed in
+   * @param framebuffer Framebuffer that commands are executed in
+   */
+  virtual void begin(RenderPassHandle renderPass,
+                     FramebufferHandle framebuffer) = 0;
+
+  /**
+   * @brief End recording secondary command list
+   */
+  virtual void end() = 0;
+
+  /**
+   * @brief Execute secondary command lists
+   *
+   * @param commandLists Secondary command lists
+   */
+  virtual void
+  executeCommandLists(const std::vector<RenderCommandList *> &commandLists) = 0;
 };
 
 } // namespace liquid::rhi
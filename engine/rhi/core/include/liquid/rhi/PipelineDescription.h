@@ -317,6 +317,38 @@ struct PipelineDescription {
    * Render pass
    */
   RenderPassHandle renderPass = RenderPassHandle::Invalid;
+
+  /**
+   * Compute shader
+   *
+   * Compute pipeline is created if compute
+   * shader is set; graphics states are ignored
+   */
+  ShaderHandle computeShader = ShaderHandle::Invalid;
 };
 
+/**
+ * @brief Get pipeline description hash
+ *
+ * Hash only depends on values of the
+ * description. Different descriptions can
+ * have the same hash; so, descriptions must
+ * be compared when hashes are equal.
+ *
+ * @param description Pipeline description
+ * @return Description hash
+ */
+uint64_t getPipelineDescriptionHash(const PipelineDescription &description);
+
+/**
+ * @brief Check if pipeline descriptions are equal
+ *
+ * @param lhs Pipeline description
+ * @param rhs Pipeline description
+ * @retval true Descriptions are equal
+ * @retval false Descriptions are not equal
+ */
+bool operator==(const PipelineDescription &lhs,
+                const PipelineDescription &rhs);
+
 } // namespace liquid::rhi
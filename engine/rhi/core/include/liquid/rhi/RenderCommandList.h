@@ -70,13 +70,16 @@ public:
    * @param framebuffer Framebuffer
    * @param renderAreaOffset Render area offset
    * @param renderAreaSize Render area size
+   * @param contents Render pass contents
    */
-  inline void beginRenderPass(rhi::RenderPassHandle renderPass,
-                              FramebufferHandle framebuffer,
-                              const glm::ivec2 &renderAreaOffset,
-                              const glm::uvec2 &renderAreaSize) {
-    mNativeRenderCommandList->beginRenderPass(renderPass, framebuffer,
-                                              renderAreaOffset, renderAreaSize);
+  inline void
+  beginRenderPass(rhi::RenderPassHandle renderPass,
+                  FramebufferHandle framebuffer,
+                  const glm::ivec2 &renderAreaOffset,
+                  const glm::uvec2 &renderAreaSize,
+                  VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE) {
+    mNativeRenderCommandList->beginRenderPass(
+        renderPass, framebuffer, renderAreaOffset, renderAreaSize, contents);
   }
 
   /**
@@ -170,6 +173,45 @@ public:
                                           instanceCount, firstInstance);
   }
 
+  /**
+   * @brief Draw with parameters from buffer
+   *
+   * @param buffer Buffer with draw commands
+   * @param offset Offset of first command
+   * @param drawCount Number of draws
+   * @param stride Stride between commands
+   */
+  inline void drawIndirect(BufferHandle buffer, size_t offset,
+                           uint32_t drawCount, uint32_t stride) {
+    mNativeRenderCommandList->drawIndirect(buffer, offset, drawCount, stride);
+  }
+
+  /**
+   * @brief Draw indexed with parameters from buffer
+   *
+   * @param buffer Buffer with draw commands
+   * @param offset Offset of first command
+   * @param drawCount Number of draws
+   * @param stride Stride between commands
+   */
+  inline void drawIndexedIndirect(BufferHandle buffer, size_t offset,
+                                  uint32_t drawCount, uint32_t stride) {
+    mNativeRenderCommandList->drawIndexedIndirect(buffer, offset, drawCount,
+                                                  stride);
+  }
+
+  /**
+   * @brief Dispatch compute work
+   *
+   * @param groupCountX Number of workgroups in X dimension
+   * @param groupCountY Number of workgroups in Y dimension
+   * @param groupCountZ Number of workgroups in Z dimension
+   */
+  inline void dispatch(uint32_t groupCountX, uint32_t groupCountY = 1,
+                       uint32_t groupCountZ = 1) {
+    mNativeRenderCommandList->dispatch(groupCountX, groupCountY, groupCountZ);
+  }
+
   /**
    * @brief Set viewport
    *
@@ -208,6 +250,97 @@ public:
                                               memoryBarriers, imageBarriers);
   }
 
+  /**
+   * @brief Signal event
+   *
+   * @param event Event index
+   * @param stage Pipeline stage that signals the event
+   */
+  inline void setEvent(size_t event, VkPipelineStageFlags stage) {
+    mNativeRenderCommandList->setEvent(event, stage);
+  }
+
+  /**
+   * @brief Unsignal event
+   *
+   * @param event Event index
+   * @param stage Pipeline stage that unsignals the event
+   */
+  inline void resetEvent(size_t event, VkPipelineStageFlags stage) {
+    mNativeRenderCommandList->resetEvent(event, stage);
+  }
+
+  /**
+   * @brief Wait for events
+   *
+   * @param events Event indices
+   * @param srcStage Source pipeline stage
+   * @param dstStage Destination pipeline stage
+   * @param memoryBarriers Memory barriers
+   * @param imageBarriers Image barriers
+   */
+  void waitEvents(const std::vector<size_t> &events,
+                  VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage,
+                  const std::vector<MemoryBarrier> &memoryBarriers,
+                  const std::vector<ImageBarrier> &imageBarriers) {
+    mNativeRenderCommandList->waitEvents(events, srcStage, dstStage,
+                                         memoryBarriers, imageBarriers);
+  }
+
+  /**
+   * @brief Get secondary command list
+   *
+   * Every secondary command list has its own
+   * command storage; so, different secondary
+   * lists can be recorded from different
+   * threads at the same time. Secondary lists
+   * are created on demand and must be requested
+   * from the thread that records this list.
+   *
+   * @param index Secondary command list index
+   * @return Secondary command list
+   */
+  inline RenderCommandList &getSecondaryCommandList(size_t index) {
+    return mNativeRenderCommandList->getSecondaryCommandList(index);
+  }
+
+  /**
+   * @brief Begin recording secondary command list
+   *
+   * Secondary lists that are executed inside a
+   * render pass inherit the render pass but not
+   * pipeline, descriptor, viewport, or scissor
+   * state; so, they must set these themselves.
+   *
+   * @param renderPass Render pass or invalid handle
+   *                   if commands are executed outside
+   *                   of render passes
+   * @param framebuffer Framebuffer of render pass
+   */
+  inline void begin(RenderPassHandle renderPass,
+                    FramebufferHandle framebuffer) {
+    mNativeRenderCommandList->begin(renderPass, framebuffer);
+  }
+
+  /**
+   * @brief End recording secondary command list
+   */
+  inline void end() { mNativeRenderCommandList->end(); }
+
+  /**
+   * @brief Execute secondary command lists
+   *
+   * Lists are executed in the given order.
+   * Inside render passes, the pass must be
+   * begun with secondary command list contents.
+   *
+   * @param commandLists Secondary command lists
+   */
+  inline void
+  executeCommandLists(const std::vector<RenderCommandList *> &commandLists) {
+    mNativeRenderCommandList->executeCommandLists(commandLists);
+  }
+
 private:
   std::unique_ptr<NativeRenderCommandListInterface> mNativeRenderCommandList;
 };
@@ -70,6 +70,15 @@ public:
    */
   virtual const DeviceStats &getDeviceStats() const = 0;
 
+  /**
+   * @brief Check if texture format is supported
+   *
+   * @param format Texture format
+   * @retval true Format can be sampled
+   * @retval false Format cannot be sampled
+   */
+  virtual bool isTextureFormatSupported(uint32_t format) const = 0;
+
   /**
    * @brief Destroy all resources in the device
    *
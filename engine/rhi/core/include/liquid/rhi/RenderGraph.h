@@ -18,11 +18,42 @@ public:
    */
   RenderGraphPass &addPass(StringView name);
 
+  /**
+   * @brief Enable or disable pass
+   *
+   * Disabled passes are not compiled
+   *
+   * @param name Pass name
+   * @param enabled Enable pass
+   */
+  void setPassEnabled(StringView name, bool enabled);
+
+  /**
+   * @brief Set graph output
+   *
+   * Passes that do not contribute to the
+   * output are culled. All passes are
+   * compiled if output is not set.
+   *
+   * @param handle Output texture
+   */
+  void setOutput(TextureHandle handle);
+
+  /**
+   * @brief Get graph output
+   *
+   * @return Output texture
+   */
+  inline TextureHandle getOutput() const { return mOutput; }
+
   /**
    * @brief Compile render graph
    *
    * Topologically sorts and updates render
-   * passes in place
+   * passes in place. Attachments whose lifetimes
+   * do not overlap are assigned to the same
+   * memory alias group. Compiled passes are
+   * cached for every set of enabled passes.
    *
    * @param resourceRegistry Resource registry
    */
@@ -73,12 +104,106 @@ public:
    */
   void updateDirtyFlag();
 
+  /**
+   * @brief Get transient memory size
+   *
+   * Memory that attachments of compiled
+   * passes need if every attachment has
+   * its own memory
+   *
+   * @return Transient memory size in bytes
+   */
+  inline size_t getTransientMemorySize() const {
+    return mTransientMemorySize;
+  }
+
+  /**
+   * @brief Get aliased transient memory size
+   *
+   * Memory that attachments of compiled
+   * passes need if attachments in the same
+   * alias group share memory
+   *
+   * @return Aliased transient memory size in bytes
+   */
+  inline size_t getAliasedTransientMemorySize() const {
+    return mAliasedTransientMemorySize;
+  }
+
+private:
+  /**
+   * @brief Compiled passes of a topology
+   */
+  struct CompiledGraph {
+    /**
+     * Compiled passes
+     */
+    std::vector<RenderGraphPass> passes;
+
+    /**
+     * Framebuffer extent that passes are built with
+     */
+    glm::uvec2 framebufferExtent{};
+  };
+
+private:
+  /**
+   * @brief Sort enabled passes
+   *
+   * Removes passes that have no inputs and
+   * outputs and passes that do not contribute
+   * to the output before sorting.
+   */
+  void sortPasses();
+
+  /**
+   * @brief Remove passes that do not contribute to output
+   *
+   * @param passIndices Indices of passes
+   */
+  void cullPasses(std::vector<size_t> &passIndices);
+
+  /**
+   * @brief Assign alias groups to attachments
+   *
+   * Lifetime of an attachment starts at its first
+   * compiled pass and ends at its last reader.
+   * Attachments that are not read by passes are
+   * graph results and live until the last pass.
+   * Only attachments with the same usage share
+   * a group.
+   *
+   * @param resourceRegistry Resource registry
+   */
+  void aliasTransientTextures(ResourceRegistry &resourceRegistry);
+
+  /**
+   * @brief Create barriers of compiled passes
+   *
+   * Tracks last access of every resource and
+   * only adds barriers for accesses that depend
+   * on it. Reads after reads, and repeated layout
+   * transitions of textures that are read by
+   * several passes, do not need barriers.
+   *
+   * @param resourceRegistry Resource registry
+   */
+  void createBarriers(ResourceRegistry &resourceRegistry);
+
 private:
   std::vector<RenderGraphPass> mPasses;
   std::vector<RenderGraphPass> mCompiledPasses;
 
   glm::uvec2 mFramebufferExtent{};
   bool mDirty = true;
+  TextureHandle mOutput = TextureHandle::Invalid;
+
+  std::vector<bool> mCompiledTopology;
+  glm::uvec2 mCompiledExtent{};
+  std::unordered_map<std::vector<bool>, CompiledGraph> mCompiledGraphs;
+
+  size_t mTransientMemorySize = 0;
+  size_t mAliasedTransientMemorySize = 0;
 };
 
 } // namespace liquid::rhi
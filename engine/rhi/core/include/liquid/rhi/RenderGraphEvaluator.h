@@ -1,5 +1,7 @@
 #pragma once
 
+#include "liquid/core/JobSystem.h"
+
 #include "PipelineDescription.h"
 #include "RenderPassDescription.h"
 #include "ResourceRegistry.h"
@@ -20,6 +22,40 @@ class RenderGraphEvaluator {
     RenderPassAttachmentDescription attachment;
   };
 
+  /**
+   * @brief Range of pass items that is
+   *        recorded into one command list
+   */
+  struct PassRange {
+    /**
+     * Pass index
+     */
+    size_t pass = 0;
+
+    /**
+     * First item
+     */
+    size_t begin = 0;
+
+    /**
+     * Item after the last one
+     */
+    size_t end = 0;
+
+    /**
+     * Secondary command list
+     */
+    RenderCommandList *commandList = nullptr;
+  };
+
+  /**
+   * Minimum number of items in a range
+   *
+   * Small ranges are not worth the cost
+   * of a separate command list
+   */
+  static constexpr size_t MIN_RANGE_SIZE = 32;
+
 public:
   /**
    * @brief Create render graph evaluator
@@ -31,6 +67,10 @@ public:
   /**
    * @brief Build render graph
    *
+   * Only builds passes that are marked
+   * by compilation. Does nothing if graph
+   * has not changed since the last build.
+   *
    * @param graph Render graph
    */
   void build(RenderGraph &graph);
@@ -38,10 +78,18 @@ public:
   /**
    * @brief Execute render graph
    *
+   * Passes are recorded into secondary command
+   * lists in parallel; large passes are split into
+   * ranges of items. Barriers and render passes are
+   * recorded into the command list that executes the
+   * secondary command lists in graph order.
+   *
    * @param commandList Command list
    * @param graph Render graph
+   * @param jobSystem Job system that records passes
    */
-  void execute(RenderCommandList &commandList, RenderGraph &graph);
+  void execute(RenderCommandList &commandList, RenderGraph &graph,
+               JobSystem &jobSystem);
 
 private:
   /**
@@ -49,9 +97,16 @@ private:
    *
    * @param index Render pass index
    * @param graph Render graph
-   * @param force Force build even if the pass resources exist
    */
-  void buildPass(size_t index, RenderGraph &graph, bool force);
+  void buildPass(size_t index, RenderGraph &graph);
+
+  /**
+   * @brief Record range of pass items
+   *
+   * @param range Pass range
+   * @param pass Render pass
+   */
+  void recordRange(const PassRange &range, RenderGraphPass &pass);
 
   /**
    * @brief Create attachment
@@ -65,17 +120,10 @@ private:
                                             RenderTargetData &renderTarget,
                                             const glm::uvec2 &extent);
 
-  /**
-   * @brief Check if pass is has swapchain relative resources
-   *
-   * @param pass Render pass
-   * @retval true Has swapchain resources
-   * @retval false Does not have swapchain relative resources
-   */
-  bool hasSwapchainRelativeResources(RenderGraphPass &pass);
-
 private:
   ResourceRegistry &mRegistry;
+  std::vector<PassRange> mRanges;
+  std::vector<RenderCommandList *> mPassCommandLists;
 };
 
 } // namespace liquid::rhi
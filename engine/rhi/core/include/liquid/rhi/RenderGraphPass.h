@@ -78,6 +78,15 @@ struct RenderGraphPassBarrier {
    * Image barriers
    */
   std::vector<ImageBarrier> imageBarriers;
+
+  /**
+   * Events of split barrier
+   *
+   * Indices of compiled passes that signal
+   * events which the barrier waits for.
+   * Barrier is a pipeline barrier if empty.
+   */
+  std::vector<size_t> events;
 };
 
 /**
@@ -85,6 +94,9 @@ struct RenderGraphPassBarrier {
  */
 class RenderGraphPass {
   using ExecutorFn = std::function<void(RenderCommandList &)>;
+  using RangeExecutorFn =
+      std::function<void(RenderCommandList &, size_t, size_t)>;
+  using ItemCountFn = std::function<size_t()>;
   friend RenderGraph;
   friend RenderGraphEvaluator;
 
@@ -138,6 +150,15 @@ public:
    */
   void execute(RenderCommandList &commandList);
 
+  /**
+   * @brief Execute range of pass items
+   *
+   * @param commandList Command list
+   * @param begin First item
+   * @param end Item after the last one
+   */
+  void execute(RenderCommandList &commandList, size_t begin, size_t end);
+
   /**
    * @brief Set output texture
    *
@@ -153,6 +174,20 @@ public:
    */
   void read(TextureHandle handle);
 
+  /**
+   * @brief Set output buffer
+   *
+   * @param handle Buffer handle
+   */
+  void write(BufferHandle handle);
+
+  /**
+   * @brief Set input buffer
+   *
+   * @param handle Buffer handle
+   */
+  void read(BufferHandle handle);
+
   /**
    * @brief Set executor function
    *
@@ -160,6 +195,30 @@ public:
    */
   void setExecutor(const ExecutorFn &executor);
 
+  /**
+   * @brief Set range executor function
+   *
+   * Items of the pass are split into ranges
+   * that are recorded into separate command
+   * lists in parallel. Every range must set
+   * all the state that it uses.
+   *
+   * @param itemCount Function that returns number of items
+   * @param executor Executor function that records items in [begin, end)
+   */
+  void setRangeExecutor(const ItemCountFn &itemCount,
+                        const RangeExecutorFn &executor);
+
+  /**
+   * @brief Get number of items
+   *
+   * Passes without range executor
+   * consist of a single item
+   *
+   * @return Number of items
+   */
+  size_t getItemCount() const;
+
   /**
    * @brief Add pipeline
    *
@@ -192,6 +251,35 @@ public:
     return mOutputs;
   }
 
+  /**
+   * @brief Get input buffers
+   *
+   * @return Input buffers
+   */
+  inline const std::vector<BufferHandle> &getBufferInputs() const {
+    return mBufferInputs;
+  }
+
+  /**
+   * @brief Get output buffers
+   *
+   * @return Output buffers
+   */
+  inline const std::vector<BufferHandle> &getBufferOutputs() const {
+    return mBufferOutputs;
+  }
+
+  /**
+   * @brief Check if pass is a compute pass
+   *
+   * Passes without output textures are
+   * compute passes and have no render pass
+   *
+   * @retval true Pass is a compute pass
+   * @retval false Pass is a render pass
+   */
+  inline bool isCompute() const { return mOutputs.empty(); }
+
   /**
    * @brief Get attachment data
    *
@@ -242,21 +330,46 @@ public:
     return mPostBarrier;
   }
 
+  /**
+   * @brief Get signal stage
+   *
+   * Event of the pass is signaled after the
+   * pass for split barriers of later passes
+   *
+   * @return Pipeline stage that signals event; none if
+   * pass does not signal an event
+   */
+  inline VkPipelineStageFlags getSignalStage() const { return mSignalStage; }
+
+  /**
+   * @brief Check if pass is enabled
+   *
+   * @retval true Pass is enabled
+   * @retval false Pass is disabled
+   */
+  inline bool isEnabled() const { return mEnabled; }
+
 private:
   std::vector<AttachmentData> mAttachments;
   std::vector<RenderTargetData> mOutputs;
   std::vector<RenderTargetData> mInputs;
+  std::vector<BufferHandle> mBufferOutputs;
+  std::vector<BufferHandle> mBufferInputs;
   std::vector<PipelineHandle> mPipelines;
 
   RenderGraphPassBarrier mPreBarrier;
   RenderGraphPassBarrier mPostBarrier;
+  VkPipelineStageFlags mSignalStage = VK_PIPELINE_STAGE_NONE_KHR;
 
-  ExecutorFn mExecutor;
+  RangeExecutorFn mExecutor;
+  ItemCountFn mItemCount;
 
   rhi::RenderPassHandle mRenderPass = rhi::RenderPassHandle::Invalid;
   FramebufferHandle mFramebuffer = rhi::FramebufferHandle::Invalid;
   glm::uvec3 mDimensions{};
+  bool mNeedsBuild = true;
 
+  bool mEnabled = true;
   String mName;
 };
 
@@ -22,6 +22,31 @@ constexpr TextureUsage operator&(TextureUsage a, TextureUsage b) {
   return TextureUsage(static_cast<uint8_t>(a) & static_cast<uint8_t>(b));
 }
 
+/**
+ * @brief Texture mip level
+ */
+struct TextureLevel {
+  /**
+   * Offset of level in texture data
+   */
+  size_t offset = 0;
+
+  /**
+   * Size of level with all layers
+   */
+  size_t size = 0;
+
+  /**
+   * Level width
+   */
+  uint32_t width = 0;
+
+  /**
+   * Level height
+   */
+  uint32_t height = 0;
+};
+
 /**
  * @brief Texture description
  */
@@ -75,6 +100,23 @@ struct TextureDescription {
    * Texture raw data
    */
   void *data = nullptr;
+
+  /**
+   * Mip levels in texture data
+   *
+   * Layers of a level are stored next to each other.
+   * Texture only has the base level if empty.
+   */
+  std::vector<TextureLevel> levels;
+
+  /**
+   * Memory alias group
+   *
+   * Textures with the same non-zero group share
+   * memory. Render graph assigns groups to
+   * attachments whose lifetimes do not overlap.
+   */
+  uint32_t aliasGroup = 0;
 };
 
 } // namespace liquid::rhi
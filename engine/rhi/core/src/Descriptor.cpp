@@ -1,4 +1,5 @@
 #include "liquid/core/Base.h"
+#include "liquid/core/Hash.h"
 #include "liquid/rhi/Descriptor.h"
 
 namespace liquid::rhi {
@@ -10,13 +11,13 @@ Descriptor &Descriptor::bind(uint32_t binding,
                 "Descriptor type for binding " + std::to_string(binding) +
                     " must be combined image sampler");
   bindings.insert({binding, DescriptorBinding{type, textures}});
-  std::stringstream ss;
-  ss << "b:" << binding << ";t:" << static_cast<uint32_t>(type) << ";";
+
+  hashCombine(hashCode, binding);
+  hashCombine(hashCode, type);
+  hashCombine(hashCode, textures.size());
   for (auto x : textures) {
-    ss << "d:" << rhi::castHandleToUint(x) << ";";
+    hashCombine(hashCode, x);
   }
-  ss << "|";
-  hashCode += ss.str();
   return *this;
 }
 
@@ -28,11 +29,19 @@ Descriptor &Descriptor::bind(uint32_t binding, BufferHandle buffer,
                     " must be uniform or storage buffer");
 
   bindings.insert({binding, DescriptorBinding{type, buffer}});
-  std::stringstream ss;
-  ss << "b:" << binding << ";t:" << static_cast<uint32_t>(type)
-     << ";d:" << rhi::castHandleToUint(buffer) << "|";
-  hashCode += ss.str();
+
+  hashCombine(hashCode, binding);
+  hashCombine(hashCode, type);
+  hashCombine(hashCode, buffer);
   return *this;
 }
 
+bool operator==(const DescriptorBinding &lhs, const DescriptorBinding &rhs) {
+  return lhs.type == rhs.type && lhs.data == rhs.data;
+}
+
+bool operator==(const Descriptor &lhs, const Descriptor &rhs) {
+  return lhs.getBindings() == rhs.getBindings();
+}
+
 } // namespace liquid::rhi
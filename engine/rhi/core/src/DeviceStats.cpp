@@ -3,18 +3,27 @@
 
 namespace liquid::rhi {
 
-void DeviceStats::addDrawCall(size_t primitiveCount) {
+void DeviceStats::addDrawCall(size_t primitiveCount, uint32_t instanceCount) {
   mDrawCallsCount++;
-  mDrawnPrimitivesCount += primitiveCount;
+  mSavedDrawCallsCount += instanceCount > 0 ? instanceCount - 1 : 0;
+  mDrawnPrimitivesCount += primitiveCount * instanceCount;
   mCommandCallsCount++;
 }
 
 void DeviceStats::resetCalls() {
   mDrawCallsCount = 0;
+  mSavedDrawCallsCount = 0;
   mDrawnPrimitivesCount = 0;
   mCommandCallsCount = 0;
 }
 
 void DeviceStats::addCommandCall() { mCommandCallsCount++; }
 
+void DeviceStats::addCalls(const DeviceStats &stats) {
+  mDrawCallsCount += stats.mDrawCallsCount;
+  mSavedDrawCallsCount += stats.mSavedDrawCallsCount;
+  mDrawnPrimitivesCount += stats.mDrawnPrimitivesCount;
+  mCommandCallsCount += stats.mCommandCallsCount;
+}
+
 } // namespace liquid::rhi
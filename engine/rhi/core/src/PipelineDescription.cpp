@@ -0,0 +1,95 @@
+#include "liquid/core/Base.h"
+#include "liquid/core/Hash.h"
+#include "liquid/rhi/PipelineDescription.h"
+
+namespace liquid::rhi {
+
+uint64_t getPipelineDescriptionHash(const PipelineDescription &description) {
+  uint64_t hash = 0;
+  hashCombine(hash, description.vertexShader);
+  hashCombine(hash, description.fragmentShader);
+  hashCombine(hash, description.computeShader);
+  hashCombine(hash, description.renderPass);
+
+  hashCombine(hash, description.inputLayout.bindings.size());
+  for (const auto &binding : description.inputLayout.bindings) {
+    hashCombine(hash, binding.binding);
+    hashCombine(hash, binding.stride);
+    hashCombine(hash, binding.inputRate);
+  }
+
+  hashCombine(hash, description.inputLayout.attributes.size());
+  for (const auto &attribute : description.inputLayout.attributes) {
+    hashCombine(hash, attribute.slot);
+    hashCombine(hash, attribute.binding);
+    hashCombine(hash, attribute.format);
+    hashCombine(hash, attribute.offset);
+  }
+
+  hashCombine(hash, description.inputAssembly.primitiveTopology);
+  hashCombine(hash, description.rasterizer.polygonMode);
+  hashCombine(hash, description.rasterizer.cullMode);
+  hashCombine(hash, description.rasterizer.frontFace);
+
+  hashCombine(hash, description.colorBlend.attachments.size());
+  for (const auto &attachment : description.colorBlend.attachments) {
+    hashCombine(hash, attachment.enabled);
+    hashCombine(hash, attachment.srcColor);
+    hashCombine(hash, attachment.dstColor);
+    hashCombine(hash, attachment.colorOp);
+    hashCombine(hash, attachment.srcAlpha);
+    hashCombine(hash, attachment.dstAlpha);
+    hashCombine(hash, attachment.alphaOp);
+  }
+
+  return hash;
+}
+
+bool operator==(const PipelineDescription &lhs,
+                const PipelineDescription &rhs) {
+  auto bindingsEqual = [](const PipelineVertexInputBinding &a,
+                          const PipelineVertexInputBinding &b) {
+    return a.binding == b.binding && a.stride == b.stride &&
+           a.inputRate == b.inputRate;
+  };
+
+  auto attributesEqual = [](const PipelineVertexInputAttribute &a,
+                            const PipelineVertexInputAttribute &b) {
+    return a.slot == b.slot && a.binding == b.binding &&
+           a.format == b.format && a.offset == b.offset;
+  };
+
+  auto attachmentsEqual = [](const PipelineColorBlendAttachment &a,
+                             const PipelineColorBlendAttachment &b) {
+    return a.enabled == b.enabled && a.srcColor == b.srcColor &&
+           a.dstColor == b.dstColor && a.colorOp == b.colorOp &&
+           a.srcAlpha == b.srcAlpha && a.dstAlpha == b.dstAlpha &&
+           a.alphaOp == b.alphaOp;
+  };
+
+  const auto &lhsLayout = lhs.inputLayout;
+  const auto &rhsLayout = rhs.inputLayout;
+  const auto &lhsBlend = lhs.colorBlend;
+  const auto &rhsBlend = rhs.colorBlend;
+
+  return lhs.vertexShader == rhs.vertexShader &&
+         lhs.fragmentShader == rhs.fragmentShader &&
+         lhs.computeShader == rhs.computeShader &&
+         lhs.renderPass == rhs.renderPass &&
+         std::equal(lhsLayout.bindings.begin(), lhsLayout.bindings.end(),
+                    rhsLayout.bindings.begin(), rhsLayout.bindings.end(),
+                    bindingsEqual) &&
+         std::equal(lhsLayout.attributes.begin(), lhsLayout.attributes.end(),
+                    rhsLayout.attributes.begin(), rhsLayout.attributes.end(),
+                    attributesEqual) &&
+         lhs.inputAssembly.primitiveTopology ==
+             rhs.inputAssembly.primitiveTopology &&
+         lhs.rasterizer.polygonMode == rhs.rasterizer.polygonMode &&
+         lhs.rasterizer.cullMode == rhs.rasterizer.cullMode &&
+         lhs.rasterizer.frontFace == rhs.rasterizer.frontFace &&
+         std::equal(lhsBlend.attachments.begin(), lhsBlend.attachments.end(),
+                    rhsBlend.attachments.begin(), rhsBlend.attachments.end(),
+                    attachmentsEqual);
+}
+
+} // namespace liquid::rhi
@@ -7,31 +7,134 @@
 namespace liquid::rhi {
 
 RenderGraphPass &RenderGraph::addPass(StringView name) {
+  // Compiled graphs do not have the new pass
+  mCompiledTopology.clear();
+  mCompiledGraphs.clear();
+  mDirty = true;
+
   mPasses.push_back(name);
   return mPasses.back();
 }
 
+void RenderGraph::setPassEnabled(StringView name, bool enabled) {
+  auto it = std::find_if(
+      mPasses.begin(), mPasses.end(),
+      [name](const RenderGraphPass &pass) { return pass.getName() == name; });
+  LIQUID_ASSERT(it != mPasses.end(), "Pass does not exist");
+
+  if (it != mPasses.end() && it->mEnabled != enabled) {
+    it->mEnabled = enabled;
+    mDirty = true;
+  }
+}
+
+void RenderGraph::setOutput(TextureHandle handle) {
+  // Culled passes depend on the output
+  mCompiledTopology.clear();
+  mCompiledGraphs.clear();
+  mOutput = handle;
+  mDirty = true;
+}
+
 /**
  * @brief Topologically sort a graph
  *
+ * @param inputs Passes
+ * @param indices Pass indices of graph nodes
  * @param index Index of current item
  * @param visited Visited nodes
  * @param adjacencyList Adjacency list
  * @param output Output array
  */
 static void topologicalSort(const std::vector<RenderGraphPass> &inputs,
-                            size_t index, std::vector<bool> &visited,
+                            const std::vector<size_t> &indices, size_t index,
+                            std::vector<bool> &visited,
                             const std::vector<std::list<size_t>> &adjacencyList,
                             std::vector<RenderGraphPass> &output) {
   visited.at(index) = true;
 
   for (size_t x : adjacencyList.at(index)) {
     if (!visited.at(x)) {
-      topologicalSort(inputs, x, visited, adjacencyList, output);
+      topologicalSort(inputs, indices, x, visited, adjacencyList, output);
     }
   }
 
-  output.push_back(inputs.at(index));
+  output.push_back(inputs.at(indices.at(index)));
+}
+
+/**
+ * @brief Check if pass has swapchain relative resources
+ *
+ * @param pass Render pass
+ * @param resourceRegistry Resource registry
+ * @retval true Has swapchain relative resources
+ * @retval false Does not have swapchain relative resources
+ */
+static bool hasSwapchainRelativeResources(const RenderGraphPass &pass,
+                                          ResourceRegistry &resourceRegistry) {
+  for (auto rt : pass.getOutputs()) {
+    auto handle = rt.texture;
+    if (handle == TextureHandle(1) ||
+        resourceRegistry.getTextureMap().getDescription(handle).sizeMethod ==
+            TextureSizeMethod::FramebufferRatio) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * @brief Get texel size of attachment format
+ *
+ * @param format Texture format
+ * @return Texel size in bytes; 0 if format is unknown
+ */
+static size_t getTexelSize(uint32_t format) {
+  switch (static_cast<VkFormat>(format)) {
+  case VK_FORMAT_D16_UNORM:
+    return 2;
+  case VK_FORMAT_R8G8B8A8_UNORM:
+  case VK_FORMAT_R8G8B8A8_SRGB:
+  case VK_FORMAT_B8G8R8A8_UNORM:
+  case VK_FORMAT_B8G8R8A8_SRGB:
+  case VK_FORMAT_R32_SFLOAT:
+  case VK_FORMAT_D32_SFLOAT:
+  case VK_FORMAT_D24_UNORM_S8_UINT:
+    return 4;
+  case VK_FORMAT_R16G16B16A16_SFLOAT:
+  case VK_FORMAT_R32G32_SFLOAT:
+    return 8;
+  case VK_FORMAT_R32G32B32A32_SFLOAT:
+    return 16;
+  default:
+    return 0;
+  }
+}
+
+/**
+ * @brief Estimate memory size of texture
+ *
+ * Alignment and padding of the device
+ * are not taken into account
+ *
+ * @param description Texture description
+ * @param framebufferExtent Framebuffer extent
+ * @return Texture size in bytes
+ */
+static size_t getTextureMemorySize(const TextureDescription &description,
+                                   const glm::uvec2 &framebufferExtent) {
+  static constexpr size_t HUNDRED_PERCENT = 100;
+
+  size_t width = description.width;
+  size_t height = description.height;
+  if (description.sizeMethod == TextureSizeMethod::FramebufferRatio) {
+    width = width * framebufferExtent.x / HUNDRED_PERCENT;
+    height = height * framebufferExtent.y / HUNDRED_PERCENT;
+  }
+
+  return width * height * description.depth * description.layers *
+         getTexelSize(description.format);
 }
 
 void RenderGraph::compile(ResourceRegistry &resourceRegistry) {
@@ -39,8 +142,6 @@ void RenderGraph::compile(ResourceRegistry &resourceRegistry) {
     return;
 
   LIQUID_PROFILE_EVENT("RenderGraph::compile");
-  std::vector<size_t> passIndices;
-  passIndices.reserve(mPasses.size());
 
   // Validate pass names
   std::set<String> uniquePasses;
@@ -56,10 +157,63 @@ void RenderGraph::compile(ResourceRegistry &resourceRegistry) {
                                          "graph are used in more than one pass";
   }
 
-  // Delete lonely nodes
-  for (auto i = 0; i < mPasses.size(); ++i) {
+  // Compiled passes are kept for every topology;
+  // so, toggling passes reuses sorted passes
+  // and their render passes and framebuffers
+  std::vector<bool> topology(mPasses.size());
+  for (size_t i = 0; i < mPasses.size(); ++i) {
+    topology.at(i) = mPasses.at(i).isEnabled();
+  }
+
+  if (topology != mCompiledTopology) {
+    if (!mCompiledTopology.empty()) {
+      mCompiledGraphs.insert_or_assign(
+          mCompiledTopology,
+          CompiledGraph{std::move(mCompiledPasses), mCompiledExtent});
+    }
+
+    auto it = mCompiledGraphs.find(topology);
+    if (it != mCompiledGraphs.end()) {
+      mCompiledPasses = std::move(it->second.passes);
+      mCompiledExtent = it->second.framebufferExtent;
+      mCompiledGraphs.erase(it);
+    } else {
+      sortPasses();
+      mCompiledExtent = mFramebufferExtent;
+    }
+
+    mCompiledTopology = std::move(topology);
+  }
+
+  // Swapchain relative attachments are
+  // recreated when framebuffer is resized
+  if (mCompiledExtent != mFramebufferExtent) {
+    for (auto &pass : mCompiledPasses) {
+      if (hasSwapchainRelativeResources(pass, resourceRegistry)) {
+        pass.mNeedsBuild = true;
+      }
+    }
+
+    mCompiledExtent = mFramebufferExtent;
+  }
+
+  aliasTransientTextures(resourceRegistry);
+  createBarriers(resourceRegistry);
+}
+
+void RenderGraph::sortPasses() {
+  std::vector<size_t> passIndices;
+  passIndices.reserve(mPasses.size());
+
+  // Delete disabled and lonely nodes
+  for (size_t i = 0; i < mPasses.size(); ++i) {
     auto &pass = mPasses.at(i);
-    if (pass.getInputs().size() == 0 && pass.getOutputs().size() == 0) {
+    if (!pass.isEnabled()) {
+      LOG_DEBUG("Pass is ignored during compilation because it is disabled: "
+                << pass.getName());
+    } else if (pass.getInputs().size() == 0 && pass.getOutputs().size() == 0 &&
+               pass.getBufferInputs().size() == 0 &&
+               pass.getBufferOutputs().size() == 0) {
       LOG_DEBUG("Pass is ignored during compilation because it has no inputs, "
                 "nor outputs: "
                 << pass.getName());
@@ -68,14 +222,23 @@ void RenderGraph::compile(ResourceRegistry &resourceRegistry) {
     }
   }
 
+  if (isHandleValid(mOutput)) {
+    cullPasses(passIndices);
+  }
+
   // Cache reads so we can easily access them
   // for creating the adjacency lsit
   std::unordered_map<rhi::TextureHandle, std::vector<size_t>> passReads;
+  std::unordered_map<rhi::BufferHandle, std::vector<size_t>> bufferReads;
   for (size_t i = 0; i < passIndices.size(); ++i) {
     auto &pass = mPasses.at(passIndices.at(i));
     for (auto &resourceId : pass.getInputs()) {
       passReads[resourceId.texture].push_back(i);
     }
+
+    for (auto buffer : pass.getBufferInputs()) {
+      bufferReads[buffer].push_back(i);
+    }
   }
 
   // Create adjacency list from inputs and outputs
@@ -92,20 +255,217 @@ void RenderGraph::compile(ResourceRegistry &resourceRegistry) {
         }
       }
     }
+
+    for (auto buffer : pass.getBufferOutputs()) {
+      if (bufferReads.find(buffer) != bufferReads.end()) {
+        for (auto read : bufferReads.at(buffer)) {
+          adjacencyList.at(i).push_back(read);
+        }
+      }
+    }
   }
 
   // Topological sort based on DFS
+  mCompiledPasses.clear();
   mCompiledPasses.reserve(passIndices.size());
   std::vector<bool> visited(passIndices.size(), false);
 
   for (size_t i = passIndices.size(); i-- > 0;) {
     if (!visited.at(i)) {
-      topologicalSort(mPasses, i, visited, adjacencyList, mCompiledPasses);
+      topologicalSort(mPasses, passIndices, i, visited, adjacencyList,
+                      mCompiledPasses);
     }
   }
 
   std::reverse(mCompiledPasses.begin(), mCompiledPasses.end());
+}
+
+void RenderGraph::cullPasses(std::vector<size_t> &passIndices) {
+  std::unordered_map<TextureHandle, std::vector<size_t>> textureWrites;
+  std::unordered_map<BufferHandle, std::vector<size_t>> bufferWrites;
+  for (auto index : passIndices) {
+    for (auto &output : mPasses.at(index).getOutputs()) {
+      textureWrites[output.texture].push_back(index);
+    }
+
+    for (auto buffer : mPasses.at(index).getBufferOutputs()) {
+      bufferWrites[buffer].push_back(index);
+    }
+  }
+
+  // Walk from the output to the passes that
+  // write resources of the reached passes
+  std::vector<bool> reachable(mPasses.size(), false);
+  std::vector<size_t> stack;
+  auto reach = [&reachable, &stack](const std::vector<size_t> &writers) {
+    for (auto writer : writers) {
+      if (!reachable.at(writer)) {
+        reachable.at(writer) = true;
+        stack.push_back(writer);
+      }
+    }
+  };
+
+  if (textureWrites.find(mOutput) != textureWrites.end()) {
+    reach(textureWrites.at(mOutput));
+  }
+
+  while (!stack.empty()) {
+    auto &pass = mPasses.at(stack.back());
+    stack.pop_back();
+
+    for (auto &input : pass.getInputs()) {
+      if (textureWrites.find(input.texture) != textureWrites.end()) {
+        reach(textureWrites.at(input.texture));
+      }
+    }
+
+    for (auto buffer : pass.getBufferInputs()) {
+      if (bufferWrites.find(buffer) != bufferWrites.end()) {
+        reach(bufferWrites.at(buffer));
+      }
+    }
+  }
+
+  auto it = std::remove_if(
+      passIndices.begin(), passIndices.end(), [this, &reachable](size_t index) {
+        if (reachable.at(index)) {
+          return false;
+        }
+
+        LOG_DEBUG("Pass is culled because it does not contribute to the "
+                  "render graph output: "
+                  << mPasses.at(index).getName());
+        return true;
+      });
+  passIndices.erase(it, passIndices.end());
+}
+
+/**
+ * @brief Get layout of texture when it is an attachment
+ *
+ * @param description Texture description
+ * @return Attachment image layout
+ */
+static VkImageLayout
+getAttachmentLayout(const TextureDescription &description) {
+  if ((description.usage & TextureUsage::Color) == TextureUsage::Color) {
+    return VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+  }
+
+  if ((description.usage & TextureUsage::Depth) == TextureUsage::Depth) {
+    return VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+  }
+
+  return VK_IMAGE_LAYOUT_MAX_ENUM;
+}
+
+/**
+ * @brief Last access of resource in compiled passes
+ */
+struct ResourceState {
+  /**
+   * Index of last pass that accessed the resource
+   */
+  size_t pass = 0;
+
+  /**
+   * Image layout after last access
+   */
+  VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+  /**
+   * Pipeline stages of last accesses
+   */
+  VkPipelineStageFlags stage = VK_PIPELINE_STAGE_NONE_KHR;
+
+  /**
+   * Writes that are not visible to other accesses
+   *
+   * Empty if last accesses are reads
+   */
+  VkAccessFlags writeAccess = VK_ACCESS_NONE_KHR;
+
+  /**
+   * Access of last write
+   *
+   * Kept after reads; so, reads in other
+   * stages can wait for the write too.
+   * Empty if resource is not written by passes.
+   */
+  VkAccessFlags lastWriteAccess = VK_ACCESS_NONE_KHR;
+};
+
+/**
+ * @brief First access of resource in compiled passes
+ *
+ * First access waits for the last
+ * access of the previous frame
+ */
+struct FirstAccess {
+  /**
+   * Index of pass
+   */
+  size_t pass = 0;
+
+  /**
+   * Pipeline stage of access
+   */
+  VkPipelineStageFlags stage = VK_PIPELINE_STAGE_NONE_KHR;
+
+  /**
+   * Access flags
+   */
+  VkAccessFlags access = VK_ACCESS_NONE_KHR;
+};
+
+/**
+ * @brief Add memory barrier to pass barrier
+ *
+ * Memory barriers of a pass barrier are
+ * global; so, they are merged into one
+ *
+ * @param barrier Pass barrier
+ * @param srcAccess Source access flags
+ * @param dstAccess Destination access flags
+ */
+static void addMemoryBarrier(RenderGraphPassBarrier &barrier,
+                             VkAccessFlags srcAccess, VkAccessFlags dstAccess) {
+  if (barrier.memoryBarriers.empty()) {
+    barrier.memoryBarriers.push_back({});
+  }
 
+  barrier.memoryBarriers.at(0).srcAccess |= srcAccess;
+  barrier.memoryBarriers.at(0).dstAccess |= dstAccess;
+}
+
+/**
+ * @brief Merge pass barriers
+ *
+ * @param barrier Barrier that is merged into
+ * @param other Merged barrier
+ */
+static void mergeBarriers(RenderGraphPassBarrier &barrier,
+                          const RenderGraphPassBarrier &other) {
+  if (!other.enabled) {
+    return;
+  }
+
+  barrier.enabled = true;
+  barrier.srcStage |= other.srcStage;
+  barrier.dstStage |= other.dstStage;
+
+  for (const auto &memoryBarrier : other.memoryBarriers) {
+    addMemoryBarrier(barrier, memoryBarrier.srcAccess,
+                     memoryBarrier.dstAccess);
+  }
+
+  barrier.imageBarriers.insert(barrier.imageBarriers.end(),
+                               other.imageBarriers.begin(),
+                               other.imageBarriers.end());
+}
+
+void RenderGraph::createBarriers(ResourceRegistry &resourceRegistry) {
   static constexpr VkPipelineStageFlags STAGE_FRAGMENT_TEST =
       VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
       VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
@@ -113,99 +473,456 @@ void RenderGraph::compile(ResourceRegistry &resourceRegistry) {
       VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
   static constexpr VkPipelineStageFlags STAGE_FRAGMENT_SHADER =
       VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+  static constexpr VkPipelineStageFlags STAGE_COMPUTE_SHADER =
+      VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+  // Buffers that are written by compute passes
+  // are read by draw commands and vertex shaders
+  static constexpr VkPipelineStageFlags STAGE_BUFFER_READ =
+      VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
+  static constexpr VkAccessFlags ACCESS_BUFFER_READ =
+      VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+
+  static constexpr VkImageLayout LAYOUT_SHADER_READ =
+      VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+  // Dependencies on the previous pass or the previous
+  // frame are pipeline barriers. Dependencies on
+  // earlier passes are split barriers that let
+  // passes in between run without waiting.
+  static constexpr size_t PREVIOUS_FRAME = std::numeric_limits<size_t>::max();
+
+  std::vector<RenderGraphPassBarrier> barriers(mCompiledPasses.size());
+  std::vector<RenderGraphPassBarrier> splitBarriers(mCompiledPasses.size());
+
+  auto getBarrier = [&](size_t pass, size_t producer,
+                        VkPipelineStageFlags srcStage,
+                        VkPipelineStageFlags dstStage)
+      -> RenderGraphPassBarrier & {
+    bool split = producer != PREVIOUS_FRAME && producer + 1 < pass;
+    auto &barrier = split ? splitBarriers.at(pass) : barriers.at(pass);
+
+    barrier.enabled = true;
+    barrier.srcStage |= srcStage;
+    barrier.dstStage |= dstStage;
+
+    if (split && std::find(barrier.events.begin(), barrier.events.end(),
+                           producer) == barrier.events.end()) {
+      barrier.events.push_back(producer);
+    }
 
-  // Determine attachments, image layouts, and barriers
-  std::unordered_map<rhi::TextureHandle, VkImageLayout> visitedOutputs;
-  for (auto &pass : mCompiledPasses) {
+    return barrier;
+  };
+
+  std::unordered_map<TextureHandle, ResourceState> textureStates;
+  std::unordered_map<BufferHandle, ResourceState> bufferStates;
+  std::vector<std::pair<TextureHandle, FirstAccess>> firstTextureAccesses;
+  std::vector<std::pair<BufferHandle, FirstAccess>> firstBufferAccesses;
+
+  auto &textures = resourceRegistry.getTextureMap();
+
+  for (size_t index = 0; index < mCompiledPasses.size(); ++index) {
+    auto &pass = mCompiledPasses.at(index);
     pass.mPreBarrier = RenderGraphPassBarrier{};
     pass.mPostBarrier = RenderGraphPassBarrier{};
+    pass.mSignalStage = VK_PIPELINE_STAGE_NONE_KHR;
+
+    VkPipelineStageFlags bufferReadStage =
+        pass.isCompute() ? STAGE_COMPUTE_SHADER : STAGE_BUFFER_READ;
+    VkPipelineStageFlags textureReadStage =
+        pass.isCompute() ? STAGE_COMPUTE_SHADER : STAGE_FRAGMENT_SHADER;
+
+    // Buffers that are not written by passes
+    // are uploaded from host and do not need
+    // barriers
+    for (auto buffer : pass.mBufferInputs) {
+      auto it = bufferStates.find(buffer);
+      if (it == bufferStates.end()) {
+        bufferStates.insert({buffer, {index, VK_IMAGE_LAYOUT_UNDEFINED,
+                                      bufferReadStage, VK_ACCESS_NONE_KHR}});
+        firstBufferAccesses.push_back(
+            {buffer, {index, bufferReadStage, ACCESS_BUFFER_READ}});
+        continue;
+      }
 
-    for (auto &input : pass.mInputs) {
-      LIQUID_ASSERT(visitedOutputs.find(input.texture) != visitedOutputs.end(),
-                    "Pass is reading from an empty texture");
+      // Reads after reads in the same stages
+      // do not need barriers
+      auto &state = it->second;
+      if (state.writeAccess == VK_ACCESS_NONE_KHR) {
+        if (state.lastWriteAccess == VK_ACCESS_NONE_KHR) {
+          // Buffer is not written yet; so, all the reads
+          // wait for the writes of the previous frame
+          auto first = std::find_if(
+              firstBufferAccesses.begin(), firstBufferAccesses.end(),
+              [buffer](const auto &access) { return access.first == buffer; });
+          first->second.stage |= bufferReadStage;
+        } else if ((state.stage & bufferReadStage) != bufferReadStage) {
+          addMemoryBarrier(
+              getBarrier(index, state.pass, state.stage, bufferReadStage),
+              state.lastWriteAccess, ACCESS_BUFFER_READ);
+        }
+
+        state.pass = index;
+        state.stage |= bufferReadStage;
+        continue;
+      }
 
-      input.srcLayout = visitedOutputs.at(input.texture);
-      input.dstLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+      auto &barrier =
+          getBarrier(index, state.pass, state.stage, bufferReadStage);
+      addMemoryBarrier(barrier, state.writeAccess, ACCESS_BUFFER_READ);
 
-      VkPipelineStageFlags otherStage = 0;
-      VkAccessFlags otherAccess = 0;
+      state = {index, VK_IMAGE_LAYOUT_UNDEFINED, bufferReadStage,
+               VK_ACCESS_NONE_KHR, state.lastWriteAccess};
+    }
 
-      if (input.srcLayout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL) {
-        otherStage = STAGE_FRAGMENT_TEST;
-        otherAccess = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-      } else if (input.srcLayout == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL) {
-        otherStage = STAGE_COLOR;
-        otherAccess = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    for (auto buffer : pass.mBufferOutputs) {
+      auto it = bufferStates.find(buffer);
+      if (it == bufferStates.end()) {
+        FirstAccess access{index, STAGE_COMPUTE_SHADER,
+                           VK_ACCESS_SHADER_WRITE_BIT};
+        firstBufferAccesses.push_back({buffer, access});
+      } else {
+        // Writes after reads only wait for the reads
+        auto &state = it->second;
+        auto &barrier =
+            getBarrier(index, state.pass, state.stage, STAGE_COMPUTE_SHADER);
+        if (state.writeAccess != VK_ACCESS_NONE_KHR) {
+          addMemoryBarrier(barrier, state.writeAccess,
+                           VK_ACCESS_SHADER_WRITE_BIT);
+        }
       }
 
-      ImageBarrier preImageBarrier{};
-      preImageBarrier.srcLayout = input.srcLayout;
-      preImageBarrier.dstLayout = input.dstLayout;
-      preImageBarrier.texture = input.texture;
-      preImageBarrier.srcAccess = otherAccess;
-      preImageBarrier.dstAccess = VK_ACCESS_SHADER_READ_BIT;
+      bufferStates.insert_or_assign(
+          buffer,
+          ResourceState{index, VK_IMAGE_LAYOUT_UNDEFINED, STAGE_COMPUTE_SHADER,
+                        VK_ACCESS_SHADER_WRITE_BIT,
+                        VK_ACCESS_SHADER_WRITE_BIT});
+    }
+
+    for (auto &input : pass.mInputs) {
+      LIQUID_ASSERT(textureStates.find(input.texture) != textureStates.end(),
+                    "Pass is reading from an empty texture");
+
+      const auto &texture = textures.getDescription(input.texture);
+      input.srcLayout = getAttachmentLayout(texture);
+      input.dstLayout = LAYOUT_SHADER_READ;
+
+      // Reads after reads in the same stages
+      // do not need barriers
+      auto &state = textureStates.at(input.texture);
+      if (state.layout == LAYOUT_SHADER_READ) {
+        if ((state.stage & textureReadStage) != textureReadStage) {
+          addMemoryBarrier(
+              getBarrier(index, state.pass, state.stage, textureReadStage),
+              state.lastWriteAccess, VK_ACCESS_SHADER_READ_BIT);
+        }
+
+        state.pass = index;
+        state.stage |= textureReadStage;
+        continue;
+      }
 
-      ImageBarrier postImageBarrier{};
-      postImageBarrier.srcLayout = input.dstLayout;
-      postImageBarrier.dstLayout = input.srcLayout;
-      postImageBarrier.texture = input.texture;
-      postImageBarrier.srcAccess = VK_ACCESS_SHADER_READ_BIT;
-      postImageBarrier.dstAccess = otherAccess;
+      ImageBarrier imageBarrier{};
+      imageBarrier.srcLayout = state.layout;
+      imageBarrier.dstLayout = LAYOUT_SHADER_READ;
+      imageBarrier.texture = input.texture;
+      imageBarrier.srcAccess = state.writeAccess;
+      imageBarrier.dstAccess = VK_ACCESS_SHADER_READ_BIT;
 
-      pass.mPreBarrier.enabled = true;
-      pass.mPreBarrier.srcStage |= otherStage;
-      pass.mPreBarrier.dstStage |= STAGE_FRAGMENT_SHADER;
-      pass.mPreBarrier.imageBarriers.push_back(preImageBarrier);
+      getBarrier(index, state.pass, state.stage, textureReadStage)
+          .imageBarriers.push_back(imageBarrier);
 
-      pass.mPostBarrier.enabled = true;
-      pass.mPostBarrier.srcStage |= STAGE_FRAGMENT_SHADER;
-      pass.mPostBarrier.dstStage |= otherStage;
-      pass.mPostBarrier.imageBarriers.push_back(postImageBarrier);
+      state = {index, LAYOUT_SHADER_READ, textureReadStage,
+               VK_ACCESS_NONE_KHR, state.lastWriteAccess};
     }
 
     for (size_t i = 0; i < pass.mOutputs.size(); ++i) {
       auto &output = pass.mOutputs.at(i);
       auto &attachment = pass.mAttachments.at(i);
-      if (visitedOutputs.find(output.texture) == visitedOutputs.end()) {
-        output.srcLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        attachment.loadOp = AttachmentLoadOp::Clear;
-      } else {
-        output.srcLayout = visitedOutputs.at(output.texture);
-        attachment.loadOp = AttachmentLoadOp::Load;
-      }
+      const auto &texture = textures.getDescription(output.texture);
 
-      attachment.storeOp = AttachmentStoreOp::Store;
+      VkPipelineStageFlags stage = VK_PIPELINE_STAGE_NONE_KHR;
+      VkAccessFlags srcAccess = VK_ACCESS_NONE_KHR;
+      VkAccessFlags dstAccess = VK_ACCESS_NONE_KHR;
 
-      VkPipelineStageFlags stage = 0;
-      VkAccessFlags srcAccess = 0;
-      VkAccessFlags dstAccess = 0;
-
-      auto &texture =
-          resourceRegistry.getTextureMap().getDescription(output.texture);
       if ((texture.usage & TextureUsage::Color) == TextureUsage::Color) {
-        output.dstLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
         stage = STAGE_COLOR;
         srcAccess = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
         dstAccess = srcAccess | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
       } else if ((texture.usage & TextureUsage::Depth) == TextureUsage::Depth) {
-        output.dstLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
         stage = STAGE_FRAGMENT_TEST;
         srcAccess = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
         dstAccess = srcAccess | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
       }
 
-      MemoryBarrier memoryBarrier{};
-      memoryBarrier.srcAccess = srcAccess;
-      memoryBarrier.dstAccess = dstAccess;
+      output.dstLayout = getAttachmentLayout(texture);
+      attachment.storeOp = AttachmentStoreOp::Store;
 
-      pass.mPostBarrier.enabled = true;
-      pass.mPostBarrier.srcStage |= stage;
-      pass.mPostBarrier.dstStage |= stage;
-      pass.mPostBarrier.memoryBarriers.push_back(memoryBarrier);
+      auto it = textureStates.find(output.texture);
+      if (it == textureStates.end()) {
+        output.srcLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        attachment.loadOp = AttachmentLoadOp::Clear;
+
+        firstTextureAccesses.push_back(
+            {output.texture, {index, stage, dstAccess}});
+      } else {
+        auto &state = it->second;
+        output.srcLayout = output.dstLayout;
+        attachment.loadOp = AttachmentLoadOp::Load;
 
-      visitedOutputs.insert_or_assign(output.texture, output.dstLayout);
+        auto &barrier = getBarrier(index, state.pass, state.stage, stage);
+        if (state.layout != output.dstLayout) {
+          ImageBarrier imageBarrier{};
+          imageBarrier.srcLayout = state.layout;
+          imageBarrier.dstLayout = output.dstLayout;
+          imageBarrier.texture = output.texture;
+          imageBarrier.srcAccess = state.writeAccess;
+          imageBarrier.dstAccess = dstAccess;
+          barrier.imageBarriers.push_back(imageBarrier);
+        } else {
+          addMemoryBarrier(barrier, state.writeAccess, dstAccess);
+        }
+      }
+
+      textureStates.insert_or_assign(
+          output.texture,
+          ResourceState{index, output.dstLayout, stage, srcAccess, srcAccess});
     }
   }
+
+  if (mCompiledPasses.empty()) {
+    return;
+  }
+
+  // Textures that are read by passes are returned
+  // to their attachment layouts once after the last
+  // pass; so, users outside of the graph always
+  // find attachments in attachment layouts.
+  // Memory of aliased attachments is already
+  // written by other attachments of the group;
+  // so, they are not transitioned. Their first
+  // write starts from undefined layout anyway.
+  auto &endBarrier = mCompiledPasses.back().mPostBarrier;
+  for (auto &[handle, access] : firstTextureAccesses) {
+    const auto &state = textureStates.at(handle);
+    const auto &texture = textures.getDescription(handle);
+    if (state.layout != LAYOUT_SHADER_READ || texture.aliasGroup != 0) {
+      continue;
+    }
+
+    bool isColor =
+        (texture.usage & TextureUsage::Color) == TextureUsage::Color;
+
+    ImageBarrier imageBarrier{};
+    imageBarrier.srcLayout = LAYOUT_SHADER_READ;
+    imageBarrier.dstLayout = getAttachmentLayout(texture);
+    imageBarrier.texture = handle;
+    imageBarrier.srcAccess = VK_ACCESS_SHADER_READ_BIT;
+    imageBarrier.dstAccess = isColor
+                                 ? VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT
+                                 : VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+    endBarrier.enabled = true;
+    endBarrier.srcStage |= state.stage;
+    endBarrier.dstStage |= isColor ? STAGE_COLOR : STAGE_FRAGMENT_TEST;
+    endBarrier.imageBarriers.push_back(imageBarrier);
+  }
+
+  // First writes of the frame wait for the last
+  // writes of the previous frame. Memory of
+  // aliased attachments is also written by other
+  // attachments of the group in earlier passes.
+  for (auto &[handle, access] : firstTextureAccesses) {
+    const auto &state = textureStates.at(handle);
+    const auto &texture = textures.getDescription(handle);
+
+    if (texture.aliasGroup != 0) {
+      auto &barrier = getBarrier(
+          access.pass, PREVIOUS_FRAME,
+          STAGE_COLOR | STAGE_FRAGMENT_TEST | STAGE_FRAGMENT_SHADER,
+          access.stage);
+      addMemoryBarrier(barrier,
+                       VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                           VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                       access.access);
+    } else if (state.writeAccess != VK_ACCESS_NONE_KHR) {
+      auto &barrier =
+          getBarrier(access.pass, PREVIOUS_FRAME, state.stage, access.stage);
+      addMemoryBarrier(barrier, state.writeAccess, access.access);
+    }
+  }
+
+  // Buffer writes also wait for the
+  // reads of the previous frame
+  for (auto &[handle, access] : firstBufferAccesses) {
+    const auto &state = bufferStates.at(handle);
+    bool isWrite = access.access == VK_ACCESS_SHADER_WRITE_BIT;
+    if (!isWrite && state.writeAccess == VK_ACCESS_NONE_KHR) {
+      continue;
+    }
+
+    auto &barrier =
+        getBarrier(access.pass, PREVIOUS_FRAME, state.stage, access.stage);
+    if (state.writeAccess != VK_ACCESS_NONE_KHR) {
+      addMemoryBarrier(barrier, state.writeAccess, access.access);
+    }
+  }
+
+  // Split barrier does not help if the pass waits
+  // with a pipeline barrier anyway
+  for (size_t index = 0; index < mCompiledPasses.size(); ++index) {
+    auto &pass = mCompiledPasses.at(index);
+    auto &barrier = barriers.at(index);
+    auto &splitBarrier = splitBarriers.at(index);
+
+    if (barrier.enabled) {
+      splitBarrier.events.clear();
+      mergeBarriers(barrier, splitBarrier);
+      pass.mPreBarrier = std::move(barrier);
+    } else if (splitBarrier.enabled) {
+      for (auto event : splitBarrier.events) {
+        mCompiledPasses.at(event).mSignalStage |= splitBarrier.srcStage;
+      }
+
+      pass.mPreBarrier = std::move(splitBarrier);
+    }
+  }
+
+  // Source stages of split barriers must match
+  // the stages that signal their events
+  for (auto &pass : mCompiledPasses) {
+    if (pass.mPreBarrier.events.empty()) {
+      continue;
+    }
+
+    pass.mPreBarrier.srcStage = VK_PIPELINE_STAGE_NONE_KHR;
+    for (auto event : pass.mPreBarrier.events) {
+      pass.mPreBarrier.srcStage |= mCompiledPasses.at(event).mSignalStage;
+    }
+  }
+}
+
+void RenderGraph::aliasTransientTextures(ResourceRegistry &resourceRegistry) {
+  struct Lifetime {
+    TextureHandle texture = TextureHandle::Invalid;
+    TextureUsage usage = TextureUsage::None;
+    size_t size = 0;
+    size_t first = 0;
+    size_t last = 0;
+    bool read = false;
+  };
+
+  struct Slot {
+    TextureUsage usage = TextureUsage::None;
+    size_t size = 0;
+    std::vector<Lifetime> lifetimes;
+  };
+
+  auto &textures = resourceRegistry.getTextureMap();
+
+  std::vector<Lifetime> lifetimes;
+  std::unordered_map<TextureHandle, size_t> lifetimeIndices;
+  auto getLifetime = [&](TextureHandle texture, size_t index) -> Lifetime & {
+    auto it = lifetimeIndices.find(texture);
+    if (it == lifetimeIndices.end()) {
+      it = lifetimeIndices.insert({texture, lifetimes.size()}).first;
+      lifetimes.push_back({texture, TextureUsage::None, 0, index, index});
+    }
+
+    return lifetimes.at(it->second);
+  };
+
+  for (size_t i = 0; i < mCompiledPasses.size(); ++i) {
+    auto &pass = mCompiledPasses.at(i);
+    for (auto &output : pass.mOutputs) {
+      getLifetime(output.texture, i).last = i;
+    }
+
+    for (auto &input : pass.mInputs) {
+      auto &lifetime = getLifetime(input.texture, i);
+      lifetime.last = i;
+      lifetime.read = true;
+    }
+  }
+
+  for (auto &lifetime : lifetimes) {
+    if (!lifetime.read) {
+      lifetime.last = mCompiledPasses.size() - 1;
+    }
+
+    const auto &description = textures.getDescription(lifetime.texture);
+    lifetime.usage = description.usage;
+    lifetime.size = getTextureMemorySize(description, mFramebufferExtent);
+  }
+
+  // Largest attachments are placed first; so,
+  // smaller ones fill memory of larger ones
+  std::stable_sort(lifetimes.begin(), lifetimes.end(),
+                   [](const Lifetime &a, const Lifetime &b) {
+                     return a.size > b.size;
+                   });
+
+  std::vector<Slot> slots;
+  mTransientMemorySize = 0;
+
+  for (auto &lifetime : lifetimes) {
+    mTransientMemorySize += lifetime.size;
+
+    // Attachments with unknown size are never aliased.
+    // Memory types depend on usage of images; so,
+    // depth and color attachments are not mixed
+    auto it = slots.end();
+    if (lifetime.size > 0) {
+      auto isDisjoint = [&lifetime](const Lifetime &other) {
+        return lifetime.last < other.first || other.last < lifetime.first;
+      };
+
+      it = std::find_if(slots.begin(), slots.end(),
+                        [&lifetime, &isDisjoint](const Slot &slot) {
+                          return slot.usage == lifetime.usage &&
+                                 std::all_of(slot.lifetimes.begin(),
+                                             slot.lifetimes.end(), isDisjoint);
+                        });
+    }
+
+    if (it == slots.end()) {
+      it = slots.insert(slots.end(), Slot{lifetime.usage});
+    }
+
+    it->size = std::max(it->size, lifetime.size);
+    it->lifetimes.push_back(lifetime);
+  }
+
+  mAliasedTransientMemorySize = 0;
+  uint32_t aliasGroup = 0;
+  std::set<TextureHandle> recreatedTextures;
+  for (auto &slot : slots) {
+    mAliasedTransientMemorySize += slot.size;
+    uint32_t group = slot.lifetimes.size() > 1 ? ++aliasGroup : 0;
+
+    // Changing the group recreates the texture
+    for (auto &lifetime : slot.lifetimes) {
+      auto description = textures.getDescription(lifetime.texture);
+      if (description.aliasGroup != group) {
+        description.aliasGroup = group;
+        resourceRegistry.setTexture(description, lifetime.texture);
+        recreatedTextures.insert(lifetime.texture);
+      }
+    }
+  }
+
+  // Framebuffers of recreated textures are rebuilt
+  for (auto &pass : mCompiledPasses) {
+    for (auto &output : pass.mOutputs) {
+      if (recreatedTextures.find(output.texture) != recreatedTextures.end()) {
+        pass.mNeedsBuild = true;
+      }
+    }
+  }
+
+  LOG_DEBUG("Render graph transient memory: "
+            << mTransientMemorySize << " bytes; aliased: "
+            << mAliasedTransientMemorySize << " bytes");
 }
 
 void RenderGraph::setFramebufferExtent(glm::uvec2 framebufferExtent) {
@@ -9,50 +9,136 @@ RenderGraphEvaluator::RenderGraphEvaluator(ResourceRegistry &registry)
     : mRegistry(registry) {}
 
 void RenderGraphEvaluator::build(RenderGraph &graph) {
+  if (!graph.isDirty()) {
+    return;
+  }
+
   LIQUID_PROFILE_EVENT("RenderGraphEvaluator::build");
 
+  // Compilation marks the passes whose
+  // resources are new or recreated
   for (size_t index = 0; index < graph.getCompiledPasses().size(); ++index) {
     auto &pass = graph.getCompiledPasses().at(index);
-    buildPass(index, graph,
-              graph.isDirty() && hasSwapchainRelativeResources(pass));
+    if (pass.mNeedsBuild) {
+      buildPass(index, graph);
+      pass.mNeedsBuild = false;
+    }
   }
 
   graph.updateDirtyFlag();
 }
 
 void RenderGraphEvaluator::execute(RenderCommandList &commandList,
-                                   RenderGraph &graph) {
+                                   RenderGraph &graph, JobSystem &jobSystem) {
   LIQUID_PROFILE_EVENT("RenderGraphEvaluator::execute");
 
-  for (auto &pass : graph.getCompiledPasses()) {
-    if (pass.mPreBarrier.enabled) {
-      commandList.pipelineBarrier(
-          pass.mPreBarrier.srcStage, pass.mPreBarrier.dstStage,
-          pass.mPreBarrier.memoryBarriers, pass.mPreBarrier.imageBarriers);
+  auto &passes = graph.getCompiledPasses();
+  size_t maxRanges = static_cast<size_t>(jobSystem.getWorkerCount()) + 1;
+
+  // Secondary command lists are created on the
+  // thread that records the frame command list
+  mRanges.clear();
+  for (size_t index = 0; index < passes.size(); ++index) {
+    size_t itemCount = passes.at(index).getItemCount();
+    size_t numRanges = (itemCount + MIN_RANGE_SIZE - 1) / MIN_RANGE_SIZE;
+    numRanges = std::clamp(numRanges, size_t{1}, maxRanges);
+    size_t rangeSize = (itemCount + numRanges - 1) / numRanges;
+
+    for (size_t i = 0; i < numRanges; ++i) {
+      size_t begin = std::min(i * rangeSize, itemCount);
+      size_t end = std::min(begin + rangeSize, itemCount);
+      mRanges.push_back({index, begin, end,
+                         &commandList.getSecondaryCommandList(mRanges.size())});
     }
+  }
 
-    commandList.beginRenderPass(pass.mRenderPass, pass.getFramebuffer(), {0, 0},
-                                glm::uvec2(pass.getDimensions()));
-    commandList.setViewport({0.0f, 0.0f}, glm::uvec2(pass.getDimensions()),
-                            {0.0f, 1.0f});
-    commandList.setScissor({0.0f, 0.0f}, glm::uvec2(pass.getDimensions()));
-    pass.execute(commandList);
-    commandList.endRenderPass();
+  jobSystem.parallelFor(
+      mRanges.size(), 1, [this, &passes](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          const auto &range = mRanges.at(i);
+          recordRange(range, passes.at(range.pass));
+        }
+      });
+
+  auto it = mRanges.begin();
+  for (size_t index = 0; index < passes.size(); ++index) {
+    auto &pass = passes.at(index);
+
+    mPassCommandLists.clear();
+    for (; it != mRanges.end() && it->pass == index; ++it) {
+      mPassCommandLists.push_back(it->commandList);
+    }
+
+    const auto &preBarrier = pass.mPreBarrier;
+    if (preBarrier.enabled && preBarrier.events.empty()) {
+      commandList.pipelineBarrier(preBarrier.srcStage, preBarrier.dstStage,
+                                  preBarrier.memoryBarriers,
+                                  preBarrier.imageBarriers);
+    } else if (preBarrier.enabled) {
+      commandList.waitEvents(preBarrier.events, preBarrier.srcStage,
+                             preBarrier.dstStage, preBarrier.memoryBarriers,
+                             preBarrier.imageBarriers);
+    }
+
+    if (pass.isCompute()) {
+      commandList.executeCommandLists(mPassCommandLists);
+    } else {
+      commandList.beginRenderPass(
+          pass.mRenderPass, pass.getFramebuffer(), {0, 0},
+          glm::uvec2(pass.getDimensions()),
+          VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+      commandList.executeCommandLists(mPassCommandLists);
+      commandList.endRenderPass();
+    }
 
     if (pass.mPostBarrier.enabled) {
       commandList.pipelineBarrier(
           pass.mPostBarrier.srcStage, pass.mPostBarrier.dstStage,
           pass.mPostBarrier.memoryBarriers, pass.mPostBarrier.imageBarriers);
     }
+
+    if (pass.mSignalStage != VK_PIPELINE_STAGE_NONE_KHR) {
+      commandList.setEvent(index, pass.mSignalStage);
+    }
   }
+
+  // Events are unsignaled at the end of the graph;
+  // so, the command list can be recorded again
+  for (size_t index = 0; index < passes.size(); ++index) {
+    if (passes.at(index).mSignalStage != VK_PIPELINE_STAGE_NONE_KHR) {
+      commandList.resetEvent(index, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+    }
+  }
+}
+
+void RenderGraphEvaluator::recordRange(const PassRange &range,
+                                       RenderGraphPass &pass) {
+  LIQUID_PROFILE_EVENT("RenderGraphEvaluator::recordRange");
+  auto &commandList = *range.commandList;
+
+  if (pass.isCompute()) {
+    commandList.begin(RenderPassHandle::Invalid, FramebufferHandle::Invalid);
+    pass.execute(commandList, range.begin, range.end);
+    commandList.end();
+    return;
+  }
+
+  // Secondary command lists do not inherit
+  // dynamic state from the render pass
+  commandList.begin(pass.mRenderPass, pass.getFramebuffer());
+  commandList.setViewport({0.0f, 0.0f}, glm::uvec2(pass.getDimensions()),
+                          {0.0f, 1.0f});
+  commandList.setScissor({0, 0}, glm::uvec2(pass.getDimensions()));
+  pass.execute(commandList, range.begin, range.end);
+  commandList.end();
 }
 
-void RenderGraphEvaluator::buildPass(size_t index, RenderGraph &graph,
-                                     bool force) {
+void RenderGraphEvaluator::buildPass(size_t index, RenderGraph &graph) {
   LIQUID_PROFILE_EVENT("RenderGraphEvaluator::buildPass");
   auto &pass = graph.getCompiledPasses().at(index);
 
-  if (!force && isHandleValid(pass.mRenderPass)) {
+  // Compute pipelines do not depend on render passes
+  if (pass.isCompute()) {
     return;
   }
 
@@ -109,8 +195,14 @@ void RenderGraphEvaluator::buildPass(size_t index, RenderGraph &graph,
 
   LIQUID_ASSERT(isHandleValid(pass.mRenderPass), "Render pass is not created");
 
+  // Recreated render pass keeps attachment formats;
+  // so, existing pipelines stay compatible with it
   for (auto resource : pass.getPipelines()) {
     auto description = mRegistry.getPipelineMap().getDescription(resource);
+    if (description.renderPass == pass.mRenderPass) {
+      continue;
+    }
+
     description.renderPass = pass.mRenderPass;
     mRegistry.setPipeline(description, resource);
   }
@@ -148,18 +240,4 @@ RenderGraphEvaluator::createAttachment(const AttachmentData &attachment,
   return info;
 }
 
-bool RenderGraphEvaluator::hasSwapchainRelativeResources(
-    RenderGraphPass &pass) {
-  for (auto rt : pass.getOutputs()) {
-    auto handle = rt.texture;
-    if (handle == TextureHandle(1) ||
-        mRegistry.getTextureMap().getDescription(handle).sizeMethod ==
-            TextureSizeMethod::FramebufferRatio) {
-      return true;
-    }
-  }
-
-  return false;
-}
-
 } // namespace liquid::rhi
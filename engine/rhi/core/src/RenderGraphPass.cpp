@@ -15,16 +15,42 @@ void RenderGraphPass::read(TextureHandle handle) {
   mInputs.push_back({handle});
 }
 
+void RenderGraphPass::write(BufferHandle handle) {
+  mBufferOutputs.push_back(handle);
+}
+
+void RenderGraphPass::read(BufferHandle handle) {
+  mBufferInputs.push_back(handle);
+}
+
 void RenderGraphPass::setExecutor(const ExecutorFn &executor) {
+  mItemCount = nullptr;
+  mExecutor = [executor](RenderCommandList &commandList, size_t, size_t) {
+    executor(commandList);
+  };
+}
+
+void RenderGraphPass::setRangeExecutor(const ItemCountFn &itemCount,
+                                       const RangeExecutorFn &executor) {
+  mItemCount = itemCount;
   mExecutor = executor;
 }
 
+size_t RenderGraphPass::getItemCount() const {
+  return mItemCount ? mItemCount() : 1;
+}
+
 void RenderGraphPass::addPipeline(PipelineHandle handle) {
   mPipelines.push_back(handle);
 }
 
 void RenderGraphPass::execute(RenderCommandList &commandList) {
-  mExecutor(commandList);
+  execute(commandList, 0, getItemCount());
+}
+
+void RenderGraphPass::execute(RenderCommandList &commandList, size_t begin,
+                              size_t end) {
+  mExecutor(commandList, begin, end);
 }
 
 } // namespace liquid::rhi
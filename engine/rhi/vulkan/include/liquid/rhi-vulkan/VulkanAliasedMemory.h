@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+#include <vma/vk_mem_alloc.h>
+
+namespace liquid::rhi {
+
+/**
+ * @brief Vulkan aliased memory
+ *
+ * Device memory that is shared by textures
+ * of the same alias group. Memory is freed
+ * when the last texture that uses it is
+ * destroyed.
+ */
+class VulkanAliasedMemory {
+public:
+  /**
+   * @brief Allocate aliased memory
+   *
+   * @param requirements Memory requirements
+   * @param allocator Vma allocator
+   */
+  VulkanAliasedMemory(const VkMemoryRequirements &requirements,
+                      VmaAllocator allocator);
+
+  /**
+   * @brief Free aliased memory
+   */
+  ~VulkanAliasedMemory();
+
+  VulkanAliasedMemory(const VulkanAliasedMemory &) = delete;
+  VulkanAliasedMemory &operator=(const VulkanAliasedMemory &) = delete;
+  VulkanAliasedMemory(VulkanAliasedMemory &&) = delete;
+  VulkanAliasedMemory &operator=(VulkanAliasedMemory &&) = delete;
+
+  /**
+   * @brief Check if memory fits requirements
+   *
+   * @param requirements Memory requirements
+   * @retval true Resource can be bound to memory
+   * @retval false Resource cannot be bound to memory
+   */
+  bool isCompatible(const VkMemoryRequirements &requirements) const;
+
+  /**
+   * @brief Get Vma allocation
+   *
+   * @return Vma allocation
+   */
+  inline VmaAllocation getAllocation() const { return mAllocation; }
+
+private:
+  VmaAllocator mAllocator = VK_NULL_HANDLE;
+  VmaAllocation mAllocation = VK_NULL_HANDLE;
+  VmaAllocationInfo mAllocationInfo{};
+};
+
+} // namespace liquid::rhi
@@ -7,8 +7,22 @@
 
 namespace liquid::rhi {
 
+class VulkanUploadContext;
+
 /**
  * @brief Vulkan hardware buffer
+ *
+ * Static buffers are stored in device local
+ * memory and are written through the upload
+ * context.
+ *
+ * Memory of host visible buffers stays mapped for
+ * the lifetime of the buffer, so that updates are
+ * written directly without mapping memory every time.
+ *
+ * Dynamic buffers are split into a ring of regions,
+ * one for every frame in flight. Every frame that
+ * updates the buffer writes to the next region.
  */
 class VulkanBuffer {
 public:
@@ -17,9 +31,12 @@ public:
    *
    * @param description Buffer description
    * @param allocator Vulkan allocator
+   * @param uploadContext Upload context
+   * @param frameNumber Current frame number
    */
   VulkanBuffer(const BufferDescription &description,
-               VulkanResourceAllocator &allocator);
+               VulkanResourceAllocator &allocator,
+               VulkanUploadContext &uploadContext, uint64_t frameNumber = 0);
 
   /**
    * @brief Destroy buffer
@@ -34,9 +51,15 @@ public:
   /**
    * @brief Update buffer
    *
+   * Recreates buffer if size is changed and
+   * copies contents of the old buffer if the
+   * description keeps contents. Uploads only
+   * the data size from the description.
+   *
    * @param description Buffer description
+   * @param frameNumber Current frame number
    */
-  void update(const BufferDescription &description);
+  void update(const BufferDescription &description, uint64_t frameNumber);
 
   /**
    * @brief Get Vulkan buffer
@@ -66,26 +89,66 @@ public:
    */
   inline size_t getSize() const { return mSize; }
 
+  /**
+   * @brief Get offset of current region
+   *
+   * Always zero for non-dynamic buffers
+   *
+   * @return Offset of current region in bytes
+   */
+  inline size_t getOffset() const { return mCurrentRegion * mRegionSize; }
+
 private:
   /**
    * @brief Create buffer
    *
    * @param description Buffer description
+   * @param frameNumber Current frame number
    */
-  void createBuffer(const BufferDescription &description);
+  void createBuffer(const BufferDescription &description,
+                    uint64_t frameNumber);
 
   /**
    * @brief Destroy buffer
    */
   void destroyBuffer();
 
+  /**
+   * @brief Upload data
+   *
+   * Data of host visible buffers is written to
+   * mapped memory. Dynamic buffer moves to the
+   * next region on first upload in a frame.
+   *
+   * @param description Buffer description
+   * @param frameNumber Current frame number
+   */
+  void upload(const BufferDescription &description, uint64_t frameNumber);
+
+  /**
+   * @brief Write data to current region
+   *
+   * @param data Data
+   * @param offset Offset in region
+   * @param size Data size
+   */
+  void write(const void *data, size_t offset, size_t size);
+
 private:
   VulkanResourceAllocator &mAllocator;
+  VulkanUploadContext &mUploadContext;
 
   VkBuffer mBuffer = VK_NULL_HANDLE;
   VmaAllocation mAllocation = VK_NULL_HANDLE;
+  void *mMappedData = nullptr;
   rhi::BufferType mType;
   size_t mSize = 0;
+  bool mDynamic = false;
+
+  size_t mRegionSize = 0;
+  size_t mNumRegions = 1;
+  size_t mCurrentRegion = 0;
+  uint64_t mLastUploadFrame = 0;
 };
 
 } // namespace liquid::rhi
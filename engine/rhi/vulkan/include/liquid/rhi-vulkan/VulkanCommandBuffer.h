@@ -5,6 +5,7 @@
 
 #include "VulkanResourceRegistry.h"
 #include "VulkanDescriptorManager.h"
+#include "VulkanCommandPool.h"
 
 namespace liquid::rhi {
 
@@ -17,19 +18,20 @@ public:
    * @brief Create Vulkan command buffer
    *
    * @param commandBuffer Command buffer
+   * @param pool Command pool that allocated the buffer
    * @param registry Resource registry
    * @param descriptorManager Vulkan descriptor manager
    * @param stats Device stats
    */
-  VulkanCommandBuffer(VkCommandBuffer commandBuffer,
+  VulkanCommandBuffer(VkCommandBuffer commandBuffer, VulkanCommandPool &pool,
                       const VulkanResourceRegistry &registry,
                       VulkanDescriptorManager &descriptorManager,
                       DeviceStats &stats);
 
   /**
-   * @brief Destructor
+   * @brief Destroy events
    */
-  ~VulkanCommandBuffer() = default;
+  ~VulkanCommandBuffer();
 
   VulkanCommandBuffer(const VulkanCommandBuffer &) = delete;
   VulkanCommandBuffer &operator=(const VulkanCommandBuffer &) = delete;
@@ -45,6 +47,13 @@ public:
     return mCommandBuffer;
   }
 
+  /**
+   * @brief Get device stats
+   *
+   * @return Device stats
+   */
+  inline DeviceStats &getDeviceStats() { return mStats; }
+
   /**
    * @brief Begin render pass
    *
@@ -52,11 +61,13 @@ public:
    * @param framebuffer Framebuffer
    * @param renderAreaOffset Render area offset
    * @param renderAreaSize Render area size
+   * @param contents Render pass contents
    */
   void beginRenderPass(rhi::RenderPassHandle renderPass,
                        FramebufferHandle framebuffer,
                        const glm::ivec2 &renderAreaOffset,
-                       const glm::uvec2 &renderAreaSize) override;
+                       const glm::uvec2 &renderAreaSize,
+                       VkSubpassContents contents) override;
 
   /**
    * @brief End render pass
@@ -131,6 +142,38 @@ public:
                    int32_t vertexOffset, uint32_t instanceCount,
                    uint32_t firstInstance) override;
 
+  /**
+   * @brief Draw with parameters from buffer
+   *
+   * @param buffer Buffer with draw commands
+   * @param offset Offset of first command
+   * @param drawCount Number of draws
+   * @param stride Stride between commands
+   */
+  void drawIndirect(BufferHandle buffer, size_t offset, uint32_t drawCount,
+                    uint32_t stride) override;
+
+  /**
+   * @brief Draw indexed with parameters from buffer
+   *
+   * @param buffer Buffer with draw commands
+   * @param offset Offset of first command
+   * @param drawCount Number of draws
+   * @param stride Stride between commands
+   */
+  void drawIndexedIndirect(BufferHandle buffer, size_t offset,
+                           uint32_t drawCount, uint32_t stride) override;
+
+  /**
+   * @brief Dispatch compute work
+   *
+   * @param groupCountX Number of workgroups in X dimension
+   * @param groupCountY Number of workgroups in Y dimension
+   * @param groupCountZ Number of workgroups in Z dimension
+   */
+  void dispatch(uint32_t groupCountX, uint32_t groupCountY,
+                uint32_t groupCountZ) override;
+
   /**
    * @brief Set viewport
    *
@@ -162,8 +205,113 @@ public:
                        const std::vector<MemoryBarrier> &memoryBarriers,
                        const std::vector<ImageBarrier> &imageBarriers) override;
 
+  /**
+   * @brief Signal event
+   *
+   * Creates event if it does not exist
+   *
+   * @param event Event index
+   * @param stage Pipeline stage that signals the event
+   */
+  void setEvent(size_t event, VkPipelineStageFlags stage) override;
+
+  /**
+   * @brief Unsignal event
+   *
+   * @param event Event index
+   * @param stage Pipeline stage that unsignals the event
+   */
+  void resetEvent(size_t event, VkPipelineStageFlags stage) override;
+
+  /**
+   * @brief Wait for events
+   *
+   * @param events Event indices
+   * @param srcStage Source pipeline stage
+   * @param dstStage Destination pipeline stage
+   * @param memoryBarriers Memory barriers
+   * @param imageBarriers Image barriers
+   */
+  void waitEvents(const std::vector<size_t> &events,
+                  VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage,
+                  const std::vector<MemoryBarrier> &memoryBarriers,
+                  const std::vector<ImageBarrier> &imageBarriers) override;
+
+  /**
+   * @brief Get secondary command list
+   *
+   * Creates command pool for the list
+   * if it does not exist
+   *
+   * @param index Secondary command list index
+   * @return Secondary command list
+   */
+  RenderCommandList &getSecondaryCommandList(size_t index) override;
+
+  /**
+   * @brief Begin recording secondary command list
+   *
+   * @param renderPass Render pass that commands are executed in
+   * @param framebuffer Framebuffer that commands are executed in
+   */
+  void begin(RenderPassHandle renderPass,
+             FramebufferHandle framebuffer) override;
+
+  /**
+   * @brief End recording secondary command list
+   */
+  void end() override;
+
+  /**
+   * @brief Execute secondary command lists
+   *
+   * Adds stats of secondary command
+   * lists to device stats
+   *
+   * @param commandLists Secondary command lists
+   */
+  void executeCommandLists(
+      const std::vector<RenderCommandList *> &commandLists) override;
+
+private:
+  /**
+   * @brief Secondary command list
+   */
+  struct SecondaryCommandList {
+    /**
+     * Stats of command list
+     */
+    DeviceStats stats;
+
+    /**
+     * Command pool of command list
+     */
+    std::unique_ptr<VulkanCommandPool> pool;
+
+    /**
+     * Command list
+     */
+    RenderCommandList commandList;
+  };
+
+  /**
+   * @brief Convert barriers to Vulkan barriers
+   *
+   * @param memoryBarriers Memory barriers
+   * @param imageBarriers Image barriers
+   */
+  void convertBarriers(const std::vector<MemoryBarrier> &memoryBarriers,
+                       const std::vector<ImageBarrier> &imageBarriers);
+
 private:
   VkCommandBuffer mCommandBuffer = VK_NULL_HANDLE;
+  VulkanCommandPool &mPool;
+  std::vector<std::unique_ptr<SecondaryCommandList>> mSecondaryCommandLists;
+  std::vector<VkCommandBuffer> mExecutedCommandBuffers;
+  std::vector<VkEvent> mEvents;
+  std::vector<VkEvent> mWaitedEvents;
+  std::vector<VkMemoryBarrier> mMemoryBarriers;
+  std::vector<VkImageMemoryBarrier> mImageBarriers;
 
   const VulkanResourceRegistry &mRegistry;
   DeviceStats &mStats;
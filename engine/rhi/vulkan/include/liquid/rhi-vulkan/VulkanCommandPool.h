@@ -41,12 +41,36 @@ public:
    * @brief Create command buffers
    *
    * @param count Number of buffers
+   * @param level Command buffer level
    * @return List of render command lists
    */
-  std::vector<RenderCommandList> createCommandLists(uint32_t count);
+  std::vector<RenderCommandList>
+  createCommandLists(uint32_t count, VkCommandBufferLevel level =
+                                         VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+
+  /**
+   * @brief Create pool for secondary command lists
+   *
+   * Command pools cannot be used from multiple
+   * threads at the same time; so, every command
+   * list that is recorded in parallel is allocated
+   * from its own pool with the same queue family
+   *
+   * @param stats Device stats of secondary command lists
+   * @return Command pool
+   */
+  std::unique_ptr<VulkanCommandPool> createSecondaryPool(DeviceStats &stats);
+
+  /**
+   * @brief Get device
+   *
+   * @return Vulkan device
+   */
+  inline VulkanDeviceObject &getDevice() { return mDevice; }
 
 private:
   VkCommandPool mCommandPool = VK_NULL_HANDLE;
+  uint32_t mQueueFamilyIndex = 0;
   VulkanDeviceObject &mDevice;
   VulkanDescriptorManager &mDescriptorManager;
   DeviceStats &mStats;
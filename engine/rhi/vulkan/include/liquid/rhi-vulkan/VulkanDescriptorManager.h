@@ -4,6 +4,7 @@
 
 #include "VulkanResourceRegistry.h"
 #include "VulkanDeviceObject.h"
+#include "VulkanFrameManager.h"
 
 #include <vulkan/vulkan.hpp>
 
@@ -14,8 +15,24 @@ namespace liquid::rhi {
  *
  * Automatically creates and retrieves
  * descriptors based on hash
+ *
+ * Descriptor sets are stored in an open
+ * addressing hash table that is keyed on
+ * descriptor hash and layout. Bindings are
+ * compared when hashes match. Sets are evicted
+ * when a buffer or texture that they reference
+ * is recreated or deleted. Evicted sets are freed
+ * after frames that can use them are finished.
+ *
+ * Every region of a dynamic buffer gets its
+ * own set instead of a dynamic offset.
  */
 class VulkanDescriptorManager {
+  /**
+   * Initial capacity of descriptor set cache
+   */
+  static constexpr size_t INITIAL_CAPACITY = 1024;
+
 public:
   /**
    * @brief Create Vulkan descriptor manager
@@ -40,7 +57,8 @@ public:
    * @brief Get Vulkan descriptor set
    *
    * Gets descriptor set from cache or creates
-   * descriptors and returns it
+   * descriptors and returns it. Safe to call
+   * from multiple recording threads.
    *
    * @param descriptor Descriptor
    * @param layout Vulkan descriptor layout
@@ -49,6 +67,103 @@ public:
   VkDescriptorSet getOrCreateDescriptor(const Descriptor &descriptor,
                                         VkDescriptorSetLayout layout);
 
+  /**
+   * @brief Evict descriptor sets that use buffer
+   *
+   * @param handle Buffer handle
+   * @param frameIndex Index of next frame
+   */
+  void evict(BufferHandle handle, uint32_t frameIndex);
+
+  /**
+   * @brief Evict descriptor sets that use texture
+   *
+   * @param handle Texture handle
+   * @param frameIndex Index of next frame
+   */
+  void evict(TextureHandle handle, uint32_t frameIndex);
+
+  /**
+   * @brief Free evicted descriptor sets
+   *
+   * Must be called after waiting for the
+   * frame; frees sets that were evicted before
+   * the oldest frame that can still be in flight
+   *
+   * @param frameIndex Index of current frame
+   */
+  void freeEvictedDescriptorSets(uint32_t frameIndex);
+
+  /**
+   * @brief Destroy all descriptor sets
+   *
+   * Device must be idle
+   */
+  void clear();
+
+private:
+  /**
+   * @brief Descriptor set cache key
+   */
+  struct CacheKey {
+    /**
+     * Descriptor hash
+     */
+    uint64_t hash = 0;
+
+    /**
+     * Descriptor layout
+     */
+    VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+  };
+
+  enum class CacheEntryState { Empty, Used, Deleted };
+
+  /**
+   * @brief Descriptor set cache entry
+   */
+  struct CacheEntry {
+    /**
+     * Entry state
+     */
+    CacheEntryState state = CacheEntryState::Empty;
+
+    /**
+     * Cache key
+     */
+    CacheKey key;
+
+    /**
+     * Descriptor
+     */
+    Descriptor descriptor;
+
+    /**
+     * Offsets of buffer regions
+     */
+    std::vector<size_t> bufferOffsets;
+
+    /**
+     * Descriptor set
+     */
+    VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+  };
+
+  /**
+   * @brief Descriptor set that uses a resource
+   */
+  struct CachedSet {
+    /**
+     * Cache key
+     */
+    CacheKey key;
+
+    /**
+     * Descriptor set
+     */
+    VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+  };
+
 private:
   /**
    * @brief Create descriptor set
@@ -74,16 +189,92 @@ private:
   void createDescriptorPool();
 
   /**
-   * @brief Create hash from descriptor and layout
+   * @brief Get offsets of buffer regions
    *
    * @param descriptor Descriptor
-   * @param layout Descriptor layout
+   * @return Region offset of every buffer binding
+   */
+  std::vector<size_t> getBufferOffsets(const Descriptor &descriptor) const;
+
+  /**
+   * @brief Create hash from descriptor
+   *
+   * @param descriptor Descriptor
+   * @param bufferOffsets Offsets of buffer regions
    * @return Hash code
    */
-  String createHash(const Descriptor &descriptor, VkDescriptorSetLayout layout);
+  uint64_t createHash(const Descriptor &descriptor,
+                      const std::vector<size_t> &bufferOffsets) const;
+
+  /**
+   * @brief Find cache entry of descriptor
+   *
+   * @param key Cache key
+   * @param descriptor Descriptor
+   * @param bufferOffsets Offsets of buffer regions
+   * @return Entry index or capacity if not found
+   */
+  size_t findEntry(const CacheKey &key, const Descriptor &descriptor,
+                   const std::vector<size_t> &bufferOffsets) const;
+
+  /**
+   * @brief Find cache entry of descriptor set
+   *
+   * @param set Cached descriptor set
+   * @return Entry index or capacity if not found
+   */
+  size_t findEntry(const CachedSet &set) const;
+
+  /**
+   * @brief Insert cache entry
+   *
+   * @param entry Cache entry
+   */
+  void insertEntry(CacheEntry &&entry);
+
+  /**
+   * @brief Rebuild cache
+   *
+   * Removes deleted entries and grows
+   * cache if it is too full
+   */
+  void rehash();
+
+  /**
+   * @brief Evict cache entries
+   *
+   * @param sets Cached descriptor sets
+   * @param frameIndex Index of next frame
+   */
+  void evictEntries(const std::vector<CachedSet> &sets, uint32_t frameIndex);
+
+  /**
+   * @brief Add descriptor set to sets of a resource
+   *
+   * @param sets Cached descriptor sets of resource
+   * @param set Cached descriptor set
+   */
+  void addResourceSet(std::vector<CachedSet> &sets, const CachedSet &set);
+
+  /**
+   * @brief Get start index of key in cache
+   *
+   * @param key Cache key
+   * @return Start index
+   */
+  size_t getStartIndex(const CacheKey &key) const;
 
 private:
-  std::unordered_map<String, VkDescriptorSet> mDescriptorCache;
+  std::vector<CacheEntry> mEntries;
+  size_t mNumUsedEntries = 0;
+  size_t mNumDeletedEntries = 0;
+
+  std::unordered_map<BufferHandle, std::vector<CachedSet>> mBufferDescriptors;
+  std::unordered_map<TextureHandle, std::vector<CachedSet>> mTextureDescriptors;
+  std::array<std::vector<VkDescriptorSet>, VulkanFrameManager::NUM_FRAMES>
+      mEvictedDescriptorSets;
+  std::mutex mMutex;
+
   VkDescriptorPool mDescriptorPool = VK_NULL_HANDLE;
   VkDevice mDevice;
 
@@ -68,6 +68,16 @@ public:
    */
   inline uint32_t getCurrentFrameIndex() const { return mFrameIndex; }
 
+  /**
+   * @brief Get frame number
+   *
+   * Frame number is increased every frame
+   * and never wraps around
+   *
+   * @return Frame number
+   */
+  inline uint64_t getFrameNumber() const { return mFrameNumber; }
+
   /**
    * @brief Go to next frame
    */
@@ -97,6 +107,7 @@ private:
   std::array<VkSemaphore, NUM_FRAMES> mRenderFinishedSemaphores{};
 
   uint32_t mFrameIndex = 0;
+  uint64_t mFrameNumber = 0;
 };
 
 } // namespace liquid::rhi
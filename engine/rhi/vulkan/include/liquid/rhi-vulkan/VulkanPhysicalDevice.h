@@ -55,6 +55,15 @@ public:
    */
   inline const String &getName() const { return mName; }
 
+  /**
+   * @brief Get device properties
+   *
+   * @return Device properties
+   */
+  inline const VkPhysicalDeviceProperties &getProperties() const {
+    return mProperties;
+  }
+
   /**
    * @brief Get device features
    *
@@ -114,6 +123,15 @@ public:
    */
   const PhysicalDeviceInformation getDeviceInfo() const;
 
+  /**
+   * @brief Check if texture format is supported
+   *
+   * @param format Texture format
+   * @retval true Format can be sampled with optimal tiling
+   * @retval false Format cannot be sampled with optimal tiling
+   */
+  bool isTextureFormatSupported(VkFormat format) const;
+
   /**
    * @brief Gets Vulkan physical device handle
    *
@@ -20,10 +20,12 @@ public:
    * @param description Pipeline description
    * @param device Vulkan device
    * @param registry Resource registry
+   * @param pipelineCache Vulkan pipeline cache
    */
   VulkanPipeline(const PipelineDescription &description,
                  VulkanDeviceObject &device,
-                 const VulkanResourceRegistry &registry);
+                 const VulkanResourceRegistry &registry,
+                 VkPipelineCache pipelineCache);
 
   /**
    * @brief Destructor
@@ -66,14 +68,13 @@ public:
    *
    * @return Pipeline bind point
    */
-  inline VkPipelineBindPoint getBindPoint() const {
-    return VK_PIPELINE_BIND_POINT_GRAPHICS;
-  }
+  inline VkPipelineBindPoint getBindPoint() const { return mBindPoint; }
 
 private:
   VulkanDeviceObject &mDevice;
   VkPipeline mPipeline = VK_NULL_HANDLE;
   VkPipelineLayout mPipelineLayout = VK_NULL_HANDLE;
+  VkPipelineBindPoint mBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
 
   std::unordered_map<uint32_t, VkDescriptorSetLayout> mDescriptorLayouts;
 };
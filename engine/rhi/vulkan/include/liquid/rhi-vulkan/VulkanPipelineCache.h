@@ -0,0 +1,172 @@
+#pragma once
+
+#include "liquid/rhi/PipelineDescription.h"
+
+#include "VulkanDeviceObject.h"
+#include "VulkanPhysicalDevice.h"
+#include "VulkanResourceRegistry.h"
+
+namespace liquid::rhi {
+
+class VulkanPipeline;
+
+/**
+ * @brief Vulkan pipeline cache
+ *
+ * Owns Vulkan pipeline cache that is loaded
+ * from a file on creation and written back
+ * to the file when new pipelines are created
+ * and on destruction. Cache file is ignored
+ * if it was created by a different device
+ * or driver.
+ *
+ * Pipelines are stored by description hash
+ * and compared by description; so, pipelines
+ * with equal descriptions are created only once.
+ */
+class VulkanPipelineCache {
+  /**
+   * @brief Pipeline cache file header
+   */
+  struct Header {
+    /**
+     * Magic number
+     */
+    uint32_t magic = 0;
+
+    /**
+     * Cache data size
+     */
+    uint32_t dataSize = 0;
+
+    /**
+     * Vendor ID
+     */
+    uint32_t vendorID = 0;
+
+    /**
+     * Device ID
+     */
+    uint32_t deviceID = 0;
+
+    /**
+     * Driver version
+     */
+    uint32_t driverVersion = 0;
+
+    /**
+     * Pipeline cache UUID
+     */
+    std::array<uint8_t, VK_UUID_SIZE> uuid{};
+  };
+
+  /**
+   * Magic number of cache files
+   */
+  static constexpr uint32_t MAGIC = 0x4C515043;
+
+  /**
+   * @brief Stored pipeline
+   */
+  struct StoredPipeline {
+    /**
+     * Pipeline description
+     */
+    PipelineDescription description;
+
+    /**
+     * Pipeline
+     */
+    std::weak_ptr<VulkanPipeline> pipeline;
+  };
+
+public:
+  /**
+   * @brief Create pipeline cache
+   *
+   * @param device Vulkan device
+   * @param physicalDevice Physical device
+   * @param path Cache file path; cache is
+   *             not persisted if path is empty
+   */
+  VulkanPipelineCache(VulkanDeviceObject &device,
+                      const VulkanPhysicalDevice &physicalDevice,
+                      const Path &path);
+
+  /**
+   * @brief Destroy pipeline cache
+   *
+   * Writes cache to file before destroying it
+   */
+  ~VulkanPipelineCache();
+
+  VulkanPipelineCache(const VulkanPipelineCache &) = delete;
+  VulkanPipelineCache(VulkanPipelineCache &&) = delete;
+  VulkanPipelineCache &operator=(const VulkanPipelineCache &) = delete;
+  VulkanPipelineCache &operator=(VulkanPipelineCache &&) = delete;
+
+  /**
+   * @brief Get or create pipeline
+   *
+   * Returns existing pipeline if a pipeline
+   * with the same description is in use
+   *
+   * @param description Pipeline description
+   * @param registry Resource registry
+   * @return Vulkan pipeline
+   */
+  std::shared_ptr<VulkanPipeline>
+  getOrCreatePipeline(const PipelineDescription &description,
+                      const VulkanResourceRegistry &registry);
+
+  /**
+   * @brief Clear stored pipelines
+   *
+   * Pipelines that are in use are not destroyed
+   * but new pipelines are not shared with them.
+   * Must be called when shaders or render passes
+   * are replaced.
+   */
+  void clearPipelines();
+
+  /**
+   * @brief Write cache to file
+   *
+   * Cache is written only if pipelines
+   * are created since the last write
+   */
+  void save();
+
+  /**
+   * @brief Get Vulkan pipeline cache
+   *
+   * @return Vulkan pipeline cache
+   */
+  inline VkPipelineCache getPipelineCache() const { return mPipelineCache; }
+
+private:
+  /**
+   * @brief Create header for the device
+   *
+   * @return Cache file header
+   */
+  Header createHeader() const;
+
+  /**
+   * @brief Read cache data from file
+   *
+   * @return Cache data or empty data if file is invalid
+   */
+  std::vector<char> readCacheData() const;
+
+private:
+  VkPipelineCache mPipelineCache = VK_NULL_HANDLE;
+  std::unordered_map<uint64_t, std::vector<StoredPipeline>> mPipelines;
+  bool mChanged = false;
+
+  Path mPath;
+  VkPhysicalDeviceProperties mProperties{};
+  VulkanDeviceObject &mDevice;
+};
+
+} // namespace liquid::rhi
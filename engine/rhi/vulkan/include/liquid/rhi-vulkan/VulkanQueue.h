@@ -10,19 +10,37 @@ namespace liquid::rhi {
 struct VulkanSubmitInfo {
   /**
    * Pipeline stage flags to wait for
+   *
+   * One per wait semaphore
    */
-  VkPipelineStageFlags waitStages;
+  std::vector<VkPipelineStageFlags> waitStages;
 
   /**
    * Semaphores to wait for
    */
   std::vector<VkSemaphore> waitSemaphores;
 
+  /**
+   * Timeline values to wait for
+   *
+   * Empty or one per wait semaphore.
+   * Ignored for binary semaphores.
+   */
+  std::vector<uint64_t> waitValues;
+
   /**
    * Semaphores to signal
    */
   std::vector<VkSemaphore> signalSemaphores;
 
+  /**
+   * Timeline values to signal
+   *
+   * Empty or one per signal semaphore.
+   * Ignored for binary semaphores.
+   */
+  std::vector<uint64_t> signalValues;
+
   /**
    * Fence to signal
    */
@@ -39,6 +39,19 @@ public:
            mTransferFamily.has_value();
   }
 
+  /**
+   * @brief Check if transfer family is dedicated
+   *
+   * Dedicated transfer family does not
+   * support graphics or compute
+   *
+   * @retval true Transfer family is dedicated
+   * @retval false Transfer family is graphics family
+   */
+  inline bool hasDedicatedTransferFamily() const {
+    return getTransferFamily() != getGraphicsFamily();
+  }
+
   /**
    * @brief Returns queue families in array
    *
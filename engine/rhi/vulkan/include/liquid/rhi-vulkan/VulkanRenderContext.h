@@ -9,6 +9,7 @@
 #include "VulkanDeviceObject.h"
 #include "VulkanQueue.h"
 #include "VulkanFrameManager.h"
+#include "VulkanUploadContext.h"
 
 #include "liquid/rhi/RenderCommandList.h"
 
@@ -57,11 +58,15 @@ public:
   /**
    * @brief End rendering
    *
-   * Ends command buffer and submits it to the graphics queue
+   * Ends command buffer and submits it to the graphics queue.
+   * Submission waits for all uploads that are submitted
+   * before it on the device.
    *
    * @param frameManager Frame manager
+   * @param uploadContext Upload context
    */
-  void endRendering(VulkanFrameManager &frameManager);
+  void endRendering(VulkanFrameManager &frameManager,
+                    const VulkanUploadContext &uploadContext);
 
 private:
   std::vector<RenderCommandList> mRenderCommandLists;
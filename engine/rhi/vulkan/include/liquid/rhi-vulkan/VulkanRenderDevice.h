@@ -14,6 +14,7 @@
 #include "VulkanResourceRegistry.h"
 #include "VulkanCommandPool.h"
 #include "VulkanDescriptorManager.h"
+#include "VulkanPipelineCache.h"
 #include "VulkanSwapchain.h"
 
 namespace liquid::rhi {
@@ -22,6 +23,11 @@ namespace liquid::rhi {
  * @brief Vulkan render device
  */
 class VulkanRenderDevice : public RenderDevice {
+  /**
+   * Pipeline cache file in user data directory
+   */
+  static constexpr const char *PIPELINE_CACHE_FILE = "pipeline-cache.bin";
+
 public:
   /**
    * @brief Create Vulkan render device
@@ -81,6 +87,18 @@ public:
    */
   const DeviceStats &getDeviceStats() const override { return mStats; }
 
+  /**
+   * @brief Check if texture format is supported
+   *
+   * @param format Texture format
+   * @retval true Format can be sampled
+   * @retval false Format cannot be sampled
+   */
+  bool isTextureFormatSupported(uint32_t format) const override {
+    return mPhysicalDevice.isTextureFormatSupported(
+        static_cast<VkFormat>(format));
+  }
+
   /**
    * @brief Synchronize resources
    *
@@ -99,6 +117,19 @@ private:
    */
   void updateFramebufferRelativeTextures();
 
+  /**
+   * @brief Allocate memory of alias groups
+   *
+   * Each group is allocated once for the
+   * largest requirements of its textures
+   *
+   * @param descriptions Descriptions of created textures
+   * @return Memory of groups that must be kept
+   *         alive until textures are created
+   */
+  std::vector<std::shared_ptr<VulkanAliasedMemory>>
+  allocateAliasedMemory(const std::vector<TextureDescription> &descriptions);
+
 private:
   DeviceStats mStats;
 
@@ -107,9 +138,11 @@ private:
   VulkanDeviceObject mDevice;
   VulkanQueue mPresentQueue;
   VulkanQueue mGraphicsQueue;
+  VulkanQueue mTransferQueue;
 
   VulkanFrameManager mFrameManager;
   VulkanResourceAllocator mAllocator;
+  VulkanPipelineCache mPipelineCache;
   VulkanResourceRegistry mRegistry;
   VulkanDescriptorManager mDescriptorManager;
   VulkanCommandPool mCommandPool;
@@ -3,6 +3,7 @@
 #include "VulkanPhysicalDevice.h"
 #include "VulkanRenderBackend.h"
 #include "VulkanDeviceObject.h"
+#include "VulkanAliasedMemory.h"
 
 #include <vma/vk_mem_alloc.h>
 
@@ -43,8 +44,39 @@ public:
    */
   inline operator VmaAllocator() { return mAllocator; }
 
+  /**
+   * @brief Allocate memory of alias group
+   *
+   * Allocates new memory for the group if
+   * current memory of the group does not fit
+   * the combined requirements of its members.
+   * Textures that are bound to previous memory
+   * keep it alive.
+   *
+   * @param aliasGroup Alias group
+   * @param requirements Combined memory requirements
+   * @return Aliased memory
+   */
+  std::shared_ptr<VulkanAliasedMemory>
+  allocateAliasedMemory(uint32_t aliasGroup,
+                        const VkMemoryRequirements &requirements);
+
+  /**
+   * @brief Get memory of alias group
+   *
+   * @param aliasGroup Alias group
+   * @param requirements Memory requirements
+   * @return Aliased memory or null if memory
+   *         of the group does not fit requirements
+   */
+  std::shared_ptr<VulkanAliasedMemory>
+  getAliasedMemory(uint32_t aliasGroup,
+                   const VkMemoryRequirements &requirements);
+
 private:
   VmaAllocator mAllocator = VK_NULL_HANDLE;
+  std::unordered_map<uint32_t, std::weak_ptr<VulkanAliasedMemory>>
+      mAliasedMemory;
 };
 
 } // namespace liquid::rhi
@@ -29,7 +29,10 @@ class VulkanResourceRegistry {
       VulkanResourceMap<rhi::RenderPassHandle, VulkanRenderPass>;
   using FramebufferMap =
       VulkanResourceMap<FramebufferHandle, VulkanFramebuffer>;
-  using PipelineMap = VulkanResourceMap<PipelineHandle, VulkanPipeline>;
+
+  // Pipelines with equal descriptions are shared
+  using PipelineMap =
+      std::unordered_map<PipelineHandle, std::shared_ptr<VulkanPipeline>>;
 
 public:
   /**
@@ -181,7 +184,7 @@ public:
    * @param pipeline Vulkan pipeline
    */
   void setPipeline(PipelineHandle handle,
-                   std::unique_ptr<VulkanPipeline> &&pipeline);
+                   const std::shared_ptr<VulkanPipeline> &pipeline);
 
   /**
    * @brief Delete pipeline
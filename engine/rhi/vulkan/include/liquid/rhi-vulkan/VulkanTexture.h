@@ -33,6 +33,11 @@ public:
   /**
    * @brief Create Vulkan texture
    *
+   * Textures with alias group are bound to
+   * memory that is shared by the group. Texture
+   * gets its own memory if memory of the group
+   * does not fit it.
+   *
    * @param description Texture description
    * @param allocator Vma allocator
    * @param device Vulkan device
@@ -54,6 +59,25 @@ public:
   VulkanTexture(VulkanTexture &&) = delete;
   VulkanTexture &operator=(VulkanTexture &&) = delete;
 
+  /**
+   * @brief Get memory requirements of texture
+   *
+   * Requirements are queried from a
+   * temporary image with the same
+   * parameters as the texture
+   *
+   * @param description Texture description
+   * @param device Vulkan device
+   * @param uploadContext Upload context
+   * @param swapchainExtent Swapchain extent
+   * @return Memory requirements
+   */
+  static VkMemoryRequirements
+  getMemoryRequirements(const TextureDescription &description,
+                        VulkanDeviceObject &device,
+                        VulkanUploadContext &uploadContext,
+                        const glm::uvec2 &swapchainExtent);
+
   /**
    * @brief Get Vulkan image
    *
@@ -121,6 +145,7 @@ private:
   VkImageView mImageView = VK_NULL_HANDLE;
   VkSampler mSampler = VK_NULL_HANDLE;
   VmaAllocation mAllocation = VK_NULL_HANDLE;
+  std::shared_ptr<VulkanAliasedMemory> mAliasedMemory;
   VkImageAspectFlags mAspectFlags = VK_IMAGE_ASPECT_FLAG_BITS_MAX_ENUM;
   VulkanResourceAllocator &mAllocator;
   VulkanDeviceObject &mDevice;
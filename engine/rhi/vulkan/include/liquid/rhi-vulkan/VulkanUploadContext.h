@@ -2,29 +2,74 @@
 
 #include "VulkanDeviceObject.h"
 #include "VulkanQueue.h"
-#include "VulkanCommandPool.h"
+#include "VulkanBuffer.h"
 
 namespace liquid::rhi {
 
 /**
  * @brief Vulkan upload context
+ *
+ * Records uploads to device local resources
+ * into a single command buffer that is
+ * submitted to the transfer queue in one batch.
+ * Every batch signals a timeline semaphore value
+ * that frames wait for on the device; so, the
+ * host never waits for uploads to finish.
+ *
+ * Data is copied to a staging ring buffer.
+ * Host only waits for a batch if the ring
+ * buffer region of that batch is needed
+ * for new data.
  */
 class VulkanUploadContext {
-  using SubmitFn = std::function<void(VkCommandBuffer)>;
+  using RecordFn = std::function<void(VkCommandBuffer)>;
+
+  /**
+   * Initial size of staging buffer
+   */
+  static constexpr size_t DEFAULT_STAGING_SIZE = 16 * 1024 * 1024;
+
+  /**
+   * Alignment of staging regions
+   *
+   * Satisfies buffer to image copy offsets
+   * of all texel and block sizes up to 16 bytes
+   */
+  static constexpr size_t STAGING_ALIGNMENT = 16;
+
+public:
+  /**
+   * @brief Staging region
+   */
+  struct StagingRegion {
+    /**
+     * Staging buffer
+     */
+    VkBuffer buffer = VK_NULL_HANDLE;
+
+    /**
+     * Offset of data in staging buffer
+     */
+    size_t offset = 0;
+  };
 
 public:
   /**
    * @brief Create upload context
    *
    * @param device Vulkan device
-   * @param pool Command pool
-   * @param queue Vulkan queue
+   * @param queue Transfer queue
+   * @param allocator Vulkan allocator
+   * @param queueFamilies Queue families that use uploaded resources
    */
-  VulkanUploadContext(VulkanDeviceObject &device, VulkanCommandPool &pool,
-                      VulkanQueue &queue);
+  VulkanUploadContext(VulkanDeviceObject &device, VulkanQueue &queue,
+                      VulkanResourceAllocator &allocator,
+                      const std::vector<uint32_t> &queueFamilies);
 
   /**
    * @brief Destroy upload context
+   *
+   * Waits for all submitted uploads
    */
   ~VulkanUploadContext();
 
@@ -34,23 +79,176 @@ public:
   VulkanUploadContext &operator=(VulkanUploadContext &&) = delete;
 
   /**
-   * @brief Submit for upload
+   * @brief Record upload commands
+   *
+   * Commands are executed when
+   * the batch is flushed
+   *
+   * @param recordFn Record function
+   */
+  void record(const RecordFn &recordFn);
+
+  /**
+   * @brief Copy data to staging buffer
+   *
+   * Staged data must be used by commands
+   * that are recorded in the current batch
+   *
+   * @param data Data
+   * @param size Data size
+   * @return Staging region
+   */
+  StagingRegion stage(const void *data, size_t size);
+
+  /**
+   * @brief Upload data to device local buffer
+   *
+   * @param buffer Destination buffer
+   * @param offset Offset in destination buffer
+   * @param data Data
+   * @param size Data size
+   */
+  void uploadBuffer(VkBuffer buffer, size_t offset, const void *data,
+                    size_t size);
+
+  /**
+   * @brief Copy device local buffer
+   *
+   * Copy waits for uploads that are
+   * recorded before it in the batch
+   *
+   * @param srcBuffer Source buffer
+   * @param dstBuffer Destination buffer
+   * @param size Size of copied data
+   */
+  void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, size_t size);
+
+  /**
+   * @brief Submit recorded uploads
+   *
+   * Does nothing if there are no recorded uploads
+   */
+  void flush();
+
+  /**
+   * @brief Wait for all submitted uploads
+   *
+   * Flushes recorded uploads before waiting
+   */
+  void waitForIdle();
+
+  /**
+   * @brief Get timeline semaphore
+   *
+   * @return Timeline semaphore
+   */
+  inline VkSemaphore getSemaphore() const { return mSemaphore; }
+
+  /**
+   * @brief Get value of last submitted batch
+   *
+   * @return Timeline semaphore value
+   */
+  inline uint64_t getSubmittedValue() const { return mSubmittedValue; }
+
+  /**
+   * @brief Get queue families that use uploaded resources
+   *
+   * Resources that are written by uploads are shared
+   * between these families. Empty if uploads are
+   * submitted to the graphics queue.
+   *
+   * @return Queue family indices
+   */
+  inline const std::vector<uint32_t> &getQueueFamilies() const {
+    return mQueueFamilies;
+  }
+
+private:
+  /**
+   * @brief Get value of last completed batch
+   *
+   * @return Timeline semaphore value
+   */
+  uint64_t getCompletedValue() const;
+
+  /**
+   * @brief Wait for batch
+   *
+   * @param value Timeline semaphore value of batch
+   */
+  void wait(uint64_t value) const;
+
+  /**
+   * @brief Begin recording batch
    *
-   * @param submitFn Submit function
+   * Reuses command buffer of a completed batch
+   *
+   * @return Command buffer of current batch
    */
-  void submit(const SubmitFn &submitFn) const;
+  VkCommandBuffer beginBatch();
+
+  /**
+   * @brief Allocate staging region
+   *
+   * Waits for batches that use the region
+   *
+   * @param size Region size
+   * @return Offset of region
+   */
+  size_t allocateStagingRegion(size_t size);
 
 private:
   /**
-   * @brief Create upload fence
+   * @brief Upload batch
+   */
+  struct Batch {
+    /**
+     * Command buffer
+     */
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+
+    /**
+     * Timeline semaphore value of last submission
+     */
+    uint64_t value = 0;
+  };
+
+  /**
+   * @brief Staging range in use
    */
-  void createFence();
+  struct StagingRange {
+    /**
+     * Start offset
+     */
+    size_t start = 0;
+
+    /**
+     * End offset
+     */
+    size_t end = 0;
+
+    /**
+     * Timeline semaphore value of batch
+     */
+    uint64_t value = 0;
+  };
 
 private:
-  VkFence mUploadFence = VK_NULL_HANDLE;
-  RenderCommandList mCommandList;
+  VkCommandPool mCommandPool = VK_NULL_HANDLE;
+  VkSemaphore mSemaphore = VK_NULL_HANDLE;
+  std::vector<Batch> mBatches;
+  size_t mCurrentBatch = std::numeric_limits<size_t>::max();
+  uint64_t mSubmittedValue = 0;
+
+  std::unique_ptr<VulkanBuffer> mStagingBuffer;
+  std::deque<StagingRange> mStagingRanges;
+  size_t mStagingHead = 0;
+
+  std::vector<uint32_t> mQueueFamilies;
   VulkanQueue &mQueue;
   VulkanDeviceObject &mDevice;
+  VulkanResourceAllocator &mAllocator;
 };
 
 } // namespace liquid::rhi
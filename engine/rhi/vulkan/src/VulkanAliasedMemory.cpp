@@ -0,0 +1,35 @@
+#include "liquid/core/Base.h"
+
+#include "VulkanAliasedMemory.h"
+#include "VulkanError.h"
+
+namespace liquid::rhi {
+
+VulkanAliasedMemory::VulkanAliasedMemory(
+    const VkMemoryRequirements &requirements, VmaAllocator allocator)
+    : mAllocator(allocator) {
+  VmaAllocationCreateInfo allocationCreateInfo{};
+  allocationCreateInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+  checkForVulkanError(vmaAllocateMemory(mAllocator, &requirements,
+                                        &allocationCreateInfo, &mAllocation,
+                                        &mAllocationInfo),
+                      "Failed to allocate aliased memory");
+}
+
+VulkanAliasedMemory::~VulkanAliasedMemory() {
+  if (mAllocation) {
+    vmaFreeMemory(mAllocator, mAllocation);
+  }
+}
+
+bool VulkanAliasedMemory::isCompatible(
+    const VkMemoryRequirements &requirements) const {
+  uint32_t memoryTypeBit = 1u << mAllocationInfo.memoryType;
+
+  return requirements.size <= mAllocationInfo.size &&
+         mAllocationInfo.offset % requirements.alignment == 0 &&
+         (requirements.memoryTypeBits & memoryTypeBit) != 0;
+}
+
+} // namespace liquid::rhi
@@ -2,37 +2,82 @@
 
 #include "VulkanBuffer.h"
 #include "VulkanError.h"
+#include "VulkanFrameManager.h"
+#include "VulkanUploadContext.h"
 
 namespace liquid::rhi {
 
+/**
+ * @brief Alignment of dynamic buffer regions
+ *
+ * Largest offset alignment that Vulkan allows
+ * for uniform and storage buffers
+ */
+static constexpr size_t DYNAMIC_REGION_ALIGNMENT = 256;
+
 VulkanBuffer::VulkanBuffer(const BufferDescription &description,
-                           VulkanResourceAllocator &allocator)
-    : mAllocator(allocator), mType(description.type), mSize(description.size) {
-  createBuffer(description);
+                           VulkanResourceAllocator &allocator,
+                           VulkanUploadContext &uploadContext,
+                           uint64_t frameNumber)
+    : mAllocator(allocator), mUploadContext(uploadContext),
+      mType(description.type), mSize(description.size) {
+  createBuffer(description, frameNumber);
+  upload(description, frameNumber);
 }
 
 VulkanBuffer::~VulkanBuffer() { destroyBuffer(); }
 
-void VulkanBuffer::update(const BufferDescription &description) {
+void VulkanBuffer::update(const BufferDescription &description,
+                          uint64_t frameNumber) {
   LIQUID_ASSERT(mType == description.type,
                 "Cannot change the type of the buffer");
 
-  if (mSize != description.size) {
-    destroyBuffer();
-    createBuffer(description);
-  } else if (description.data) {
-    void *data = nullptr;
-    vmaMapMemory(mAllocator, mAllocation, &data);
-    memcpy(data, description.data, description.size);
-    vmaUnmapMemory(mAllocator, mAllocation);
+  if (mSize != description.size || mDynamic != description.dynamic) {
+    VkBuffer oldBuffer = mBuffer;
+    VmaAllocation oldAllocation = mAllocation;
+    size_t oldSize = mSize;
+
+    // Only device local buffers are copied on the device
+    bool keepContents = description.keepContents && !mMappedData &&
+                        isDeviceLocalBuffer(description);
+
+    createBuffer(description, frameNumber);
+
+    if (keepContents) {
+      mUploadContext.copyBuffer(oldBuffer, mBuffer, std::min(oldSize, mSize));
+
+      // Old buffer can only be destroyed
+      // after its contents are copied
+      mUploadContext.waitForIdle();
+    }
+
+    vmaDestroyBuffer(mAllocator, oldBuffer, oldAllocation);
   }
+
+  upload(description, frameNumber);
 }
 
-void VulkanBuffer::createBuffer(const BufferDescription &description) {
+void VulkanBuffer::createBuffer(const BufferDescription &description,
+                                uint64_t frameNumber) {
   mSize = description.size;
   mType = description.type;
+  mDynamic = description.dynamic;
+
+  if (mDynamic) {
+    mNumRegions = VulkanFrameManager::NUM_FRAMES;
+    mRegionSize = (mSize + DYNAMIC_REGION_ALIGNMENT - 1) /
+                  DYNAMIC_REGION_ALIGNMENT * DYNAMIC_REGION_ALIGNMENT;
+  } else {
+    mNumRegions = 1;
+    mRegionSize = mSize;
+  }
+  mCurrentRegion = 0;
+  mLastUploadFrame = frameNumber;
+
+  bool deviceLocal = isDeviceLocalBuffer(description);
 
-  VmaMemoryUsage memoryUsage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+  VmaMemoryUsage memoryUsage =
+      deviceLocal ? VMA_MEMORY_USAGE_GPU_ONLY : VMA_MEMORY_USAGE_CPU_TO_GPU;
   VkBufferUsageFlags bufferUsage = VK_BUFFER_USAGE_FLAG_BITS_MAX_ENUM;
   if (description.type == rhi::BufferType::Vertex) {
     bufferUsage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
@@ -45,34 +90,97 @@ void VulkanBuffer::createBuffer(const BufferDescription &description) {
   } else if (description.type == rhi::BufferType::Transfer) {
     bufferUsage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
     memoryUsage = VMA_MEMORY_USAGE_CPU_ONLY;
+  } else if (description.type == rhi::BufferType::Indirect) {
+    // Indirect commands are written by compute shaders
+    bufferUsage = VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                  VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+  }
+
+  // Device local memory is written by transfers
+  // and is copied to a new buffer when it grows
+  if (deviceLocal) {
+    bufferUsage |=
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
   }
 
   VkBufferCreateInfo createBufferInfo{};
   createBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
   createBufferInfo.pNext = nullptr;
   createBufferInfo.flags = 0;
-  createBufferInfo.size = description.size;
+  createBufferInfo.size = mRegionSize * mNumRegions;
   createBufferInfo.usage = bufferUsage;
 
+  // Uploads can be written by a dedicated
+  // transfer queue and read by graphics queue
+  const auto &queueFamilies = mUploadContext.getQueueFamilies();
+  if (deviceLocal && !queueFamilies.empty()) {
+    createBufferInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+    createBufferInfo.queueFamilyIndexCount =
+        static_cast<uint32_t>(queueFamilies.size());
+    createBufferInfo.pQueueFamilyIndices = queueFamilies.data();
+  }
+
   VmaAllocationCreateInfo createAllocationInfo{};
-  createAllocationInfo.flags = 0;
+  createAllocationInfo.flags =
+      deviceLocal ? 0 : VMA_ALLOCATION_CREATE_MAPPED_BIT;
   createAllocationInfo.usage = memoryUsage;
 
+  VmaAllocationInfo allocationInfo{};
   checkForVulkanError(vmaCreateBuffer(mAllocator, &createBufferInfo,
                                       &createAllocationInfo, &mBuffer,
-                                      &mAllocation, nullptr),
+                                      &mAllocation, &allocationInfo),
                       "Cannot create buffer");
-
-  if (description.data) {
-    void *data = nullptr;
-    vmaMapMemory(mAllocator, mAllocation, &data);
-    memcpy(data, description.data, description.size);
-    vmaUnmapMemory(mAllocator, mAllocation);
-  }
+  mMappedData = allocationInfo.pMappedData;
 }
 
 void VulkanBuffer::destroyBuffer() {
   vmaDestroyBuffer(mAllocator, mBuffer, mAllocation);
+  mMappedData = nullptr;
+}
+
+void VulkanBuffer::upload(const BufferDescription &description,
+                          uint64_t frameNumber) {
+  LIQUID_ASSERT(description.dataOffset + description.dataSize <=
+                    description.size,
+                "Uploaded data cannot exceed buffer size");
+
+  if (!description.data) {
+    return;
+  }
+
+  // Region of the previous frame can still
+  // be read by the GPU; so, write to the next one
+  if (mMappedData && frameNumber != mLastUploadFrame) {
+    mCurrentRegion = (mCurrentRegion + 1) % mNumRegions;
+    mLastUploadFrame = frameNumber;
+  }
+
+  if (description.uploadRanges.empty()) {
+    size_t size = description.dataSize > 0 ? description.dataSize
+                                           : mSize - description.dataOffset;
+    write(description.data, description.dataOffset, size);
+    return;
+  }
+
+  const auto *data = static_cast<const uint8_t *>(description.data);
+  for (const auto &range : description.uploadRanges) {
+    LIQUID_ASSERT(range.bufferOffset + range.size <= description.size,
+                  "Uploaded data cannot exceed buffer size");
+    write(data + range.dataOffset, range.bufferOffset, range.size);
+  }
+}
+
+void VulkanBuffer::write(const void *data, size_t offset, size_t size) {
+  if (!mMappedData) {
+    mUploadContext.uploadBuffer(mBuffer, offset, data, size);
+    return;
+  }
+
+  size_t regionOffset = getOffset() + offset;
+  memcpy(static_cast<uint8_t *>(mMappedData) + regionOffset, data, size);
+
+  // Does nothing if memory is host coherent
+  vmaFlushAllocation(mAllocator, mAllocation, regionOffset, size);
 }
 
 } // namespace liquid::rhi
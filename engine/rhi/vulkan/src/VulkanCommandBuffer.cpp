@@ -6,19 +6,30 @@
 #include "VulkanRenderPass.h"
 #include "VulkanFramebuffer.h"
 #include "VulkanPipeline.h"
+#include "VulkanError.h"
 
 namespace liquid::rhi {
 
 VulkanCommandBuffer::VulkanCommandBuffer(
-    VkCommandBuffer commandBuffer, const VulkanResourceRegistry &registry,
+    VkCommandBuffer commandBuffer, VulkanCommandPool &pool,
+    const VulkanResourceRegistry &registry,
     VulkanDescriptorManager &descriptorManager, DeviceStats &stats)
-    : mCommandBuffer(commandBuffer), mRegistry(registry),
+    : mCommandBuffer(commandBuffer), mPool(pool), mRegistry(registry),
       mDescriptorManager(descriptorManager), mStats(stats) {}
 
+VulkanCommandBuffer::~VulkanCommandBuffer() {
+  for (auto event : mEvents) {
+    if (event != VK_NULL_HANDLE) {
+      vkDestroyEvent(mPool.getDevice(), event, nullptr);
+    }
+  }
+}
+
 void VulkanCommandBuffer::beginRenderPass(rhi::RenderPassHandle renderPass,
                                           FramebufferHandle framebuffer,
                                           const glm::ivec2 &renderAreaOffset,
-                                          const glm::uvec2 &renderAreaSize) {
+                                          const glm::uvec2 &renderAreaSize,
+                                          VkSubpassContents contents) {
 
   const auto &vulkanRenderPass = mRegistry.getRenderPasses().at(renderPass);
 
@@ -34,7 +45,7 @@ void VulkanCommandBuffer::beginRenderPass(rhi::RenderPassHandle renderPass,
       static_cast<uint32_t>(vulkanRenderPass->getClearValues().size());
   beginInfo.pClearValues = vulkanRenderPass->getClearValues().data();
 
-  vkCmdBeginRenderPass(mCommandBuffer, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
+  vkCmdBeginRenderPass(mCommandBuffer, &beginInfo, contents);
   mStats.addCommandCall();
 }
 
@@ -66,7 +77,7 @@ void VulkanCommandBuffer::bindDescriptor(PipelineHandle pipeline,
 
 void VulkanCommandBuffer::bindVertexBuffer(BufferHandle buffer) {
   const auto &vulkanBuffer = mRegistry.getBuffers().at(buffer);
-  std::array<VkDeviceSize, 1> offsets{0};
+  std::array<VkDeviceSize, 1> offsets{vulkanBuffer->getOffset()};
   std::array<VkBuffer, 1> buffers{vulkanBuffer->getBuffer()};
 
   vkCmdBindVertexBuffers(mCommandBuffer, 0, 1, buffers.data(), offsets.data());
@@ -77,7 +88,8 @@ void VulkanCommandBuffer::bindIndexBuffer(BufferHandle buffer,
                                           VkIndexType indexType) {
   const auto &vulkanBuffer = mRegistry.getBuffers().at(buffer);
 
-  vkCmdBindIndexBuffer(mCommandBuffer, vulkanBuffer->getBuffer(), 0, indexType);
+  vkCmdBindIndexBuffer(mCommandBuffer, vulkanBuffer->getBuffer(),
+                       vulkanBuffer->getOffset(), indexType);
   mStats.addCommandCall();
 }
 
@@ -96,7 +108,7 @@ void VulkanCommandBuffer::draw(uint32_t vertexCount, uint32_t firstVertex,
                                uint32_t instanceCount, uint32_t firstInstance) {
   vkCmdDraw(mCommandBuffer, vertexCount, instanceCount, firstVertex,
             firstInstance);
-  mStats.addDrawCall(vertexCount / 3);
+  mStats.addDrawCall(vertexCount / 3, instanceCount);
 }
 
 void VulkanCommandBuffer::drawIndexed(uint32_t indexCount, uint32_t firstIndex,
@@ -105,7 +117,37 @@ void VulkanCommandBuffer::drawIndexed(uint32_t indexCount, uint32_t firstIndex,
                                       uint32_t firstInstance) {
   vkCmdDrawIndexed(mCommandBuffer, indexCount, instanceCount, firstIndex,
                    vertexOffset, firstInstance);
-  mStats.addDrawCall(indexCount / 3);
+  mStats.addDrawCall(indexCount / 3, instanceCount);
+}
+
+void VulkanCommandBuffer::drawIndirect(BufferHandle buffer, size_t offset,
+                                       uint32_t drawCount, uint32_t stride) {
+  const auto &vulkanBuffer = mRegistry.getBuffers().at(buffer);
+
+  vkCmdDrawIndirect(mCommandBuffer, vulkanBuffer->getBuffer(),
+                    vulkanBuffer->getOffset() + offset, drawCount, stride);
+
+  // Number of primitives is only known to the device
+  mStats.addDrawCall(0);
+}
+
+void VulkanCommandBuffer::drawIndexedIndirect(BufferHandle buffer,
+                                              size_t offset, uint32_t drawCount,
+                                              uint32_t stride) {
+  const auto &vulkanBuffer = mRegistry.getBuffers().at(buffer);
+
+  vkCmdDrawIndexedIndirect(mCommandBuffer, vulkanBuffer->getBuffer(),
+                           vulkanBuffer->getOffset() + offset, drawCount,
+                           stride);
+
+  // Number of primitives is only known to the device
+  mStats.addDrawCall(0);
+}
+
+void VulkanCommandBuffer::dispatch(uint32_t groupCountX, uint32_t groupCountY,
+                                   uint32_t groupCountZ) {
+  vkCmdDispatch(mCommandBuffer, groupCountX, groupCountY, groupCountZ);
+  mStats.addCommandCall();
 }
 
 void VulkanCommandBuffer::setViewport(const glm::vec2 &offset,
@@ -130,26 +172,89 @@ void VulkanCommandBuffer::pipelineBarrier(
     VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage,
     const std::vector<MemoryBarrier> &memoryBarriers,
     const std::vector<ImageBarrier> &imageBarriers) {
+  convertBarriers(memoryBarriers, imageBarriers);
 
-  std::vector<VkMemoryBarrier> vkMemoryBarriers(memoryBarriers.size());
+  vkCmdPipelineBarrier(
+      mCommandBuffer, srcStage, dstStage, VK_DEPENDENCY_BY_REGION_BIT,
+      static_cast<uint32_t>(mMemoryBarriers.size()), mMemoryBarriers.data(),
+      0, nullptr, static_cast<uint32_t>(mImageBarriers.size()),
+      mImageBarriers.data());
+}
+
+void VulkanCommandBuffer::setEvent(size_t event, VkPipelineStageFlags stage) {
+  if (mEvents.size() <= event) {
+    mEvents.resize(event + 1, VK_NULL_HANDLE);
+  }
+
+  if (mEvents.at(event) == VK_NULL_HANDLE) {
+    VkEventCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.flags = 0;
+
+    checkForVulkanError(vkCreateEvent(mPool.getDevice(), &createInfo, nullptr,
+                                      &mEvents.at(event)),
+                        "Failed to create event");
+  }
+
+  vkCmdSetEvent(mCommandBuffer, mEvents.at(event), stage);
+}
+
+void VulkanCommandBuffer::resetEvent(size_t event,
+                                     VkPipelineStageFlags stage) {
+  LIQUID_ASSERT(event < mEvents.size() && mEvents.at(event) != VK_NULL_HANDLE,
+                "Event does not exist");
+
+  vkCmdResetEvent(mCommandBuffer, mEvents.at(event), stage);
+}
+
+void VulkanCommandBuffer::waitEvents(
+    const std::vector<size_t> &events, VkPipelineStageFlags srcStage,
+    VkPipelineStageFlags dstStage,
+    const std::vector<MemoryBarrier> &memoryBarriers,
+    const std::vector<ImageBarrier> &imageBarriers) {
+  convertBarriers(memoryBarriers, imageBarriers);
+
+  mWaitedEvents.clear();
+  for (auto event : events) {
+    LIQUID_ASSERT(event < mEvents.size() &&
+                      mEvents.at(event) != VK_NULL_HANDLE,
+                  "Event is not signaled");
+    mWaitedEvents.push_back(mEvents.at(event));
+  }
+
+  vkCmdWaitEvents(
+      mCommandBuffer, static_cast<uint32_t>(mWaitedEvents.size()),
+      mWaitedEvents.data(), srcStage, dstStage,
+      static_cast<uint32_t>(mMemoryBarriers.size()), mMemoryBarriers.data(),
+      0, nullptr, static_cast<uint32_t>(mImageBarriers.size()),
+      mImageBarriers.data());
+}
+
+void VulkanCommandBuffer::convertBarriers(
+    const std::vector<MemoryBarrier> &memoryBarriers,
+    const std::vector<ImageBarrier> &imageBarriers) {
+  mMemoryBarriers.resize(memoryBarriers.size());
   for (size_t i = 0; i < memoryBarriers.size(); ++i) {
     auto &barrier = memoryBarriers.at(i);
-    auto &vkBarrier = vkMemoryBarriers.at(i);
+    auto &vkBarrier = mMemoryBarriers.at(i);
     vkBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
     vkBarrier.pNext = nullptr;
     vkBarrier.srcAccessMask = barrier.srcAccess;
     vkBarrier.dstAccessMask = barrier.dstAccess;
   }
 
-  std::vector<VkImageMemoryBarrier> vkImageMemoryBarriers(imageBarriers.size());
+  mImageBarriers.resize(imageBarriers.size());
   for (size_t i = 0; i < imageBarriers.size(); ++i) {
     auto &barrier = imageBarriers.at(i);
     const auto &texture = mRegistry.getTextures().at(barrier.texture);
-    auto &vkBarrier = vkImageMemoryBarriers.at(i);
+    auto &vkBarrier = mImageBarriers.at(i);
     vkBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     vkBarrier.pNext = nullptr;
     vkBarrier.srcAccessMask = barrier.srcAccess;
     vkBarrier.dstAccessMask = barrier.dstAccess;
+    vkBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    vkBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
     vkBarrier.oldLayout = barrier.srcLayout;
     vkBarrier.newLayout = barrier.dstLayout;
     vkBarrier.image = texture->getImage();
@@ -159,12 +264,76 @@ void VulkanCommandBuffer::pipelineBarrier(
     vkBarrier.subresourceRange.levelCount = 1;
     vkBarrier.subresourceRange.aspectMask = texture->getImageAspectFlags();
   }
+}
 
-  vkCmdPipelineBarrier(
-      mCommandBuffer, srcStage, dstStage, VK_DEPENDENCY_BY_REGION_BIT,
-      static_cast<uint32_t>(vkMemoryBarriers.size()), vkMemoryBarriers.data(),
-      0, nullptr, static_cast<uint32_t>(vkImageMemoryBarriers.size()),
-      vkImageMemoryBarriers.data());
+RenderCommandList &VulkanCommandBuffer::getSecondaryCommandList(size_t index) {
+  while (mSecondaryCommandLists.size() <= index) {
+    auto secondary = std::make_unique<SecondaryCommandList>();
+    secondary->pool = mPool.createSecondaryPool(secondary->stats);
+    auto commandLists = secondary->pool->createCommandLists(
+        1, VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+    secondary->commandList = std::move(commandLists.at(0));
+    mSecondaryCommandLists.push_back(std::move(secondary));
+  }
+
+  return mSecondaryCommandLists.at(index)->commandList;
+}
+
+void VulkanCommandBuffer::begin(RenderPassHandle renderPass,
+                                FramebufferHandle framebuffer) {
+  VkCommandBufferInheritanceInfo inheritanceInfo{};
+  inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+  inheritanceInfo.pNext = nullptr;
+  inheritanceInfo.subpass = 0;
+
+  VkCommandBufferBeginInfo beginInfo{};
+  beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+  beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+  beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+  if (isHandleValid(renderPass)) {
+    inheritanceInfo.renderPass =
+        mRegistry.getRenderPasses().at(renderPass)->getRenderPass();
+    inheritanceInfo.framebuffer =
+        mRegistry.getFramebuffers().at(framebuffer)->getFramebuffer();
+    beginInfo.flags |= VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+  }
+
+  // Command pool of every secondary command buffer is
+  // created with reset flag; so, beginning the buffer
+  // resets commands of the previous recording
+  checkForVulkanError(vkBeginCommandBuffer(mCommandBuffer, &beginInfo),
+                      "Failed to begin recording secondary command buffer");
+}
+
+void VulkanCommandBuffer::end() {
+  checkForVulkanError(vkEndCommandBuffer(mCommandBuffer),
+                      "Failed to end recording secondary command buffer");
+}
+
+void VulkanCommandBuffer::executeCommandLists(
+    const std::vector<RenderCommandList *> &commandLists) {
+  if (commandLists.empty()) {
+    return;
+  }
+
+  mExecutedCommandBuffers.clear();
+  for (auto *commandList : commandLists) {
+    auto *secondary = dynamic_cast<VulkanCommandBuffer *>(
+        commandList->getNativeRenderCommandList().get());
+
+    mExecutedCommandBuffers.push_back(secondary->getVulkanCommandBuffer());
+
+    // Lists are recorded before they are executed;
+    // so, their stats are not written anymore
+    mStats.addCalls(secondary->getDeviceStats());
+    secondary->getDeviceStats().resetCalls();
+  }
+
+  vkCmdExecuteCommands(mCommandBuffer,
+                       static_cast<uint32_t>(mExecutedCommandBuffers.size()),
+                       mExecutedCommandBuffers.data());
+  mStats.addCommandCall();
 }
 
 } // namespace liquid::rhi
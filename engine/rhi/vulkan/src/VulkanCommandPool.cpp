@@ -12,8 +12,9 @@ VulkanCommandPool::VulkanCommandPool(VulkanDeviceObject &device,
                                      const VulkanResourceRegistry &registry,
                                      VulkanDescriptorManager &descriptorManager,
                                      DeviceStats &stats)
-    : mDevice(device), mRegistry(registry),
-      mDescriptorManager(descriptorManager), mStats(stats) {
+    : mQueueFamilyIndex(queueFamilyIndex), mDevice(device),
+      mRegistry(registry), mDescriptorManager(descriptorManager),
+      mStats(stats) {
   VkCommandPoolCreateInfo poolInfo{};
   poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
   poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
@@ -34,14 +35,15 @@ VulkanCommandPool::~VulkanCommandPool() {
 }
 
 std::vector<RenderCommandList>
-VulkanCommandPool::createCommandLists(uint32_t count) {
+VulkanCommandPool::createCommandLists(uint32_t count,
+                                      VkCommandBufferLevel level) {
   std::vector<VkCommandBuffer> commandBuffers(count);
   std::vector<RenderCommandList> renderCommandLists(count);
 
   VkCommandBufferAllocateInfo allocInfo{};
   allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
   allocInfo.commandPool = mCommandPool;
-  allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+  allocInfo.level = level;
   allocInfo.commandBufferCount = count;
 
   checkForVulkanError(
@@ -52,7 +54,8 @@ VulkanCommandPool::createCommandLists(uint32_t count) {
 
     renderCommandLists.at(i) =
         std::move(RenderCommandList(new VulkanCommandBuffer(
-            commandBuffers.at(i), mRegistry, mDescriptorManager, mStats)));
+            commandBuffers.at(i), *this, mRegistry, mDescriptorManager,
+            mStats)));
   }
 
   LOG_DEBUG("[Vulkan] Command buffers allocated");
@@ -60,4 +63,10 @@ VulkanCommandPool::createCommandLists(uint32_t count) {
   return std::move(renderCommandLists);
 }
 
+std::unique_ptr<VulkanCommandPool>
+VulkanCommandPool::createSecondaryPool(DeviceStats &stats) {
+  return std::make_unique<VulkanCommandPool>(
+      mDevice, mQueueFamilyIndex, mRegistry, mDescriptorManager, stats);
+}
+
 } // namespace liquid::rhi
@@ -9,12 +9,13 @@
 #include "VulkanError.h"
 
 #include "liquid/core/EngineGlobals.h"
+#include "liquid/core/Hash.h"
 
 namespace liquid::rhi {
 
 VulkanDescriptorManager::VulkanDescriptorManager(
     VulkanDeviceObject &device, const VulkanResourceRegistry &registry)
-    : mDevice(device), mRegistry(registry) {
+    : mEntries(INITIAL_CAPACITY), mDevice(device), mRegistry(registry) {
   createDescriptorPool();
 }
 
@@ -27,15 +28,89 @@ VulkanDescriptorManager::~VulkanDescriptorManager() {
 VkDescriptorSet
 VulkanDescriptorManager::getOrCreateDescriptor(const Descriptor &descriptor,
                                                VkDescriptorSetLayout layout) {
-  const String &hash = createHash(descriptor, layout);
-  const auto &found = mDescriptorCache.find(hash);
+  auto bufferOffsets = getBufferOffsets(descriptor);
+  CacheKey key{createHash(descriptor, bufferOffsets), layout};
 
-  if (found == mDescriptorCache.end()) {
-    VkDescriptorSet set = createDescriptorSet(descriptor, layout);
-    mDescriptorCache.insert({hash, set});
-    return set;
+  // Cache and pool are shared by all command lists
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  size_t index = findEntry(key, descriptor, bufferOffsets);
+  if (index < mEntries.size()) {
+    return mEntries.at(index).descriptorSet;
+  }
+
+  VkDescriptorSet set = createDescriptorSet(descriptor, layout);
+
+  CacheEntry entry{};
+  entry.key = key;
+  entry.descriptor = descriptor;
+  entry.bufferOffsets = std::move(bufferOffsets);
+  entry.descriptorSet = set;
+  insertEntry(std::move(entry));
+
+  CachedSet cachedSet{key, set};
+  for (const auto &binding : descriptor.getBindings()) {
+    if (binding.second.type == DescriptorType::UniformBuffer ||
+        binding.second.type == DescriptorType::StorageBuffer) {
+      addResourceSet(
+          mBufferDescriptors[std::get<BufferHandle>(binding.second.data)],
+          cachedSet);
+    } else {
+      for (auto texture :
+           std::get<std::vector<TextureHandle>>(binding.second.data)) {
+        addResourceSet(mTextureDescriptors[texture], cachedSet);
+      }
+    }
+  }
+
+  return set;
+}
+
+void VulkanDescriptorManager::evict(BufferHandle handle, uint32_t frameIndex) {
+  auto it = mBufferDescriptors.find(handle);
+  if (it != mBufferDescriptors.end()) {
+    evictEntries(it->second, frameIndex);
+    mBufferDescriptors.erase(it);
+  }
+}
+
+void VulkanDescriptorManager::evict(TextureHandle handle,
+                                    uint32_t frameIndex) {
+  auto it = mTextureDescriptors.find(handle);
+  if (it != mTextureDescriptors.end()) {
+    evictEntries(it->second, frameIndex);
+    mTextureDescriptors.erase(it);
+  }
+}
+
+void VulkanDescriptorManager::freeEvictedDescriptorSets(uint32_t frameIndex) {
+  // Sets that are evicted before frame N can be used
+  // by frames until N - 1; frame N - 1 is finished
+  // when frame N + NUM_FRAMES - 1 starts
+  auto &sets = mEvictedDescriptorSets.at((frameIndex + 1) %
+                                         VulkanFrameManager::NUM_FRAMES);
+  if (sets.empty()) {
+    return;
+  }
+
+  vkFreeDescriptorSets(mDevice, mDescriptorPool,
+                       static_cast<uint32_t>(sets.size()), sets.data());
+  LOG_DEBUG("[Vulkan] " << sets.size() << " descriptor sets freed");
+  sets.clear();
+}
+
+void VulkanDescriptorManager::clear() {
+  vkResetDescriptorPool(mDevice, mDescriptorPool, 0);
+
+  std::fill(mEntries.begin(), mEntries.end(), CacheEntry{});
+  mNumUsedEntries = 0;
+  mNumDeletedEntries = 0;
+  mBufferDescriptors.clear();
+  mTextureDescriptors.clear();
+
+  for (auto &sets : mEvictedDescriptorSets) {
+    sets.clear();
   }
-  return (*found).second;
 }
 
 VkDescriptorSet
@@ -67,7 +142,8 @@ VulkanDescriptorManager::createDescriptorSet(const Descriptor &descriptor,
         binding.second.type == DescriptorType::StorageBuffer) {
       const auto &vkBuffer = mRegistry.getBuffers().at(
           std::get<BufferHandle>(binding.second.data));
-      bufferInfos.push_back(VkDescriptorBufferInfo{vkBuffer->getBuffer(), 0,
+      bufferInfos.push_back(VkDescriptorBufferInfo{vkBuffer->getBuffer(),
+                                                   vkBuffer->getOffset(),
                                                    vkBuffer->getSize()});
 
       const auto &bufferObj = bufferInfos.at(bufferInfos.size() - 1);
@@ -127,7 +203,7 @@ VulkanDescriptorManager::allocateDescriptorSet(VkDescriptorSetLayout layout) {
 
 void VulkanDescriptorManager::createDescriptorPool() {
   constexpr uint32_t NUM_UNIFORM_BUFFERS = 15000;
-  constexpr uint32_t NUM_STORAGE_BUFFERS = 10;
+  constexpr uint32_t NUM_STORAGE_BUFFERS = 1000;
   constexpr uint32_t NUM_SAMPLERS = 1000;
   constexpr uint32_t NUM_DESCRIPTORS = 30000;
   constexpr uint32_t MAX_TEXTURE_DESCRIPTORS = 8;
@@ -143,7 +219,7 @@ void VulkanDescriptorManager::createDescriptorPool() {
   VkDescriptorPoolCreateInfo descriptorPoolInfo{};
   descriptorPoolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
   descriptorPoolInfo.pNext = nullptr;
-  descriptorPoolInfo.flags = 0;
+  descriptorPoolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
   descriptorPoolInfo.maxSets = NUM_DESCRIPTORS;
   descriptorPoolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
   descriptorPoolInfo.pPoolSizes = poolSizes.data();
@@ -155,11 +231,165 @@ void VulkanDescriptorManager::createDescriptorPool() {
   LOG_DEBUG("[Vulkan] Descriptor pool created");
 }
 
-String VulkanDescriptorManager::createHash(const Descriptor &descriptor,
-                                           VkDescriptorSetLayout layout) {
-  std::stringstream ss;
-  ss << descriptor.getHashCode() << layout;
-  return ss.str();
+std::vector<size_t>
+VulkanDescriptorManager::getBufferOffsets(const Descriptor &descriptor) const {
+  std::vector<size_t> offsets;
+
+  // Dynamic buffers change their region every
+  // frame; so, every region is a new set.
+  //
+  // Dynamic offsets are not used because set
+  // layouts come from shader reflection, which only
+  // reports plain buffer types. Making every buffer
+  // binding dynamic instead would hit the small
+  // device limits on dynamic buffers per layout.
+  // There is one region per frame in flight; so,
+  // a descriptor has at most NUM_FRAMES sets and
+  // binding a set costs the same as an offset.
+  for (const auto &binding : descriptor.getBindings()) {
+    if (binding.second.type == DescriptorType::UniformBuffer ||
+        binding.second.type == DescriptorType::StorageBuffer) {
+      const auto &buffer = mRegistry.getBuffers().at(
+          std::get<BufferHandle>(binding.second.data));
+      offsets.push_back(buffer->getOffset());
+    }
+  }
+
+  return offsets;
+}
+
+uint64_t VulkanDescriptorManager::createHash(
+    const Descriptor &descriptor,
+    const std::vector<size_t> &bufferOffsets) const {
+  uint64_t hash = descriptor.getHashCode();
+  for (auto offset : bufferOffsets) {
+    hashCombine(hash, offset);
+  }
+
+  return hash;
+}
+
+void VulkanDescriptorManager::addResourceSet(std::vector<CachedSet> &sets,
+                                             const CachedSet &set) {
+  constexpr size_t MIN_COMPACT_SIZE = 16;
+
+  // Sets that are evicted by other resources
+  // are removed every time the list doubles in size;
+  // so, lists of long living resources do not grow
+  bool powerOfTwo = (sets.size() & (sets.size() - 1)) == 0;
+  if (sets.size() >= MIN_COMPACT_SIZE && powerOfTwo) {
+    sets.erase(std::remove_if(sets.begin(), sets.end(),
+                              [this](const CachedSet &set) {
+                                return findEntry(set) == mEntries.size();
+                              }),
+               sets.end());
+  }
+
+  sets.push_back(set);
+}
+
+size_t VulkanDescriptorManager::getStartIndex(const CacheKey &key) const {
+  uint64_t hash = key.hash;
+  hashCombine(hash, key.layout);
+  return static_cast<size_t>(hash) & (mEntries.size() - 1);
+}
+
+size_t VulkanDescriptorManager::findEntry(
+    const CacheKey &key, const Descriptor &descriptor,
+    const std::vector<size_t> &bufferOffsets) const {
+  size_t mask = mEntries.size() - 1;
+  for (size_t i = getStartIndex(key);; i = (i + 1) & mask) {
+    const auto &entry = mEntries.at(i);
+    if (entry.state == CacheEntryState::Empty) {
+      return mEntries.size();
+    }
+
+    // Different descriptors can have the same
+    // hash; so, bindings are compared as well
+    if (entry.state == CacheEntryState::Used && entry.key.hash == key.hash &&
+        entry.key.layout == key.layout &&
+        entry.bufferOffsets == bufferOffsets &&
+        entry.descriptor == descriptor) {
+      return i;
+    }
+  }
+}
+
+size_t VulkanDescriptorManager::findEntry(const CachedSet &set) const {
+  size_t mask = mEntries.size() - 1;
+  for (size_t i = getStartIndex(set.key);; i = (i + 1) & mask) {
+    const auto &entry = mEntries.at(i);
+    if (entry.state == CacheEntryState::Empty) {
+      return mEntries.size();
+    }
+
+    if (entry.state == CacheEntryState::Used &&
+        entry.descriptorSet == set.descriptorSet) {
+      return i;
+    }
+  }
+}
+
+void VulkanDescriptorManager::insertEntry(CacheEntry &&entry) {
+  // Deleted entries are counted as used until the
+  // next rehash; so, probing always ends at an empty entry
+  if ((mNumUsedEntries + mNumDeletedEntries + 1) * 2 > mEntries.size()) {
+    rehash();
+  }
+
+  size_t mask = mEntries.size() - 1;
+  size_t i = getStartIndex(entry.key);
+  while (mEntries.at(i).state == CacheEntryState::Used) {
+    i = (i + 1) & mask;
+  }
+
+  auto &slot = mEntries.at(i);
+  if (slot.state == CacheEntryState::Deleted) {
+    mNumDeletedEntries--;
+  }
+
+  slot = std::move(entry);
+  slot.state = CacheEntryState::Used;
+  mNumUsedEntries++;
+}
+
+void VulkanDescriptorManager::rehash() {
+  size_t capacity = mEntries.size();
+  while ((mNumUsedEntries + 1) * 4 > capacity) {
+    capacity *= 2;
+  }
+
+  std::vector<CacheEntry> entries(capacity);
+  std::swap(entries, mEntries);
+  mNumUsedEntries = 0;
+  mNumDeletedEntries = 0;
+
+  for (auto &entry : entries) {
+    if (entry.state == CacheEntryState::Used) {
+      insertEntry(std::move(entry));
+    }
+  }
+}
+
+void VulkanDescriptorManager::evictEntries(const std::vector<CachedSet> &sets,
+                                           uint32_t frameIndex) {
+  for (const auto &set : sets) {
+    // Entry can already be evicted by
+    // another resource of the same set
+    size_t index = findEntry(set);
+    if (index == mEntries.size()) {
+      continue;
+    }
+
+    auto &entry = mEntries.at(index);
+    mEvictedDescriptorSets.at(frameIndex).push_back(entry.descriptorSet);
+    entry.state = CacheEntryState::Deleted;
+    entry.descriptor = Descriptor{};
+    entry.bufferOffsets.clear();
+    entry.descriptorSet = VK_NULL_HANDLE;
+    mNumUsedEntries--;
+    mNumDeletedEntries++;
+  }
 }
 
 } // namespace liquid::rhi
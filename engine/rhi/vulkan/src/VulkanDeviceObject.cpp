@@ -24,6 +24,14 @@ VulkanDeviceObject::VulkanDeviceObject(
 
   std::vector<VkDeviceQueueCreateInfo> queueInfos;
   queueInfos.push_back(createGraphicsQueueInfo);
+
+  if (physicalDevice.getQueueFamilyIndices().hasDedicatedTransferFamily()) {
+    VkDeviceQueueCreateInfo createTransferQueueInfo = createGraphicsQueueInfo;
+    createTransferQueueInfo.queueFamilyIndex =
+        physicalDevice.getQueueFamilyIndices().getTransferFamily();
+    queueInfos.push_back(createTransferQueueInfo);
+  }
+
   if (physicalDevice.getQueueFamilyIndices().getGraphicsFamily() !=
       physicalDevice.getQueueFamilyIndices().getPresentFamily()) {
     VkDeviceQueueCreateInfo createPresentQueueInfo{};
@@ -69,10 +77,16 @@ VulkanDeviceObject::VulkanDeviceObject(
               << LIQUID_VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME);
   }
 
+  VkPhysicalDeviceTimelineSemaphoreFeatures timelineSemaphoreFeatures{};
+  timelineSemaphoreFeatures.sType =
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+  timelineSemaphoreFeatures.pNext = nullptr;
+  timelineSemaphoreFeatures.timelineSemaphore = VK_TRUE;
+
   VkPhysicalDeviceHostQueryResetFeatures queryResetFeatures{};
   queryResetFeatures.sType =
       VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_QUERY_RESET_FEATURES;
-  queryResetFeatures.pNext = nullptr;
+  queryResetFeatures.pNext = &timelineSemaphoreFeatures;
   queryResetFeatures.hostQueryReset = VK_TRUE;
 
   VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexingFeatures{};
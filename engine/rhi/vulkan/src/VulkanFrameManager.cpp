@@ -37,6 +37,7 @@ VulkanFrameManager::~VulkanFrameManager() {
 
 void VulkanFrameManager::nextFrame() {
   mFrameIndex = (mFrameIndex + 1) % NUM_FRAMES;
+  mFrameNumber++;
 }
 
 void VulkanFrameManager::waitForFrame() {
@@ -98,6 +98,15 @@ VulkanPhysicalDevice::getPresentModes(const VkSurfaceKHR &surface) const {
   return presentModes;
 }
 
+bool VulkanPhysicalDevice::isTextureFormatSupported(VkFormat format) const {
+  VkFormatProperties properties{};
+  vkGetPhysicalDeviceFormatProperties(mDevice, format, &properties);
+
+  return (properties.optimalTilingFeatures &
+          VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) ==
+         VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+}
+
 const PhysicalDeviceInformation VulkanPhysicalDevice::getDeviceInfo() const {
   VkPhysicalDeviceProperties mProperties;
   vkGetPhysicalDeviceProperties(mDevice, &mProperties);
@@ -11,16 +11,23 @@ namespace liquid::rhi {
 
 VulkanPipeline::VulkanPipeline(const PipelineDescription &description,
                                VulkanDeviceObject &device,
-                               const VulkanResourceRegistry &registry)
+                               const VulkanResourceRegistry &registry,
+                               VkPipelineCache pipelineCache)
     : mDevice(device) {
 
-  std::array<VulkanShader *, 2> shaders{
-      registry.getShaders().at(description.vertexShader).get(),
-      registry.getShaders().at(description.fragmentShader).get(),
-  };
+  std::vector<VulkanShader *> shaders;
+  if (isHandleValid(description.computeShader)) {
+    mBindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
+    shaders.push_back(
+        registry.getShaders().at(description.computeShader).get());
+  } else {
+    shaders.push_back(registry.getShaders().at(description.vertexShader).get());
+    shaders.push_back(
+        registry.getShaders().at(description.fragmentShader).get());
+  }
 
-  std::array<VkPipelineShaderStageCreateInfo, 2> stages{};
-  for (size_t i = 0; i < 2; ++i) {
+  std::vector<VkPipelineShaderStageCreateInfo> stages(shaders.size());
+  for (size_t i = 0; i < shaders.size(); ++i) {
     stages.at(i).sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
     stages.at(i).pName = "main";
     stages.at(i).module = shaders.at(i)->getShaderModule();
@@ -87,6 +94,23 @@ VulkanPipeline::VulkanPipeline(const PipelineDescription &description,
                                              nullptr, &mPipelineLayout),
                       "Failed to create pipeline layout");
 
+  if (mBindPoint == VK_PIPELINE_BIND_POINT_COMPUTE) {
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.pNext = nullptr;
+    pipelineInfo.flags = 0;
+    pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+    pipelineInfo.basePipelineIndex = -1;
+    pipelineInfo.layout = mPipelineLayout;
+    pipelineInfo.stage = stages.at(0);
+
+    checkForVulkanError(vkCreateComputePipelines(mDevice, pipelineCache, 1,
+                                                 &pipelineInfo, nullptr,
+                                                 &mPipeline),
+                        "Failed to create compute pipeline");
+    return;
+  }
+
   // Dynamic state
   std::array<VkDynamicState, 2> dynamicStates{VK_DYNAMIC_STATE_VIEWPORT,
                                               VK_DYNAMIC_STATE_SCISSOR};
@@ -248,7 +272,7 @@ VulkanPipeline::VulkanPipeline(const PipelineDescription &description,
   pipelineInfo.pColorBlendState = &colorBlending;
   pipelineInfo.pDynamicState = &dynamicState;
 
-  checkForVulkanError(vkCreateGraphicsPipelines(mDevice, VK_NULL_HANDLE, 1,
+  checkForVulkanError(vkCreateGraphicsPipelines(mDevice, pipelineCache, 1,
                                                 &pipelineInfo, nullptr,
                                                 &mPipeline),
                       "Failed to create pipeline");
@@ -0,0 +1,151 @@
+#include "liquid/core/Base.h"
+#include "liquid/core/EngineGlobals.h"
+
+#include "VulkanPipelineCache.h"
+#include "VulkanPipeline.h"
+#include "VulkanError.h"
+
+namespace liquid::rhi {
+
+VulkanPipelineCache::VulkanPipelineCache(
+    VulkanDeviceObject &device, const VulkanPhysicalDevice &physicalDevice,
+    const Path &path)
+    : mPath(path), mProperties(physicalDevice.getProperties()),
+      mDevice(device) {
+  auto data = readCacheData();
+
+  VkPipelineCacheCreateInfo createInfo{};
+  createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+  createInfo.pNext = nullptr;
+  createInfo.flags = 0;
+  createInfo.initialDataSize = data.size();
+  createInfo.pInitialData = data.empty() ? nullptr : data.data();
+
+  checkForVulkanError(
+      vkCreatePipelineCache(mDevice, &createInfo, nullptr, &mPipelineCache),
+      "Failed to create pipeline cache");
+
+  LOG_DEBUG("[Vulkan] Pipeline cache created with " << data.size()
+                                                    << " bytes of data");
+}
+
+VulkanPipelineCache::~VulkanPipelineCache() {
+  if (mPipelineCache) {
+    save();
+    vkDestroyPipelineCache(mDevice, mPipelineCache, nullptr);
+    LOG_DEBUG("[Vulkan] Pipeline cache destroyed");
+  }
+}
+
+std::shared_ptr<VulkanPipeline> VulkanPipelineCache::getOrCreatePipeline(
+    const PipelineDescription &description,
+    const VulkanResourceRegistry &registry) {
+  // Different descriptions can have the same hash
+  auto &pipelines = mPipelines[getPipelineDescriptionHash(description)];
+  auto it = std::find_if(pipelines.begin(), pipelines.end(),
+                         [&description](const StoredPipeline &stored) {
+                           return stored.description == description;
+                         });
+
+  if (it != pipelines.end()) {
+    if (auto pipeline = it->pipeline.lock()) {
+      return pipeline;
+    }
+  }
+
+  auto pipeline = std::make_shared<VulkanPipeline>(description, mDevice,
+                                                   registry, mPipelineCache);
+  if (it != pipelines.end()) {
+    it->pipeline = pipeline;
+  } else {
+    pipelines.push_back({description, pipeline});
+  }
+
+  mChanged = true;
+  return pipeline;
+}
+
+void VulkanPipelineCache::clearPipelines() { mPipelines.clear(); }
+
+void VulkanPipelineCache::save() {
+  if (!mChanged || mPath.empty()) {
+    return;
+  }
+
+  mChanged = false;
+
+  size_t size = 0;
+  checkForVulkanError(
+      vkGetPipelineCacheData(mDevice, mPipelineCache, &size, nullptr),
+      "Failed to get pipeline cache size");
+
+  std::vector<char> data(size);
+  checkForVulkanError(
+      vkGetPipelineCacheData(mDevice, mPipelineCache, &size, data.data()),
+      "Failed to get pipeline cache data");
+
+  auto header = createHeader();
+  header.dataSize = static_cast<uint32_t>(size);
+
+  std::error_code error;
+  std::filesystem::create_directories(mPath.parent_path(), error);
+
+  std::ofstream file(mPath, std::ios::binary);
+  if (!file.is_open()) {
+    LOG_DEBUG("[Vulkan] Cannot write pipeline cache to " << mPath);
+    return;
+  }
+
+  file.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+  file.write(data.data(), static_cast<std::streamsize>(size));
+
+  LOG_DEBUG("[Vulkan] Pipeline cache written to " << mPath);
+}
+
+VulkanPipelineCache::Header VulkanPipelineCache::createHeader() const {
+  Header header{};
+  header.magic = MAGIC;
+  header.vendorID = mProperties.vendorID;
+  header.deviceID = mProperties.deviceID;
+  header.driverVersion = mProperties.driverVersion;
+  std::copy(std::begin(mProperties.pipelineCacheUUID),
+            std::end(mProperties.pipelineCacheUUID), header.uuid.begin());
+  return header;
+}
+
+std::vector<char> VulkanPipelineCache::readCacheData() const {
+  if (mPath.empty()) {
+    return {};
+  }
+
+  std::ifstream file(mPath, std::ios::binary);
+  if (!file.is_open()) {
+    return {};
+  }
+
+  Header header{};
+  file.read(reinterpret_cast<char *>(&header), sizeof(Header));
+
+  auto expected = createHeader();
+  if (!file || header.magic != expected.magic ||
+      header.vendorID != expected.vendorID ||
+      header.deviceID != expected.deviceID ||
+      header.driverVersion != expected.driverVersion ||
+      header.uuid != expected.uuid) {
+    LOG_DEBUG("[Vulkan] Pipeline cache in "
+              << mPath << " is created by a different device or driver");
+    return {};
+  }
+
+  std::vector<char> data(header.dataSize);
+  file.read(data.data(), static_cast<std::streamsize>(data.size()));
+
+  if (!file) {
+    LOG_DEBUG("[Vulkan] Pipeline cache in " << mPath << " is incomplete");
+    return {};
+  }
+
+  return data;
+}
+
+} // namespace liquid::rhi
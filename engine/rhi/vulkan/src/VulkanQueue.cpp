@@ -11,14 +11,30 @@ VulkanQueue::VulkanQueue(VulkanDeviceObject &device, uint32_t queueIndex)
 }
 
 void VulkanQueue::submit(VulkanSubmitInfo submitInfo) {
-  std::array<VkPipelineStageFlags, 1> waitStages{submitInfo.waitStages};
+  LIQUID_ASSERT(submitInfo.waitStages.size() ==
+                    submitInfo.waitSemaphores.size(),
+                "Every wait semaphore must have a wait stage");
+
+  VkTimelineSemaphoreSubmitInfo timelineSubmitInfo{};
+  timelineSubmitInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+  timelineSubmitInfo.pNext = nullptr;
+  timelineSubmitInfo.waitSemaphoreValueCount =
+      static_cast<uint32_t>(submitInfo.waitValues.size());
+  timelineSubmitInfo.pWaitSemaphoreValues = submitInfo.waitValues.data();
+  timelineSubmitInfo.signalSemaphoreValueCount =
+      static_cast<uint32_t>(submitInfo.signalValues.size());
+  timelineSubmitInfo.pSignalSemaphoreValues = submitInfo.signalValues.data();
+
+  bool hasTimelineValues =
+      !submitInfo.waitValues.empty() || !submitInfo.signalValues.empty();
+
   VkSubmitInfo vkSubmitInfo{};
   vkSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-  vkSubmitInfo.pNext = nullptr;
+  vkSubmitInfo.pNext = hasTimelineValues ? &timelineSubmitInfo : nullptr;
   vkSubmitInfo.waitSemaphoreCount =
       static_cast<uint32_t>(submitInfo.waitSemaphores.size());
   vkSubmitInfo.pWaitSemaphores = submitInfo.waitSemaphores.data();
-  vkSubmitInfo.pWaitDstStageMask = waitStages.data();
+  vkSubmitInfo.pWaitDstStageMask = submitInfo.waitStages.data();
   vkSubmitInfo.commandBufferCount =
       static_cast<uint32_t>(submitInfo.commandBuffers.size());
   vkSubmitInfo.pCommandBuffers = submitInfo.commandBuffers.data();
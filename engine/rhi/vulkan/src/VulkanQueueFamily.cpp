@@ -14,11 +14,17 @@ VulkanQueueFamily::VulkanQueueFamily(VkPhysicalDevice device,
                                            queueFamilies.data());
 
   for (uint32_t i = 0; i < queueFamilies.size(); ++i) {
-    if (queueFamilies.at(i).queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+    const auto flags = queueFamilies.at(i).queueFlags;
+
+    if (!mGraphicsFamily.has_value() && (flags & VK_QUEUE_GRAPHICS_BIT)) {
       mGraphicsFamily = i;
     }
 
-    if (queueFamilies.at(i).queueFlags & VK_QUEUE_TRANSFER_BIT) {
+    // Dedicated transfer families are usually
+    // backed by DMA engines that copy in parallel
+    // with graphics work
+    if (!mTransferFamily.has_value() && (flags & VK_QUEUE_TRANSFER_BIT) &&
+        !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT))) {
       mTransferFamily = i;
     }
 
@@ -27,13 +33,14 @@ VulkanQueueFamily::VulkanQueueFamily(VkPhysicalDevice device,
                                                              &presentSupport),
                         "Cannot query physics device surface support");
 
-    if (presentSupport) {
+    if (!mPresentFamily.has_value() && presentSupport) {
       mPresentFamily = i;
     }
+  }
 
-    if (isComplete()) {
-      break;
-    }
+  // Graphics queues always support transfers
+  if (!mTransferFamily.has_value()) {
+    mTransferFamily = mGraphicsFamily;
   }
 }
 
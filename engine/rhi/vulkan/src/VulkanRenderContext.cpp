@@ -58,7 +58,9 @@ VulkanRenderContext::beginRendering(VulkanFrameManager &frameManager) {
   return mRenderCommandLists.at(frameManager.getCurrentFrameIndex());
 }
 
-void VulkanRenderContext::endRendering(VulkanFrameManager &frameManager) {
+void VulkanRenderContext::endRendering(
+    VulkanFrameManager &frameManager,
+    const VulkanUploadContext &uploadContext) {
   auto *commandBuffer =
       dynamic_cast<rhi::VulkanCommandBuffer *>(
           mRenderCommandLists.at(frameManager.getCurrentFrameIndex())
@@ -72,8 +74,19 @@ void VulkanRenderContext::endRendering(VulkanFrameManager &frameManager) {
   submitInfo.commandBuffers = {commandBuffer};
   submitInfo.fence = frameManager.getFrameFence();
   submitInfo.signalSemaphores = {frameManager.getRenderFinishedSemaphore()};
-  submitInfo.waitSemaphores = {frameManager.getImageAvailableSemaphore()};
-  submitInfo.waitStages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+  submitInfo.waitSemaphores = {frameManager.getImageAvailableSemaphore(),
+                               uploadContext.getSemaphore()};
+  submitInfo.waitValues = {0, uploadContext.getSubmittedValue()};
+
+  // Uploaded resources are only read by
+  // these stages; so, earlier stages do
+  // not wait for uploads
+  submitInfo.waitStages = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                           VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT |
+                               VK_PIPELINE_STAGE_VERTEX_INPUT_BIT |
+                               VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+                               VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+                               VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT};
 
   mGraphicsQueue.submit(submitInfo);
 }
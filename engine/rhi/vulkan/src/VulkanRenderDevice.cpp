@@ -13,9 +13,46 @@
 
 #include "VulkanError.h"
 #include "liquid/core/EngineGlobals.h"
+#include "liquid/core/Engine.h"
 
 namespace liquid::rhi {
 
+/**
+ * @brief Get queue families that share uploaded resources
+ *
+ * @param physicalDevice Physical device
+ * @return Graphics and transfer families if transfer family is dedicated
+ */
+static std::vector<uint32_t>
+getUploadQueueFamilies(const VulkanPhysicalDevice &physicalDevice) {
+  const auto &queueFamilies = physicalDevice.getQueueFamilyIndices();
+  if (!queueFamilies.hasDedicatedTransferFamily()) {
+    return {};
+  }
+
+  LOG_DEBUG("[Vulkan] Uploads use dedicated transfer queue family "
+            << queueFamilies.getTransferFamily());
+
+  return {queueFamilies.getGraphicsFamily(),
+          queueFamilies.getTransferFamily()};
+}
+
+/**
+ * @brief Get path of file in user data directory
+ *
+ * @param fileName File name
+ * @return File path or empty path if user
+ *         data directory is not set
+ */
+static Path getUserDataFilePath(const char *fileName) {
+  const auto &userDataPath = Engine::getUserDataPath();
+  if (userDataPath.empty()) {
+    return Path{};
+  }
+
+  return Path(userDataPath) / fileName;
+}
+
 VulkanRenderDevice::VulkanRenderDevice(
     VulkanRenderBackend &backend, const VulkanPhysicalDevice &physicalDevice)
     : mPhysicalDevice(physicalDevice), mBackend(backend),
@@ -29,9 +66,14 @@ VulkanRenderDevice::VulkanRenderDevice(
                     mPhysicalDevice.getQueueFamilyIndices().getPresentFamily()),
       mFrameManager(mDevice),
       mRenderContext(mDevice, mCommandPool, mGraphicsQueue, mPresentQueue),
-      mUploadContext(mDevice, mCommandPool, mGraphicsQueue),
+      mTransferQueue(
+          mDevice, mPhysicalDevice.getQueueFamilyIndices().getTransferFamily()),
+      mUploadContext(mDevice, mTransferQueue, mAllocator,
+                     getUploadQueueFamilies(mPhysicalDevice)),
       mSwapchain(mBackend, mPhysicalDevice, mDevice, mRegistry, mAllocator),
-      mAllocator(mBackend, mPhysicalDevice, mDevice) {
+      mAllocator(mBackend, mPhysicalDevice, mDevice),
+      mPipelineCache(mDevice, mPhysicalDevice,
+                     getUserDataFilePath(PIPELINE_CACHE_FILE)) {
 
   VkDevice device = mDevice.getVulkanHandle();
   VkPhysicalDevice physicalDeviceHandle = mPhysicalDevice.getVulkanHandle();
@@ -55,6 +97,8 @@ RenderFrame VulkanRenderDevice::beginFrame() {
 
   mStats.resetCalls();
   mFrameManager.waitForFrame();
+  mDescriptorManager.freeEvictedDescriptorSets(
+      mFrameManager.getCurrentFrameIndex());
 
   uint32_t imageIndex =
       mSwapchain.acquireNextImage(mFrameManager.getImageAvailableSemaphore());
@@ -75,7 +119,7 @@ void VulkanRenderDevice::endFrame(const RenderFrame &renderFrame) {
   LIQUID_PROFILE_EVENT("VulkanRenderDevice::endFrame");
   mSwapchainRecreated = false;
 
-  mRenderContext.endRendering(mFrameManager);
+  mRenderContext.endRendering(mFrameManager, mUploadContext);
 
   VkSwapchainKHR swapchainHandle = mSwapchain.getVulkanHandle();
   LIQUID_PROFILE_GPU_FLIP(&mSwapchain);
@@ -90,10 +134,14 @@ void VulkanRenderDevice::endFrame(const RenderFrame &renderFrame) {
   mFrameManager.nextFrame();
 }
 
-void VulkanRenderDevice::waitForIdle() { vkDeviceWaitIdle(mDevice); }
+void VulkanRenderDevice::waitForIdle() {
+  mUploadContext.flush();
+  vkDeviceWaitIdle(mDevice);
+}
 
 void VulkanRenderDevice::destroyResources() {
   waitForIdle();
+  mDescriptorManager.clear();
   mRegistry = VulkanResourceRegistry();
   mSwapchain.recreate(mBackend, mPhysicalDevice, mAllocator);
 }
@@ -116,7 +164,17 @@ void VulkanRenderDevice::recreateSwapchain() {
 void VulkanRenderDevice::updateFramebufferRelativeTextures() {
   mRegistry.deleteDanglingSwapchainRelativeTextures();
 
+  std::vector<TextureDescription> descriptions;
   for (auto handle : mRegistry.getSwapchainRelativeTextures()) {
+    descriptions.push_back(
+        mRegistry.getTextures().at(handle)->getDescription());
+  }
+
+  auto aliasedMemory = allocateAliasedMemory(descriptions);
+
+  for (auto handle : mRegistry.getSwapchainRelativeTextures()) {
+    mDescriptorManager.evict(handle, mFrameManager.getCurrentFrameIndex());
+
     auto &texture = mRegistry.getTextures().at(handle);
     mRegistry.setTexture(handle,
                          std::make_unique<VulkanTexture>(
@@ -125,10 +183,58 @@ void VulkanRenderDevice::updateFramebufferRelativeTextures() {
   }
 }
 
+std::vector<std::shared_ptr<VulkanAliasedMemory>>
+VulkanRenderDevice::allocateAliasedMemory(
+    const std::vector<TextureDescription> &descriptions) {
+  std::map<uint32_t, VkMemoryRequirements> groups;
+  for (const auto &description : descriptions) {
+    if (description.aliasGroup == 0) {
+      continue;
+    }
+
+    auto requirements = VulkanTexture::getMemoryRequirements(
+        description, mDevice, mUploadContext, mSwapchain.getExtent());
+
+    auto it = groups.find(description.aliasGroup);
+    if (it == groups.end()) {
+      groups.insert({description.aliasGroup, requirements});
+      continue;
+    }
+
+    // Alignments are powers of two; so,
+    // the largest one satisfies all of them
+    auto &group = it->second;
+    group.size = std::max(group.size, requirements.size);
+    group.alignment = std::max(group.alignment, requirements.alignment);
+    group.memoryTypeBits &= requirements.memoryTypeBits;
+  }
+
+  std::vector<std::shared_ptr<VulkanAliasedMemory>> memory;
+  for (auto &[aliasGroup, requirements] : groups) {
+    if (requirements.memoryTypeBits == 0) {
+      engineLogger.log(Logger::Warning)
+          << "[Vulkan] Textures of alias group " << aliasGroup
+          << " have no common memory type; textures are not aliased";
+      continue;
+    }
+
+    memory.push_back(
+        mAllocator.allocateAliasedMemory(aliasGroup, requirements));
+  }
+
+  return memory;
+}
+
 void VulkanRenderDevice::synchronize(ResourceRegistry &registry) {
   LIQUID_PROFILE_EVENT("VulkanRenderDevice::synchronize");
   // Shaders
   for (auto [handle, state] : registry.getShaderMap().getStagedResources()) {
+    // Pipelines of replaced shaders
+    // must not be shared anymore
+    if (mRegistry.getShaders().find(handle) != mRegistry.getShaders().end()) {
+      mPipelineCache.clearPipelines();
+    }
+
     if (state == ResourceRegistryState::Set) {
       mRegistry.setShader(
           handle, std::make_unique<VulkanShader>(
@@ -140,19 +246,51 @@ void VulkanRenderDevice::synchronize(ResourceRegistry &registry) {
 
   registry.getShaderMap().clearStagedResources();
 
+  // Submitted uploads can still write to
+  // resources that are about to be destroyed
+  bool uploadsFinished = false;
+  auto waitForUploads = [this, &uploadsFinished]() {
+    if (!uploadsFinished) {
+      mUploadContext.waitForIdle();
+      uploadsFinished = true;
+    }
+  };
+
+  // Descriptor sets of recreated and deleted
+  // resources are evicted before next frame
+  uint32_t frameIndex = mFrameManager.getCurrentFrameIndex();
+
   // Buffers
+  bool idle = false;
   for (auto [handle, state] : registry.getBufferMap().getStagedResources()) {
     if (state == ResourceRegistryState::Set) {
       if (mRegistry.hasBuffer(handle)) {
-        mRegistry.getBuffers().at(handle)->update(
-            registry.getBufferMap().getDescription(handle));
+        const auto &description =
+            registry.getBufferMap().getDescription(handle);
+        auto &buffer = mRegistry.getBuffers().at(handle);
+
+        // Resized buffer is recreated; so, previous
+        // frames must stop using the old buffer
+        if (buffer->getSize() != description.size) {
+          if (!idle) {
+            waitForIdle();
+            idle = true;
+          }
+
+          mDescriptorManager.evict(handle, frameIndex);
+        }
+
+        buffer->update(description, mFrameManager.getFrameNumber());
       } else {
         mRegistry.setBuffer(
             handle,
             std::make_unique<VulkanBuffer>(
-                registry.getBufferMap().getDescription(handle), mAllocator));
+                registry.getBufferMap().getDescription(handle), mAllocator,
+                mUploadContext, mFrameManager.getFrameNumber()));
       }
     } else {
+      waitForUploads();
+      mDescriptorManager.evict(handle, frameIndex);
       mRegistry.deleteBuffer(handle);
     }
   }
@@ -160,23 +298,49 @@ void VulkanRenderDevice::synchronize(ResourceRegistry &registry) {
   registry.getBufferMap().clearStagedResources();
 
   // Textures
+  std::vector<TextureDescription> descriptions;
   for (auto [handle, state] : registry.getTextureMap().getStagedResources()) {
     if (state == ResourceRegistryState::Set) {
+      descriptions.push_back(registry.getTextureMap().getDescription(handle));
+    }
+  }
+
+  auto aliasedMemory = allocateAliasedMemory(descriptions);
+
+  for (auto [handle, state] : registry.getTextureMap().getStagedResources()) {
+    if (state == ResourceRegistryState::Set) {
+      if (mRegistry.getTextures().find(handle) !=
+          mRegistry.getTextures().end()) {
+        waitForUploads();
+        mDescriptorManager.evict(handle, frameIndex);
+      }
+
       mRegistry.setTexture(handle,
                            std::make_unique<VulkanTexture>(
                                registry.getTextureMap().getDescription(handle),
                                mAllocator, mDevice, mUploadContext,
                                mSwapchain.getExtent()));
     } else {
+      waitForUploads();
+      mDescriptorManager.evict(handle, frameIndex);
       mRegistry.deleteTexture(handle);
     }
   }
 
   registry.getTextureMap().clearStagedResources();
 
+  // All uploads of this synchronization
+  // are submitted in one batch
+  mUploadContext.flush();
+
   // Render passes
   for (auto [handle, state] :
        registry.getRenderPassMap().getStagedResources()) {
+    if (mRegistry.getRenderPasses().find(handle) !=
+        mRegistry.getRenderPasses().end()) {
+      mPipelineCache.clearPipelines();
+    }
+
     if (state == ResourceRegistryState::Set) {
       mRegistry.setRenderPass(
           handle, std::make_unique<VulkanRenderPass>(
@@ -207,10 +371,9 @@ void VulkanRenderDevice::synchronize(ResourceRegistry &registry) {
   // Pipelines
   for (auto [handle, state] : registry.getPipelineMap().getStagedResources()) {
     if (state == ResourceRegistryState::Set) {
-
       mRegistry.setPipeline(
-          handle, std::make_unique<VulkanPipeline>(
-                      registry.getPipelineMap().getDescription(handle), mDevice,
+          handle, mPipelineCache.getOrCreatePipeline(
+                      registry.getPipelineMap().getDescription(handle),
                       mRegistry));
     } else {
       mRegistry.deletePipeline(handle);
@@ -218,6 +381,10 @@ void VulkanRenderDevice::synchronize(ResourceRegistry &registry) {
   }
 
   registry.getPipelineMap().clearStagedResources();
+
+  // Cache is written when pipelines are created;
+  // so, it is not lost if application crashes
+  mPipelineCache.save();
 }
 
 } // namespace liquid::rhi
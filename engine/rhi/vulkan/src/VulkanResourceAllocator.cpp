@@ -29,4 +29,32 @@ VulkanResourceAllocator::~VulkanResourceAllocator() {
   }
 }
 
+std::shared_ptr<VulkanAliasedMemory>
+VulkanResourceAllocator::allocateAliasedMemory(
+    uint32_t aliasGroup, const VkMemoryRequirements &requirements) {
+  auto memory = mAliasedMemory[aliasGroup].lock();
+
+  if (!memory || !memory->isCompatible(requirements)) {
+    memory = std::make_shared<VulkanAliasedMemory>(requirements, mAllocator);
+    mAliasedMemory.insert_or_assign(aliasGroup, memory);
+  }
+
+  return memory;
+}
+
+std::shared_ptr<VulkanAliasedMemory> VulkanResourceAllocator::getAliasedMemory(
+    uint32_t aliasGroup, const VkMemoryRequirements &requirements) {
+  auto it = mAliasedMemory.find(aliasGroup);
+  if (it == mAliasedMemory.end()) {
+    return nullptr;
+  }
+
+  auto memory = it->second.lock();
+  if (!memory || !memory->isCompatible(requirements)) {
+    return nullptr;
+  }
+
+  return memory;
+}
+
 } // namespace liquid::rhi
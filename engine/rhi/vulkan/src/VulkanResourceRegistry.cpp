@@ -72,8 +72,8 @@ void VulkanResourceRegistry::deleteFramebuffer(FramebufferHandle handle) {
 }
 
 void VulkanResourceRegistry::setPipeline(
-    PipelineHandle handle, std::unique_ptr<VulkanPipeline> &&pipeline) {
-  mPipelines.insert_or_assign(handle, std::move(pipeline));
+    PipelineHandle handle, const std::shared_ptr<VulkanPipeline> &pipeline) {
+  mPipelines.insert_or_assign(handle, pipeline);
 }
 
 void VulkanResourceRegistry::deletePipeline(PipelineHandle handle) {
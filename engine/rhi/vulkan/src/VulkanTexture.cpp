@@ -1,6 +1,6 @@
 #include "liquid/core/Base.h"
+#include "liquid/core/EngineGlobals.h"
 
-#include "VulkanBuffer.h"
 #include "VulkanTexture.h"
 #include "VulkanError.h"
 
@@ -19,37 +19,22 @@ VulkanTexture::VulkanTexture(VkImage image, VkImageView imageView,
   mDescription.usage = TextureUsage::Color;
 }
 
-VulkanTexture::VulkanTexture(const TextureDescription &description,
-                             VulkanResourceAllocator &allocator,
-                             VulkanDeviceObject &device,
-                             VulkanUploadContext &uploadContext,
-                             const glm::uvec2 &swapchainExtent)
-    : mAllocator(allocator), mDevice(device),
-      mFormat(static_cast<VkFormat>(description.format)),
-      mDescription(description) {
-  LIQUID_ASSERT(
-      description.type == TextureType::Cubemap ? description.layers == 6 : true,
-      "Cubemap must have 6 layers");
-
-  uint32_t imageFlags = description.type == TextureType::Cubemap
-                            ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT
-                            : 0;
-
-  VkFormat format = static_cast<VkFormat>(description.format);
-  VkImageViewType imageViewType = VK_IMAGE_VIEW_TYPE_MAX_ENUM;
-
-  if (description.type == TextureType::Cubemap) {
-    imageViewType = VK_IMAGE_VIEW_TYPE_CUBE;
-  } else if (description.layers > 1) {
-    imageViewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
-  } else {
-    imageViewType = VK_IMAGE_VIEW_TYPE_2D;
-  }
-
+/**
+ * @brief Get image create info
+ *
+ * @param description Texture description
+ * @param queueFamilies Queue families of uploads
+ * @param swapchainExtent Swapchain extent
+ * @return Image create info
+ */
+static VkImageCreateInfo
+getImageCreateInfo(const TextureDescription &description,
+                   const std::vector<uint32_t> &queueFamilies,
+                   const glm::uvec2 &swapchainExtent) {
   static constexpr uint32_t HUNDRED_PERCENT = 100;
 
   VkExtent3D extent{};
-  if (isFramebufferRelative()) {
+  if (description.sizeMethod == TextureSizeMethod::FramebufferRatio) {
     extent.width = description.width * swapchainExtent.x / HUNDRED_PERCENT;
     extent.height = description.height * swapchainExtent.y / HUNDRED_PERCENT;
   } else {
@@ -62,12 +47,10 @@ VulkanTexture::VulkanTexture(const TextureDescription &description,
 
   if ((description.usage & TextureUsage::Color) == TextureUsage::Color) {
     usageFlags |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
-    mAspectFlags = VK_IMAGE_ASPECT_COLOR_BIT;
   }
 
   if ((description.usage & TextureUsage::Depth) == TextureUsage::Depth) {
     usageFlags |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
-    mAspectFlags = VK_IMAGE_ASPECT_DEPTH_BIT;
   }
 
   if ((description.usage & TextureUsage::Sampled) == TextureUsage::Sampled) {
@@ -79,25 +62,110 @@ VulkanTexture::VulkanTexture(const TextureDescription &description,
     usageFlags |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
   }
 
+  uint32_t mipLevels =
+      std::max(static_cast<uint32_t>(description.levels.size()), 1u);
+
+  uint32_t imageFlags = description.type == TextureType::Cubemap
+                            ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT
+                            : 0;
+
   VkImageCreateInfo imageCreateInfo{};
   imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
   imageCreateInfo.pNext = nullptr;
   imageCreateInfo.flags = imageFlags;
   imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
-  imageCreateInfo.format = format;
+  imageCreateInfo.format = static_cast<VkFormat>(description.format);
   imageCreateInfo.extent = extent;
-  imageCreateInfo.mipLevels = 1;
+  imageCreateInfo.mipLevels = mipLevels;
   imageCreateInfo.arrayLayers = description.layers;
   imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
   imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
   imageCreateInfo.usage = usageFlags;
 
+  if ((usageFlags & VK_IMAGE_USAGE_TRANSFER_DST_BIT) &&
+      !queueFamilies.empty()) {
+    imageCreateInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+    imageCreateInfo.queueFamilyIndexCount =
+        static_cast<uint32_t>(queueFamilies.size());
+    imageCreateInfo.pQueueFamilyIndices = queueFamilies.data();
+  }
+
+  return imageCreateInfo;
+}
+
+VulkanTexture::VulkanTexture(const TextureDescription &description,
+                             VulkanResourceAllocator &allocator,
+                             VulkanDeviceObject &device,
+                             VulkanUploadContext &uploadContext,
+                             const glm::uvec2 &swapchainExtent)
+    : mAllocator(allocator), mDevice(device),
+      mFormat(static_cast<VkFormat>(description.format)),
+      mDescription(description) {
+  LIQUID_ASSERT(
+      description.type == TextureType::Cubemap ? description.layers == 6 : true,
+      "Cubemap must have 6 layers");
+
+  VkFormat format = static_cast<VkFormat>(description.format);
+  VkImageViewType imageViewType = VK_IMAGE_VIEW_TYPE_MAX_ENUM;
+
+  if (description.type == TextureType::Cubemap) {
+    imageViewType = VK_IMAGE_VIEW_TYPE_CUBE;
+  } else if (description.layers > 1) {
+    imageViewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+  } else {
+    imageViewType = VK_IMAGE_VIEW_TYPE_2D;
+  }
+
+  if ((description.usage & TextureUsage::Color) == TextureUsage::Color) {
+    mAspectFlags = VK_IMAGE_ASPECT_COLOR_BIT;
+  }
+
+  if ((description.usage & TextureUsage::Depth) == TextureUsage::Depth) {
+    mAspectFlags = VK_IMAGE_ASPECT_DEPTH_BIT;
+  }
+
+  auto imageCreateInfo = getImageCreateInfo(
+      description, uploadContext.getQueueFamilies(), swapchainExtent);
+  VkExtent3D extent = imageCreateInfo.extent;
+  uint32_t mipLevels = imageCreateInfo.mipLevels;
+
   VmaAllocationCreateInfo allocationCreateInfo{};
   allocationCreateInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
-  checkForVulkanError(vmaCreateImage(mAllocator, &imageCreateInfo,
-                                     &allocationCreateInfo, &mImage,
-                                     &mAllocation, nullptr),
-                      "Failed to create texture");
+
+  if (description.aliasGroup != 0) {
+    checkForVulkanError(
+        vkCreateImage(mDevice, &imageCreateInfo, nullptr, &mImage),
+        "Failed to create texture");
+
+    VkMemoryRequirements requirements{};
+    vkGetImageMemoryRequirements(mDevice, mImage, &requirements);
+
+    mAliasedMemory =
+        mAllocator.getAliasedMemory(description.aliasGroup, requirements);
+
+    if (mAliasedMemory) {
+      checkForVulkanError(vmaBindImageMemory(mAllocator,
+                                             mAliasedMemory->getAllocation(),
+                                             mImage),
+                          "Failed to bind texture memory");
+    } else {
+      engineLogger.log(Logger::Warning)
+          << "[Vulkan] Memory of alias group " << description.aliasGroup
+          << " does not fit texture; texture is not aliased";
+
+      checkForVulkanError(
+          vmaAllocateMemoryForImage(mAllocator, mImage, &allocationCreateInfo,
+                                    &mAllocation, nullptr),
+          "Failed to allocate texture memory");
+      checkForVulkanError(vmaBindImageMemory(mAllocator, mAllocation, mImage),
+                          "Failed to bind texture memory");
+    }
+  } else {
+    checkForVulkanError(vmaCreateImage(mAllocator, &imageCreateInfo,
+                                       &allocationCreateInfo, &mImage,
+                                       &mAllocation, nullptr),
+                        "Failed to create texture");
+  }
 
   VkImageViewCreateInfo imageViewCreateInfo{};
   imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -109,7 +177,7 @@ VulkanTexture::VulkanTexture(const TextureDescription &description,
   imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
   imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
   imageViewCreateInfo.subresourceRange.layerCount = description.layers;
-  imageViewCreateInfo.subresourceRange.levelCount = 1;
+  imageViewCreateInfo.subresourceRange.levelCount = mipLevels;
   imageViewCreateInfo.subresourceRange.aspectMask = mAspectFlags;
   checkForVulkanError(
       vkCreateImageView(mDevice, &imageViewCreateInfo, nullptr, &mImageView),
@@ -124,21 +192,23 @@ VulkanTexture::VulkanTexture(const TextureDescription &description,
   samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
   samplerCreateInfo.minFilter = VK_FILTER_NEAREST;
   samplerCreateInfo.magFilter = VK_FILTER_NEAREST;
+  samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+  samplerCreateInfo.minLod = 0.0f;
+  samplerCreateInfo.maxLod = static_cast<float>(mipLevels);
   checkForVulkanError(
       vkCreateSampler(mDevice, &samplerCreateInfo, nullptr, &mSampler),
       "Failed to image sampler");
 
   if (description.data) {
-    VulkanBuffer stagingBuffer(
-        {rhi::BufferType::Transfer, description.size, description.data},
-        mAllocator);
+    auto stagingRegion =
+        uploadContext.stage(description.data, description.size);
 
-    uploadContext.submit([extent, this, &stagingBuffer,
+    uploadContext.record([extent, mipLevels, this, stagingRegion,
                           &description](VkCommandBuffer commandBuffer) {
       VkImageSubresourceRange range{};
       range.aspectMask = mAspectFlags;
       range.baseMipLevel = 0;
-      range.levelCount = 1;
+      range.levelCount = mipLevels;
       range.baseArrayLayer = 0;
       range.layerCount = description.layers;
 
@@ -156,33 +226,64 @@ VulkanTexture::VulkanTexture(const TextureDescription &description,
                            VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0,
                            nullptr, 1, &imageBarrierTransfer);
 
-      VkBufferImageCopy copyRegion{};
-      copyRegion.bufferImageHeight = 0;
-      copyRegion.bufferOffset = 0;
-      copyRegion.bufferRowLength = 0;
-      copyRegion.imageExtent = extent;
-      copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-      copyRegion.imageSubresource.baseArrayLayer = 0;
-      copyRegion.imageSubresource.layerCount = description.layers;
-      copyRegion.imageSubresource.mipLevel = 0;
+      std::vector<VkBufferImageCopy> copyRegions(mipLevels);
+      for (uint32_t i = 0; i < mipLevels; ++i) {
+        auto &copyRegion = copyRegions.at(i);
+        copyRegion.bufferImageHeight = 0;
+        copyRegion.bufferOffset = stagingRegion.offset;
+        copyRegion.bufferRowLength = 0;
+        copyRegion.imageExtent = extent;
+        copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        copyRegion.imageSubresource.baseArrayLayer = 0;
+        copyRegion.imageSubresource.layerCount = description.layers;
+        copyRegion.imageSubresource.mipLevel = i;
 
-      vkCmdCopyBufferToImage(commandBuffer, stagingBuffer.getBuffer(), mImage,
-                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1,
-                             &copyRegion);
+        if (!description.levels.empty()) {
+          const auto &level = description.levels.at(i);
+          copyRegion.bufferOffset += level.offset;
+          copyRegion.imageExtent.width = level.width;
+          copyRegion.imageExtent.height = level.height;
+        }
+      }
 
+      vkCmdCopyBufferToImage(commandBuffer, stagingRegion.buffer, mImage,
+                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                             static_cast<uint32_t>(copyRegions.size()),
+                             copyRegions.data());
+
+      // Transfer queues do not support shader stages;
+      // so, shader reads are synchronized by the
+      // upload semaphore that frames wait for
       VkImageMemoryBarrier imageBarrierReadable = imageBarrierTransfer;
       imageBarrierReadable.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
       imageBarrierReadable.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
       imageBarrierReadable.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-      imageBarrierReadable.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+      imageBarrierReadable.dstAccessMask = 0;
 
       vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                           VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr,
+                           VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr,
                            0, nullptr, 1, &imageBarrierReadable);
     });
   }
 }
 
+VkMemoryRequirements VulkanTexture::getMemoryRequirements(
+    const TextureDescription &description, VulkanDeviceObject &device,
+    VulkanUploadContext &uploadContext, const glm::uvec2 &swapchainExtent) {
+  auto imageCreateInfo = getImageCreateInfo(
+      description, uploadContext.getQueueFamilies(), swapchainExtent);
+
+  VkImage image = VK_NULL_HANDLE;
+  checkForVulkanError(vkCreateImage(device, &imageCreateInfo, nullptr, &image),
+                      "Failed to create texture");
+
+  VkMemoryRequirements requirements{};
+  vkGetImageMemoryRequirements(device, image, &requirements);
+  vkDestroyImage(device, image, nullptr);
+
+  return requirements;
+}
+
 VulkanTexture::~VulkanTexture() {
   if (mSampler) {
     vkDestroySampler(mDevice, mSampler, nullptr);
@@ -194,6 +295,8 @@ VulkanTexture::~VulkanTexture() {
 
   if (mAllocation && mImage) {
     vmaDestroyImage(mAllocator, mImage, mAllocation);
+  } else if (mAliasedMemory && mImage) {
+    vkDestroyImage(mDevice, mImage, nullptr);
   }
 }
 
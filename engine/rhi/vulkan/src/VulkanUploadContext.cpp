@@ -1,75 +1,249 @@
 #include "liquid/core/Base.h"
 #include "liquid/core/EngineGlobals.h"
 
-#include "VulkanCommandBuffer.h"
 #include "VulkanUploadContext.h"
 #include "VulkanError.h"
 
 namespace liquid::rhi {
 
-VulkanUploadContext::VulkanUploadContext(VulkanDeviceObject &mDevice,
-                                         VulkanCommandPool &pool,
-                                         VulkanQueue &queue)
-    : mDevice(mDevice), mQueue(queue) {
+VulkanUploadContext::VulkanUploadContext(
+    VulkanDeviceObject &device, VulkanQueue &queue,
+    VulkanResourceAllocator &allocator,
+    const std::vector<uint32_t> &queueFamilies)
+    : mQueueFamilies(queueFamilies), mQueue(queue), mDevice(device),
+      mAllocator(allocator) {
+  VkCommandPoolCreateInfo poolInfo{};
+  poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+  poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+  poolInfo.queueFamilyIndex = mQueue.getQueueIndex();
 
-  mCommandList = std::move(pool.createCommandLists(1).at(0));
+  checkForVulkanError(
+      vkCreateCommandPool(mDevice, &poolInfo, nullptr, &mCommandPool),
+      "Failed to create upload command pool");
+
+  VkSemaphoreTypeCreateInfo semaphoreTypeInfo{};
+  semaphoreTypeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+  semaphoreTypeInfo.pNext = nullptr;
+  semaphoreTypeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+  semaphoreTypeInfo.initialValue = 0;
+
+  VkSemaphoreCreateInfo semaphoreInfo{};
+  semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+  semaphoreInfo.pNext = &semaphoreTypeInfo;
+  semaphoreInfo.flags = 0;
 
-  createFence();
+  checkForVulkanError(
+      vkCreateSemaphore(mDevice, &semaphoreInfo, nullptr, &mSemaphore),
+      "Failed to create upload semaphore");
+
+  LOG_DEBUG("[Vulkan] Upload context created");
 }
 
 VulkanUploadContext::~VulkanUploadContext() {
-  if (mUploadFence) {
-    vkDestroyFence(mDevice, mUploadFence, nullptr);
-    LOG_DEBUG("[Vulkan] Upload fence destroyed");
+  if (mSemaphore) {
+    wait(mSubmittedValue);
+    vkDestroySemaphore(mDevice, mSemaphore, nullptr);
   }
+
+  if (mCommandPool) {
+    vkDestroyCommandPool(mDevice, mCommandPool, nullptr);
+  }
+
+  LOG_DEBUG("[Vulkan] Upload context destroyed");
 }
 
-void VulkanUploadContext::submit(const SubmitFn &submitFn) const {
-  vkWaitForFences(mDevice, 1, &mUploadFence, true,
-                  std::numeric_limits<uint32_t>::max());
+void VulkanUploadContext::record(const RecordFn &recordFn) {
+  recordFn(beginBatch());
+}
 
-  vkResetFences(mDevice, 1, &mUploadFence);
+VulkanUploadContext::StagingRegion
+VulkanUploadContext::stage(const void *data, size_t size) {
+  size_t offset = allocateStagingRegion(size);
 
-  VkCommandBufferBeginInfo beginInfo{};
-  beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-  beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+  mStagingBuffer->update({BufferType::Transfer, mStagingBuffer->getSize(),
+                          const_cast<void *>(data), size, false, offset},
+                         0);
 
-  auto *commandBuffer = dynamic_cast<rhi::VulkanCommandBuffer *>(
-                            mCommandList.getNativeRenderCommandList().get())
-                            ->getVulkanCommandBuffer();
+  return {mStagingBuffer->getBuffer(), offset};
+}
 
-  checkForVulkanError(vkBeginCommandBuffer(commandBuffer, &beginInfo),
-                      "Failed to start recording command buffer for uploads");
+void VulkanUploadContext::uploadBuffer(VkBuffer buffer, size_t offset,
+                                       const void *data, size_t size) {
+  auto region = stage(data, size);
+
+  // Semaphore that frames wait for makes
+  // the written data visible; so, no
+  // barriers are needed after the copy
+  record([region, buffer, offset, size](VkCommandBuffer commandBuffer) {
+    VkBufferCopy copyRegion{};
+    copyRegion.srcOffset = region.offset;
+    copyRegion.dstOffset = offset;
+    copyRegion.size = size;
+    vkCmdCopyBuffer(commandBuffer, region.buffer, buffer, 1, &copyRegion);
+  });
+}
 
-  submitFn(commandBuffer);
+void VulkanUploadContext::copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer,
+                                     size_t size) {
+  record([srcBuffer, dstBuffer, size](VkCommandBuffer commandBuffer) {
+    // Source can be written by earlier
+    // uploads of the same batch
+    VkMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0,
+                         nullptr, 0, nullptr);
+
+    VkBufferCopy copyRegion{};
+    copyRegion.srcOffset = 0;
+    copyRegion.dstOffset = 0;
+    copyRegion.size = size;
+    vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
+  });
+}
 
-  checkForVulkanError(vkEndCommandBuffer(commandBuffer),
-                      "Failed to stop recording command buffer");
+void VulkanUploadContext::flush() {
+  if (mCurrentBatch >= mBatches.size()) {
+    return;
+  }
+
+  LIQUID_PROFILE_EVENT("VulkanUploadContext::flush");
 
-  VkSubmitInfo submitInfo{};
-  submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-  submitInfo.commandBufferCount = 1;
-  submitInfo.pCommandBuffers = &commandBuffer;
+  auto &batch = mBatches.at(mCurrentBatch);
+  checkForVulkanError(vkEndCommandBuffer(batch.commandBuffer),
+                      "Failed to stop recording command buffer for uploads");
 
-  vkQueueSubmit(mQueue, 1, &submitInfo, mUploadFence);
+  batch.value = ++mSubmittedValue;
 
-  vkWaitForFences(mDevice, 1, &mUploadFence, true,
-                  std::numeric_limits<uint32_t>::max());
+  VulkanSubmitInfo submitInfo{};
+  submitInfo.commandBuffers = {batch.commandBuffer};
+  submitInfo.signalSemaphores = {mSemaphore};
+  submitInfo.signalValues = {batch.value};
+  mQueue.submit(submitInfo);
 
-  vkResetCommandBuffer(commandBuffer, 0);
+  mCurrentBatch = std::numeric_limits<size_t>::max();
 }
 
-void VulkanUploadContext::createFence() {
-  VkFenceCreateInfo fenceInfo{};
-  fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-  fenceInfo.pNext = nullptr;
-  fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+void VulkanUploadContext::waitForIdle() {
+  flush();
+  wait(mSubmittedValue);
+}
 
-  checkForVulkanError(
-      vkCreateFence(mDevice, &fenceInfo, nullptr, &mUploadFence),
-      "Failed to create upload fence");
+uint64_t VulkanUploadContext::getCompletedValue() const {
+  uint64_t value = 0;
+  checkForVulkanError(vkGetSemaphoreCounterValue(mDevice, mSemaphore, &value),
+                      "Failed to get upload semaphore value");
+  return value;
+}
 
-  LOG_DEBUG("[Vulkan] Upload fence created");
+void VulkanUploadContext::wait(uint64_t value) const {
+  VkSemaphoreWaitInfo waitInfo{};
+  waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+  waitInfo.pNext = nullptr;
+  waitInfo.flags = 0;
+  waitInfo.semaphoreCount = 1;
+  waitInfo.pSemaphores = &mSemaphore;
+  waitInfo.pValues = &value;
+
+  checkForVulkanError(vkWaitSemaphores(mDevice, &waitInfo,
+                                       std::numeric_limits<uint64_t>::max()),
+                      "Failed to wait for uploads");
+}
+
+VkCommandBuffer VulkanUploadContext::beginBatch() {
+  if (mCurrentBatch < mBatches.size()) {
+    return mBatches.at(mCurrentBatch).commandBuffer;
+  }
+
+  uint64_t completedValue = getCompletedValue();
+  auto it = std::find_if(
+      mBatches.begin(), mBatches.end(),
+      [completedValue](const Batch &batch) {
+        return batch.value <= completedValue;
+      });
+
+  if (it != mBatches.end()) {
+    mCurrentBatch = static_cast<size_t>(std::distance(mBatches.begin(), it));
+    vkResetCommandBuffer(it->commandBuffer, 0);
+  } else {
+    VkCommandBufferAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.commandPool = mCommandPool;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandBufferCount = 1;
+
+    Batch batch{};
+    checkForVulkanError(
+        vkAllocateCommandBuffers(mDevice, &allocInfo, &batch.commandBuffer),
+        "Failed to allocate command buffer for uploads");
+
+    mCurrentBatch = mBatches.size();
+    mBatches.push_back(batch);
+  }
+
+  VkCommandBufferBeginInfo beginInfo{};
+  beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+  beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+  auto commandBuffer = mBatches.at(mCurrentBatch).commandBuffer;
+  checkForVulkanError(vkBeginCommandBuffer(commandBuffer, &beginInfo),
+                      "Failed to start recording command buffer for uploads");
+
+  return commandBuffer;
+}
+
+size_t VulkanUploadContext::allocateStagingRegion(size_t size) {
+  size_t stagingSize = mStagingBuffer ? mStagingBuffer->getSize() : 0;
+
+  if (stagingSize < size) {
+    // Old staging buffer can be destroyed
+    // only after its uploads are finished
+    waitForIdle();
+
+    stagingSize = std::max(stagingSize, DEFAULT_STAGING_SIZE);
+    while (stagingSize < size) {
+      stagingSize *= 2;
+    }
+
+    mStagingBuffer = std::make_unique<VulkanBuffer>(
+        BufferDescription{BufferType::Transfer, stagingSize}, mAllocator,
+        *this);
+    mStagingRanges.clear();
+    mStagingHead = 0;
+  }
+
+  while (true) {
+    size_t offset = mStagingHead + size <= stagingSize ? mStagingHead : 0;
+
+    uint64_t completedValue = getCompletedValue();
+    while (!mStagingRanges.empty() &&
+           mStagingRanges.front().value <= completedValue) {
+      mStagingRanges.pop_front();
+    }
+
+    bool overlaps = std::any_of(
+        mStagingRanges.begin(), mStagingRanges.end(),
+        [offset, size](const StagingRange &range) {
+          return range.start < offset + size && offset < range.end;
+        });
+
+    if (!overlaps) {
+      mStagingRanges.push_back({offset, offset + size, mSubmittedValue + 1});
+      mStagingHead = (offset + size + STAGING_ALIGNMENT - 1) /
+                     STAGING_ALIGNMENT * STAGING_ALIGNMENT;
+      return offset;
+    }
+
+    // Oldest range is released first; so,
+    // ring buffer is freed in write order
+    uint64_t value = mStagingRanges.front().value;
+    if (value > mSubmittedValue) {
+      flush();
+    }
+    wait(value);
+  }
 }
 
 } // namespace liquid::rhi
@@ -3,15 +3,17 @@
 
 namespace liquid {
 
-AnimationSystem::AnimationSystem(AssetRegistry &assetRegistry)
-    : mAssetRegistry(assetRegistry) {}
+AnimationSystem::AnimationSystem(AssetRegistry &assetRegistry,
+                                 JobSystem &jobSystem)
+    : mAssetRegistry(assetRegistry), mJobSystem(jobSystem) {}
 
 void AnimationSystem::update(float dt, EntityDatabase &entityDatabase) {
   LIQUID_PROFILE_EVENT("AnimationSystem::update");
   const auto &animMap = mAssetRegistry.getAnimations();
-  entityDatabase.iterateEntities<LocalTransformComponent, AnimatorComponent>(
-      [&entityDatabase, &animMap, this, dt](Entity entity, auto &transform,
-                                            auto &animComp) {
+  entityDatabase.parallelIterateEntities<LocalTransformComponent,
+                                         AnimatorComponent>(
+      mJobSystem, [&entityDatabase, &animMap, this,
+                   dt](Entity entity, auto &transform, auto &animComp) {
         auto handle = animComp.animations.at(animComp.currentAnimation);
 
         if (!animMap.hasAsset(handle)) {
@@ -32,6 +34,7 @@ void AnimationSystem::update(float dt, EntityDatabase &entityDatabase) {
 
         bool hasSkeleton =
             entityDatabase.hasComponent<SkeletonComponent>(entity);
+        bool transformChanged = false;
 
         for (const auto &sequence : animation.data.keyframes) {
           const auto &value = mKeyframeInterpolator.interpolate(
@@ -51,6 +54,7 @@ void AnimationSystem::update(float dt, EntityDatabase &entityDatabase) {
               skeleton.jointLocalScales.at(sequence.joint) = glm::vec3(value);
             }
           } else {
+            transformChanged = true;
             if (sequence.target == KeyframeSequenceAssetTarget::Position) {
               transform.localPosition = glm::vec3(value);
             } else if (sequence.target ==
@@ -62,6 +66,10 @@ void AnimationSystem::update(float dt, EntityDatabase &entityDatabase) {
             }
           }
         }
+
+        if (transformChanged) {
+          entityDatabase.markComponentChanged<LocalTransformComponent>(entity);
+        }
       });
 }
 
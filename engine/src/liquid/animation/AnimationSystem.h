@@ -2,6 +2,7 @@
 
 #include "liquid/entity/EntityDatabase.h"
 #include "liquid/asset/AssetRegistry.h"
+#include "liquid/core/JobSystem.h"
 #include "KeyframeInterpolator.h"
 
 namespace liquid {
@@ -15,8 +16,9 @@ public:
    * @brief Create animation system
    *
    * @param assetRegistry Asset registry
+   * @param jobSystem Job system
    */
-  AnimationSystem(AssetRegistry &assetRegistry);
+  AnimationSystem(AssetRegistry &assetRegistry, JobSystem &jobSystem);
 
   /**
    * @brief Update all animations
@@ -28,6 +30,7 @@ public:
 
 private:
   AssetRegistry &mAssetRegistry;
+  JobSystem &mJobSystem;
   KeyframeInterpolator mKeyframeInterpolator;
 };
 
@@ -26,7 +26,10 @@ public:
    * @brief Create texture from asset
    *
    * Create engine specific texture
-   * asset from any texture asset
+   * asset from any texture asset.
+   *
+   * Texture is compressed to UASTC
+   * with zstd supercompression
    *
    * @param asset Texture asset
    * @return Path to new texture asset
@@ -36,11 +39,26 @@ public:
   /**
    * @brief Load texture from file
    *
+   * Compressed textures are transcoded to
+   * a block compressed format that matches
+   * texture usage or to RGBA if the
+   * format is not supported
+   *
    * @param filePath Path to asset
    * @return Texture asset handle
    */
   Result<TextureAssetHandle> loadTextureFromFile(const Path &filePath);
 
+  /**
+   * @brief Set texture format support check
+   *
+   * All formats are supported by default
+   *
+   * @param isFormatSupported Returns true if format is supported
+   */
+  void setTextureFormatSupport(
+      const std::function<bool(uint32_t)> &isFormatSupported);
+
   /**
    * @brief Load font from file
    *
@@ -336,6 +354,14 @@ private:
                                 const Path &filePath);
 
 private:
+  /**
+   * @brief Get transcode format of compressed texture
+   *
+   * @param usage Texture usage
+   * @return KTX transcode format
+   */
+  uint32_t getTranscodeFormat(TextureAssetUsage usage) const;
+
   /**
    * @brief Get or load texture from path
    *
@@ -391,6 +417,7 @@ private:
 private:
   AssetRegistry mRegistry;
   Path mAssetsPath;
+  std::function<bool(uint32_t)> mIsTextureFormatSupported;
 };
 
 } // namespace liquid
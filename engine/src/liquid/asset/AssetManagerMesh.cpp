@@ -9,6 +9,30 @@
 
 namespace liquid {
 
+/**
+ * @brief Calculate bounding box of geometries
+ *
+ * @tparam TVertex Vertex type
+ * @param geometries Geometries
+ * @return Bounding box that contains all vertices
+ */
+template <class TVertex>
+static BoundingBox calculateBoundingBox(
+    const std::vector<BaseGeometryAsset<TVertex>> &geometries) {
+  BoundingBox box{glm::vec3{std::numeric_limits<float>::max()},
+                  glm::vec3{std::numeric_limits<float>::lowest()}};
+  bool empty = true;
+
+  for (const auto &geometry : geometries) {
+    for (const auto &vertex : geometry.vertices) {
+      box.extend({vertex.x, vertex.y, vertex.z});
+      empty = false;
+    }
+  }
+
+  return empty ? BoundingBox{} : box;
+}
+
 Result<Path>
 AssetManager::createMeshFromAsset(const AssetData<MeshAsset> &asset) {
   String extension = ".lqmesh";
@@ -140,6 +164,8 @@ AssetManager::loadMeshDataFromInputStream(InputBinaryStream &stream,
     }
   }
 
+  mesh.data.boundingBox = calculateBoundingBox(mesh.data.geometries);
+
   return Result<MeshAssetHandle>::Ok(mRegistry.getMeshes().addAsset(mesh),
                                      warnings);
 }
@@ -306,6 +332,8 @@ AssetManager::loadSkinnedMeshDataFromInputStream(InputBinaryStream &stream,
     }
   }
 
+  mesh.data.boundingBox = calculateBoundingBox(mesh.data.geometries);
+
   return Result<SkinnedMeshAssetHandle>::Ok(
       mRegistry.getSkinnedMeshes().addAsset(mesh), warnings);
 }
@@ -6,6 +6,7 @@
 #include "AssetFileHeader.h"
 #include "OutputBinaryStream.h"
 #include "InputBinaryStream.h"
+#include "TextureUtils.h"
 
 #include <ktx.h>
 #include <vulkan/vulkan.h>
@@ -14,8 +15,78 @@
 
 namespace liquid {
 
+/**
+ * Key of texture usage in KTX metadata
+ */
+static constexpr const char *TEXTURE_USAGE_KEY = "LiquidTextureUsage";
+
+/**
+ * Zstd supercompression level of textures
+ */
+static constexpr uint32_t TEXTURE_ZSTD_LEVEL = 18;
+
+/**
+ * @brief Get texture usage name
+ *
+ * @param usage Texture usage
+ * @return Texture usage name
+ */
+static String getTextureUsageName(TextureAssetUsage usage) {
+  switch (usage) {
+  case TextureAssetUsage::Normal:
+    return "normal";
+  case TextureAssetUsage::Data:
+    return "data";
+  case TextureAssetUsage::Color:
+  default:
+    return "color";
+  }
+}
+
+/**
+ * @brief Read texture usage from KTX metadata
+ *
+ * @param texture KTX texture
+ * @return Texture usage
+ */
+static TextureAssetUsage getTextureUsage(ktxTexture *texture) {
+  unsigned int length = 0;
+  void *value = nullptr;
+  if (ktxHashList_FindValue(&texture->kvDataHead, TEXTURE_USAGE_KEY, &length,
+                            &value) != KTX_SUCCESS ||
+      length == 0) {
+    return TextureAssetUsage::Color;
+  }
+
+  // Stored value includes the null terminator
+  String name(static_cast<const char *>(value), length - 1);
+  if (name == getTextureUsageName(TextureAssetUsage::Normal)) {
+    return TextureAssetUsage::Normal;
+  }
+
+  if (name == getTextureUsageName(TextureAssetUsage::Data)) {
+    return TextureAssetUsage::Data;
+  }
+
+  return TextureAssetUsage::Color;
+}
+
 Result<Path>
 AssetManager::createTextureFromAsset(const AssetData<TextureAsset> &asset) {
+  bool srgb = asset.data.usage == TextureAssetUsage::Color;
+
+  // Mip chain is generated once during import;
+  // so, loading textures does not need to do it
+  std::vector<TextureAssetLevel> levels = asset.data.levels;
+  std::vector<uint8_t> generatedData;
+  const uint8_t *data = static_cast<const uint8_t *>(asset.data.data);
+
+  if (levels.empty()) {
+    generatedData = generateMipmaps(data, asset.data.width, asset.data.height,
+                                    srgb, levels);
+    data = generatedData.data();
+  }
+
   ktxTextureCreateInfo createInfo{};
   createInfo.baseWidth = asset.data.width;
   createInfo.baseHeight = asset.data.height;
@@ -23,10 +94,11 @@ AssetManager::createTextureFromAsset(const AssetData<TextureAsset> &asset) {
   createInfo.numDimensions = 2;
   createInfo.numFaces = 1;
   createInfo.numLayers = 1;
-  createInfo.numLevels = 1;
+  createInfo.numLevels = static_cast<uint32_t>(levels.size());
   createInfo.isArray = KTX_FALSE;
   createInfo.generateMipmaps = KTX_FALSE;
-  createInfo.vkFormat = VK_FORMAT_R8G8B8A8_SRGB;
+  createInfo.vkFormat =
+      srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
 
   Path assetPath = (mAssetsPath / (asset.name + ".ktx2")).make_preferred();
 
@@ -45,9 +117,44 @@ AssetManager::createTextureFromAsset(const AssetData<TextureAsset> &asset) {
 
   auto *baseTexture = reinterpret_cast<ktxTexture *>(texture);
 
-  ktxTexture_SetImageFromMemory(
-      baseTexture, 0, 0, 0, static_cast<const ktx_uint8_t *>(asset.data.data),
-      asset.size);
+  for (size_t i = 0; i < levels.size(); ++i) {
+    const auto &level = levels.at(i);
+    ktxTexture_SetImageFromMemory(baseTexture, static_cast<ktx_uint32_t>(i), 0,
+                                  0, data + level.offset, level.size);
+  }
+
+  auto usageName = getTextureUsageName(asset.data.usage);
+  ktxHashList_AddKVPair(&baseTexture->kvDataHead, TEXTURE_USAGE_KEY,
+                        static_cast<unsigned int>(usageName.size() + 1),
+                        usageName.c_str());
+
+  {
+    ktxBasisParams params{};
+    params.structSize = sizeof(ktxBasisParams);
+    params.uastc = KTX_TRUE;
+    params.uastcFlags = KTX_PACK_UASTC_LEVEL_DEFAULT;
+    params.threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+    // Normal maps store X in color and Y in alpha;
+    // so, they can be transcoded to two channel formats
+    if (asset.data.usage == TextureAssetUsage::Normal) {
+      params.inputSwizzle[0] = 'r';
+      params.inputSwizzle[1] = 'r';
+      params.inputSwizzle[2] = 'r';
+      params.inputSwizzle[3] = 'g';
+    }
+
+    auto res = ktxTexture2_CompressBasisEx(texture, &params);
+    if (res == KTX_SUCCESS) {
+      res = ktxTexture2_DeflateZstd(texture, TEXTURE_ZSTD_LEVEL);
+    }
+
+    if (res != KTX_SUCCESS) {
+      ktxTexture_Destroy(baseTexture);
+      return Result<Path>::Error(
+          KtxError("Cannot compress KTX texture", res).what());
+    }
+  }
 
   {
     auto res =
@@ -87,8 +194,42 @@ AssetManager::loadTextureFromFile(const Path &filePath) {
         "Texture arrays are not supported");
   }
 
+  auto usage = getTextureUsage(ktxTextureData);
+  bool transcoded = false;
+
+  if (ktxTextureData->classId == ktxTexture2_c &&
+      ktxTexture2_NeedsTranscoding(
+          reinterpret_cast<ktxTexture2 *>(ktxTextureData))) {
+    result = ktxTexture2_TranscodeBasis(
+        reinterpret_cast<ktxTexture2 *>(ktxTextureData),
+        static_cast<ktx_transcode_fmt_e>(getTranscodeFormat(usage)), 0);
+
+    if (result != KTX_SUCCESS) {
+      ktxTexture_Destroy(ktxTextureData);
+      return Result<TextureAssetHandle>::Error(
+          KtxError("Cannot transcode KTX texture", result).what());
+    }
+
+    transcoded = true;
+  }
+
+  uint32_t numFaces = ktxTextureData->isCubemap ? CUBEMAP_SIDES : 1;
+
+  // Levels are stored from largest to smallest and
+  // faces of every level are stored next to each other
+  std::vector<TextureAssetLevel> levels(ktxTextureData->numLevels);
+  size_t size = 0;
+  for (uint32_t i = 0; i < ktxTextureData->numLevels; ++i) {
+    auto &level = levels.at(i);
+    level.offset = size;
+    level.size = ktxTexture_GetImageSize(ktxTextureData, i) * numFaces;
+    level.width = std::max(ktxTextureData->baseWidth >> i, 1u);
+    level.height = std::max(ktxTextureData->baseHeight >> i, 1u);
+    size += level.size;
+  }
+
   AssetData<TextureAsset> texture{};
-  texture.size = ktxTexture_GetDataSizeUncompressed(ktxTextureData);
+  texture.size = size;
   texture.path = filePath;
   texture.relativePath = std::filesystem::relative(filePath, mAssetsPath);
   texture.name = texture.relativePath.string();
@@ -102,21 +243,35 @@ AssetManager::loadTextureFromFile(const Path &filePath) {
   texture.data.format = ktxTexture_GetVkFormat(ktxTextureData);
 
   char *srcData = reinterpret_cast<char *>(ktxTexture_GetData(ktxTextureData));
+  char *dstData = static_cast<char *>(texture.data.data);
 
-  if (ktxTextureData->isCubemap) {
-    size_t faceSize = ktxTexture_GetImageSize(ktxTextureData, 0);
-
-    char *dstData = static_cast<char *>(texture.data.data);
+  for (uint32_t i = 0; i < ktxTextureData->numLevels; ++i) {
+    size_t faceSize = ktxTexture_GetImageSize(ktxTextureData, i);
 
-    for (size_t i = 0; i < CUBEMAP_SIDES; ++i) {
+    for (uint32_t face = 0; face < numFaces; ++face) {
       size_t offset = 0;
-      ktxTexture_GetImageOffset(ktxTextureData, 0, 0,
-                                static_cast<ktx_uint32_t>(i), &offset);
+      ktxTexture_GetImageOffset(ktxTextureData, i, 0, face, &offset);
 
-      memcpy(dstData + faceSize * i, srcData + offset, faceSize);
+      memcpy(dstData + levels.at(i).offset + faceSize * face, srcData + offset,
+             faceSize);
+    }
+  }
+
+  texture.data.levels = levels;
+  texture.data.usage = usage;
+
+  // Normal maps that are transcoded to RGBA store
+  // Y in alpha; so, it is moved to green channel
+  if (transcoded && usage == TextureAssetUsage::Normal &&
+      texture.data.format == VK_FORMAT_R8G8B8A8_UNORM) {
+    constexpr size_t CHANNELS = 4;
+    constexpr uint8_t MAX_ALPHA = 255;
+    auto *pixels = static_cast<uint8_t *>(texture.data.data);
+    for (size_t i = 0; i + CHANNELS <= texture.size; i += CHANNELS) {
+      pixels[i + 1] = pixels[i + 3];
+      pixels[i + 2] = 0;
+      pixels[i + 3] = MAX_ALPHA;
     }
-  } else {
-    memcpy(texture.data.data, srcData, texture.size);
   }
 
   ktxTexture_Destroy(ktxTextureData);
@@ -125,6 +280,30 @@ AssetManager::loadTextureFromFile(const Path &filePath) {
       mRegistry.getTextures().addAsset(texture));
 }
 
+void AssetManager::setTextureFormatSupport(
+    const std::function<bool(uint32_t)> &isFormatSupported) {
+  mIsTextureFormatSupported = isFormatSupported;
+}
+
+uint32_t AssetManager::getTranscodeFormat(TextureAssetUsage usage) const {
+  ktx_transcode_fmt_e format = KTX_TTF_BC7_RGBA;
+  VkFormat vkFormat = VK_FORMAT_BC7_SRGB_BLOCK;
+
+  if (usage == TextureAssetUsage::Normal) {
+    format = KTX_TTF_BC5_RG;
+    vkFormat = VK_FORMAT_BC5_UNORM_BLOCK;
+  } else if (usage == TextureAssetUsage::Data) {
+    format = KTX_TTF_BC1_RGB;
+    vkFormat = VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+  }
+
+  if (mIsTextureFormatSupported && !mIsTextureFormatSupported(vkFormat)) {
+    return KTX_TTF_RGBA32;
+  }
+
+  return format;
+}
+
 Result<TextureAssetHandle>
 AssetManager::getOrLoadTextureFromPath(StringView relativePath) {
   if (relativePath.empty()) {
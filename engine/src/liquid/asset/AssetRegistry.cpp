@@ -40,6 +40,11 @@ void AssetRegistry::syncWithDeviceRegistry(rhi::ResourceRegistry &registry) {
       description.size = texture.size;
       description.format = texture.data.format;
 
+      for (const auto &level : texture.data.levels) {
+        description.levels.push_back(
+            {level.offset, level.size, level.width, level.height});
+      }
+
       texture.data.deviceHandle = registry.setTexture(description);
     }
   }
@@ -107,33 +112,27 @@ void AssetRegistry::syncWithDeviceRegistry(rhi::ResourceRegistry &registry) {
 
   // Synchronize meshes
   for (auto &[_, mesh] : mMeshes.getAssets()) {
-    if (mesh.data.vertexBuffers.empty()) {
-      mesh.data.vertexBuffers.resize(mesh.data.geometries.size(),
-                                     rhi::BufferHandle::Invalid);
-      mesh.data.indexBuffers.resize(mesh.data.geometries.size(),
-                                    rhi::BufferHandle::Invalid);
+    // Geometries are only written to arenas once
+    if (mesh.data.vertexOffsets.empty()) {
+      mesh.data.vertexOffsets.resize(mesh.data.geometries.size(), 0);
+      mesh.data.indexOffsets.resize(mesh.data.geometries.size(), 0);
       mesh.data.materials.resize(mesh.data.geometries.size(), nullptr);
-    }
 
-    for (size_t i = 0; i < mesh.data.geometries.size(); ++i) {
-      auto &geometry = mesh.data.geometries.at(i);
+      for (size_t i = 0; i < mesh.data.geometries.size(); ++i) {
+        auto &geometry = mesh.data.geometries.at(i);
 
-      {
-        rhi::BufferDescription description;
-        description.type = rhi::BufferType::Vertex;
-        description.size = geometry.vertices.size() * sizeof(Vertex);
-        description.data = geometry.vertices.data();
-        mesh.data.vertexBuffers.at(i) = registry.setBuffer(description);
-      }
+        mesh.data.vertexOffsets.at(i) = mMeshVertexArena.allocate(
+            geometry.vertices.data(), geometry.vertices.size());
 
-      if (!geometry.indices.empty()) {
-        rhi::BufferDescription description;
-        description.type = rhi::BufferType::Index;
-        description.size = geometry.indices.size() * sizeof(uint32_t);
-        description.data = geometry.indices.data();
-        mesh.data.indexBuffers.at(i) = registry.setBuffer(description);
+        if (!geometry.indices.empty()) {
+          mesh.data.indexOffsets.at(i) = mMeshIndexArena.allocate(
+              geometry.indices.data(), geometry.indices.size());
+        }
       }
+    }
 
+    for (size_t i = 0; i < mesh.data.geometries.size(); ++i) {
+      auto &geometry = mesh.data.geometries.at(i);
       auto material = geometry.material != MaterialAssetHandle::Invalid
                           ? geometry.material
                           : mDefaultObjects.defaultMaterial;
@@ -144,33 +143,27 @@ void AssetRegistry::syncWithDeviceRegistry(rhi::ResourceRegistry &registry) {
 
   // Synchronize skinned meshes
   for (auto &[_, mesh] : mSkinnedMeshes.getAssets()) {
-    if (mesh.data.vertexBuffers.empty()) {
-      mesh.data.vertexBuffers.resize(mesh.data.geometries.size(),
-                                     rhi::BufferHandle::Invalid);
-      mesh.data.indexBuffers.resize(mesh.data.geometries.size(),
-                                    rhi::BufferHandle::Invalid);
+    // Geometries are only written to arenas once
+    if (mesh.data.vertexOffsets.empty()) {
+      mesh.data.vertexOffsets.resize(mesh.data.geometries.size(), 0);
+      mesh.data.indexOffsets.resize(mesh.data.geometries.size(), 0);
       mesh.data.materials.resize(mesh.data.geometries.size(), nullptr);
-    }
 
-    for (size_t i = 0; i < mesh.data.geometries.size(); ++i) {
-      auto &geometry = mesh.data.geometries.at(i);
+      for (size_t i = 0; i < mesh.data.geometries.size(); ++i) {
+        auto &geometry = mesh.data.geometries.at(i);
 
-      {
-        rhi::BufferDescription description;
-        description.type = rhi::BufferType::Vertex;
-        description.size = geometry.vertices.size() * sizeof(SkinnedVertex);
-        description.data = geometry.vertices.data();
-        mesh.data.vertexBuffers.at(i) = registry.setBuffer(description);
-      }
+        mesh.data.vertexOffsets.at(i) = mSkinnedMeshVertexArena.allocate(
+            geometry.vertices.data(), geometry.vertices.size());
 
-      if (!geometry.indices.empty()) {
-        rhi::BufferDescription description;
-        description.type = rhi::BufferType::Index;
-        description.size = geometry.indices.size() * sizeof(uint32_t);
-        description.data = geometry.indices.data();
-        mesh.data.indexBuffers.at(i) = registry.setBuffer(description);
+        if (!geometry.indices.empty()) {
+          mesh.data.indexOffsets.at(i) = mMeshIndexArena.allocate(
+              geometry.indices.data(), geometry.indices.size());
+        }
       }
+    }
 
+    for (size_t i = 0; i < mesh.data.geometries.size(); ++i) {
+      auto &geometry = mesh.data.geometries.at(i);
       auto material = geometry.material != MaterialAssetHandle::Invalid
                           ? geometry.material
                           : mDefaultObjects.defaultMaterial;
@@ -178,6 +171,10 @@ void AssetRegistry::syncWithDeviceRegistry(rhi::ResourceRegistry &registry) {
           mMaterials.getAsset(material).data.deviceHandle;
     }
   }
+
+  mMeshVertexArena.updateBuffer(registry);
+  mSkinnedMeshVertexArena.updateBuffer(registry);
+  mMeshIndexArena.updateBuffer(registry);
 }
 
 std::pair<AssetType, uint32_t>
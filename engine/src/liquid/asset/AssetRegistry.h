@@ -17,6 +17,7 @@
 #include "liquid/scene/SkinnedVertex.h"
 
 #include "liquid/rhi/ResourceRegistry.h"
+#include "liquid/renderer/MeshArena.h"
 
 namespace liquid {
 
@@ -150,6 +151,33 @@ public:
    */
   inline LuaScriptMap &getLuaScripts() { return mLuaScripts; }
 
+  /**
+   * @brief Get mesh vertex arena
+   *
+   * @return Vertices of all meshes
+   */
+  inline const MeshArena &getMeshVertexArena() const {
+    return mMeshVertexArena;
+  }
+
+  /**
+   * @brief Get skinned mesh vertex arena
+   *
+   * @return Vertices of all skinned meshes
+   */
+  inline const MeshArena &getSkinnedMeshVertexArena() const {
+    return mSkinnedMeshVertexArena;
+  }
+
+  /**
+   * @brief Get mesh index arena
+   *
+   * @return Indices of all meshes and skinned meshes
+   */
+  inline const MeshArena &getMeshIndexArena() const {
+    return mMeshIndexArena;
+  }
+
   /**
    * @brief Get asset located at path
    *
@@ -171,6 +199,11 @@ private:
   PrefabMap mPrefabs;
   LuaScriptMap mLuaScripts;
 
+  MeshArena mMeshVertexArena{rhi::BufferType::Vertex, sizeof(Vertex)};
+  MeshArena mSkinnedMeshVertexArena{rhi::BufferType::Vertex,
+                                    sizeof(SkinnedVertex)};
+  MeshArena mMeshIndexArena{rhi::BufferType::Index, sizeof(uint32_t)};
+
   DefaultObjects mDefaultObjects;
 };
 
@@ -79,6 +79,7 @@ AssetData<MeshAsset> createCube() {
   geometry.indices = indices;
   mesh.name = "__liquid.engine.defaultCube";
   mesh.data.geometries.push_back(geometry);
+  mesh.data.boundingBox = {glm::vec3{-1.0f}, glm::vec3{1.0f}};
 
   return mesh;
 
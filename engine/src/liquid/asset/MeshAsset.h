@@ -2,6 +2,7 @@
 
 #include "liquid/scene/Vertex.h"
 #include "liquid/scene/SkinnedVertex.h"
+#include "liquid/scene/BoundingBox.h"
 #include "liquid/rhi/RenderHandle.h"
 
 #include "Asset.h"
@@ -42,14 +43,19 @@ struct MeshAsset {
   std::vector<BaseGeometryAsset<Vertex>> geometries;
 
   /**
-   * List of vertex buffers
+   * Bounding box of all geometries
    */
-  std::vector<rhi::BufferHandle> vertexBuffers;
+  BoundingBox boundingBox;
 
   /**
-   * List of index buffers
+   * Offsets of geometry vertices in vertex arena
    */
-  std::vector<rhi::BufferHandle> indexBuffers;
+  std::vector<uint32_t> vertexOffsets;
+
+  /**
+   * Offsets of geometry indices in index arena
+   */
+  std::vector<uint32_t> indexOffsets;
 
   /**
    * List of materials
@@ -66,19 +72,26 @@ struct SkinnedMeshAsset {
    */
   std::vector<BaseGeometryAsset<SkinnedVertex>> geometries;
 
+  /**
+   * Bounding box of all geometries
+   *
+   * Calculated from vertices in bind pose
+   */
+  BoundingBox boundingBox;
+
   /**
    * Skeleton
    */
   SkeletonAssetHandle skeleton = SkeletonAssetHandle::Invalid;
   /**
-   * List of vertex buffers
+   * Offsets of geometry vertices in vertex arena
    */
-  std::vector<rhi::BufferHandle> vertexBuffers;
+  std::vector<uint32_t> vertexOffsets;
 
   /**
-   * List of index buffers
+   * Offsets of geometry indices in index arena
    */
-  std::vector<rhi::BufferHandle> indexBuffers;
+  std::vector<uint32_t> indexOffsets;
 
   /**
    * List of materials
@@ -6,8 +6,56 @@ namespace liquid {
 
 enum class TextureAssetType { Standard, Cubemap };
 
+/**
+ * @brief Texture asset usage
+ *
+ * Selects color space and compression
+ * format of imported textures
+ */
+enum class TextureAssetUsage {
+  /**
+   * sRGB color with alpha
+   */
+  Color,
+
+  /**
+   * Tangent space normal map
+   */
+  Normal,
+
+  /**
+   * Linear data (e.g occlusion, roughness, metallic)
+   */
+  Data
+};
+
 static constexpr uint32_t DEFAULT_TEXTURE_FORMAT = 43;
 
+/**
+ * @brief Texture asset mip level
+ */
+struct TextureAssetLevel {
+  /**
+   * Offset of level in texture data
+   */
+  size_t offset = 0;
+
+  /**
+   * Size of level with all layers
+   */
+  size_t size = 0;
+
+  /**
+   * Level width
+   */
+  uint32_t width = 0;
+
+  /**
+   * Level height
+   */
+  uint32_t height = 0;
+};
+
 /**
  * @brief Texture asset data
  */
@@ -32,6 +80,11 @@ struct TextureAsset {
    */
   TextureAssetType type = TextureAssetType::Standard;
 
+  /**
+   * Texture usage
+   */
+  TextureAssetUsage usage = TextureAssetUsage::Color;
+
   /**
    * Texture format
    */
@@ -42,6 +95,13 @@ struct TextureAsset {
    */
   void *data = nullptr;
 
+  /**
+   * Mip levels in texture data
+   *
+   * Texture only has the base level if empty
+   */
+  std::vector<TextureAssetLevel> levels;
+
   /**
    * Device handle
    */
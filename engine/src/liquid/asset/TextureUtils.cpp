@@ -0,0 +1,118 @@
+#include "liquid/core/Base.h"
+#include "TextureUtils.h"
+
+namespace liquid {
+
+static constexpr uint32_t CHANNELS = 4;
+static constexpr uint32_t ALPHA_CHANNEL = 3;
+static constexpr float MAX_COLOR = 255.0f;
+
+/**
+ * @brief Convert sRGB color to linear color
+ *
+ * @param value sRGB color in [0, 1] range
+ * @return Linear color
+ */
+static float srgbToLinear(float value) {
+  if (value <= 0.04045f) {
+    return value / 12.92f;
+  }
+
+  return std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+/**
+ * @brief Convert linear color to sRGB color
+ *
+ * @param value Linear color in [0, 1] range
+ * @return sRGB color
+ */
+static float linearToSrgb(float value) {
+  if (value <= 0.0031308f) {
+    return value * 12.92f;
+  }
+
+  return 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
+
+uint32_t getMipLevelCount(uint32_t width, uint32_t height) {
+  uint32_t size = std::max(width, height);
+  uint32_t count = 1;
+  while (size > 1) {
+    size /= 2;
+    count++;
+  }
+
+  return count;
+}
+
+std::vector<uint8_t> generateMipmaps(const uint8_t *data, uint32_t width,
+                                     uint32_t height, bool srgb,
+                                     std::vector<TextureAssetLevel> &levels) {
+  uint32_t levelCount = getMipLevelCount(width, height);
+
+  levels.clear();
+  levels.reserve(levelCount);
+
+  size_t totalSize = 0;
+  for (uint32_t i = 0; i < levelCount; ++i) {
+    uint32_t levelWidth = std::max(width >> i, 1u);
+    uint32_t levelHeight = std::max(height >> i, 1u);
+    size_t size = static_cast<size_t>(levelWidth) * levelHeight * CHANNELS;
+
+    levels.push_back({totalSize, size, levelWidth, levelHeight});
+    totalSize += size;
+  }
+
+  std::vector<uint8_t> pixels(totalSize);
+  memcpy(pixels.data(), data, levels.at(0).size);
+
+  std::array<float, 256> toLinear{};
+  for (size_t i = 0; i < toLinear.size(); ++i) {
+    float value = static_cast<float>(i) / MAX_COLOR;
+    toLinear.at(i) = srgb ? srgbToLinear(value) : value;
+  }
+
+  for (uint32_t i = 1; i < levelCount; ++i) {
+    const auto &src = levels.at(i - 1);
+    const auto &dst = levels.at(i);
+    const uint8_t *srcPixels = pixels.data() + src.offset;
+    uint8_t *dstPixels = pixels.data() + dst.offset;
+
+    for (uint32_t y = 0; y < dst.height; ++y) {
+      for (uint32_t x = 0; x < dst.width; ++x) {
+        // Odd sizes clamp to the last row or column
+        std::array<uint32_t, 2> xs{std::min(x * 2, src.width - 1),
+                                   std::min(x * 2 + 1, src.width - 1)};
+        std::array<uint32_t, 2> ys{std::min(y * 2, src.height - 1),
+                                   std::min(y * 2 + 1, src.height - 1)};
+
+        for (uint32_t c = 0; c < CHANNELS; ++c) {
+          float sum = 0.0f;
+          for (auto sy : ys) {
+            for (auto sx : xs) {
+              uint8_t value =
+                  srcPixels[(static_cast<size_t>(sy) * src.width + sx) *
+                                CHANNELS +
+                            c];
+              sum += c == ALPHA_CHANNEL ? value / MAX_COLOR
+                                        : toLinear.at(value);
+            }
+          }
+
+          float average = sum / 4.0f;
+          float color = c == ALPHA_CHANNEL || !srgb ? average
+                                                    : linearToSrgb(average);
+
+          dstPixels[(static_cast<size_t>(y) * dst.width + x) * CHANNELS + c] =
+              static_cast<uint8_t>(
+                  std::clamp(color, 0.0f, 1.0f) * MAX_COLOR + 0.5f);
+        }
+      }
+    }
+  }
+
+  return pixels;
+}
+
+} // namespace liquid
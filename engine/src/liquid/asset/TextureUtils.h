@@ -0,0 +1,35 @@
+#pragma once
+
+#include "TextureAsset.h"
+
+namespace liquid {
+
+/**
+ * @brief Get number of levels in full mip chain
+ *
+ * @param width Base level width
+ * @param height Base level height
+ * @return Number of mip levels
+ */
+uint32_t getMipLevelCount(uint32_t width, uint32_t height);
+
+/**
+ * @brief Generate mip chain of RGBA8 image
+ *
+ * Every level is downsampled from the previous
+ * one with a box filter. sRGB colors are averaged
+ * in linear space to keep brightness of minified
+ * textures; alpha is averaged as is.
+ *
+ * @param data Base level pixels
+ * @param width Base level width
+ * @param height Base level height
+ * @param srgb Colors are in sRGB space
+ * @param levels Generated mip levels
+ * @return Pixels of all levels starting from base level
+ */
+std::vector<uint8_t> generateMipmaps(const uint8_t *data, uint32_t width,
+                                     uint32_t height, bool srgb,
+                                     std::vector<TextureAssetLevel> &levels);
+
+} // namespace liquid
@@ -37,6 +37,12 @@
 #include <variant>
 #include <random>
 #include <string_view>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <typeindex>
 
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
 #include <glm/glm.hpp>
@@ -10,4 +10,10 @@ void Engine::setAssetsPath(const String &path) { engine.mAssetsPath = path; }
 
 const String &Engine::getAssetsPath() { return engine.mAssetsPath; }
 
+void Engine::setUserDataPath(const String &path) {
+  engine.mUserDataPath = path;
+}
+
+const String &Engine::getUserDataPath() { return engine.mUserDataPath; }
+
 } // namespace liquid
@@ -30,6 +30,23 @@ public:
    */
   static const String &getAssetsPath();
 
+  /**
+   * @brief Set user data path for engine
+   *
+   * Files that are generated by the
+   * engine are written to this path
+   *
+   * @param path User data path
+   */
+  static void setUserDataPath(const String &path);
+
+  /**
+   * @brief Get user data path for engine
+   *
+   * @return User data path
+   */
+  static const String &getUserDataPath();
+
 private:
   /**
    * @brief Create engine
@@ -41,6 +58,7 @@ private:
 
 private:
   String mAssetsPath;
+  String mUserDataPath;
 };
 
 } // namespace liquid
@@ -10,12 +10,12 @@ void EntityDeleter::update(EntityDatabase &entityDatabase) {
   std::vector<Entity> deleteList;
   deleteList.reserve(count);
 
-  entityDatabase.iterateEntities<liquid::DeleteComponent>(
-      [&deleteList](auto entity, auto &) { deleteList.push_back(entity); });
+  entityDatabase.iterateEntities<const liquid::DeleteComponent>(
+      [&deleteList](auto entity, const auto &) {
+        deleteList.push_back(entity);
+      });
 
-  for (auto entity : deleteList) {
-    entityDatabase.deleteEntity(entity);
-  }
+  entityDatabase.deleteEntities(deleteList);
 }
 
 } // namespace liquid
@@ -0,0 +1,128 @@
+#include "liquid/core/Base.h"
+#include "FreeListAllocator.h"
+
+namespace liquid {
+
+FreeListAllocator::FreeListAllocator(size_t capacity) : mCapacity(capacity) {
+  if (capacity > 0) {
+    addFreeBlock(0, capacity);
+  }
+}
+
+size_t FreeListAllocator::allocate(size_t size) {
+  LIQUID_ASSERT(size > 0, "Cannot allocate empty range");
+
+  // Smallest free block that fits the size
+  auto it = mFreeBlocksBySize.lower_bound(size);
+  if (it == mFreeBlocksBySize.end()) {
+    return INVALID_OFFSET;
+  }
+
+  auto [blockSize, offset] = *it;
+  removeFreeBlock(offset);
+
+  if (blockSize > size) {
+    addFreeBlock(offset + size, blockSize - size);
+  }
+
+  mAllocations.insert({offset, size});
+  mUsedSize += size;
+  return offset;
+}
+
+void FreeListAllocator::free(size_t offset) {
+  auto allocation = mAllocations.find(offset);
+  LIQUID_ASSERT(allocation != mAllocations.end(),
+                "Cannot free range that is not allocated");
+
+  size_t size = allocation->second;
+  mAllocations.erase(allocation);
+  mUsedSize -= size;
+
+  // Merge with the next free block
+  auto next = mFreeBlocks.find(offset + size);
+  if (next != mFreeBlocks.end()) {
+    size += next->second;
+    removeFreeBlock(next->first);
+  }
+
+  // Merge with the previous free block
+  auto prev = mFreeBlocks.lower_bound(offset);
+  if (prev != mFreeBlocks.begin()) {
+    --prev;
+    if (prev->first + prev->second == offset) {
+      offset = prev->first;
+      size += prev->second;
+      removeFreeBlock(offset);
+    }
+  }
+
+  addFreeBlock(offset, size);
+}
+
+void FreeListAllocator::grow(size_t capacity) {
+  LIQUID_ASSERT(capacity >= mCapacity, "Allocator cannot shrink");
+  if (capacity == mCapacity) {
+    return;
+  }
+
+  size_t offset = mCapacity;
+  size_t size = capacity - mCapacity;
+  mCapacity = capacity;
+
+  // Extend the last free block if it ends
+  // at the end of the previous capacity
+  if (!mFreeBlocks.empty()) {
+    auto last = std::prev(mFreeBlocks.end());
+    if (last->first + last->second == offset) {
+      offset = last->first;
+      size += last->second;
+      removeFreeBlock(offset);
+    }
+  }
+
+  addFreeBlock(offset, size);
+}
+
+size_t FreeListAllocator::getLargestFreeBlock() const {
+  return mFreeBlocksBySize.empty() ? 0 : mFreeBlocksBySize.rbegin()->first;
+}
+
+size_t FreeListAllocator::getEnd() const {
+  if (mAllocations.empty()) {
+    return 0;
+  }
+
+  auto last = mAllocations.rbegin();
+  return last->first + last->second;
+}
+
+float FreeListAllocator::getFragmentation() const {
+  size_t freeSize = mCapacity - mUsedSize;
+  if (freeSize == 0) {
+    return 0.0f;
+  }
+
+  return 1.0f - static_cast<float>(getLargestFreeBlock()) /
+                    static_cast<float>(freeSize);
+}
+
+void FreeListAllocator::addFreeBlock(size_t offset, size_t size) {
+  mFreeBlocks.insert({offset, size});
+  mFreeBlocksBySize.insert({size, offset});
+}
+
+void FreeListAllocator::removeFreeBlock(size_t offset) {
+  auto block = mFreeBlocks.find(offset);
+  auto range = mFreeBlocksBySize.equal_range(block->second);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == offset) {
+      mFreeBlocksBySize.erase(it);
+      break;
+    }
+  }
+
+  mFreeBlocks.erase(block);
+}
+
+} // namespace liquid
@@ -0,0 +1,135 @@
+#pragma once
+
+namespace liquid {
+
+/**
+ * @brief Free list allocator
+ *
+ * Allocates ranges from a contiguous space
+ * without owning any memory. Free blocks are
+ * searched by size to find the best fit and
+ * neighbouring free blocks are merged when a
+ * range is freed.
+ */
+class FreeListAllocator {
+public:
+  /**
+   * Offset that is returned if allocation fails
+   */
+  static constexpr size_t INVALID_OFFSET = std::numeric_limits<size_t>::max();
+
+public:
+  /**
+   * @brief Create allocator
+   *
+   * @param capacity Size of allocatable space
+   */
+  FreeListAllocator(size_t capacity = 0);
+
+  /**
+   * @brief Allocate range
+   *
+   * @param size Range size
+   * @return Range offset or INVALID_OFFSET if range does not fit
+   */
+  size_t allocate(size_t size);
+
+  /**
+   * @brief Free range
+   *
+   * @param offset Range offset
+   */
+  void free(size_t offset);
+
+  /**
+   * @brief Grow allocatable space
+   *
+   * Existing allocations keep their offsets
+   *
+   * @param capacity New capacity
+   */
+  void grow(size_t capacity);
+
+  /**
+   * @brief Get capacity
+   *
+   * @return Size of allocatable space
+   */
+  inline size_t getCapacity() const { return mCapacity; }
+
+  /**
+   * @brief Get used size
+   *
+   * @return Size of all allocated ranges
+   */
+  inline size_t getUsedSize() const { return mUsedSize; }
+
+  /**
+   * @brief Get number of allocations
+   *
+   * @return Number of allocations
+   */
+  inline size_t getNumAllocations() const { return mAllocations.size(); }
+
+  /**
+   * @brief Get number of free blocks
+   *
+   * @return Number of free blocks
+   */
+  inline size_t getNumFreeBlocks() const { return mFreeBlocks.size(); }
+
+  /**
+   * @brief Get size of largest free block
+   *
+   * @return Size of largest free block
+   */
+  size_t getLargestFreeBlock() const;
+
+  /**
+   * @brief Get end of allocated space
+   *
+   * Nothing is allocated after this offset
+   *
+   * @return End of last allocated range
+   */
+  size_t getEnd() const;
+
+  /**
+   * @brief Get fragmentation
+   *
+   * Ratio of free space that is not
+   * in the largest free block
+   *
+   * @return Fragmentation between zero and one
+   */
+  float getFragmentation() const;
+
+private:
+  /**
+   * @brief Add free block
+   *
+   * @param offset Block offset
+   * @param size Block size
+   */
+  void addFreeBlock(size_t offset, size_t size);
+
+  /**
+   * @brief Remove free block
+   *
+   * @param offset Block offset
+   */
+  void removeFreeBlock(size_t offset);
+
+private:
+  size_t mCapacity = 0;
+  size_t mUsedSize = 0;
+
+  // Offset to size
+  std::map<size_t, size_t> mFreeBlocks;
+  std::map<size_t, size_t> mAllocations;
+
+  // Size to offset
+  std::multimap<size_t, size_t> mFreeBlocksBySize;
+};
+
+} // namespace liquid
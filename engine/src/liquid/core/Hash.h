@@ -0,0 +1,25 @@
+#pragma once
+
+namespace liquid {
+
+/**
+ * @brief Combine hash with value
+ *
+ * Result depends on the order of
+ * combined values
+ *
+ * @tparam TValue Value type
+ * @param seed Hash
+ * @param value Value
+ */
+template <class TValue>
+inline void hashCombine(uint64_t &seed, const TValue &value) {
+  constexpr uint64_t GOLDEN_RATIO = 0x9e3779b97f4a7c15;
+  constexpr uint64_t LEFT_SHIFT = 6;
+  constexpr uint64_t RIGHT_SHIFT = 2;
+
+  seed ^= static_cast<uint64_t>(std::hash<TValue>{}(value)) + GOLDEN_RATIO +
+          (seed << LEFT_SHIFT) + (seed >> RIGHT_SHIFT);
+}
+
+} // namespace liquid
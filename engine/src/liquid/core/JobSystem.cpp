@@ -0,0 +1,201 @@
+#include "liquid/core/Base.h"
+#include "JobSystem.h"
+
+namespace liquid {
+
+/**
+ * Number of chunks per thread
+ *
+ * Having more than one chunk per thread
+ * evens out uneven chunks
+ */
+static constexpr size_t CHUNKS_PER_THREAD = 4;
+
+/**
+ * Job system that owns the current thread
+ */
+static thread_local const JobSystem *sCurrentJobSystem = nullptr;
+
+/**
+ * Queue index of the current thread
+ */
+static thread_local size_t sCurrentQueueIndex = 0;
+
+JobSystem::JobSystem(uint32_t numWorkers) : mNumWorkers(numWorkers) {
+  // Last queue is shared by threads
+  // that are not workers
+  mQueues.reserve(static_cast<size_t>(numWorkers) + 1);
+  for (uint32_t i = 0; i <= numWorkers; ++i) {
+    mQueues.push_back(std::make_unique<JobQueue>());
+  }
+
+  mWorkers.reserve(numWorkers);
+  for (uint32_t i = 0; i < numWorkers; ++i) {
+    mWorkers.emplace_back([this, i]() { work(i); });
+  }
+}
+
+JobSystem::~JobSystem() {
+  {
+    std::lock_guard<std::mutex> lock(mSleepMutex);
+    mStopped = true;
+  }
+  mCondition.notify_all();
+
+  for (auto &worker : mWorkers) {
+    worker.join();
+  }
+}
+
+uint32_t JobSystem::getDefaultWorkerCount() {
+  auto count = std::thread::hardware_concurrency();
+  return count > 1 ? count - 1 : 0;
+}
+
+void JobSystem::submit(std::function<void()> &&job) {
+  auto &queue = *mQueues.at(getCurrentQueueIndex());
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.jobs.push_back(std::move(job));
+  }
+  mPendingJobs++;
+
+  wakeWorkers(1);
+}
+
+void JobSystem::wait(const std::atomic<size_t> &counter) {
+  size_t queueIndex = getCurrentQueueIndex();
+  while (counter > 0) {
+    if (runNextJob(queueIndex)) {
+      continue;
+    }
+
+    // Remaining jobs are run by other threads;
+    // so, sleep until a job finishes or a new
+    // job is submitted
+    std::unique_lock<std::mutex> lock(mSleepMutex);
+    mNumWaitingThreads++;
+    mCondition.wait(lock, [this, &counter]() {
+      return counter == 0 || mPendingJobs > 0;
+    });
+    mNumWaitingThreads--;
+  }
+}
+
+void JobSystem::parallelFor(size_t count, size_t minChunkSize,
+                            const std::function<void(size_t, size_t)> &fn) {
+  if (count == 0) {
+    return;
+  }
+
+  size_t numThreads = static_cast<size_t>(mNumWorkers) + 1;
+  size_t chunkSize =
+      std::max(std::max(minChunkSize, size_t{1}),
+               (count + numThreads * CHUNKS_PER_THREAD - 1) /
+                   (numThreads * CHUNKS_PER_THREAD));
+  size_t numChunks = (count + chunkSize - 1) / chunkSize;
+
+  if (numChunks == 1 || mNumWorkers == 0) {
+    fn(0, count);
+    return;
+  }
+
+  std::atomic<size_t> remaining{numChunks};
+
+  auto &queue = *mQueues.at(getCurrentQueueIndex());
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    for (size_t i = 0; i < numChunks; ++i) {
+      size_t begin = i * chunkSize;
+      size_t end = std::min(begin + chunkSize, count);
+      queue.jobs.push_back([&fn, &remaining, begin, end]() {
+        fn(begin, end);
+        remaining--;
+      });
+    }
+  }
+  mPendingJobs += numChunks;
+
+  wakeWorkers(numChunks);
+  wait(remaining);
+}
+
+void JobSystem::work(size_t queueIndex) {
+  sCurrentJobSystem = this;
+  sCurrentQueueIndex = queueIndex;
+
+  while (true) {
+    if (runNextJob(queueIndex)) {
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(mSleepMutex);
+    mCondition.wait(lock, [this]() { return mStopped || mPendingJobs > 0; });
+
+    if (mStopped && mPendingJobs == 0) {
+      return;
+    }
+  }
+}
+
+bool JobSystem::runNextJob(size_t queueIndex) {
+  std::function<void()> job;
+
+  // Newest job of own queue is likely
+  // to still be in cache
+  {
+    auto &queue = *mQueues.at(queueIndex);
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.jobs.empty()) {
+      job = std::move(queue.jobs.back());
+      queue.jobs.pop_back();
+    }
+  }
+
+  for (size_t i = 1; !job && i < mQueues.size(); ++i) {
+    auto &queue = *mQueues.at((queueIndex + i) % mQueues.size());
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.jobs.empty()) {
+      job = std::move(queue.jobs.front());
+      queue.jobs.pop_front();
+    }
+  }
+
+  if (!job) {
+    return false;
+  }
+
+  mPendingJobs--;
+  job();
+
+  // Finished job can release waiting threads
+  if (mNumWaitingThreads > 0) {
+    { std::lock_guard<std::mutex> lock(mSleepMutex); }
+    mCondition.notify_all();
+  }
+
+  return true;
+}
+
+size_t JobSystem::getCurrentQueueIndex() const {
+  return sCurrentJobSystem == this ? sCurrentQueueIndex
+                                   : static_cast<size_t>(mNumWorkers);
+}
+
+void JobSystem::wakeWorkers(size_t numJobs) {
+  if (mNumWorkers == 0) {
+    return;
+  }
+
+  // Locking makes sure that workers that are
+  // about to sleep see the pending jobs
+  { std::lock_guard<std::mutex> lock(mSleepMutex); }
+
+  if (numJobs == 1) {
+    mCondition.notify_one();
+  } else {
+    mCondition.notify_all();
+  }
+}
+
+} // namespace liquid
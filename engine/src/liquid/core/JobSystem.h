@@ -0,0 +1,155 @@
+#pragma once
+
+namespace liquid {
+
+/**
+ * @brief Job system
+ *
+ * Runs jobs on a pool of worker threads. Every
+ * worker owns a job queue; jobs submitted from
+ * a worker are added to its own queue and idle
+ * workers steal jobs from other queues.
+ */
+class JobSystem {
+public:
+  /**
+   * @brief Create job system
+   *
+   * If there are no workers, all jobs
+   * are run by the waiting thread
+   *
+   * @param numWorkers Number of worker threads
+   */
+  JobSystem(uint32_t numWorkers = getDefaultWorkerCount());
+
+  /**
+   * @brief Destroy job system
+   *
+   * Waits for all workers to finish
+   */
+  ~JobSystem();
+
+  JobSystem(const JobSystem &) = delete;
+  JobSystem(JobSystem &&) = delete;
+  JobSystem &operator=(const JobSystem &) = delete;
+  JobSystem &operator=(JobSystem &&) = delete;
+
+  /**
+   * @brief Submit job
+   *
+   * @param job Job
+   */
+  void submit(std::function<void()> &&job);
+
+  /**
+   * @brief Run jobs until counter reaches zero
+   *
+   * Calling thread runs jobs instead of
+   * blocking; so, it is safe to call this
+   * function from inside a job. If there
+   * are no jobs left, calling thread sleeps
+   * until a job finishes or is submitted.
+   *
+   * @param counter Counter that is decremented by jobs
+   */
+  void wait(const std::atomic<size_t> &counter);
+
+  /**
+   * @brief Run function over range in parallel
+   *
+   * Splits the range into chunks and runs
+   * every chunk as a separate job. Calling
+   * thread also runs jobs until all chunks
+   * are processed.
+   *
+   * @param count Number of items
+   * @param minChunkSize Minimum number of items in a chunk
+   * @param fn Function that processes items in [begin, end)
+   */
+  void parallelFor(size_t count, size_t minChunkSize,
+                   const std::function<void(size_t, size_t)> &fn);
+
+  /**
+   * @brief Get number of worker threads
+   *
+   * @return Number of worker threads
+   */
+  inline uint32_t getWorkerCount() const { return mNumWorkers; }
+
+  /**
+   * @brief Get default number of workers
+   *
+   * Calling thread also runs jobs; so,
+   * one hardware thread is left for it
+   *
+   * @return Default number of workers
+   */
+  static uint32_t getDefaultWorkerCount();
+
+private:
+  /**
+   * @brief Job queue
+   */
+  struct JobQueue {
+    /**
+     * Jobs
+     */
+    std::deque<std::function<void()>> jobs;
+
+    /**
+     * Queue mutex
+     */
+    std::mutex mutex;
+  };
+
+private:
+  /**
+   * @brief Worker loop
+   *
+   * @param queueIndex Queue index of the worker
+   */
+  void work(size_t queueIndex);
+
+  /**
+   * @brief Run one job
+   *
+   * Takes the newest job from the given
+   * queue or steals the oldest job from
+   * other queues
+   *
+   * @param queueIndex Queue index of the calling thread
+   * @retval true Job is run
+   * @retval false There are no jobs
+   */
+  bool runNextJob(size_t queueIndex);
+
+  /**
+   * @brief Get queue index of calling thread
+   *
+   * Threads that are not workers of this
+   * job system share the last queue
+   *
+   * @return Queue index
+   */
+  size_t getCurrentQueueIndex() const;
+
+  /**
+   * @brief Wake up sleeping workers
+   *
+   * @param numJobs Number of new jobs
+   */
+  void wakeWorkers(size_t numJobs);
+
+private:
+  uint32_t mNumWorkers = 0;
+  std::vector<std::thread> mWorkers;
+  std::vector<std::unique_ptr<JobQueue>> mQueues;
+  std::atomic<size_t> mPendingJobs{0};
+
+  std::mutex mSleepMutex;
+  std::condition_variable mCondition;
+  std::atomic<uint32_t> mNumWaitingThreads{0};
+  bool mStopped = false;
+};
+
+} // namespace liquid
@@ -0,0 +1,108 @@
+#include "liquid/core/Base.h"
+#include "TaskGraph.h"
+
+namespace liquid {
+
+/**
+ * @brief Check if two component lists intersect
+ *
+ * @param a First list
+ * @param b Second list
+ * @retval true Lists have common components
+ * @retval false Lists do not have common components
+ */
+static bool intersects(const std::vector<std::type_index> &a,
+                       const std::vector<std::type_index> &b) {
+  for (const auto &type : a) {
+    if (std::find(b.begin(), b.end(), type) != b.end()) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+size_t TaskGraph::addTask(StringView name, TaskFn &&fn) {
+  return addTask(Task{String(name), std::move(fn)});
+}
+
+size_t TaskGraph::addTask(Task &&task) {
+  size_t index = mTasks.size();
+
+  for (size_t i = 0; i < mTasks.size(); ++i) {
+    if (conflicts(mTasks.at(i), task)) {
+      mTasks.at(i).dependents.push_back(index);
+      task.numDependencies++;
+    }
+  }
+
+  mTasks.push_back(std::move(task));
+  return index;
+}
+
+void TaskGraph::execute(float dt, EntityDatabase &entityDatabase,
+                        JobSystem &jobSystem) {
+  if (jobSystem.getWorkerCount() == 0) {
+    execute(dt, entityDatabase);
+    return;
+  }
+
+  LIQUID_PROFILE_EVENT("TaskGraph::execute");
+
+  ExecutionState state{dt, entityDatabase, jobSystem,
+                       std::vector<std::atomic<size_t>>(mTasks.size()),
+                       mTasks.size()};
+
+  for (size_t i = 0; i < mTasks.size(); ++i) {
+    state.remainingDependencies.at(i) = mTasks.at(i).numDependencies;
+  }
+
+  for (size_t i = 0; i < mTasks.size(); ++i) {
+    if (mTasks.at(i).numDependencies == 0) {
+      jobSystem.submit([this, i, &state]() { runTask(i, state); });
+    }
+  }
+
+  jobSystem.wait(state.remainingTasks);
+}
+
+void TaskGraph::execute(float dt, EntityDatabase &entityDatabase) {
+  LIQUID_PROFILE_EVENT("TaskGraph::execute");
+
+  // Dependencies are always added before
+  // their dependents; so, order of addition
+  // satisfies all dependencies
+  for (auto &task : mTasks) {
+    task.fn(dt, entityDatabase);
+  }
+}
+
+bool TaskGraph::dependsOn(size_t task, size_t dependency) const {
+  const auto &dependents = mTasks.at(dependency).dependents;
+  return std::find(dependents.begin(), dependents.end(), task) !=
+         dependents.end();
+}
+
+void TaskGraph::runTask(size_t index, ExecutionState &state) {
+  auto &task = mTasks.at(index);
+  task.fn(state.dt, state.entityDatabase);
+
+  for (auto dependent : task.dependents) {
+    if (--state.remainingDependencies.at(dependent) == 0) {
+      state.jobSystem.submit(
+          [this, dependent, &state]() { runTask(dependent, state); });
+    }
+  }
+
+  state.remainingTasks--;
+}
+
+bool TaskGraph::conflicts(const Task &a, const Task &b) {
+  bool aExclusive = a.reads.empty() && a.writes.empty();
+  bool bExclusive = b.reads.empty() && b.writes.empty();
+
+  return aExclusive || bExclusive || intersects(a.writes, b.writes) ||
+         intersects(a.writes, b.reads) || intersects(a.reads, b.writes);
+}
+
+} // namespace liquid
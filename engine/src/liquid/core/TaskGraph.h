@@ -0,0 +1,207 @@
+#pragma once
+
+#include "liquid/entity/EntityDatabase.h"
+#include "JobSystem.h"
+
+namespace liquid {
+
+/**
+ * @brief Task graph
+ *
+ * Runs systems as tasks. Every task declares
+ * components that it reads and writes. A task
+ * depends on all previously added tasks that
+ * conflict with it; tasks that do not depend
+ * on each other run concurrently.
+ */
+class TaskGraph {
+public:
+  /**
+   * @brief Task function
+   */
+  using TaskFn = std::function<void(float, EntityDatabase &)>;
+
+  /**
+   * @brief Components that task reads
+   *
+   * @tparam TComponents Component types
+   */
+  template <class... TComponents> struct Reads {};
+
+  /**
+   * @brief Components that task writes
+   *
+   * @tparam TComponents Component types
+   */
+  template <class... TComponents> struct Writes {};
+
+public:
+  /**
+   * @brief Add exclusive task
+   *
+   * Exclusive task does not run concurrently
+   * with any other task. Use it for systems
+   * that create or delete entities.
+   *
+   * @param name Task name
+   * @param fn Task function
+   * @return Task index
+   */
+  size_t addTask(StringView name, TaskFn &&fn);
+
+  /**
+   * @brief Add task
+   *
+   * @tparam TReads Components that task reads
+   * @tparam TWrites Components that task writes
+   * @param name Task name
+   * @param fn Task function
+   * @return Task index
+   */
+  template <class... TReads, class... TWrites>
+  size_t addTask(StringView name, Reads<TReads...>, Writes<TWrites...>,
+                 TaskFn &&fn) {
+    Task task{String(name), std::move(fn)};
+    task.reads = {std::type_index(typeid(TReads))...};
+    task.writes = {std::type_index(typeid(TWrites))...};
+    return addTask(std::move(task));
+  }
+
+  /**
+   * @brief Execute tasks
+   *
+   * Runs tasks in order of dependencies.
+   * Runs tasks in order of addition if
+   * job system has no workers.
+   *
+   * @param dt Time delta
+   * @param entityDatabase Entity database
+   * @param jobSystem Job system
+   */
+  void execute(float dt, EntityDatabase &entityDatabase, JobSystem &jobSystem);
+
+  /**
+   * @brief Execute tasks in order of addition
+   *
+   * Runs all tasks on calling thread
+   *
+   * @param dt Time delta
+   * @param entityDatabase Entity database
+   */
+  void execute(float dt, EntityDatabase &entityDatabase);
+
+  /**
+   * @brief Check if task depends on another task
+   *
+   * @param task Task index
+   * @param dependency Dependency task index
+   * @retval true Task depends on dependency
+   * @retval false Task does not depend on dependency
+   */
+  bool dependsOn(size_t task, size_t dependency) const;
+
+  /**
+   * @brief Get number of tasks
+   *
+   * @return Number of tasks
+   */
+  inline size_t getTaskCount() const { return mTasks.size(); }
+
+private:
+  /**
+   * @brief Task
+   */
+  struct Task {
+    /**
+     * Task name
+     */
+    String name;
+
+    /**
+     * Task function
+     */
+    TaskFn fn;
+
+    /**
+     * Read components
+     */
+    std::vector<std::type_index> reads;
+
+    /**
+     * Written components
+     */
+    std::vector<std::type_index> writes;
+
+    /**
+     * Tasks that depend on this task
+     */
+    std::vector<size_t> dependents;
+
+    /**
+     * Number of dependencies
+     */
+    size_t numDependencies = 0;
+  };
+
+  /**
+   * @brief Task execution state
+   */
+  struct ExecutionState {
+    /**
+     * Time delta
+     */
+    float dt;
+
+    /**
+     * Entity database
+     */
+    EntityDatabase &entityDatabase;
+
+    /**
+     * Job system
+     */
+    JobSystem &jobSystem;
+
+    /**
+     * Remaining dependencies of every task
+     */
+    std::vector<std::atomic<size_t>> remainingDependencies;
+
+    /**
+     * Number of unfinished tasks
+     */
+    std::atomic<size_t> remainingTasks;
+  };
+
+private:
+  /**
+   * @brief Add task and find its dependencies
+   *
+   * @param task Task
+   * @return Task index
+   */
+  size_t addTask(Task &&task);
+
+  /**
+   * @brief Run task and submit ready dependents
+   *
+   * @param index Task index
+   * @param state Execution state
+   */
+  void runTask(size_t index, ExecutionState &state);
+
+  /**
+   * @brief Check if tasks conflict
+   *
+   * @param a First task
+   * @param b Second task
+   * @retval true Tasks cannot run concurrently
+   * @retval false Tasks can run concurrently
+   */
+  static bool conflicts(const Task &a, const Task &b);
+
+private:
+  std::vector<Task> mTasks;
+};
+
+} // namespace liquid
@@ -2,8 +2,65 @@
 
 namespace liquid {
 
+/**
+ * @brief Entity handle
+ *
+ * Lower bits store entity index and upper
+ * bits store entity generation. Generation
+ * changes every time an index is reused, so
+ * that handles of deleted entities never
+ * refer to new entities.
+ */
 using Entity = uint32_t;
 
 static constexpr uint32_t EntityNull = 0;
 
+/**
+ * Number of bits that store entity index
+ */
+static constexpr uint32_t EntityIndexBits = 20;
+
+/**
+ * Entity index mask
+ */
+static constexpr uint32_t EntityIndexMask = (1u << EntityIndexBits) - 1;
+
+/**
+ * Entity generation mask
+ */
+static constexpr uint32_t EntityGenerationMask =
+    std::numeric_limits<uint32_t>::max() >> EntityIndexBits;
+
+/**
+ * @brief Get entity index
+ *
+ * @param entity Entity
+ * @return Entity index
+ */
+inline constexpr uint32_t getEntityIndex(Entity entity) {
+  return entity & EntityIndexMask;
+}
+
+/**
+ * @brief Get entity generation
+ *
+ * @param entity Entity
+ * @return Entity generation
+ */
+inline constexpr uint32_t getEntityGeneration(Entity entity) {
+  return entity >> EntityIndexBits;
+}
+
+/**
+ * @brief Create entity handle
+ *
+ * @param index Entity index
+ * @param generation Entity generation
+ * @return Entity
+ */
+inline constexpr Entity createEntityHandle(uint32_t index,
+                                           uint32_t generation) {
+  return (generation << EntityIndexBits) | (index & EntityIndexMask);
+}
+
 } // namespace liquid
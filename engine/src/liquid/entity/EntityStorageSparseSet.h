@@ -1,10 +1,137 @@
 #pragma once
 
+#include "liquid/core/JobSystem.h"
+
 #include "Entity.h"
 #include "EntityUtils.h"
 
 namespace liquid {
 
+/**
+ * @brief Paged sparse array of component indices
+ *
+ * Stores component indices in fixed size pages
+ * that are allocated when an entity in the page
+ * gets a component. Memory scales with the number
+ * of used pages instead of the largest entity index.
+ */
+class EntityStorageSparseSetSparseArray {
+public:
+  /**
+   * Index of missing component
+   */
+  static constexpr uint32_t DeadIndex = std::numeric_limits<uint32_t>::max();
+
+  /**
+   * Number of bits for index inside a page
+   */
+  static constexpr uint32_t PageBits = 10;
+
+  /**
+   * Number of indices in a page
+   */
+  static constexpr uint32_t PageSize = 1u << PageBits;
+
+public:
+  /**
+   * @brief Get component index
+   *
+   * @param entityIndex Entity index
+   * @return Component index or dead index
+   */
+  inline uint32_t get(uint32_t entityIndex) const {
+    size_t page = entityIndex >> PageBits;
+    if (page >= mPages.size() || mPages[page].empty()) {
+      return DeadIndex;
+    }
+
+    return mPages[page][entityIndex & (PageSize - 1)];
+  }
+
+  /**
+   * @brief Set component index
+   *
+   * Allocates page if it does not exist
+   *
+   * @param entityIndex Entity index
+   * @param index Component index
+   */
+  inline void set(uint32_t entityIndex, uint32_t index) {
+    size_t page = entityIndex >> PageBits;
+    if (page >= mPages.size()) {
+      mPages.resize(page + 1);
+    }
+
+    if (mPages[page].empty()) {
+      mPages[page].resize(PageSize, DeadIndex);
+    }
+
+    mPages[page][entityIndex & (PageSize - 1)] = index;
+  }
+
+  /**
+   * @brief Delete all pages
+   */
+  void clear() { mPages.clear(); }
+
+  /**
+   * @brief Get number of allocated pages
+   *
+   * @return Number of allocated pages
+   */
+  size_t getPageCount() const {
+    return std::count_if(mPages.begin(), mPages.end(),
+                         [](const auto &page) { return !page.empty(); });
+  }
+
+  /**
+   * @brief Get allocated memory in bytes
+   *
+   * @return Allocated memory in bytes
+   */
+  size_t getMemoryUsage() const {
+    size_t size = mPages.capacity() * sizeof(std::vector<uint32_t>);
+    for (const auto &page : mPages) {
+      size += page.capacity() * sizeof(uint32_t);
+    }
+
+    return size;
+  }
+
+private:
+  std::vector<std::vector<uint32_t>> mPages;
+};
+
+/**
+ * @brief Memory usage of a component pool
+ */
+struct EntityStorageSparseSetPoolMemoryUsage {
+  /**
+   * Component type name
+   */
+  String name;
+
+  /**
+   * Number of components
+   */
+  size_t size = 0;
+
+  /**
+   * Memory used by sparse array in bytes
+   */
+  size_t sparseMemory = 0;
+
+  /**
+   * Memory used by dense arrays in bytes
+   */
+  size_t denseMemory = 0;
+
+  /**
+   * Pool is shared with another storage
+   */
+  bool shared = false;
+};
+
 /**
  * @brief Sparse set pool for entity storage
  *
@@ -12,9 +139,11 @@ namespace liquid {
  */
 template <class TComponentType> struct EntityStorageSparseSetComponentPool {
   /**
-   * List of entity indices
+   * Component indices of entities
+   *
+   * Indexed by entity index
    */
-  std::vector<size_t> entityIndices;
+  EntityStorageSparseSetSparseArray entityIndices;
 
   /**
    * List of Entities
@@ -26,10 +155,174 @@ template <class TComponentType> struct EntityStorageSparseSetComponentPool {
    */
   std::vector<TComponentType> components;
 
+  /**
+   * List of component versions
+   */
+  std::vector<size_t> versions;
+
   /**
    * Pool size
    */
   size_t size = 0;
+
+  /**
+   * Pool version
+   *
+   * Changes every time a component is
+   * added, replaced, or deleted
+   */
+  size_t version = 0;
+
+  /**
+   * Order version
+   *
+   * Changes every time entities are added,
+   * deleted, or moved in the pool. Pools
+   * with the same order version store the
+   * same entities in the same order.
+   */
+  size_t orderVersion = 0;
+};
+
+/**
+ * @brief Copy-on-write component pool
+ *
+ * Pool is shared between storages after duplication
+ * and copied when it is accessed for writing for the
+ * first time. Pools that are only read are never
+ * copied. Own pool that is replaced by a shared pool
+ * is kept, so that its memory is reused for the copy.
+ *
+ * Pool can be read and written for the first time
+ * from multiple threads. Storages that share pools
+ * must not be modified concurrently.
+ *
+ * @tparam TComponentType Component type
+ */
+template <class TComponentType> class EntityStorageSparseSetSharedPool {
+  using Pool = EntityStorageSparseSetComponentPool<TComponentType>;
+
+public:
+  /**
+   * @brief Create empty pool
+   */
+  EntityStorageSparseSetSharedPool()
+      : mOwner(std::make_shared<Pool>()), mPool(mOwner.get()) {}
+
+  EntityStorageSparseSetSharedPool(const EntityStorageSparseSetSharedPool &) =
+      delete;
+  EntityStorageSparseSetSharedPool(EntityStorageSparseSetSharedPool &&) =
+      delete;
+  EntityStorageSparseSetSharedPool &
+  operator=(const EntityStorageSparseSetSharedPool &) = delete;
+  EntityStorageSparseSetSharedPool &
+  operator=(EntityStorageSparseSetSharedPool &&) = delete;
+
+  /**
+   * @brief Get pool for reading
+   *
+   * @return Component pool
+   */
+  inline const Pool &get() const {
+    return *mPool.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Get pool for writing
+   *
+   * Copies the pool if it is shared
+   *
+   * @return Component pool
+   */
+  inline Pool &getUnique() {
+    if (mShared.load(std::memory_order_acquire)) {
+      detach();
+    }
+
+    return *mPool.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Share pool with another pool
+   *
+   * @param rhs Pool that receives this pool
+   */
+  void share(EntityStorageSparseSetSharedPool &rhs) {
+    if (rhs.mOwner.use_count() == 1) {
+      rhs.mSpare = std::move(rhs.mOwner);
+    }
+
+    rhs.mOwner = mOwner;
+    rhs.mPool.store(mOwner.get(), std::memory_order_release);
+    rhs.mShared.store(true, std::memory_order_release);
+    mShared.store(true, std::memory_order_release);
+  }
+
+  /**
+   * @brief Delete all components
+   *
+   * Own pool keeps its memory. Shared pool
+   * is replaced with spare or empty pool.
+   *
+   * @param version New pool version
+   */
+  void clear(size_t version) {
+    if (mOwner.use_count() > 1) {
+      mOwner = mSpare ? std::move(mSpare) : std::make_shared<Pool>();
+      mPool.store(mOwner.get(), std::memory_order_release);
+    }
+    mShared.store(false, std::memory_order_release);
+
+    mOwner->components.clear();
+    mOwner->entityIndices.clear();
+    mOwner->entities.clear();
+    mOwner->versions.clear();
+    mOwner->version = version;
+    mOwner->orderVersion = version;
+  }
+
+  /**
+   * @brief Check if pool is shared with another storage
+   *
+   * @retval true Pool is shared
+   * @retval false Pool is not shared
+   */
+  inline bool isShared() const {
+    return mShared.load(std::memory_order_acquire) && mOwner.use_count() > 1;
+  }
+
+private:
+  /**
+   * @brief Copy pool if it is still shared
+   */
+  void detach() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mShared.load(std::memory_order_relaxed)) {
+      return;
+    }
+
+    // Other storage could have copied the pool already
+    if (mOwner.use_count() > 1) {
+      if (mSpare) {
+        // Copy assignment reuses memory of the spare pool
+        *mSpare = *mOwner;
+        mOwner = std::move(mSpare);
+      } else {
+        mOwner = std::make_shared<Pool>(*mOwner);
+      }
+
+      mPool.store(mOwner.get(), std::memory_order_release);
+    }
+
+    mShared.store(false, std::memory_order_release);
+  }
+
+private:
+  std::shared_ptr<Pool> mOwner;
+  std::shared_ptr<Pool> mSpare;
+  std::atomic<Pool *> mPool;
+  std::atomic<bool> mShared{false};
+  std::mutex mMutex;
 };
 
 /**
@@ -41,66 +334,386 @@ template <class... ComponentTypes> class EntityStorageSparseSet {
   static_assert(entity_utils::are_types_unique<ComponentTypes...>,
                 "All types must be unique");
 
-  static constexpr size_t DEAD_INDEX = std::numeric_limits<size_t>::max();
-  template <typename T> struct IterFnType { typedef T type; };
+  static constexpr uint32_t DEAD_INDEX =
+      EntityStorageSparseSetSparseArray::DeadIndex;
+  static constexpr size_t PARALLEL_MIN_CHUNK_SIZE = 64;
+  static constexpr size_t ORDER_COMPARISON_CACHE_SIZE = 64;
+
+  /**
+   * @brief Cached comparison of entity orders
+   */
+  struct OrderComparison {
+    /**
+     * Order version of first pool
+     */
+    size_t orderVersion = 0;
+
+    /**
+     * Order version of second pool
+     */
+    size_t otherOrderVersion = 0;
+
+    /**
+     * Pools store entities in the same order
+     */
+    bool equal = false;
+  };
+
+  /**
+   * @brief Component pool of picked component
+   *
+   * Pool is constant if picked component is constant
+   *
+   * @tparam TComponent Picked component type
+   */
+  template <class TComponent>
+  using PickPool = std::conditional_t<
+      std::is_const_v<TComponent>,
+      const EntityStorageSparseSetComponentPool<
+          std::remove_const_t<TComponent>>,
+      EntityStorageSparseSetComponentPool<TComponent>>;
+
+public:
+  /**
+   * @brief View of entities with specified components
+   *
+   * Iterates over the smallest entity list of picked
+   * pools and skips entities that do not have all the
+   * picked components. If all the picked pools store
+   * entities in the same order, components are read
+   * directly without looking up their indices.
+   *
+   * Adding or deleting picked components while iterating
+   * the view invalidates the view. Constant components are
+   * picked without copying pools that are shared with
+   * another storage.
+   *
+   * @tparam PickComponents Components to pick
+   */
+  template <class... PickComponents> class View {
+  public:
+    /**
+     * @brief View iterator
+     */
+    class Iterator {
+    public:
+      /**
+       * @brief Create iterator
+       *
+       * @param view View
+       * @param index Index in entity list
+       */
+      Iterator(const View &view, size_t index) : mView(&view), mIndex(index) {
+        skipMissing();
+      }
+
+      /**
+       * @brief Get entity and its components
+       *
+       * @return Entity and its components
+       */
+      inline std::tuple<Entity, PickComponents &...> operator*() const {
+        return mView->get(mIndex);
+      }
+
+      /**
+       * @brief Advance to next entity
+       *
+       * @return This iterator
+       */
+      inline Iterator &operator++() {
+        mIndex++;
+        skipMissing();
+        return *this;
+      }
+
+      /**
+       * @brief Check if iterators are equal
+       *
+       * @param rhs Other iterator
+       * @retval true Iterators are equal
+       * @retval false Iterators are not equal
+       */
+      inline bool operator==(const Iterator &rhs) const {
+        return mIndex == rhs.mIndex;
+      }
+
+      /**
+       * @brief Check if iterators are not equal
+       *
+       * @param rhs Other iterator
+       * @retval true Iterators are not equal
+       * @retval false Iterators are equal
+       */
+      inline bool operator!=(const Iterator &rhs) const {
+        return mIndex != rhs.mIndex;
+      }
+
+    private:
+      /**
+       * @brief Skip entities that do not have all components
+       */
+      inline void skipMissing() {
+        while (mIndex < mView->size() && !mView->contains(mIndex)) {
+          mIndex++;
+        }
+      }
+
+    private:
+      const View *mView;
+      size_t mIndex;
+    };
+
+  public:
+    /**
+     * @brief Create view
+     *
+     * Entity lists are only compared if
+     * order of pools changed since the
+     * last comparison
+     *
+     * @param storage Entity storage
+     * @param pools Component pools
+     */
+    View(const EntityStorageSparseSet &storage,
+         PickPool<PickComponents> &...pools)
+        : mPools{&pools...} {
+      constexpr size_t NUM_POOLS = sizeof...(PickComponents);
+      std::array<const std::vector<Entity> *, NUM_POOLS> lists{
+          &pools.entities...};
+      std::array<size_t, NUM_POOLS> orderVersions{pools.orderVersion...};
+
+      size_t smallest = 0;
+      for (size_t i = 1; i < NUM_POOLS; ++i) {
+        if (lists[i]->size() < lists[smallest]->size()) {
+          smallest = i;
+        }
+      }
+
+      mEntities = lists[smallest];
+      mAligned = true;
+      for (size_t i = 0; i < NUM_POOLS && mAligned; ++i) {
+        mAligned = i == smallest ||
+                   storage.isSameOrder(*lists[i], orderVersions[i], *mEntities,
+                                       orderVersions[smallest]);
+      }
+    }
+
+    /**
+     * @brief Get iterator to first entity
+     *
+     * @return Begin iterator
+     */
+    inline Iterator begin() const { return Iterator(*this, 0); }
+
+    /**
+     * @brief Get iterator past last entity
+     *
+     * @return End iterator
+     */
+    inline Iterator end() const { return Iterator(*this, size()); }
+
+    /**
+     * @brief Check if all pools are in the same order
+     *
+     * @retval true Pools are in the same order
+     * @retval false Pools are not in the same order
+     */
+    inline bool isAligned() const { return mAligned; }
+
+    /**
+     * @brief Call function for every entity in view
+     *
+     * @tparam TFunction Function type
+     * @param fn Function
+     */
+    template <class TFunction> void each(TFunction &&fn) const {
+      each(0, size(), std::forward<TFunction>(fn));
+    }
+
+    /**
+     * @brief Call function for entities in range
+     *
+     * @tparam TFunction Function type
+     * @param begin First index in entity list
+     * @param end Index past the last item in entity list
+     * @param fn Function
+     */
+    template <class TFunction>
+    void each(size_t begin, size_t end, TFunction &&fn) const {
+      end = std::min(end, size());
+      if (mAligned) {
+        for (size_t i = begin; i < end; ++i) {
+          std::apply(
+              [&fn, i, entity = (*mEntities)[i]](auto *...pools) {
+                fn(entity, pools->components[i]...);
+              },
+              mPools);
+        }
+
+        return;
+      }
+
+      for (size_t i = begin; i < end; ++i) {
+        if (contains(i)) {
+          std::apply(fn, get(i));
+        }
+      }
+    }
+
+    /**
+     * @brief Get size of iterated entity list
+     *
+     * Entity list can contain entities that
+     * do not have all picked components
+     *
+     * @return Size of entity list
+     */
+    inline size_t size() const { return mEntities->size(); }
+
+  private:
+    /**
+     * @brief Check if entity has all picked components
+     *
+     * @param index Index in entity list
+     * @retval true Entity has all components
+     * @retval false Entity does not have all components
+     */
+    inline bool contains(size_t index) const {
+      if (mAligned) {
+        return true;
+      }
+
+      uint32_t entityIndex = getEntityIndex((*mEntities)[index]);
+      return std::apply(
+          [this, entityIndex](auto *...pools) {
+            return ((&pools->entities == mEntities ||
+                     pools->entityIndices.get(entityIndex) != DEAD_INDEX) &&
+                    ...);
+          },
+          mPools);
+    }
+
+    /**
+     * @brief Get entity and its components
+     *
+     * @param index Index in entity list
+     * @return Entity and its components
+     */
+    inline std::tuple<Entity, PickComponents &...> get(size_t index) const {
+      Entity entity = (*mEntities)[index];
+      return std::apply(
+          [this, entity, index](auto *...pools) {
+            return std::tuple<Entity, PickComponents &...>(
+                entity,
+                pools->components[mAligned || &pools->entities == mEntities
+                                      ? index
+                                      : pools->entityIndices.get(
+                                            getEntityIndex(entity))]...);
+          },
+          mPools);
+    }
+
+  private:
+    std::tuple<PickPool<PickComponents> *...> mPools;
+    const std::vector<Entity> *mEntities = nullptr;
+    bool mAligned = false;
+  };
 
 public:
   EntityStorageSparseSet() = default;
+  ~EntityStorageSparseSet() = default;
   EntityStorageSparseSet(const EntityStorageSparseSet &) = delete;
   EntityStorageSparseSet(EntityStorageSparseSet &&) = delete;
   EntityStorageSparseSet &operator=(const EntityStorageSparseSet &) = delete;
   EntityStorageSparseSet &operator=(EntityStorageSparseSet &&) = delete;
 
   /**
-   * @brief Destroy storage
+   * @brief Duplicate contents into other storage
    *
-   * Destroys all components and entities
-   */
-  ~EntityStorageSparseSet() { destroy(); }
-
-  /**
-   * @brief Duplicate contents into new storage
+   * Replaces contents of the other storage.
+   * Component pools are shared between both
+   * storages until one of them writes to a
+   * pool. Memory of previous pools of the other
+   * storage is reused when shared pools are copied.
    *
    * @param rhs Other storage
    */
   void duplicate(EntityStorageSparseSet &rhs) {
-    rhs.mComponentPools = mComponentPools;
-    rhs.mLastEntity = mLastEntity;
-    rhs.mDeleted = mDeleted;
+    sharePools(rhs);
+    rhs.mEntities = mEntities;
+    rhs.mFreeHead = mFreeHead;
+    rhs.mFreeTail = mFreeTail;
     rhs.mNumEntities = mNumEntities;
   }
 
   /**
    * @brief Create entity
    *
+   * Reuses index of the oldest deleted
+   * entity with the next generation
+   *
    * @return Newly created entity
    */
   Entity createEntity() {
     mNumEntities++;
-    if (mDeleted.size() > 0) {
-      auto eid = mDeleted.front();
-      mDeleted.pop_front();
-      return eid;
+    if (mFreeHead != 0) {
+      return reuseFreeSlot();
     }
 
-    auto eid = mLastEntity++;
-    return eid;
+    LIQUID_ASSERT(mEntities.size() <= EntityIndexMask,
+                  "Maximum number of entities is reached");
+
+    Entity entity = static_cast<Entity>(mEntities.size());
+    mEntities.push_back(entity);
+    return entity;
+  }
+
+  /**
+   * @brief Create multiple entities
+   *
+   * Reuses indices of deleted entities first
+   * and allocates remaining entities at once
+   *
+   * @param count Number of entities
+   * @return Newly created entities
+   */
+  std::vector<Entity> createEntities(size_t count) {
+    std::vector<Entity> entities;
+    entities.reserve(count);
+    mNumEntities += count;
+
+    while (entities.size() < count && mFreeHead != 0) {
+      entities.push_back(reuseFreeSlot());
+    }
+
+    size_t remaining = count - entities.size();
+    LIQUID_ASSERT(mEntities.size() + remaining <= EntityIndexMask + 1,
+                  "Maximum number of entities is reached");
+
+    mEntities.reserve(mEntities.size() + remaining);
+    for (size_t i = 0; i < remaining; ++i) {
+      Entity entity = static_cast<Entity>(mEntities.size());
+      mEntities.push_back(entity);
+      entities.push_back(entity);
+    }
+
+    return entities;
   }
 
   /**
    * @brief Check if entity exists
    *
+   * Handles of deleted entities do not
+   * exist even if their indices are reused
+   *
    * @param entity Entity
    * @retval true Entity exists
    * @retval false Entity does not exist
    */
-  bool hasEntity(Entity entity) const {
-    for (auto &deletedEntity : mDeleted) {
-      if (deletedEntity == entity)
-        return false;
-    }
-
-    return entity > EntityNull && entity < mLastEntity;
+  inline bool hasEntity(Entity entity) const {
+    uint32_t index = getEntityIndex(entity);
+    return index > 0 && index < mEntities.size() && mEntities[index] == entity;
   }
 
   /**
@@ -116,12 +729,29 @@ public:
    * @param entity Entity
    */
   void deleteEntity(Entity entity) {
-    if (entity == EntityNull)
+    if (!hasEntity(entity))
       return;
 
     deleteAllEntityComponents(entity);
-    mDeleted.push_back(entity);
-    this->mNumEntities--;
+    releaseEntity(entity);
+  }
+
+  /**
+   * @brief Delete multiple entities
+   *
+   * Deletes components pool by pool.
+   * Entities that do not exist are skipped.
+   *
+   * @param entities Entities
+   */
+  void deleteEntities(const std::vector<Entity> &entities) {
+    deleteAllEntitiesComponents(entities);
+
+    for (auto entity : entities) {
+      if (hasEntity(entity)) {
+        releaseEntity(entity);
+      }
+    }
   }
 
   /**
@@ -142,22 +772,102 @@ public:
 
     auto &pool = getPoolForComponent<ComponentType>();
 
-    if (entity >= pool.entityIndices.size()) {
-      // TODO: Make this better
-      pool.entityIndices.resize((entity + 1) * 2, DEAD_INDEX);
+    pool.version = getNextVersion();
+    insertComponent(pool, entity, value);
+  }
+
+  /**
+   * @brief Set components of multiple entities
+   *
+   * Grows dense arrays once for all entities.
+   * All components get the same version.
+   *
+   * @tparam ComponentType Component type
+   * @param entities Entities
+   * @param values Component values for every entity
+   */
+  template <class ComponentType>
+  void setComponents(const std::vector<Entity> &entities,
+                     const std::vector<ComponentType> &values) {
+    LIQUID_ASSERT(entities.size() == values.size(),
+                  "Number of entities and components must be equal");
+
+    if (entities.empty()) {
+      return;
     }
 
-    size_t index = pool.entityIndices[entity];
-    if (index != DEAD_INDEX) {
-      pool.components[index] = value;
-      pool.entities[index] = entity;
-    } else {
-      pool.entities.push_back(entity);
-      pool.components.push_back(value);
-      pool.entityIndices[entity] = pool.entities.size() - 1;
+    auto &pool = getPoolForComponent<ComponentType>();
+
+    for (auto entity : entities) {
+      LIQUID_ASSERT(hasEntity(entity),
+                    "Entity " + std::to_string(entity) + " does not exist");
     }
+
+    size_t capacity = pool.entities.size() + entities.size();
+    reserveForBatch(pool.entities, capacity);
+    reserveForBatch(pool.components, capacity);
+    reserveForBatch(pool.versions, capacity);
+
+    pool.version = getNextVersion();
+    for (size_t i = 0; i < entities.size(); ++i) {
+      insertComponent(pool, entities[i], values[i]);
+    }
+  }
+
+  /**
+   * @brief Mark component as changed
+   *
+   * Components that are modified in place
+   * must be marked as changed, so that systems
+   * that only process changed components
+   * can pick up the change
+   *
+   * @tparam ComponentType Component type
+   * @param entity Entity
+   */
+  template <class ComponentType> void markComponentChanged(Entity entity) {
+    LIQUID_ASSERT(hasComponent<ComponentType>(entity),
+                  "Component named " + String(typeid(ComponentType).name()) +
+                      " does not exist for entity " + std::to_string(entity));
+    auto &pool = getPoolForComponent<ComponentType>();
+
+    pool.versions[pool.entityIndices.get(getEntityIndex(entity))] =
+        getNextVersion();
+  }
+
+  /**
+   * @brief Get component version
+   *
+   * Component version changes every time
+   * the component is set or marked as changed.
+   * Component is changed after a point in time
+   * if its version is greater than the last
+   * version at that time.
+   *
+   * @tparam ComponentType Component type
+   * @param entity Entity
+   * @return Component version
+   */
+  template <class ComponentType>
+  size_t getComponentVersion(Entity entity) const {
+    LIQUID_ASSERT(hasComponent<ComponentType>(entity),
+                  "Component named " + String(typeid(ComponentType).name()) +
+                      " does not exist for entity " + std::to_string(entity));
+    const auto &pool = getPoolForComponent<ComponentType>();
+
+    return pool.versions[pool.entityIndices.get(getEntityIndex(entity))];
   }
 
+  /**
+   * @brief Get last version
+   *
+   * Last version that is assigned to
+   * any pool or component
+   *
+   * @return Last version
+   */
+  static size_t getLastVersion() { return getVersionCounter().load(); }
+
   /**
    * @brief Get component
    *
@@ -172,7 +882,7 @@ public:
                       " does not exist for entity " + std::to_string(entity));
     const auto &pool = getPoolForComponent<ComponentType>();
 
-    return pool.components[pool.entityIndices[entity]];
+    return pool.components[pool.entityIndices.get(getEntityIndex(entity))];
   }
 
   /**
@@ -188,21 +898,22 @@ public:
                       " does not exist for entity " + std::to_string(entity));
     auto &pool = getPoolForComponent<ComponentType>();
 
-    return pool.components[pool.entityIndices[entity]];
+    return pool.components[pool.entityIndices.get(getEntityIndex(entity))];
   }
 
   /**
    * @brief Check if component exists in entity
    *
+   * Components are not found for handles
+   * of deleted entities
+   *
    * @tparam ComponentType Component type
    * @param entity Entity
    * @retval true Entity exists
    * @retval false Entity does not exist
    */
   template <class ComponentType> bool hasComponent(Entity entity) const {
-    const auto &pool = getPoolForComponent<ComponentType>();
-    return entity < pool.entityIndices.size() &&
-           pool.entityIndices[entity] != DEAD_INDEX;
+    return hasComponentInPool(getPoolForComponent<ComponentType>(), entity);
   }
 
   /**
@@ -212,30 +923,14 @@ public:
    * @param entity Entity
    */
   template <class ComponentType> void deleteComponent(Entity entity) {
-    auto &pool = getPoolForComponent<ComponentType>();
-    LIQUID_ASSERT(entity < pool.entityIndices.size(),
+    LIQUID_ASSERT(hasComponent<ComponentType>(entity),
                   "Component named " + String(typeid(ComponentType).name()) +
                       " does not exist for entity " + std::to_string(entity));
+    auto &pool = getPoolForComponent<ComponentType>();
 
-    Entity movedEntity = pool.entities.back();
-    size_t entityIndexToDelete = pool.entityIndices[entity];
-
-    // Move last entity in the array to place of deleted entity
-    pool.entities[entityIndexToDelete] = movedEntity;
-
-    // Change index of moved entity to the index of deleted entity
-    pool.entityIndices[movedEntity] = entityIndexToDelete;
-
-    // Delete last item from entities array
-    pool.entities.pop_back();
-
-    // Move last component in the array to place of deleted component
-    pool.components[entityIndexToDelete] = pool.components.back();
-
-    // Delete last item from components array
-    pool.components.pop_back();
-
-    pool.entityIndices[entity] = DEAD_INDEX;
+    removeComponent(pool, entity);
+    pool.version = getNextVersion();
+    pool.orderVersion = pool.version;
   }
 
   /**
@@ -248,18 +943,104 @@ public:
     return getPoolForComponent<ComponentType>().entities.size();
   }
 
+  /**
+   * @brief Get component pool version
+   *
+   * Versions are unique across all storages.
+   * If version of a pool did not change,
+   * no component of this type was added,
+   * replaced, or deleted since then.
+   *
+   * @tparam ComponentType Component type
+   * @return Component pool version
+   */
+  template <class ComponentType> size_t getComponentPoolVersion() const {
+    return getPoolForComponent<ComponentType>().version;
+  }
+
+  /**
+   * @brief Get component pool order version
+   *
+   * If order version of a pool did not change,
+   * no component of this type was added to
+   * or deleted from an entity since then.
+   *
+   * @tparam ComponentType Component type
+   * @return Component pool order version
+   */
+  template <class ComponentType> size_t getComponentPoolOrderVersion() const {
+    return getPoolForComponent<ComponentType>().orderVersion;
+  }
+
+  /**
+   * @brief Get memory usage of every component pool
+   *
+   * @return Memory usage of component pools
+   */
+  std::vector<EntityStorageSparseSetPoolMemoryUsage> getMemoryUsage() const {
+    std::vector<EntityStorageSparseSetPoolMemoryUsage> usages;
+    usages.reserve(sizeof...(ComponentTypes));
+
+    std::apply(
+        [&usages](const auto &...pools) {
+          (usages.push_back(getPoolMemoryUsage(pools)), ...);
+        },
+        mComponentPools);
+
+    return usages;
+  }
+
   /**
    * @brief Get all entities with specified components
    *
    * @tparam PickComponents Components to pick
+   * @tparam TFunction Iterator function type
    * @param iterFn Iterator function
    */
-  template <class... PickComponents>
-  void iterateEntities(
-      const typename IterFnType<
-          std::function<void(Entity, PickComponents &...)>>::type &iterFn) {
-    iterateEntitiesInternal(iterFn,
-                            std::index_sequence_for<PickComponents...>{});
+  template <class... PickComponents, class TFunction>
+  void iterateEntities(TFunction &&iterFn) {
+    view<PickComponents...>().each(std::forward<TFunction>(iterFn));
+  }
+
+  /**
+   * @brief Get all entities with specified components in parallel
+   *
+   * Splits entities into chunks and runs them
+   * on job system workers. Blocks until all
+   * entities are processed.
+   *
+   * Every entity is passed to exactly one call
+   * and the function can read and write picked
+   * components of that entity in place. Picked
+   * components of other entities, entities, and
+   * components of other types must only be read.
+   * Components and entities must not be added or
+   * deleted. Marking components as changed is
+   * allowed. Order of the calls is not defined.
+   *
+   * @tparam PickComponents Components to pick
+   * @tparam TFunction Iterator function type
+   * @param jobSystem Job system
+   * @param iterFn Iterator function
+   */
+  template <class... PickComponents, class TFunction>
+  void parallelIterateEntities(JobSystem &jobSystem, TFunction &&iterFn) {
+    auto entities = view<PickComponents...>();
+    jobSystem.parallelFor(entities.size(), PARALLEL_MIN_CHUNK_SIZE,
+                          [&entities, &iterFn](size_t begin, size_t end) {
+                            entities.each(begin, end, iterFn);
+                          });
+  }
+
+  /**
+   * @brief Get view of entities with specified components
+   *
+   * @tparam PickComponents Components to pick
+   * @return View of entities
+   */
+  template <class... PickComponents> View<PickComponents...> view() {
+    return View<PickComponents...>(*this,
+                                   getPoolForPick<PickComponents>()...);
   }
 
   /**
@@ -276,9 +1057,8 @@ public:
    * @tparam Component type to destroy
    */
   template <class ComponentType> void destroyComponents() {
-    getPoolForComponent<ComponentType>().components.clear();
-    getPoolForComponent<ComponentType>().entities.clear();
-    getPoolForComponent<ComponentType>().entityIndices.clear();
+    std::get<EntityStorageSparseSetSharedPool<ComponentType>>(mComponentPools)
+        .clear(getNextVersion());
   }
 
 private:
@@ -293,67 +1073,61 @@ private:
   template <class ComponentType>
   const EntityStorageSparseSetComponentPool<ComponentType> &
   getPoolForComponent() const {
-    return std::get<EntityStorageSparseSetComponentPool<ComponentType>>(
-        mComponentPools);
+    return std::get<EntityStorageSparseSetSharedPool<ComponentType>>(
+               mComponentPools)
+        .get();
   }
 
   /**
    * @brief Get pool for component
    *
-   * Retrieves component pool from the tuple in compile-time
+   * Retrieves component pool from the tuple in compile-time.
+   * Copies the pool if it is shared with another storage.
    *
    * @tparam ComponentType Component type
    * @return Component pool for component type
    */
   template <class ComponentType>
   EntityStorageSparseSetComponentPool<ComponentType> &getPoolForComponent() {
-    return std::get<EntityStorageSparseSetComponentPool<ComponentType>>(
-        mComponentPools);
+    return std::get<EntityStorageSparseSetSharedPool<ComponentType>>(
+               mComponentPools)
+        .getUnique();
   }
 
   /**
-   * @brief Get all entities with specified components
+   * @brief Get pool for picked component
    *
-   * Infers template parameter for indices using index sequence
-   * and uses the index to get the needed values for components
+   * Constant components are picked from
+   * constant pools
    *
-   * @tparam PickComponents Components to pick
-   * @tparam PickComponentIndices Indices of picked components
-   * @param iterFn Iterator function
-   * @param sequence Index sequence of picked components
-   */
-  template <class... PickComponents, size_t... PickComponentIndices>
-  void iterateEntitiesInternal(
-      const std::function<void(Entity, PickComponents &...)> &iterFn,
-      std::index_sequence<PickComponentIndices...> sequence) {
-    std::tuple<EntityStorageSparseSetComponentPool<PickComponents> &...>
-        pickedPools = {
-            std::get<EntityStorageSparseSetComponentPool<PickComponents>>(
-                mComponentPools)...};
-
-    const auto &smallestEntities = getSmallestEntityListFromPools(pickedPools);
-
-    for (size_t i = 0; i < smallestEntities.size(); ++i) {
-      Entity entity = smallestEntities[i];
-      bool isDead = std::apply(
-          [entity](auto &&...args) {
-            return ((entity >= args.entityIndices.size() ||
-                     args.entityIndices[entity] == DEAD_INDEX) ||
-                    ...);
-          },
-          pickedPools);
-
-      if (isDead) {
-        continue;
-      }
+   * @tparam PickComponent Picked component type
+   * @return Component pool for picked component
+   */
+  template <class PickComponent> PickPool<PickComponent> &getPoolForPick() {
+    if constexpr (std::is_const_v<PickComponent>) {
+      using ComponentType = std::remove_const_t<PickComponent>;
+      return std::get<EntityStorageSparseSetSharedPool<ComponentType>>(
+                 mComponentPools)
+          .get();
+    } else {
+      return getPoolForComponent<PickComponent>();
+    }
+  }
 
-      const auto &indices = std::array{
-          std::get<PickComponentIndices>(pickedPools).entityIndices[entity]...};
-      std::tuple<PickComponents &...> components = {
-          std::get<PickComponentIndices>(pickedPools)
-              .components[std::get<PickComponentIndices>(indices)]...};
+  /**
+   * @brief Share component pools with other storage
+   *
+   * Recursion function. Loops through component pools.
+   *
+   * @tparam Index Tuple index of component pool
+   * @param rhs Other storage
+   */
+  template <size_t Index = 0> void sharePools(EntityStorageSparseSet &rhs) {
+    auto &pool = std::get<Index>(mComponentPools);
+    pool.share(std::get<Index>(rhs.mComponentPools));
 
-      iterFn(entity, std::get<PickComponentIndices>(components)...);
+    if constexpr (Index + 1 != sizeof...(ComponentTypes)) {
+      sharePools<Index + 1>(rhs);
     }
   }
 
@@ -366,45 +1140,290 @@ private:
    * @param entity Entity
    */
   template <size_t Index = 0> void deleteAllEntityComponents(Entity entity) {
-    auto &pool = std::get<Index>(mComponentPools);
-    if (entity < pool.entityIndices.size() &&
-        pool.entityIndices[entity] < DEAD_INDEX) {
+    auto &sharedPool = std::get<Index>(mComponentPools);
+
+    // Only copy shared pools that have the component
+    if (hasComponentInPool(sharedPool.get(), entity)) {
+      auto &pool = sharedPool.getUnique();
+      removeComponent(pool, entity);
+      pool.version = getNextVersion();
+      pool.orderVersion = pool.version;
+    }
 
-      Entity movedEntity = pool.entities.back();
-      size_t entityIndexToDelete = pool.entityIndices[entity];
+    if constexpr (Index + 1 != sizeof...(ComponentTypes)) {
+      deleteAllEntityComponents<Index + 1>(entity);
+    }
+  }
 
-      // Move last entity in the array to place of deleted entity
-      pool.entities[entityIndexToDelete] = movedEntity;
+  /**
+   * @brief Delete all components of multiple entities
+   *
+   * Recursion function. Loops through component pools
+   * and deletes all entities from one pool at a time.
+   *
+   * @tparam Index Tuple index of component pool
+   * @param entities Entities
+   */
+  template <size_t Index = 0>
+  void deleteAllEntitiesComponents(const std::vector<Entity> &entities) {
+    auto &sharedPool = std::get<Index>(mComponentPools);
+
+    // Only copy shared pools that have any of the components
+    const auto &constPool = sharedPool.get();
+    bool found = std::any_of(
+        entities.begin(), entities.end(),
+        [&constPool](Entity e) { return hasComponentInPool(constPool, e); });
+
+    if (found) {
+      auto &pool = sharedPool.getUnique();
+      for (auto entity : entities) {
+        removeComponent(pool, entity);
+      }
+      pool.version = getNextVersion();
+      pool.orderVersion = pool.version;
+    }
 
-      // Change index of moved entity to the index of deleted entity
-      pool.entityIndices[movedEntity] = entityIndexToDelete;
+    if constexpr (Index + 1 != sizeof...(ComponentTypes)) {
+      deleteAllEntitiesComponents<Index + 1>(entities);
+    }
+  }
 
-      // Delete last item from entities array
-      pool.entities.pop_back();
+  /**
+   * @brief Add or replace component in pool
+   *
+   * Pool must have an entity index slot for
+   * the entity. Uses current pool version
+   * as component and order version.
+   *
+   * @tparam ComponentType Component type
+   * @param pool Component pool
+   * @param entity Entity
+   * @param value Component value
+   */
+  template <class ComponentType>
+  void insertComponent(EntityStorageSparseSetComponentPool<ComponentType> &pool,
+                       Entity entity, const ComponentType &value) {
+    uint32_t entityIndex = getEntityIndex(entity);
 
-      // Move last component in the array to place of deleted component
-      pool.components[entityIndexToDelete] = pool.components.back();
+    uint32_t index = pool.entityIndices.get(entityIndex);
+    if (index != DEAD_INDEX) {
+      if (pool.entities[index] != entity) {
+        pool.orderVersion = pool.version;
+      }
 
-      // Delete last item from components array
-      pool.components.pop_back();
+      pool.components[index] = value;
+      pool.entities[index] = entity;
+      pool.versions[index] = pool.version;
+    } else {
+      pool.orderVersion = pool.version;
+      pool.entities.push_back(entity);
+      pool.components.push_back(value);
+      pool.versions.push_back(pool.version);
+      pool.entityIndices.set(entityIndex,
+                             static_cast<uint32_t>(pool.entities.size() - 1));
+    }
+  }
 
-      pool.entityIndices[entity] = DEAD_INDEX;
+  /**
+   * @brief Remove component from pool
+   *
+   * Does not change pool version or
+   * order version
+   *
+   * @tparam ComponentType Component type
+   * @param pool Component pool
+   * @param entity Entity
+   * @retval true Component is removed
+   * @retval false Entity does not have component
+   */
+  template <class ComponentType>
+  bool removeComponent(EntityStorageSparseSetComponentPool<ComponentType> &pool,
+                       Entity entity) {
+    if (!hasComponentInPool(pool, entity)) {
+      return false;
     }
 
-    if constexpr (Index + 1 != sizeof...(ComponentTypes)) {
-      deleteAllEntityComponents<Index + 1>(entity);
+    uint32_t entityIndex = getEntityIndex(entity);
+    uint32_t entityIndexToDelete = pool.entityIndices.get(entityIndex);
+
+    Entity movedEntity = pool.entities.back();
+
+    // Move last entity in the array to place of deleted entity
+    pool.entities[entityIndexToDelete] = movedEntity;
+
+    // Change index of moved entity to the index of deleted entity
+    pool.entityIndices.set(getEntityIndex(movedEntity), entityIndexToDelete);
+
+    // Delete last item from entities array
+    pool.entities.pop_back();
+
+    // Move last component in the array to place of deleted component
+    pool.components[entityIndexToDelete] = std::move(pool.components.back());
+
+    // Delete last item from components array
+    pool.components.pop_back();
+
+    // Move version of last component to place of deleted component
+    pool.versions[entityIndexToDelete] = pool.versions.back();
+    pool.versions.pop_back();
+
+    pool.entityIndices.set(entityIndex, DEAD_INDEX);
+    return true;
+  }
+
+  /**
+   * @brief Check if entity lists are in the same order
+   *
+   * Pools with the same order version are equal.
+   * Other pools are compared once and the result
+   * is cached by order versions of the pools.
+   *
+   * @param entities Entities of pool
+   * @param orderVersion Order version of pool
+   * @param otherEntities Entities of other pool
+   * @param otherOrderVersion Order version of other pool
+   * @retval true Entity lists are equal
+   * @retval false Entity lists are not equal
+   */
+  bool isSameOrder(const std::vector<Entity> &entities, size_t orderVersion,
+                   const std::vector<Entity> &otherEntities,
+                   size_t otherOrderVersion) const {
+    if (orderVersion == otherOrderVersion) {
+      return true;
+    }
+
+    if (entities.size() != otherEntities.size()) {
+      return false;
+    }
+
+    if (orderVersion > otherOrderVersion) {
+      std::swap(orderVersion, otherOrderVersion);
+    }
+
+    constexpr size_t PRIME = 31;
+    auto &comparison =
+        mOrderComparisons[(orderVersion * PRIME + otherOrderVersion) %
+                          ORDER_COMPARISON_CACHE_SIZE];
+
+    std::lock_guard<std::mutex> lock(mOrderComparisonMutex);
+    if (comparison.orderVersion != orderVersion ||
+        comparison.otherOrderVersion != otherOrderVersion) {
+      comparison.orderVersion = orderVersion;
+      comparison.otherOrderVersion = otherOrderVersion;
+      comparison.equal = entities == otherEntities;
+    }
+
+    return comparison.equal;
+  }
+
+  /**
+   * @brief Check if pool has component of entity
+   *
+   * @tparam ComponentType Component type
+   * @param pool Component pool
+   * @param entity Entity
+   * @retval true Pool has component of entity
+   * @retval false Pool does not have component of entity
+   */
+  template <class ComponentType>
+  static inline bool hasComponentInPool(
+      const EntityStorageSparseSetComponentPool<ComponentType> &pool,
+      Entity entity) {
+    uint32_t index = pool.entityIndices.get(getEntityIndex(entity));
+    return index != DEAD_INDEX && pool.entities[index] == entity;
+  }
+
+  /**
+   * @brief Get memory usage of component pool
+   *
+   * @tparam ComponentType Component type
+   * @param sharedPool Component pool
+   * @return Memory usage of component pool
+   */
+  template <class ComponentType>
+  static EntityStorageSparseSetPoolMemoryUsage getPoolMemoryUsage(
+      const EntityStorageSparseSetSharedPool<ComponentType> &sharedPool) {
+    const auto &pool = sharedPool.get();
+
+    EntityStorageSparseSetPoolMemoryUsage usage{};
+    usage.shared = sharedPool.isShared();
+    usage.name = typeid(ComponentType).name();
+    usage.size = pool.entities.size();
+    usage.sparseMemory = pool.entityIndices.getMemoryUsage();
+    usage.denseMemory = pool.entities.capacity() * sizeof(Entity) +
+                        pool.components.capacity() * sizeof(ComponentType) +
+                        pool.versions.capacity() * sizeof(size_t);
+    return usage;
+  }
+
+  /**
+   * @brief Reserve space for batch insert
+   *
+   * Grows geometrically, so that repeated
+   * small batches do not reallocate every time
+   *
+   * @tparam T Item type
+   * @param items Items
+   * @param capacity Required capacity
+   */
+  template <class T>
+  static void reserveForBatch(std::vector<T> &items, size_t capacity) {
+    if (capacity > items.capacity()) {
+      items.reserve(std::max(capacity, items.capacity() * 2));
     }
   }
 
+  /**
+   * @brief Reuse oldest free entity slot
+   *
+   * @return Entity with next generation
+   */
+  Entity reuseFreeSlot() {
+    uint32_t index = mFreeHead;
+    Entity slot = mEntities[index];
+
+    mFreeHead = getEntityIndex(slot);
+    if (mFreeHead == 0) {
+      mFreeTail = 0;
+    }
+
+    Entity entity = createEntityHandle(index, getEntityGeneration(slot));
+    mEntities[index] = entity;
+    return entity;
+  }
+
+  /**
+   * @brief Add slot of existing entity to free list
+   *
+   * @param entity Entity
+   */
+  void releaseEntity(Entity entity) {
+    // Slot of deleted entity stores index of the
+    // next free slot and generation of the next
+    // entity that reuses this slot
+    uint32_t index = getEntityIndex(entity);
+    uint32_t generation =
+        (getEntityGeneration(entity) + 1) & EntityGenerationMask;
+    mEntities[index] = createEntityHandle(0, generation);
+
+    if (mFreeTail != 0) {
+      mEntities[mFreeTail] = createEntityHandle(
+          index, getEntityGeneration(mEntities[mFreeTail]));
+    } else {
+      mFreeHead = index;
+    }
+    mFreeTail = index;
+
+    mNumEntities--;
+  }
+
   /**
    * @brief Delete all components
    *
    * @tparam Index Tuple index
    */
   template <size_t Index = 0> void deleteAllComponents() {
-    std::get<Index>(mComponentPools).components.clear();
-    std::get<Index>(mComponentPools).entityIndices.clear();
-    std::get<Index>(mComponentPools).entities.clear();
+    std::get<Index>(mComponentPools).clear(getNextVersion());
 
     if constexpr (Index + 1 != sizeof...(ComponentTypes)) {
       deleteAllComponents<Index + 1>();
@@ -415,46 +1434,55 @@ private:
    * @brief Delete all entities
    */
   void deleteAllEntities() {
-    mLastEntity = 1;
-    mDeleted.clear();
+    mEntities.resize(1);
+    mFreeHead = 0;
+    mFreeTail = 0;
     mNumEntities = 0;
   }
 
 private:
   /**
-   * @brief Recursively find the smallest entity list
-   *
-   * @tparam Index Current index
-   * @tparam IndexForSmallest Index for smallest pool
-   * @tparam PickComponents Component types to pick
-   * @param pools Pools to search from
-   * @return Reference to smallest entity list
-   */
-  template <size_t Index = 0, size_t IndexForSmallest = 0,
-            class... PickComponents>
-  static inline const std::vector<Entity> &getSmallestEntityListFromPools(
-      const std::tuple<EntityStorageSparseSetComponentPool<PickComponents> &...>
-          &pools) {
-    if constexpr (Index < sizeof...(PickComponents)) {
-      if (std::get<Index>(pools).entities.size() <
-          std::get<IndexForSmallest>(pools).entities.size()) {
-        return getSmallestEntityListFromPools<Index + 1, Index,
-                                              PickComponents...>(pools);
-      }
-      return getSmallestEntityListFromPools<Index + 1, IndexForSmallest,
-                                            PickComponents...>(pools);
-    }
-
-    return std::get<IndexForSmallest>(pools).entities;
+   * @brief Get version counter
+   *
+   * Versions are shared between all storages
+   * of the same type, so that a duplicated
+   * storage never reuses a version of another
+   * storage. Counter is atomic, so that components
+   * can be marked as changed from multiple threads.
+   *
+   * @return Version counter
+   */
+  static std::atomic<size_t> &getVersionCounter() {
+    static std::atomic<size_t> lastVersion{0};
+    return lastVersion;
   }
 
+  /**
+   * @brief Get next version
+   *
+   * @return Next version
+   */
+  static size_t getNextVersion() { return ++getVersionCounter(); }
+
 private:
-  std::tuple<EntityStorageSparseSetComponentPool<ComponentTypes>...>
+  std::tuple<EntityStorageSparseSetSharedPool<ComponentTypes>...>
       mComponentPools;
 
-  Entity mLastEntity = 1;
-  std::list<Entity> mDeleted;
+  // Entity slots indexed by entity index. Slot
+  // of a live entity stores its handle. Slots of
+  // deleted entities form a free list. First slot
+  // is reserved for null entity.
+  std::vector<Entity> mEntities{EntityNull};
+  uint32_t mFreeHead = 0;
+  uint32_t mFreeTail = 0;
   size_t mNumEntities = 0;
+
+  // Views of the same pools are created every
+  // frame; so, entity lists of pools are only
+  // compared after their order changes
+  mutable std::array<OrderComparison, ORDER_COMPARISON_CACHE_SIZE>
+      mOrderComparisons{};
+  mutable std::mutex mOrderComparisonMutex;
 };
 
 } // namespace liquid
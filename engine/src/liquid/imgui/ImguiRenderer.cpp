@@ -175,14 +175,16 @@ void ImguiRenderer::updateFrameData(uint32_t frameIndex) {
     ibDst += cmd_list->IdxBuffer.Size;
   }
 
+  // Buffers are written every frame; so,
+  // they are kept in host visible memory
   frameObj.vertexBuffer =
       mRegistry.setBuffer({rhi::BufferType::Vertex, frameObj.vertexBufferSize,
-                           frameObj.vertexBufferData},
+                           frameObj.vertexBufferData, 0, true},
                           frameObj.vertexBuffer);
 
   frameObj.indexBuffer =
       mRegistry.setBuffer({rhi::BufferType::Index, frameObj.indexBufferSize,
-                           frameObj.indexBufferData},
+                           frameObj.indexBufferData, 0, true},
                           frameObj.indexBuffer);
 }
 
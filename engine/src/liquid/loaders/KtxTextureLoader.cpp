@@ -29,6 +29,20 @@ rhi::TextureHandle KtxTextureLoader::loadFromFile(const String &filename) {
           .what());
 
   constexpr uint32_t CUBEMAP_SIDES = 6;
+  uint32_t numFaces = ktxTextureData->isCubemap ? CUBEMAP_SIDES : 1;
+
+  // Levels are stored from largest to smallest and
+  // faces of every level are stored next to each other
+  std::vector<rhi::TextureLevel> levels(ktxTextureData->numLevels);
+  size_t size = 0;
+  for (uint32_t i = 0; i < ktxTextureData->numLevels; ++i) {
+    auto &level = levels.at(i);
+    level.offset = size;
+    level.size = ktxTexture_GetImageSize(ktxTextureData, i) * numFaces;
+    level.width = std::max(ktxTextureData->baseWidth >> i, 1u);
+    level.height = std::max(ktxTextureData->baseHeight >> i, 1u);
+    size += level.size;
+  }
 
   rhi::TextureDescription description;
   description.type = ktxTextureData->isCubemap ? rhi::TextureType::Cubemap
@@ -39,29 +53,28 @@ rhi::TextureHandle KtxTextureLoader::loadFromFile(const String &filename) {
   description.format = ktxTexture_GetVkFormat(ktxTextureData);
   description.layers = ktxTextureData->numLayers *
                        (ktxTextureData->isCubemap ? CUBEMAP_SIDES : 1);
-  description.size = ktxTexture_GetDataSizeUncompressed(ktxTextureData);
+  description.size = size;
   description.usage = rhi::TextureUsage::Sampled | rhi::TextureUsage::Color |
                       rhi::TextureUsage::TransferDestination;
   description.data = new char[description.size];
 
   char *srcData = reinterpret_cast<char *>(ktxTexture_GetData(ktxTextureData));
+  char *dstData = static_cast<char *>(description.data);
 
-  if (ktxTextureData->isCubemap) {
-    size_t faceSize = ktxTexture_GetImageSize(ktxTextureData, 0);
-
-    char *dstData = static_cast<char *>(description.data);
+  for (uint32_t i = 0; i < ktxTextureData->numLevels; ++i) {
+    size_t faceSize = ktxTexture_GetImageSize(ktxTextureData, i);
 
-    for (size_t i = 0; i < CUBEMAP_SIDES; ++i) {
+    for (uint32_t face = 0; face < numFaces; ++face) {
       size_t offset = 0;
-      ktxTexture_GetImageOffset(ktxTextureData, 0, 0,
-                                static_cast<ktx_uint32_t>(i), &offset);
+      ktxTexture_GetImageOffset(ktxTextureData, i, 0, face, &offset);
 
-      memcpy(dstData + faceSize * i, srcData + offset, faceSize);
+      memcpy(dstData + levels.at(i).offset + faceSize * face, srcData + offset,
+             faceSize);
     }
-  } else {
-    memcpy(description.data, srcData, description.size);
   }
 
+  description.levels = levels;
+
   ktxTexture_Destroy(ktxTextureData);
 
   return mRegistry.setTexture(description);
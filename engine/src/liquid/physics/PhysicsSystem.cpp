@@ -624,6 +624,8 @@ void PhysicsSystem::synchronizeTransforms(EntityDatabase &entityDatabase) {
           transform.localPosition = position;
           transform.localRotation = rotation;
         }
+
+        entityDatabase.markComponentChanged<LocalTransformComponent>(entity);
       }
     }
   }
@@ -12,6 +12,14 @@ ImguiDebugLayer::ImguiDebugLayer(
     : mPhysicalDeviceInfo(physicalDeviceInfo), mResourceRegistry(registry),
       mFpsCounter(fpsCounter), mDeviceStats(deviceStats) {}
 
+void ImguiDebugLayer::setEntityDatabase(const EntityDatabase &entityDatabase) {
+  mEntityDatabase = &entityDatabase;
+}
+
+void ImguiDebugLayer::setAssetRegistry(const AssetRegistry &assetRegistry) {
+  mAssetRegistry = &assetRegistry;
+}
+
 void ImguiDebugLayer::renderMenu() {
   if (ImGui::BeginMenu("Debug")) {
     ImGui::MenuItem("Physical Device Information", nullptr,
@@ -20,6 +28,15 @@ void ImguiDebugLayer::renderMenu() {
 
     ImGui::MenuItem("Performance Metrics", nullptr,
                     &mPerformanceMetricsVisible);
+
+    if (mEntityDatabase) {
+      ImGui::MenuItem("Entity Database Memory", nullptr,
+                      &mEntityDatabaseMemoryVisible);
+    }
+
+    if (mAssetRegistry) {
+      ImGui::MenuItem("Mesh Memory", nullptr, &mMeshMemoryVisible);
+    }
     ImGui::EndMenu();
   }
 }
@@ -28,6 +45,8 @@ void ImguiDebugLayer::render() {
   renderPhysicalDeviceInfo();
   renderUsageMetrics();
   renderPerformanceMetrics();
+  renderEntityDatabaseMemory();
+  renderMeshMemory();
 }
 
 void ImguiDebugLayer::renderPerformanceMetrics() {
@@ -95,6 +114,8 @@ void ImguiDebugLayer::renderUsageMetrics() {
     // Draw calls
     renderTableRow("Number of draw calls",
                    std::to_string(mDeviceStats.getDrawCallsCount()));
+    renderTableRow("Number of draw calls saved by instancing",
+                   std::to_string(mDeviceStats.getSavedDrawCallsCount()));
     renderTableRow("Number of drawn primitives",
                    std::to_string(mDeviceStats.getDrawnPrimitivesCount()));
     renderTableRow("Number of command calls",
@@ -106,6 +127,108 @@ void ImguiDebugLayer::renderUsageMetrics() {
   ImGui::End();
 }
 
+void ImguiDebugLayer::renderEntityDatabaseMemory() {
+  if (!mEntityDatabaseMemoryVisible || !mEntityDatabase)
+    return;
+
+  ImGui::Begin("Entity Database Memory", &mEntityDatabaseMemoryVisible,
+               ImGuiWindowFlags_NoDocking);
+
+  if (ImGui::BeginTable("Table", 5,
+                        ImGuiTableFlags_Borders |
+                            ImGuiTableColumnFlags_WidthStretch |
+                            ImGuiTableFlags_RowBg)) {
+    ImGui::TableSetupColumn("Component");
+    ImGui::TableSetupColumn("Count");
+    ImGui::TableSetupColumn("Sparse (bytes)");
+    ImGui::TableSetupColumn("Dense (bytes)");
+    ImGui::TableSetupColumn("Shared");
+    ImGui::TableHeadersRow();
+
+    size_t sparseMemory = 0;
+    size_t denseMemory = 0;
+    for (const auto &usage : mEntityDatabase->getMemoryUsage()) {
+      ImGui::TableNextRow();
+      ImGui::TableSetColumnIndex(0);
+      ImGui::Text("%s", usage.name.c_str());
+      ImGui::TableSetColumnIndex(1);
+      ImGui::Text("%zu", usage.size);
+      ImGui::TableSetColumnIndex(2);
+      ImGui::Text("%zu", usage.sparseMemory);
+      ImGui::TableSetColumnIndex(3);
+      ImGui::Text("%zu", usage.denseMemory);
+      ImGui::TableSetColumnIndex(4);
+      ImGui::Text("%s", usage.shared ? "Yes" : "No");
+
+      sparseMemory += usage.sparseMemory;
+      denseMemory += usage.denseMemory;
+    }
+
+    ImGui::TableNextRow();
+    ImGui::TableSetColumnIndex(0);
+    ImGui::Text("Total");
+    ImGui::TableSetColumnIndex(1);
+    ImGui::Text("%zu", mEntityDatabase->getEntityCount());
+    ImGui::TableSetColumnIndex(2);
+    ImGui::Text("%zu", sparseMemory);
+    ImGui::TableSetColumnIndex(3);
+    ImGui::Text("%zu", denseMemory);
+
+    ImGui::EndTable();
+  }
+
+  ImGui::End();
+}
+
+void ImguiDebugLayer::renderMeshMemory() {
+  if (!mMeshMemoryVisible || !mAssetRegistry)
+    return;
+
+  ImGui::Begin("Mesh Memory", &mMeshMemoryVisible,
+               ImGuiWindowFlags_NoDocking);
+
+  if (ImGui::BeginTable("Table", 6,
+                        ImGuiTableFlags_Borders |
+                            ImGuiTableColumnFlags_WidthStretch |
+                            ImGuiTableFlags_RowBg)) {
+    ImGui::TableSetupColumn("Arena");
+    ImGui::TableSetupColumn("Allocations");
+    ImGui::TableSetupColumn("Used (bytes)");
+    ImGui::TableSetupColumn("Capacity (bytes)");
+    ImGui::TableSetupColumn("Free blocks");
+    ImGui::TableSetupColumn("Fragmentation");
+    ImGui::TableHeadersRow();
+
+    std::array<std::pair<const char *, const MeshArena *>, 3> arenas{
+        {{"Mesh vertices", &mAssetRegistry->getMeshVertexArena()},
+         {"Skinned mesh vertices",
+          &mAssetRegistry->getSkinnedMeshVertexArena()},
+         {"Mesh indices", &mAssetRegistry->getMeshIndexArena()}}};
+
+    for (const auto &[name, arena] : arenas) {
+      const auto &allocator = arena->getAllocator();
+
+      ImGui::TableNextRow();
+      ImGui::TableSetColumnIndex(0);
+      ImGui::Text("%s", name);
+      ImGui::TableSetColumnIndex(1);
+      ImGui::Text("%zu", allocator.getNumAllocations());
+      ImGui::TableSetColumnIndex(2);
+      ImGui::Text("%zu", allocator.getUsedSize() * arena->getStride());
+      ImGui::TableSetColumnIndex(3);
+      ImGui::Text("%zu", allocator.getCapacity() * arena->getStride());
+      ImGui::TableSetColumnIndex(4);
+      ImGui::Text("%zu", allocator.getNumFreeBlocks());
+      ImGui::TableSetColumnIndex(5);
+      ImGui::Text("%.1f%%", allocator.getFragmentation() * 100.0f);
+    }
+
+    ImGui::EndTable();
+  }
+
+  ImGui::End();
+}
+
 void ImguiDebugLayer::renderPhysicalDeviceInfo() {
   if (!mPhysicalDeviceInfoVisible)
     return;
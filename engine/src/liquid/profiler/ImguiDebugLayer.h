@@ -4,6 +4,8 @@
 #include "liquid/rhi/PhysicalDeviceInformation.h"
 #include "liquid/rhi/ResourceRegistry.h"
 #include "liquid/rhi/DeviceStats.h"
+#include "liquid/entity/EntityDatabase.h"
+#include "liquid/asset/AssetRegistry.h"
 
 namespace liquid {
 
@@ -28,6 +30,20 @@ public:
                   rhi::ResourceRegistry &registry,
                   const FPSCounter &fpsCounter);
 
+  /**
+   * @brief Set entity database for memory metrics
+   *
+   * @param entityDatabase Entity database
+   */
+  void setEntityDatabase(const EntityDatabase &entityDatabase);
+
+  /**
+   * @brief Set asset registry for mesh memory metrics
+   *
+   * @param assetRegistry Asset registry
+   */
+  void setAssetRegistry(const AssetRegistry &assetRegistry);
+
   /**
    * @brief Render debug menu
    */
@@ -54,6 +70,16 @@ private:
    */
   void renderUsageMetrics();
 
+  /**
+   * @brief Render entity database memory usage
+   */
+  void renderEntityDatabaseMemory();
+
+  /**
+   * @brief Render mesh arena memory usage
+   */
+  void renderMeshMemory();
+
   /**
    * @brief Render two col row
    *
@@ -75,10 +101,14 @@ private:
   const FPSCounter &mFpsCounter;
   const rhi::DeviceStats &mDeviceStats;
   rhi::ResourceRegistry &mResourceRegistry;
+  const EntityDatabase *mEntityDatabase = nullptr;
+  const AssetRegistry *mAssetRegistry = nullptr;
 
   bool mUsageMetricsVisible = false;
   bool mPhysicalDeviceInfoVisible = false;
   bool mPerformanceMetricsVisible = false;
+  bool mEntityDatabaseMemoryVisible = false;
+  bool mMeshMemoryVisible = false;
 };
 
 } // namespace liquid
@@ -0,0 +1,200 @@
+#include "liquid/core/Base.h"
+
+#include "liquid/rhi/RenderHandle.h"
+#include "liquid/rhi/ResourceRegistry.h"
+#include "RenderStorage.h"
+#include "CullingStorage.h"
+
+namespace liquid {
+
+/**
+ * @brief Check if box is visible from view
+ *
+ * Same test as the one in culling shader
+ *
+ * @param view View data
+ * @param box Bounding box in world space
+ * @retval true Box is visible
+ * @retval false Box is not visible
+ */
+static bool isVisible(const CullingStorage::ViewData &view,
+                      const BoundingBox &box) {
+  glm::vec3 center = (box.min + box.max) * 0.5f;
+  glm::vec3 extent = (box.max - box.min) * 0.5f;
+
+  bool outside = false;
+  for (const auto &plane : view.planes) {
+    glm::vec3 normal{plane};
+    float distance = glm::dot(normal, center) + plane.w;
+    float radius = glm::dot(glm::abs(normal), extent);
+    outside |= distance + radius < 0.0f;
+  }
+
+  return !outside;
+}
+
+CullingStorage::CullingStorage(size_t reservedSpace)
+    : mReservedSpace(reservedSpace) {
+  mInstances.reserve(mReservedSpace);
+  mViews.reserve(RenderStorage::MAX_NUM_LIGHTS + 1);
+}
+
+void CullingStorage::addView(const Frustum &frustum) {
+  ViewData view{};
+  for (size_t i = 0; i < Frustum::NUM_PLANES; ++i) {
+    view.planes.at(i) = frustum.getPlane(i);
+  }
+
+  mViews.push_back(view);
+}
+
+void CullingStorage::addMesh(MeshAssetHandle handle, const MeshAsset &mesh,
+                             const std::vector<uint32_t> &items) {
+  GroupData group{};
+  group.boundsMin = glm::vec4(mesh.boundingBox.min, 1.0f);
+  group.boundsMax = glm::vec4(mesh.boundingBox.max, 1.0f);
+  group.firstDraw = static_cast<uint32_t>(mDraws.size());
+  group.numDraws = static_cast<uint32_t>(mesh.geometries.size());
+  group.firstInstance = static_cast<uint32_t>(mInstances.size());
+
+  auto groupIndex = static_cast<uint32_t>(mGroups.size());
+  for (auto item : items) {
+    mInstances.push_back({item, groupIndex});
+  }
+
+  for (size_t g = 0; g < mesh.geometries.size(); ++g) {
+    const auto &geometry = mesh.geometries.at(g);
+    bool indexed = !geometry.indices.empty();
+
+    DrawCommand draw{};
+    if (indexed) {
+      draw.indexCount = static_cast<uint32_t>(geometry.indices.size());
+      draw.firstIndex = mesh.indexOffsets.at(g);
+      draw.vertexOffset = static_cast<int32_t>(mesh.vertexOffsets.at(g));
+    } else {
+      draw.indexCount = static_cast<uint32_t>(geometry.vertices.size());
+      draw.firstIndex = mesh.vertexOffsets.at(g);
+    }
+    mDraws.push_back(draw);
+    mIndexedDraws.push_back(indexed);
+  }
+
+  mGroups.push_back(group);
+  mMeshDraws.push_back({handle, group.firstDraw});
+}
+
+void CullingStorage::buildDrawCommands() {
+  mDrawCommands.resize(mViews.size() * mDraws.size());
+
+  for (size_t view = 0; view < mViews.size(); ++view) {
+    auto viewInstance = static_cast<uint32_t>(view * mInstances.size());
+
+    for (const auto &group : mGroups) {
+      for (uint32_t i = 0; i < group.numDraws; ++i) {
+        auto draw = group.firstDraw + i;
+        auto &command = mDrawCommands.at(view * mDraws.size() + draw);
+        command = mDraws.at(draw);
+
+        uint32_t firstInstance = viewInstance + group.firstInstance;
+        if (mIndexedDraws.at(draw)) {
+          command.firstInstance = firstInstance;
+        } else {
+          command.vertexOffset = static_cast<int32_t>(firstInstance);
+        }
+      }
+    }
+  }
+}
+
+void CullingStorage::updateBuffers(rhi::ResourceRegistry &registry) {
+  buildDrawCommands();
+
+  mViewsBuffer = setBuffer(registry, mViewsBuffer, rhi::BufferType::Storage,
+                           mViews.data(), mViews.size() * sizeof(ViewData),
+                           (RenderStorage::MAX_NUM_LIGHTS + 1) *
+                               sizeof(ViewData),
+                           true);
+
+  mGroupsBuffer = setBuffer(registry, mGroupsBuffer, rhi::BufferType::Storage,
+                            mGroups.data(), mGroups.size() * sizeof(GroupData),
+                            mReservedSpace * sizeof(GroupData), true);
+
+  mInstancesBuffer = setBuffer(
+      registry, mInstancesBuffer, rhi::BufferType::Storage, mInstances.data(),
+      mInstances.size() * sizeof(InstanceData),
+      mReservedSpace * sizeof(InstanceData), true);
+
+  mDrawsBuffer = setBuffer(
+      registry, mDrawsBuffer, rhi::BufferType::Indirect, mDrawCommands.data(),
+      mDrawCommands.size() * sizeof(DrawCommand),
+      mReservedSpace * sizeof(DrawCommand), true);
+
+  // Visible instances are only written by
+  // culling pass; so, nothing is uploaded
+  mVisibleInstancesBuffer =
+      setBuffer(registry, mVisibleInstancesBuffer, rhi::BufferType::Storage,
+                nullptr, mViews.size() * mInstances.size() * sizeof(uint32_t),
+                mReservedSpace * sizeof(uint32_t), false);
+}
+
+void CullingStorage::cull(const std::vector<glm::mat4> &transforms) {
+  buildDrawCommands();
+  mVisibleInstances.assign(mViews.size() * mInstances.size(), 0);
+
+  // Every iteration is one invocation of culling shader
+  for (size_t view = 0; view < mViews.size(); ++view) {
+    for (const auto &instance : mInstances) {
+      const auto &group = mGroups.at(instance.group);
+      BoundingBox bounds{glm::vec3(group.boundsMin),
+                         glm::vec3(group.boundsMax)};
+
+      if (!isVisible(mViews.at(view),
+                     bounds.transform(transforms.at(instance.item)))) {
+        continue;
+      }
+
+      size_t firstDraw = view * mDraws.size() + group.firstDraw;
+      uint32_t slot = mDrawCommands.at(firstDraw).instanceCount;
+      for (size_t i = 0; i < group.numDraws; ++i) {
+        mDrawCommands.at(firstDraw + i).instanceCount++;
+      }
+
+      mVisibleInstances.at(view * mInstances.size() + group.firstInstance +
+                           slot) = instance.item;
+    }
+  }
+}
+
+void CullingStorage::clear() {
+  mViews.clear();
+  mGroups.clear();
+  mInstances.clear();
+  mMeshDraws.clear();
+  mDraws.clear();
+  mIndexedDraws.clear();
+  mDrawCommands.clear();
+  mVisibleInstances.clear();
+}
+
+rhi::BufferHandle CullingStorage::setBuffer(rhi::ResourceRegistry &registry,
+                                            rhi::BufferHandle handle,
+                                            rhi::BufferType type, void *data,
+                                            size_t dataSize,
+                                            size_t reservedSize, bool dynamic) {
+  size_t size = reservedSize;
+  if (rhi::isHandleValid(handle)) {
+    size = registry.getBufferMap().getDescription(handle).size;
+  }
+
+  while (size < dataSize) {
+    size *= 2;
+  }
+
+  // Nothing is uploaded if there is no data
+  bool hasData = data && dataSize > 0;
+  return registry.setBuffer(
+      {type, size, hasData ? data : nullptr, hasData ? dataSize : 0, dynamic},
+      handle);
+}
+
+} // namespace liquid
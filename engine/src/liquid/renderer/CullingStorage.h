@@ -0,0 +1,361 @@
+#pragma once
+
+#include "liquid/rhi/ResourceRegistry.h"
+#include "liquid/asset/MeshAsset.h"
+#include "Frustum.h"
+
+namespace liquid {
+
+/**
+ * @brief Culling storage
+ *
+ * Stores inputs and outputs of mesh culling
+ * compute pass. Every view has its own draw
+ * commands and list of visible instances.
+ */
+class CullingStorage {
+public:
+  /**
+   * Default reserved space for buffers
+   */
+  static constexpr size_t DEFAULT_RESERVED_SPACE = 10000;
+
+  /**
+   * Number of invocations in culling workgroup
+   */
+  static constexpr uint32_t WORKGROUP_SIZE = 64;
+
+  /**
+   * @brief Draw command
+   *
+   * Layout matches VkDrawIndexedIndirectCommand.
+   * Commands of non-indexed geometries use the
+   * layout of VkDrawIndirectCommand, where
+   * vertex offset is the first instance.
+   */
+  struct DrawCommand {
+    /**
+     * Index or vertex count
+     */
+    uint32_t indexCount = 0;
+
+    /**
+     * Number of visible instances
+     */
+    uint32_t instanceCount = 0;
+
+    /**
+     * First index or first vertex in arena
+     */
+    uint32_t firstIndex = 0;
+
+    /**
+     * Vertex offset or first instance
+     */
+    int32_t vertexOffset = 0;
+
+    /**
+     * First instance
+     */
+    uint32_t firstInstance = 0;
+  };
+
+  /**
+   * @brief Group data
+   *
+   * Instances of the same mesh
+   */
+  struct GroupData {
+    /**
+     * Minimum corner of mesh bounding box
+     */
+    glm::vec4 boundsMin{0.0f};
+
+    /**
+     * Maximum corner of mesh bounding box
+     */
+    glm::vec4 boundsMax{0.0f};
+
+    /**
+     * First draw command of mesh
+     */
+    uint32_t firstDraw = 0;
+
+    /**
+     * Number of draw commands
+     */
+    uint32_t numDraws = 0;
+
+    /**
+     * First instance in visible instances
+     */
+    uint32_t firstInstance = 0;
+
+    /**
+     * Padding for std430 layout
+     */
+    uint32_t padding = 0;
+  };
+
+  /**
+   * @brief Instance data
+   */
+  struct InstanceData {
+    /**
+     * Item index in transforms
+     */
+    uint32_t item = 0;
+
+    /**
+     * Group index
+     */
+    uint32_t group = 0;
+  };
+
+  /**
+   * @brief View data
+   */
+  struct ViewData {
+    /**
+     * Frustum planes
+     */
+    std::array<glm::vec4, Frustum::NUM_PLANES> planes{};
+  };
+
+  /**
+   * @brief Mesh draws
+   */
+  struct MeshDraws {
+    /**
+     * Mesh handle
+     */
+    MeshAssetHandle handle = MeshAssetHandle::Invalid;
+
+    /**
+     * First draw command of mesh
+     */
+    uint32_t firstDraw = 0;
+  };
+
+public:
+  /**
+   * @brief Create culling storage
+   *
+   * @param reservedSpace Reserved space for buffers
+   */
+  CullingStorage(size_t reservedSpace = DEFAULT_RESERVED_SPACE);
+
+  /**
+   * @brief Add view
+   *
+   * @param frustum View frustum
+   */
+  void addView(const Frustum &frustum);
+
+  /**
+   * @brief Add mesh
+   *
+   * Every geometry of the mesh gets a draw
+   * command in every view. Draw commands point
+   * to geometry offsets in mesh arenas.
+   *
+   * @param handle Mesh handle
+   * @param mesh Mesh asset data
+   * @param items Item indices of mesh instances
+   */
+  void addMesh(MeshAssetHandle handle, const MeshAsset &mesh,
+               const std::vector<uint32_t> &items);
+
+  /**
+   * @brief Update buffers
+   *
+   * Draw commands are uploaded without
+   * instances; culling pass counts them
+   *
+   * @param registry Resource registry
+   */
+  void updateBuffers(rhi::ResourceRegistry &registry);
+
+  /**
+   * @brief Cull instances on CPU
+   *
+   * Reference implementation of culling
+   * compute shader. Fills draw commands and
+   * visible instances of every view.
+   *
+   * @param transforms Item transforms
+   */
+  void cull(const std::vector<glm::mat4> &transforms);
+
+  /**
+   * @brief Clear views and meshes
+   */
+  void clear();
+
+  /**
+   * @brief Get offset of draw command
+   *
+   * @param view View index
+   * @param draw Draw index
+   * @return Offset of draw command in draws buffer
+   */
+  inline size_t getDrawCommandOffset(uint32_t view, uint32_t draw) const {
+    return (view * mDraws.size() + draw) * sizeof(DrawCommand);
+  }
+
+  /**
+   * @brief Check if draw is indexed
+   *
+   * @param draw Draw index
+   * @retval true Draw is indexed
+   * @retval false Draw is not indexed
+   */
+  inline bool isIndexedDraw(uint32_t draw) const {
+    return mIndexedDraws.at(draw);
+  }
+
+  /**
+   * @brief Get mesh draws
+   *
+   * @return Mesh draws
+   */
+  inline const std::vector<MeshDraws> &getMeshDraws() const {
+    return mMeshDraws;
+  }
+
+  /**
+   * @brief Get draw commands
+   *
+   * @return Draw commands of every view
+   */
+  inline const std::vector<DrawCommand> &getDrawCommands() const {
+    return mDrawCommands;
+  }
+
+  /**
+   * @brief Get visible instances
+   *
+   * Only filled by CPU culling
+   *
+   * @return Visible instances of every view
+   */
+  inline const std::vector<uint32_t> &getVisibleInstances() const {
+    return mVisibleInstances;
+  }
+
+  /**
+   * @brief Get number of views
+   *
+   * @return Number of views
+   */
+  inline uint32_t getNumViews() const {
+    return static_cast<uint32_t>(mViews.size());
+  }
+
+  /**
+   * @brief Get number of instances
+   *
+   * @return Number of instances
+   */
+  inline uint32_t getNumInstances() const {
+    return static_cast<uint32_t>(mInstances.size());
+  }
+
+  /**
+   * @brief Get number of draws in one view
+   *
+   * @return Number of draws
+   */
+  inline uint32_t getNumDraws() const {
+    return static_cast<uint32_t>(mDraws.size());
+  }
+
+  /**
+   * @brief Get views buffer
+   *
+   * @return Views buffer
+   */
+  inline rhi::BufferHandle getViewsBuffer() const { return mViewsBuffer; }
+
+  /**
+   * @brief Get groups buffer
+   *
+   * @return Groups buffer
+   */
+  inline rhi::BufferHandle getGroupsBuffer() const { return mGroupsBuffer; }
+
+  /**
+   * @brief Get instances buffer
+   *
+   * @return Instances buffer
+   */
+  inline rhi::BufferHandle getInstancesBuffer() const {
+    return mInstancesBuffer;
+  }
+
+  /**
+   * @brief Get draws buffer
+   *
+   * @return Draws buffer
+   */
+  inline rhi::BufferHandle getDrawsBuffer() const { return mDrawsBuffer; }
+
+  /**
+   * @brief Get visible instances buffer
+   *
+   * @return Visible instances buffer
+   */
+  inline rhi::BufferHandle getVisibleInstancesBuffer() const {
+    return mVisibleInstancesBuffer;
+  }
+
+private:
+  /**
+   * @brief Build draw commands of every view
+   */
+  void buildDrawCommands();
+
+  /**
+   * @brief Set buffer data
+   *
+   * Keeps buffer size while data fits in the
+   * buffer and doubles the size when data does
+   * not fit. Only the data size is uploaded.
+   *
+   * @param registry Resource registry
+   * @param handle Buffer handle
+   * @param type Buffer type
+   * @param data Buffer data
+   * @param dataSize Data size
+   * @param reservedSize Initial buffer size
+   * @param dynamic Buffer is updated every frame
+   * @return Buffer handle
+   */
+  static rhi::BufferHandle setBuffer(rhi::ResourceRegistry &registry,
+                                     rhi::BufferHandle handle,
+                                     rhi::BufferType type, void *data,
+                                     size_t dataSize, size_t reservedSize,
+                                     bool dynamic);
+
+private:
+  std::vector<ViewData> mViews;
+  std::vector<GroupData> mGroups;
+  std::vector<InstanceData> mInstances;
+  std::vector<MeshDraws> mMeshDraws;
+
+  std::vector<DrawCommand> mDraws;
+  std::vector<bool> mIndexedDraws;
+
+  std::vector<DrawCommand> mDrawCommands;
+  std::vector<uint32_t> mVisibleInstances;
+
+  rhi::BufferHandle mViewsBuffer = rhi::BufferHandle::Invalid;
+  rhi::BufferHandle mGroupsBuffer = rhi::BufferHandle::Invalid;
+  rhi::BufferHandle mInstancesBuffer = rhi::BufferHandle::Invalid;
+  rhi::BufferHandle mDrawsBuffer = rhi::BufferHandle::Invalid;
+  rhi::BufferHandle mVisibleInstancesBuffer = rhi::BufferHandle::Invalid;
+
+  size_t mReservedSpace = 0;
+};
+
+} // namespace liquid
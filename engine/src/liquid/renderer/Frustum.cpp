@@ -0,0 +1,52 @@
+#include "liquid/core/Base.h"
+#include "Frustum.h"
+
+namespace liquid {
+
+Frustum::Frustum(const glm::mat4 &projectionView) {
+  // Matrix is column major; so, rows
+  // are created from every column
+  auto row = [&projectionView](glm::length_t i) {
+    return glm::vec4(projectionView[0][i], projectionView[1][i],
+                     projectionView[2][i], projectionView[3][i]);
+  };
+
+  auto x = row(0);
+  auto y = row(1);
+  auto z = row(2);
+  auto w = row(3);
+
+  // Depth range is [0, 1]; so, near plane
+  // is the third row of the matrix
+  std::array<glm::vec4, NUM_PLANES> planes{w + x, w - x, w + y,
+                                           w - y, z,     w - z};
+
+  for (size_t i = 0; i < NUM_PLANES; ++i) {
+    mX.at(i) = planes.at(i).x;
+    mY.at(i) = planes.at(i).y;
+    mZ.at(i) = planes.at(i).z;
+    mW.at(i) = planes.at(i).w;
+  }
+}
+
+bool Frustum::intersects(const BoundingBox &box) const {
+  glm::vec3 center = (box.min + box.max) * 0.5f;
+  glm::vec3 extent = (box.max - box.min) * 0.5f;
+
+  // Box is outside if it is behind any plane.
+  // All planes are tested without early exit,
+  // so that the loop can be vectorized
+  bool outside = false;
+  for (size_t i = 0; i < NUM_PLANES; ++i) {
+    float distance =
+        mX[i] * center.x + mY[i] * center.y + mZ[i] * center.z + mW[i];
+    float radius = std::abs(mX[i]) * extent.x + std::abs(mY[i]) * extent.y +
+                   std::abs(mZ[i]) * extent.z;
+
+    outside |= distance + radius < 0.0f;
+  }
+
+  return !outside;
+}
+
+} // namespace liquid
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "liquid/scene/BoundingBox.h"
+
+namespace liquid {
+
+/**
+ * @brief View frustum
+ *
+ * Plane components are stored in separate
+ * arrays, so that testing a box against all
+ * planes is vectorized by the compiler
+ */
+class Frustum {
+public:
+  /**
+   * Number of frustum planes
+   */
+  static constexpr size_t NUM_PLANES = 6;
+
+public:
+  /**
+   * @brief Create frustum that contains everything
+   */
+  Frustum() = default;
+
+  /**
+   * @brief Create frustum from projection view matrix
+   *
+   * @param projectionView Projection view matrix
+   */
+  Frustum(const glm::mat4 &projectionView);
+
+  /**
+   * @brief Check if box intersects frustum
+   *
+   * Test is conservative; boxes near the
+   * frustum corners can intersect the frustum
+   * without being visible
+   *
+   * @param box Bounding box in world space
+   * @retval true Box is inside or intersects frustum
+   * @retval false Box is outside of frustum
+   */
+  bool intersects(const BoundingBox &box) const;
+
+  /**
+   * @brief Get frustum plane
+   *
+   * Plane normals point inside the frustum
+   *
+   * @param index Plane index
+   * @return Plane normal and distance
+   */
+  inline glm::vec4 getPlane(size_t index) const {
+    return glm::vec4{mX.at(index), mY.at(index), mZ.at(index), mW.at(index)};
+  }
+
+private:
+  std::array<float, NUM_PLANES> mX{};
+  std::array<float, NUM_PLANES> mY{};
+  std::array<float, NUM_PLANES> mZ{};
+  std::array<float, NUM_PLANES> mW{};
+};
+
+} // namespace liquid
@@ -17,7 +17,8 @@ Material::Material(const std::vector<rhi::TextureHandle> &textures,
 
   if (!mProperties.empty()) {
     auto size = updateBufferData();
-    mBuffer = mRegistry.setBuffer({rhi::BufferType::Uniform, size, mData});
+    mBuffer =
+        mRegistry.setBuffer({rhi::BufferType::Uniform, size, mData, 0, true});
     mDescriptor.bind(0, mBuffer, rhi::DescriptorType::UniformBuffer);
   }
 
@@ -42,8 +43,8 @@ void Material::updateProperty(StringView name, const Property &value) {
 
   mProperties.at(index) = value;
   auto size = updateBufferData();
-  mBuffer =
-      mRegistry.setBuffer({rhi::BufferType::Uniform, size, mData}, mBuffer);
+  mBuffer = mRegistry.setBuffer(
+      {rhi::BufferType::Uniform, size, mData, 0, true}, mBuffer);
 }
 
 size_t Material::updateBufferData() {
@@ -0,0 +1,130 @@
+#include "liquid/core/Base.h"
+#include "MeshArena.h"
+
+namespace liquid {
+
+/**
+ * @brief Add upload range
+ *
+ * Parts of existing ranges that are overwritten
+ * by the new range are removed, so that ranges
+ * never overlap. Range that continues the last
+ * range is merged into it.
+ *
+ * @param ranges Upload ranges
+ * @param range New range
+ */
+static void addUploadRange(std::vector<rhi::BufferUploadRange> &ranges,
+                           const rhi::BufferUploadRange &range) {
+  if (range.size == 0) {
+    return;
+  }
+
+  size_t start = range.bufferOffset;
+  size_t end = range.bufferOffset + range.size;
+
+  std::vector<rhi::BufferUploadRange> kept;
+  kept.reserve(ranges.size() + 1);
+  for (const auto &other : ranges) {
+    size_t otherStart = other.bufferOffset;
+    size_t otherEnd = other.bufferOffset + other.size;
+
+    if (otherEnd <= start || end <= otherStart) {
+      kept.push_back(other);
+      continue;
+    }
+
+    if (otherStart < start) {
+      kept.push_back({other.dataOffset, otherStart, start - otherStart});
+    }
+
+    if (end < otherEnd) {
+      kept.push_back(
+          {other.dataOffset + (end - otherStart), end, otherEnd - end});
+    }
+  }
+
+  if (!kept.empty() &&
+      kept.back().bufferOffset + kept.back().size == range.bufferOffset &&
+      kept.back().dataOffset + kept.back().size == range.dataOffset) {
+    kept.back().size += range.size;
+  } else {
+    kept.push_back(range);
+  }
+
+  ranges = std::move(kept);
+}
+
+MeshArena::MeshArena(rhi::BufferType type, size_t stride, size_t capacity)
+    : mType(type), mStride(stride), mAllocator(capacity) {
+  LIQUID_ASSERT(capacity > 0, "Mesh arena cannot be empty");
+}
+
+uint32_t MeshArena::allocate(const void *data, size_t count) {
+  size_t offset = mAllocator.allocate(count);
+
+  if (offset == FreeListAllocator::INVALID_OFFSET) {
+    size_t capacity = mAllocator.getCapacity();
+    while (capacity - mAllocator.getEnd() < count) {
+      capacity *= 2;
+    }
+
+    mAllocator.grow(capacity);
+    mResized = true;
+    offset = mAllocator.allocate(count);
+  }
+
+  size_t size = count * mStride;
+  const auto *bytes = static_cast<const uint8_t *>(data);
+
+  addUploadRange(mPendingRanges, {mPendingData.size(), offset * mStride, size});
+  mPendingData.insert(mPendingData.end(), bytes, bytes + size);
+
+  return static_cast<uint32_t>(offset);
+}
+
+void MeshArena::free(uint32_t offset) { mAllocator.free(offset); }
+
+void MeshArena::updateBuffer(rhi::ResourceRegistry &registry) {
+  bool created = rhi::isHandleValid(mBuffer);
+  const auto &stagedBuffers = registry.getBufferMap().getStagedResources();
+
+  // Device has read the last upload; so,
+  // its data is not needed anymore
+  if (created && stagedBuffers.find(mBuffer) == stagedBuffers.end()) {
+    std::vector<uint8_t>().swap(mUploadData);
+    std::vector<rhi::BufferUploadRange>().swap(mUploadRanges);
+  }
+
+  if (created && !mResized && mPendingRanges.empty()) {
+    return;
+  }
+
+  // Data of the last upload that is not read
+  // by the device yet is uploaded together
+  // with the new data
+  size_t dataOffset = mUploadData.size();
+  for (auto range : mPendingRanges) {
+    range.dataOffset += dataOffset;
+    addUploadRange(mUploadRanges, range);
+  }
+  mUploadData.insert(mUploadData.end(), mPendingData.begin(),
+                     mPendingData.end());
+
+  std::vector<uint8_t>().swap(mPendingData);
+  mPendingRanges.clear();
+
+  rhi::BufferDescription description{};
+  description.type = mType;
+  description.size = mAllocator.getCapacity() * mStride;
+  description.keepContents = true;
+  if (!mUploadRanges.empty()) {
+    description.data = mUploadData.data();
+    description.uploadRanges = mUploadRanges;
+  }
+
+  mBuffer = registry.setBuffer(description, mBuffer);
+  mResized = false;
+}
+
+} // namespace liquid
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "liquid/core/FreeListAllocator.h"
+#include "liquid/rhi/ResourceRegistry.h"
+
+namespace liquid {
+
+/**
+ * @brief Mesh arena
+ *
+ * Single device buffer that stores vertices
+ * or indices of many geometries. Geometries
+ * are addressed by element offsets that are
+ * allocated from a free list. Buffer grows
+ * when allocations do not fit.
+ *
+ * Arena does not keep a copy of the buffer.
+ * Allocated data is only kept until the device
+ * reads it and contents of the buffer are copied
+ * on the device when the buffer grows.
+ */
+class MeshArena {
+public:
+  /**
+   * Default capacity in elements
+   */
+  static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+public:
+  /**
+   * @brief Create mesh arena
+   *
+   * @param type Buffer type
+   * @param stride Element size
+   * @param capacity Initial capacity in elements
+   */
+  MeshArena(rhi::BufferType type, size_t stride,
+            size_t capacity = DEFAULT_CAPACITY);
+
+  /**
+   * @brief Allocate elements and copy data
+   *
+   * @param data Element data
+   * @param count Number of elements
+   * @return Offset of first element
+   */
+  uint32_t allocate(const void *data, size_t count);
+
+  /**
+   * @brief Free elements
+   *
+   * Range must not be read by frames in flight
+   *
+   * @param offset Offset of first element
+   */
+  void free(uint32_t offset);
+
+  /**
+   * @brief Update device buffer
+   *
+   * Uploads only the elements that are written
+   * since last upload. Releases data of the last
+   * upload if the device has already read it.
+   *
+   * @param registry Resource registry
+   */
+  void updateBuffer(rhi::ResourceRegistry &registry);
+
+  /**
+   * @brief Get buffer
+   *
+   * @return Device buffer
+   */
+  inline rhi::BufferHandle getBuffer() const { return mBuffer; }
+
+  /**
+   * @brief Get allocator
+   *
+   * @return Free list allocator
+   */
+  inline const FreeListAllocator &getAllocator() const { return mAllocator; }
+
+  /**
+   * @brief Get element size
+   *
+   * @return Element size
+   */
+  inline size_t getStride() const { return mStride; }
+
+private:
+  rhi::BufferType mType;
+  size_t mStride = 0;
+  FreeListAllocator mAllocator;
+  bool mResized = false;
+
+  // Data that is written since last update
+  std::vector<uint8_t> mPendingData;
+  std::vector<rhi::BufferUploadRange> mPendingRanges;
+
+  // Data of the last description that
+  // is not synchronized with the device
+  std::vector<uint8_t> mUploadData;
+  std::vector<rhi::BufferUploadRange> mUploadRanges;
+
+  rhi::BufferHandle mBuffer = rhi::BufferHandle::Invalid;
+};
+
+} // namespace liquid
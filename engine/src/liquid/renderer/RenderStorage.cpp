@@ -6,12 +6,76 @@
 
 namespace liquid {
 
+/**
+ * @brief Build instances of mesh groups
+ *
+ * Items of every group are stored contiguously
+ * for camera and every light, so that every
+ * geometry is drawn with one instanced draw
+ *
+ * @tparam THandle Mesh handle type
+ * @param groups Mesh groups
+ * @param instances Instances
+ */
+template <class THandle>
+static void
+buildInstances(std::unordered_map<THandle, RenderStorage::MeshData> &groups,
+               std::vector<uint32_t> &instances) {
+  instances.clear();
+
+  for (auto &[_, data] : groups) {
+    data.firstInstance = static_cast<uint32_t>(instances.size());
+    instances.insert(instances.end(), data.indices.begin(), data.indices.end());
+
+    data.shadowFirstInstances.resize(data.shadowIndices.size());
+    for (size_t i = 0; i < data.shadowIndices.size(); ++i) {
+      const auto &indices = data.shadowIndices.at(i);
+      data.shadowFirstInstances.at(i) = static_cast<uint32_t>(instances.size());
+      instances.insert(instances.end(), indices.begin(), indices.end());
+    }
+  }
+}
+
+/**
+ * @brief Get bounds of posed skinned mesh
+ *
+ * Skinned vertices are weighted sums of the vertex
+ * transformed by its joints. So, they are always
+ * inside the box that contains mesh bounds
+ * transformed by every joint of the skeleton.
+ *
+ * @param bounds Bind pose bounding box
+ * @param skeleton Skeleton joint transforms
+ * @return Posed bounding box
+ */
+static BoundingBox getSkinnedBounds(const BoundingBox &bounds,
+                                    const std::vector<glm::mat4> &skeleton) {
+  if (skeleton.empty()) {
+    return bounds;
+  }
+
+  BoundingBox posed{glm::vec3{std::numeric_limits<float>::max()},
+                    glm::vec3{std::numeric_limits<float>::lowest()}};
+
+  // Shaders only read maximum number of joints
+  size_t numJoints = std::min(skeleton.size(), RenderStorage::MAX_NUM_JOINTS);
+  for (size_t i = 0; i < numJoints; ++i) {
+    auto jointBounds = bounds.transform(skeleton.at(i));
+    posed.extend(jointBounds.min);
+    posed.extend(jointBounds.max);
+  }
+
+  return posed;
+}
+
 RenderStorage::RenderStorage(size_t reservedSpace)
     : mReservedSpace(reservedSpace) {
   mMeshTransformMatrices.reserve(mReservedSpace);
 
   mSkinnedMeshTransformMatrices.reserve(mReservedSpace);
-  mSkeletonVector.reset(new glm::mat4[mReservedSpace * MAX_NUM_JOINTS]);
+  mSkeletonVector.reserve(mReservedSpace * MAX_NUM_JOINTS);
+  mMeshInstances.reserve(mReservedSpace);
+  mSkinnedMeshInstances.reserve(mReservedSpace);
 
   mLights.reserve(MAX_NUM_LIGHTS);
 
@@ -20,86 +84,142 @@ RenderStorage::RenderStorage(size_t reservedSpace)
 }
 
 void RenderStorage::updateBuffers(rhi::ResourceRegistry &registry) {
-  mMeshTransformsBuffer = registry.setBuffer(
-      {
-          rhi::BufferType::Storage,
-          mReservedSpace * sizeof(glm::mat4),
-          mMeshTransformMatrices.data(),
-      },
-      mMeshTransformsBuffer);
-
-  mSkinnedMeshTransformsBuffer = registry.setBuffer(
-      {
-          rhi::BufferType::Storage,
-          mReservedSpace * sizeof(glm::mat4),
-          mSkinnedMeshTransformMatrices.data(),
-      },
-      mSkinnedMeshTransformsBuffer);
-
-  mSkeletonsBuffer = registry.setBuffer(
-      {
-          rhi::BufferType::Storage,
-          mReservedSpace * MAX_NUM_JOINTS * sizeof(glm::mat4),
-          mSkeletonVector.get(),
-      },
-      mSkeletonsBuffer);
-
-  mTextTransformsBuffer = registry.setBuffer(
-      {rhi::BufferType::Storage, mReservedSpace * sizeof(glm::mat4),
-       mTextTransforms.data()},
-      mTextTransformsBuffer);
-
-  mTextGlyphsBuffer = registry.setBuffer({rhi::BufferType::Storage,
-                                          mReservedSpace * sizeof(GlyphData),
-                                          mTextGlyphs.data()},
-                                         mTextGlyphsBuffer);
-
-  mLightsBuffer = registry.setBuffer({rhi::BufferType::Storage,
-                                      mLights.capacity() * sizeof(LightData),
-                                      mLights.data()},
-                                     mLightsBuffer);
-
-  mCameraBuffer = registry.setBuffer(
-      {rhi::BufferType::Uniform, sizeof(CameraComponent), &mCameraData},
-      mCameraBuffer);
+  buildInstances(mMeshGroups, mMeshInstances);
+  buildInstances(mSkinnedMeshGroups, mSkinnedMeshInstances);
+
+  mMeshInstancesBuffer = setStorageBuffer(
+      registry, mMeshInstancesBuffer, mMeshInstances.data(),
+      mMeshInstances.size() * sizeof(uint32_t),
+      mReservedSpace * sizeof(uint32_t));
+
+  mSkinnedMeshInstancesBuffer = setStorageBuffer(
+      registry, mSkinnedMeshInstancesBuffer, mSkinnedMeshInstances.data(),
+      mSkinnedMeshInstances.size() * sizeof(uint32_t),
+      mReservedSpace * sizeof(uint32_t));
+
+  mMeshTransformsBuffer = setStorageBuffer(
+      registry, mMeshTransformsBuffer, mMeshTransformMatrices.data(),
+      mMeshTransformMatrices.size() * sizeof(glm::mat4),
+      mReservedSpace * sizeof(glm::mat4));
+
+  mSkinnedMeshTransformsBuffer = setStorageBuffer(
+      registry, mSkinnedMeshTransformsBuffer,
+      mSkinnedMeshTransformMatrices.data(),
+      mSkinnedMeshTransformMatrices.size() * sizeof(glm::mat4),
+      mReservedSpace * sizeof(glm::mat4));
+
+  mSkeletonsBuffer = setStorageBuffer(
+      registry, mSkeletonsBuffer, mSkeletonVector.data(),
+      mSkeletonVector.size() * sizeof(glm::mat4),
+      mReservedSpace * MAX_NUM_JOINTS * sizeof(glm::mat4));
+
+  mTextTransformsBuffer = setStorageBuffer(
+      registry, mTextTransformsBuffer, mTextTransforms.data(),
+      mTextTransforms.size() * sizeof(glm::mat4),
+      mReservedSpace * sizeof(glm::mat4));
+
+  mTextGlyphsBuffer = setStorageBuffer(
+      registry, mTextGlyphsBuffer, mTextGlyphs.data(),
+      mTextGlyphs.size() * sizeof(GlyphData),
+      mReservedSpace * sizeof(GlyphData));
+
+  mLightsBuffer = setStorageBuffer(registry, mLightsBuffer, mLights.data(),
+                                   mLights.size() * sizeof(LightData),
+                                   MAX_NUM_LIGHTS * sizeof(LightData));
+
+  // Per frame buffers are dynamic; RHI binds the
+  // region of the current frame through a descriptor
+  // set that is cached for every region
+  mCameraBuffer = registry.setBuffer({rhi::BufferType::Uniform,
+                                      sizeof(CameraComponent), &mCameraData, 0,
+                                      true},
+                                     mCameraBuffer);
 
   mSceneBuffer = registry.setBuffer(
-      {rhi::BufferType::Uniform, sizeof(SceneData), &mSceneData}, mSceneBuffer);
+      {rhi::BufferType::Uniform, sizeof(SceneData), &mSceneData, 0, true},
+      mSceneBuffer);
 }
 
-void RenderStorage::addMesh(MeshAssetHandle handle,
-                            const glm::mat4 &transform) {
-  mMeshTransformMatrices.push_back(transform);
-  uint32_t index = static_cast<uint32_t>(mMeshTransformMatrices.size() - 1);
+rhi::BufferHandle RenderStorage::setStorageBuffer(
+    rhi::ResourceRegistry &registry, rhi::BufferHandle handle, void *data,
+    size_t dataSize, size_t reservedSize) {
+  size_t size = reservedSize;
+  if (rhi::isHandleValid(handle)) {
+    size = registry.getBufferMap().getDescription(handle).size;
+  }
 
-  if (mMeshGroups.find(handle) == mMeshGroups.end()) {
-    MeshData data{};
-    mMeshGroups.insert_or_assign(handle, data);
+  while (size < dataSize) {
+    size *= 2;
   }
 
-  mMeshGroups.at(handle).indices.push_back(index);
+  // Nothing is uploaded if there is no data
+  return registry.setBuffer({rhi::BufferType::Storage, size,
+                             dataSize > 0 ? data : nullptr, dataSize, true},
+                            handle);
+}
+
+template <class THandle>
+bool RenderStorage::addToMeshGroup(
+    std::unordered_map<THandle, MeshData> &groups, THandle handle,
+    uint32_t index, const BoundingBox &bounds) {
+  MeshData *data = nullptr;
+
+  // Group is only created for visible items
+  auto getData = [&]() -> MeshData & {
+    if (!data) {
+      data = &groups[handle];
+      data->shadowIndices.resize(mLightFrustums.size());
+    }
+    return *data;
+  };
+
+  if (mCameraFrustum.intersects(bounds)) {
+    getData().indices.push_back(index);
+  }
+
+  for (size_t i = 0; i < mLightFrustums.size(); ++i) {
+    if (mLightFrustums.at(i).intersects(bounds)) {
+      getData().shadowIndices.at(i).push_back(index);
+    }
+  }
+
+  return data != nullptr;
+}
+
+void RenderStorage::addMesh(MeshAssetHandle handle, const glm::mat4 &transform,
+                            const BoundingBox &bounds) {
+  auto index = static_cast<uint32_t>(mMeshTransformMatrices.size());
+
+  if (mGpuMeshCulling) {
+    mMeshGroups[handle].indices.push_back(index);
+    mMeshTransformMatrices.push_back(transform);
+    return;
+  }
+
+  if (addToMeshGroup(mMeshGroups, handle, index, bounds.transform(transform))) {
+    mMeshTransformMatrices.push_back(transform);
+  }
 }
 
 void RenderStorage::addSkinnedMesh(SkinnedMeshAssetHandle handle,
                                    const glm::mat4 &transform,
-                                   const std::vector<glm::mat4> &skeleton) {
-  mSkinnedMeshTransformMatrices.push_back(transform);
-  uint32_t index =
-      static_cast<uint32_t>(mSkinnedMeshTransformMatrices.size() - 1);
-
-  if (mSkinnedMeshGroups.find(handle) == mSkinnedMeshGroups.end()) {
-    MeshData data{};
-    mSkinnedMeshGroups.insert_or_assign(handle, data);
+                                   const std::vector<glm::mat4> &skeleton,
+                                   const BoundingBox &bounds) {
+  auto index = static_cast<uint32_t>(mSkinnedMeshTransformMatrices.size());
+
+  auto posedBounds = getSkinnedBounds(bounds, skeleton);
+  if (!addToMeshGroup(mSkinnedMeshGroups, handle, index,
+                      posedBounds.transform(transform))) {
+    return;
   }
 
-  mSkinnedMeshGroups.at(handle).indices.push_back(index);
+  mSkinnedMeshTransformMatrices.push_back(transform);
 
-  auto *currentSkeleton =
-      mSkeletonVector.get() + (mLastSkeleton * MAX_NUM_JOINTS);
+  // Every skeleton takes maximum number of joints
   size_t dataSize = std::min(skeleton.size(), MAX_NUM_JOINTS);
-  memcpy(currentSkeleton, skeleton.data(), dataSize * sizeof(glm::mat4));
-
-  mLastSkeleton++;
+  mSkeletonVector.insert(mSkeletonVector.end(), skeleton.begin(),
+                         skeleton.begin() + dataSize);
+  mSkeletonVector.resize(mSkeletonVector.size() + MAX_NUM_JOINTS - dataSize);
 }
 
 void RenderStorage::addLight(const DirectionalLightComponent &light) {
@@ -126,13 +246,19 @@ void RenderStorage::addLight(const DirectionalLightComponent &light) {
       projectionViewMatrix,
   };
   mLights.push_back(data);
+  mLightFrustums.emplace_back(projectionViewMatrix);
 
   mSceneData.data.x = static_cast<int32_t>(mLights.size());
 }
 
 void RenderStorage::addText(FontAssetHandle font,
                             const std::vector<GlyphData> &glyphs,
-                            const glm::mat4 &transform) {
+                            const glm::mat4 &transform,
+                            const BoundingBox &bounds) {
+  if (!mCameraFrustum.intersects(bounds.transform(transform))) {
+    return;
+  }
+
   mTextTransforms.push_back(transform);
   uint32_t index = static_cast<uint32_t>(mTextTransforms.size() - 1);
 
@@ -163,6 +289,11 @@ void RenderStorage::setEnvironmentTextures(rhi::TextureHandle irradianceMap,
 
 void RenderStorage::setCameraData(const CameraComponent &data) {
   mCameraData = data;
+  mCameraFrustum = Frustum(data.projectionViewMatrix);
+}
+
+void RenderStorage::setGpuMeshCulling(bool enabled) {
+  mGpuMeshCulling = enabled;
 }
 
 void RenderStorage::clear() {
@@ -174,9 +305,12 @@ void RenderStorage::clear() {
   mTextGlyphs.clear();
 
   mLights.clear();
+  mLightFrustums.clear();
   mSceneData.data.x = 0;
   mSceneData.data.y = 0;
-  mLastSkeleton = 0;
+  mSkeletonVector.clear();
+  mMeshInstances.clear();
+  mSkinnedMeshInstances.clear();
   mIrradianceMap = rhi::TextureHandle::Invalid;
   mSpecularMap = rhi::TextureHandle::Invalid;
   mBrdfLUT = rhi::TextureHandle::Invalid;
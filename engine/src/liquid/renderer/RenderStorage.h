@@ -5,6 +5,7 @@
 #include "liquid/entity/Entity.h"
 #include "liquid/renderer/Material.h"
 #include "liquid/entity/EntityDatabase.h"
+#include "Frustum.h"
 
 namespace liquid {
 
@@ -18,6 +19,8 @@ class RenderStorage {
 public:
   /**
    * Default reserved space for buffers
+   *
+   * Buffers grow when they need more space
    */
   static constexpr size_t DEFAULT_RESERVED_SPACE = 10000;
 
@@ -75,8 +78,31 @@ public:
     /**
      * List of indices that point to
      * items in storage
+     *
+     * Only items that are visible
+     * from camera are listed
      */
     std::vector<uint32_t> indices;
+
+    /**
+     * List of item indices for every light
+     *
+     * Only items that are visible
+     * from the light are listed
+     */
+    std::vector<std::vector<uint32_t>> shadowIndices;
+
+    /**
+     * Position of first camera instance
+     * in instances buffer
+     */
+    uint32_t firstInstance = 0;
+
+    /**
+     * Position of first instance in
+     * instances buffer for every light
+     */
+    std::vector<uint32_t> shadowFirstInstances;
   };
 
   /**
@@ -130,6 +156,10 @@ public:
   /**
    * @brief Update storage buffers
    *
+   * Builds instance lists of mesh groups and
+   * uploads only the data that is added since
+   * the last clear
+   *
    * @param registry Resource registry
    */
   void updateBuffers(rhi::ResourceRegistry &registry);
@@ -152,6 +182,24 @@ public:
     return mSkinnedMeshTransformsBuffer;
   }
 
+  /**
+   * @brief Get mesh instances buffer
+   *
+   * @return Mesh instances buffer
+   */
+  inline rhi::BufferHandle getMeshInstancesBuffer() const {
+    return mMeshInstancesBuffer;
+  }
+
+  /**
+   * @brief Get skinned mesh instances buffer
+   *
+   * @return Skinned mesh instances buffer
+   */
+  inline rhi::BufferHandle getSkinnedMeshInstancesBuffer() const {
+    return mSkinnedMeshInstancesBuffer;
+  }
+
   /**
    * @brief Get skeletons buffer
    *
@@ -260,23 +308,65 @@ public:
    */
   inline int32_t getNumLights() const { return mSceneData.data.x; }
 
+  /**
+   * @brief Get camera frustum
+   *
+   * @return Camera frustum
+   */
+  inline const Frustum &getCameraFrustum() const { return mCameraFrustum; }
+
+  /**
+   * @brief Get light frustums
+   *
+   * @return Light frustums
+   */
+  inline const std::vector<Frustum> &getLightFrustums() const {
+    return mLightFrustums;
+  }
+
+  /**
+   * @brief Enable or disable mesh culling on GPU
+   *
+   * When enabled, meshes are not culled on CPU.
+   * Every mesh is added to the camera list and
+   * is culled for every view by the GPU.
+   *
+   * @param enabled Mesh culling on GPU is enabled
+   */
+  void setGpuMeshCulling(bool enabled);
+
   /**
    * @brief Add mesh data
    *
+   * Mesh is skipped if it is not visible from
+   * camera or any light. Camera and lights must
+   * be set before adding meshes. Mesh is always
+   * added if it is culled on GPU.
+   *
    * @param handle Mesh handle
    * @param transform Mesh world transform
+   * @param bounds Mesh bounding box
    */
-  void addMesh(MeshAssetHandle handle, const glm::mat4 &transform);
+  void addMesh(MeshAssetHandle handle, const glm::mat4 &transform,
+               const BoundingBox &bounds);
 
   /**
    * @brief Add skinned mesh data
    *
+   * Skinned mesh is skipped if it is not visible
+   * from camera or any light. Camera and lights
+   * must be set before adding skinned meshes.
+   * Bounding box is posed with skeleton joints
+   * before it is tested for visibility.
+   *
    * @param handle Skinned mesh handle
    * @param transform Skinned mesh world transform
    * @param skeleton Skeleton joint transforms
+   * @param bounds Skinned mesh bind pose bounding box
    */
   void addSkinnedMesh(SkinnedMeshAssetHandle handle, const glm::mat4 &transform,
-                      const std::vector<glm::mat4> &skeleton);
+                      const std::vector<glm::mat4> &skeleton,
+                      const BoundingBox &bounds);
 
   /**
    * @brief Add directional light
@@ -288,12 +378,15 @@ public:
   /**
    * @brief Add text
    *
+   * Text is skipped if it is not visible from camera
+   *
    * @param fontHandle Font handle
    * @param glyphs Text glyphs
    * @param transform Text world transform
+   * @param bounds Text bounding box
    */
   void addText(FontAssetHandle fontHandle, const std::vector<GlyphData> &glyphs,
-               const glm::mat4 &transform);
+               const glm::mat4 &transform, const BoundingBox &bounds);
 
   /**
    * @brief Set environment textures
@@ -318,19 +411,63 @@ public:
    */
   void clear();
 
+  /**
+   * @brief Set storage buffer data
+   *
+   * Keeps buffer size while data fits in the
+   * buffer and doubles the size when data does
+   * not fit. Only the data size is uploaded.
+   *
+   * @param registry Resource registry
+   * @param handle Buffer handle
+   * @param data Buffer data
+   * @param dataSize Data size
+   * @param reservedSize Initial buffer size
+   * @return Buffer handle
+   */
+  static rhi::BufferHandle setStorageBuffer(rhi::ResourceRegistry &registry,
+                                            rhi::BufferHandle handle,
+                                            void *data, size_t dataSize,
+                                            size_t reservedSize);
+
+private:
+  /**
+   * @brief Add item to mesh group
+   *
+   * Item is added to camera list and
+   * to lists of lights that see it
+   *
+   * @tparam THandle Mesh handle type
+   * @param groups Mesh groups
+   * @param handle Mesh handle
+   * @param index Item index
+   * @param bounds World space bounding box
+   * @retval true Item is visible
+   * @retval false Item is not visible
+   */
+  template <class THandle>
+  bool addToMeshGroup(std::unordered_map<THandle, MeshData> &groups,
+                      THandle handle, uint32_t index,
+                      const BoundingBox &bounds);
+
 private:
   std::vector<glm::mat4> mMeshTransformMatrices;
   std::vector<glm::mat4> mSkinnedMeshTransformMatrices;
-  std::unique_ptr<glm::mat4> mSkeletonVector;
+  std::vector<glm::mat4> mSkeletonVector;
+  std::vector<uint32_t> mMeshInstances;
+  std::vector<uint32_t> mSkinnedMeshInstances;
   std::vector<LightData> mLights;
   SceneData mSceneData{};
   CameraComponent mCameraData;
-
-  size_t mLastSkeleton = 0;
+  Frustum mCameraFrustum;
+  std::vector<Frustum> mLightFrustums;
+  bool mGpuMeshCulling = false;
 
   rhi::BufferHandle mMeshTransformsBuffer = rhi::BufferHandle::Invalid;
   rhi::BufferHandle mSkinnedMeshTransformsBuffer = rhi::BufferHandle::Invalid;
   rhi::BufferHandle mSkeletonsBuffer = rhi::BufferHandle::Invalid;
+  rhi::BufferHandle mMeshInstancesBuffer = rhi::BufferHandle::Invalid;
+  rhi::BufferHandle mSkinnedMeshInstancesBuffer = rhi::BufferHandle::Invalid;
   rhi::BufferHandle mSceneBuffer = rhi::BufferHandle::Invalid;
   rhi::BufferHandle mLightsBuffer = rhi::BufferHandle::Invalid;
   rhi::BufferHandle mCameraBuffer = rhi::BufferHandle::Invalid;
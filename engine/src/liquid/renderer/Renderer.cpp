@@ -13,8 +13,8 @@
 namespace liquid {
 
 Renderer::Renderer(AssetRegistry &assetRegistry, Window &window,
-                   rhi::RenderDevice *device)
-    : mGraphEvaluator(mRegistry), mDevice(device),
+                   rhi::RenderDevice *device, JobSystem &jobSystem)
+    : mJobSystem(jobSystem), mGraphEvaluator(mRegistry), mDevice(device),
       mImguiRenderer(window, mShaderLibrary, mRegistry),
       mAssetRegistry(assetRegistry),
       mSceneRenderer(mShaderLibrary, mRegistry, mAssetRegistry) {}
@@ -27,7 +27,7 @@ void Renderer::render(rhi::RenderGraph &graph,
   mGraphEvaluator.build(graph);
 
   mDevice->synchronize(mRegistry);
-  mGraphEvaluator.execute(commandList, graph);
+  mGraphEvaluator.execute(commandList, graph, mJobSystem);
 }
 
 } // namespace liquid
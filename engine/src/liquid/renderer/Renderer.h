@@ -1,5 +1,6 @@
 #pragma once
 
+#include "liquid/core/JobSystem.h"
 #include "liquid/rhi/RenderDevice.h"
 #include "ShaderLibrary.h"
 #include "MaterialPBR.h"
@@ -51,9 +52,10 @@ public:
    * @param assetRegistry Asset registry
    * @param window Window
    * @param device Render device
+   * @param jobSystem Job system
    */
   Renderer(AssetRegistry &assetRegistry, Window &window,
-           rhi::RenderDevice *device);
+           rhi::RenderDevice *device, JobSystem &jobSystem);
 
   ~Renderer() = default;
   Renderer(const Renderer &rhs) = delete;
@@ -99,6 +101,9 @@ public:
   /**
    * @brief Render
    *
+   * Passes are recorded in parallel
+   * by job system
+   *
    * @param graph Render graph
    * @param commandList Render command list
    */
@@ -110,6 +115,7 @@ public:
   inline void wait() { mDevice->waitForIdle(); }
 
 private:
+  JobSystem &mJobSystem;
   rhi::ResourceRegistry mRegistry;
   rhi::RenderGraphEvaluator mGraphEvaluator;
   rhi::RenderDevice *mDevice;
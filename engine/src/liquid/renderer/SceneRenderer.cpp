@@ -6,6 +6,26 @@
 
 namespace liquid {
 
+/**
+ * @brief Get instances of visible items
+ *
+ * @param meshData Mesh data
+ * @param lightIndex Light index or camera view
+ * @return First instance and number of instances
+ */
+static std::pair<uint32_t, uint32_t>
+getVisibleInstances(const RenderStorage::MeshData &meshData,
+                    int32_t lightIndex) {
+  if (lightIndex < 0) {
+    return {meshData.firstInstance,
+            static_cast<uint32_t>(meshData.indices.size())};
+  }
+
+  auto light = static_cast<size_t>(lightIndex);
+  return {meshData.shadowFirstInstances.at(light),
+          static_cast<uint32_t>(meshData.shadowIndices.at(light).size())};
+}
+
 SceneRenderer::SceneRenderer(ShaderLibrary &shaderLibrary,
                              rhi::ResourceRegistry &resourceRegistry,
                              AssetRegistry &assetRegistry)
@@ -47,12 +67,21 @@ SceneRenderer::SceneRenderer(ShaderLibrary &shaderLibrary,
   mShaderLibrary.addShader(
       "__engine.text.default.fragment",
       mRegistry.setShader({assetsPath + "/shaders/text.frag.spv"}));
+
+  mShaderLibrary.addShader(
+      "__engine.culling.default.compute",
+      mRegistry.setShader({assetsPath + "/shaders/cullMeshes.comp.spv"}));
 }
 
 void SceneRenderer::setClearColor(const glm::vec4 &clearColor) {
   mClearColor = clearColor;
 }
 
+void SceneRenderer::setGpuDrivenRendering(bool enabled) {
+  mGpuDriven = enabled;
+  mRenderStorage.setGpuMeshCulling(enabled);
+}
+
 SceneRenderPassData SceneRenderer::attach(rhi::RenderGraph &graph) {
   constexpr uint32_t NUM_LIGHTS = 16;
   constexpr uint32_t SHADOWMAP_DIMENSIONS = 2048;
@@ -85,9 +114,67 @@ SceneRenderPassData SceneRenderer::attach(rhi::RenderGraph &graph) {
   depthBufferDesc.format = VK_FORMAT_D32_SFLOAT;
   auto depthBuffer = mRegistry.setTexture(depthBufferDesc);
 
+  if (mGpuDriven) {
+    // Buffers must exist before passes depend on them
+    mCullingStorage.updateBuffers(mRegistry);
+
+    auto &pass = graph.addPass("cullingPass");
+    pass.write(mCullingStorage.getDrawsBuffer());
+    pass.write(mCullingStorage.getVisibleInstancesBuffer());
+
+    rhi::PipelineDescription pipelineDesc{};
+    pipelineDesc.computeShader =
+        mShaderLibrary.getShader("__engine.culling.default.compute");
+    auto pipeline = mRegistry.setPipeline(pipelineDesc);
+    pass.addPipeline(pipeline);
+
+    pass.setExecutor([pipeline, this](rhi::RenderCommandList &commandList) {
+      auto numInstances = mCullingStorage.getNumInstances();
+      if (numInstances == 0) {
+        return;
+      }
+
+      commandList.bindPipeline(pipeline);
+
+      static constexpr uint32_t DRAWS_BINDING = 4;
+      static constexpr uint32_t VISIBLE_INSTANCES_BINDING = 5;
+
+      rhi::Descriptor descriptor;
+      descriptor
+          .bind(0, mRenderStorage.getMeshTransformsBuffer(),
+                rhi::DescriptorType::StorageBuffer)
+          .bind(1, mCullingStorage.getGroupsBuffer(),
+                rhi::DescriptorType::StorageBuffer)
+          .bind(2, mCullingStorage.getInstancesBuffer(),
+                rhi::DescriptorType::StorageBuffer)
+          .bind(3, mCullingStorage.getViewsBuffer(),
+                rhi::DescriptorType::StorageBuffer)
+          .bind(DRAWS_BINDING, mCullingStorage.getDrawsBuffer(),
+                rhi::DescriptorType::StorageBuffer)
+          .bind(VISIBLE_INSTANCES_BINDING,
+                mCullingStorage.getVisibleInstancesBuffer(),
+                rhi::DescriptorType::StorageBuffer);
+      commandList.bindDescriptor(pipeline, 0, descriptor);
+
+      glm::uvec4 counts{numInstances, mCullingStorage.getNumDraws(), 0, 0};
+      commandList.pushConstants(pipeline, VK_SHADER_STAGE_COMPUTE_BIT, 0,
+                                sizeof(glm::uvec4), glm::value_ptr(counts));
+
+      // Every row of workgroups culls one view
+      uint32_t groupCount =
+          (numInstances + CullingStorage::WORKGROUP_SIZE - 1) /
+          CullingStorage::WORKGROUP_SIZE;
+      commandList.dispatch(groupCount, mCullingStorage.getNumViews());
+    });
+  } // culling pass
+
   {
     auto &pass = graph.addPass("shadowPass");
     pass.write(shadowmap, rhi::DepthStencilClear{1.0f, 0});
+    if (mGpuDriven) {
+      pass.read(mCullingStorage.getDrawsBuffer());
+      pass.read(mCullingStorage.getVisibleInstancesBuffer());
+    }
 
     auto pipeline = mRegistry.setPipeline(rhi::PipelineDescription{
         mShaderLibrary.getShader("__engine.shadowmap.default.vertex"),
@@ -126,7 +213,8 @@ SceneRenderPassData SceneRenderer::attach(rhi::RenderGraph &graph) {
 
           commandList.pushConstants(pipeline, VK_SHADER_STAGE_VERTEX_BIT, 0,
                                     sizeof(glm::ivec4), &pcIndex);
-          render(commandList, pipeline, false);
+          render(commandList, pipeline, false, index, 0,
+                 mRenderStorage.getMeshGroups().size());
         }
       }
 
@@ -141,8 +229,8 @@ SceneRenderPassData SceneRenderer::attach(rhi::RenderGraph &graph) {
 
           commandList.pushConstants(skinnedPipeline, VK_SHADER_STAGE_VERTEX_BIT,
                                     0, sizeof(glm::ivec4), &pcIndex);
-          renderSkinned(commandList, skinnedPipeline, false);
-          index++;
+          renderSkinned(commandList, skinnedPipeline, false, index, 0,
+                        mRenderStorage.getSkinnedMeshGroups().size());
         }
       }
     });
@@ -151,6 +239,10 @@ SceneRenderPassData SceneRenderer::attach(rhi::RenderGraph &graph) {
   {
     auto &pass = graph.addPass("meshPass");
     pass.read(shadowmap);
+    if (mGpuDriven) {
+      pass.read(mCullingStorage.getDrawsBuffer());
+      pass.read(mCullingStorage.getVisibleInstancesBuffer());
+    }
     pass.write(sceneColor, mClearColor);
     pass.write(depthBuffer, rhi::DepthStencilClear{1.0, 0});
 
@@ -175,10 +267,16 @@ SceneRenderPassData SceneRenderer::attach(rhi::RenderGraph &graph) {
     pass.addPipeline(pipeline);
     pass.addPipeline(skinnedPipeline);
 
-    pass.setExecutor([this, pipeline, skinnedPipeline,
-                      shadowmap](rhi::RenderCommandList &commandList) {
-      commandList.bindPipeline(pipeline);
+    // Mesh groups are followed by skinned mesh groups;
+    // every range of groups binds its own state
+    auto getItemCount = [this]() {
+      return mRenderStorage.getMeshGroups().size() +
+             mRenderStorage.getSkinnedMeshGroups().size();
+    };
 
+    auto executor = [this, pipeline, skinnedPipeline,
+                     shadowmap](rhi::RenderCommandList &commandList,
+                                size_t begin, size_t end) {
       rhi::Descriptor sceneDescriptor, sceneDescriptorFragment;
 
       static constexpr uint32_t BRDF_BINDING = 5;
@@ -200,26 +298,33 @@ SceneRenderPassData SceneRenderer::attach(rhi::RenderGraph &graph) {
           .bind(BRDF_BINDING, {mRenderStorage.getBrdfLUT()},
                 rhi::DescriptorType::CombinedImageSampler);
 
-      {
+      size_t meshCount = mRenderStorage.getMeshGroups().size();
+
+      if (begin < meshCount) {
         LIQUID_PROFILE_EVENT("meshPass::meshes");
 
         commandList.bindPipeline(pipeline);
         commandList.bindDescriptor(pipeline, 0, sceneDescriptor);
         commandList.bindDescriptor(pipeline, 2, sceneDescriptorFragment);
 
-        render(commandList, pipeline, true);
+        render(commandList, pipeline, true, CAMERA_VIEW, begin,
+               std::min(end, meshCount));
       }
 
-      {
+      if (end > meshCount) {
         LIQUID_PROFILE_EVENT("meshPass::skinnedMeshes");
 
         commandList.bindPipeline(skinnedPipeline);
         commandList.bindDescriptor(skinnedPipeline, 0, sceneDescriptor);
         commandList.bindDescriptor(skinnedPipeline, 2, sceneDescriptorFragment);
 
-        renderSkinned(commandList, skinnedPipeline, true);
+        renderSkinned(commandList, skinnedPipeline, true, CAMERA_VIEW,
+                      std::max(begin, meshCount) - meshCount,
+                      end - meshCount);
       }
-    });
+    };
+
+    pass.setRangeExecutor(getItemCount, executor);
   } // mesh pass
 
   {
@@ -256,11 +361,15 @@ SceneRenderPassData SceneRenderer::attach(rhi::RenderGraph &graph) {
                              .getAsset(mAssetRegistry.getDefaultObjects().cube)
                              .data;
 
-      commandList.bindVertexBuffer(cube.vertexBuffers.at(0));
-      commandList.bindIndexBuffer(cube.indexBuffers.at(0),
-                                  VK_INDEX_TYPE_UINT32);
+      commandList.bindVertexBuffer(
+          mAssetRegistry.getMeshVertexArena().getBuffer());
+      commandList.bindIndexBuffer(
+          mAssetRegistry.getMeshIndexArena().getBuffer(),
+          VK_INDEX_TYPE_UINT32);
       commandList.drawIndexed(
-          static_cast<uint32_t>(cube.geometries.at(0).indices.size()), 0, 0);
+          static_cast<uint32_t>(cube.geometries.at(0).indices.size()),
+          cube.indexOffsets.at(0),
+          static_cast<int32_t>(cube.vertexOffsets.at(0)));
     });
   } // environment pass
 
@@ -308,27 +417,47 @@ void SceneRenderer::updateFrameData(EntityDatabase &entityDatabase,
   mRenderStorage.setCameraData(
       entityDatabase.getComponent<CameraComponent>(camera));
 
+  // Components are only read, so that pools that
+  // are shared with editor database are not copied
+
+  // Lights are added before everything else
+  // because meshes are culled per light
+  entityDatabase.iterateEntities<const DirectionalLightComponent>(
+      [this](auto entity, const auto &light) {
+        mRenderStorage.addLight(light);
+      });
+
   // Meshes
-  entityDatabase.iterateEntities<WorldTransformComponent, MeshComponent>(
+  entityDatabase.iterateEntities<const WorldTransformComponent,
+                                 const MeshComponent>(
       [this](auto entity, const auto &world, const auto &mesh) {
-        mRenderStorage.addMesh(mesh.handle, world.worldTransform);
+        const auto &bounds =
+            mAssetRegistry.getMeshes().getAsset(mesh.handle).data.boundingBox;
+        mRenderStorage.addMesh(mesh.handle, world.worldTransform, bounds);
       });
 
   // Skinned Meshes
-  entityDatabase.iterateEntities<SkeletonComponent, WorldTransformComponent,
-                                 SkinnedMeshComponent>(
+  entityDatabase.iterateEntities<const SkeletonComponent,
+                                 const WorldTransformComponent,
+                                 const SkinnedMeshComponent>(
       [this](auto entity, const auto &skeleton, const auto &world,
              const auto &mesh) {
+        const auto &bounds = mAssetRegistry.getSkinnedMeshes()
+                                 .getAsset(mesh.handle)
+                                 .data.boundingBox;
         mRenderStorage.addSkinnedMesh(mesh.handle, world.worldTransform,
-                                      skeleton.jointFinalTransforms);
+                                      skeleton.jointFinalTransforms, bounds);
       });
 
   // Texts
-  entityDatabase.iterateEntities<TextComponent, WorldTransformComponent>(
+  entityDatabase.iterateEntities<const TextComponent,
+                                 const WorldTransformComponent>(
       [this](auto entity, const auto &text, const auto &world) {
         const auto &font = mAssetRegistry.getFonts().getAsset(text.font).data;
 
         std::vector<RenderStorage::GlyphData> glyphs(text.text.length());
+        BoundingBox bounds{glm::vec3{std::numeric_limits<float>::max()},
+                           glm::vec3{std::numeric_limits<float>::lowest()}};
         float advanceX = 0;
         float advanceY = 0;
         for (size_t i = 0; i < text.text.length(); ++i) {
@@ -349,46 +478,80 @@ void SceneRenderer::updateFrameData(EntityDatabase &entityDatabase,
           glyphs.at(i).planeBounds.y -= advanceY;
           glyphs.at(i).planeBounds.w -= advanceY;
 
+          const auto &planeBounds = glyphs.at(i).planeBounds;
+          bounds.extend({planeBounds.x, planeBounds.y, 0.0f});
+          bounds.extend({planeBounds.z, planeBounds.w, 0.0f});
+
           advanceX += fontGlyph.advanceX;
         }
 
-        mRenderStorage.addText(text.font, glyphs, world.worldTransform);
-      });
-
-  // Lights
-  entityDatabase.iterateEntities<DirectionalLightComponent>(
-      [this](auto entity, const auto &light) {
-        mRenderStorage.addLight(light);
+        mRenderStorage.addText(text.font, glyphs, world.worldTransform,
+                               bounds);
       });
 
   // Environments
-  entityDatabase.iterateEntities<EnvironmentComponent>(
+  entityDatabase.iterateEntities<const EnvironmentComponent>(
       [this](auto entity, const auto &environment) {
         mRenderStorage.setEnvironmentTextures(environment.irradianceMap,
                                               environment.specularMap,
                                               environment.brdfLUT);
       });
 
+  // Views are camera followed by lights
+  if (mGpuDriven) {
+    mCullingStorage.clear();
+    mCullingStorage.addView(mRenderStorage.getCameraFrustum());
+    for (const auto &frustum : mRenderStorage.getLightFrustums()) {
+      mCullingStorage.addView(frustum);
+    }
+
+    for (const auto &[handle, meshData] : mRenderStorage.getMeshGroups()) {
+      mCullingStorage.addMesh(
+          handle, mAssetRegistry.getMeshes().getAsset(handle).data,
+          meshData.indices);
+    }
+
+    mCullingStorage.updateBuffers(mRegistry);
+  }
+
   mRenderStorage.updateBuffers(mRegistry);
 }
 
 void SceneRenderer::render(rhi::RenderCommandList &commandList,
-                           rhi::PipelineHandle pipeline,
-                           bool bindMaterialData) {
+                           rhi::PipelineHandle pipeline, bool bindMaterialData,
+                           int32_t lightIndex, size_t begin, size_t end) {
+  if (mGpuDriven) {
+    // Camera view is the first culling view
+    renderIndirect(commandList, pipeline, bindMaterialData,
+                   static_cast<uint32_t>(lightIndex + 1), begin, end);
+    return;
+  }
+
   rhi::Descriptor descriptor;
   descriptor.bind(0, mRenderStorage.getMeshTransformsBuffer(),
                   rhi::DescriptorType::StorageBuffer);
+  descriptor.bind(1, mRenderStorage.getMeshInstancesBuffer(),
+                  rhi::DescriptorType::StorageBuffer);
   commandList.bindDescriptor(pipeline, 1, descriptor);
 
-  for (auto &[handle, meshData] : mRenderStorage.getMeshGroups()) {
+  // All meshes live in the same buffers
+  commandList.bindVertexBuffer(mAssetRegistry.getMeshVertexArena().getBuffer());
+  commandList.bindIndexBuffer(mAssetRegistry.getMeshIndexArena().getBuffer(),
+                              VK_INDEX_TYPE_UINT32);
+
+  auto it = std::next(mRenderStorage.getMeshGroups().begin(),
+                      static_cast<std::ptrdiff_t>(begin));
+  for (size_t i = begin; i < end; ++i, ++it) {
+    const auto &[handle, meshData] = *it;
+    auto [firstInstance, instanceCount] =
+        getVisibleInstances(meshData, lightIndex);
+    if (instanceCount == 0) {
+      continue;
+    }
+
     const auto &mesh = mAssetRegistry.getMeshes().getAsset(handle).data;
-    for (size_t g = 0; g < mesh.vertexBuffers.size(); ++g) {
-      commandList.bindVertexBuffer(mesh.vertexBuffers.at(g));
-      bool indexed = rhi::isHandleValid(mesh.indexBuffers.at(g));
-      if (indexed) {
-        commandList.bindIndexBuffer(mesh.indexBuffers.at(g),
-                                    VK_INDEX_TYPE_UINT32);
-      }
+    for (size_t g = 0; g < mesh.geometries.size(); ++g) {
+      bool indexed = !mesh.geometries.at(g).indices.empty();
 
       if (bindMaterialData) {
         commandList.bindDescriptor(pipeline, 3,
@@ -400,12 +563,83 @@ void SceneRenderer::render(rhi::RenderCommandList &commandList,
       uint32_t vertexCount =
           static_cast<uint32_t>(mesh.geometries.at(g).vertices.size());
 
-      for (auto index : meshData.indices) {
-        if (indexed) {
-          commandList.drawIndexed(indexCount, 0, 0, 1, index);
-        } else {
-          commandList.draw(vertexCount, 0, 1, index);
-        }
+      // All visible items of the group are drawn at once
+      if (indexed) {
+        commandList.drawIndexed(
+            indexCount, mesh.indexOffsets.at(g),
+            static_cast<int32_t>(mesh.vertexOffsets.at(g)), instanceCount,
+            firstInstance);
+      } else {
+        commandList.draw(vertexCount, mesh.vertexOffsets.at(g), instanceCount,
+                         firstInstance);
+      }
+    }
+  }
+}
+
+void SceneRenderer::renderIndirect(rhi::RenderCommandList &commandList,
+                                   rhi::PipelineHandle pipeline,
+                                   bool bindMaterialData, uint32_t view,
+                                   size_t begin, size_t end) {
+  rhi::Descriptor descriptor;
+  descriptor.bind(0, mRenderStorage.getMeshTransformsBuffer(),
+                  rhi::DescriptorType::StorageBuffer);
+  descriptor.bind(1, mCullingStorage.getVisibleInstancesBuffer(),
+                  rhi::DescriptorType::StorageBuffer);
+  commandList.bindDescriptor(pipeline, 1, descriptor);
+
+  commandList.bindVertexBuffer(mAssetRegistry.getMeshVertexArena().getBuffer());
+  commandList.bindIndexBuffer(mAssetRegistry.getMeshIndexArena().getBuffer(),
+                              VK_INDEX_TYPE_UINT32);
+
+  auto drawsBuffer = mCullingStorage.getDrawsBuffer();
+  auto stride = static_cast<uint32_t>(sizeof(CullingStorage::DrawCommand));
+  const auto &allMeshDraws = mCullingStorage.getMeshDraws();
+
+  if (!bindMaterialData) {
+    // Draws of mesh groups are contiguous; so,
+    // every run of draws of the same kind in
+    // the range is issued at once
+    uint32_t numDraws = mCullingStorage.getNumDraws();
+    uint32_t first = begin < allMeshDraws.size()
+                         ? allMeshDraws.at(begin).firstDraw
+                         : numDraws;
+    uint32_t last =
+        end < allMeshDraws.size() ? allMeshDraws.at(end).firstDraw : numDraws;
+    for (uint32_t draw = first + 1; draw <= last; ++draw) {
+      bool indexed = mCullingStorage.isIndexedDraw(first);
+      if (draw < last && mCullingStorage.isIndexedDraw(draw) == indexed) {
+        continue;
+      }
+
+      auto offset = mCullingStorage.getDrawCommandOffset(view, first);
+      if (indexed) {
+        commandList.drawIndexedIndirect(drawsBuffer, offset, draw - first,
+                                        stride);
+      } else {
+        commandList.drawIndirect(drawsBuffer, offset, draw - first, stride);
+      }
+      first = draw;
+    }
+
+    return;
+  }
+
+  for (size_t i = begin; i < end; ++i) {
+    const auto &meshDraws = allMeshDraws.at(i);
+    const auto &mesh =
+        mAssetRegistry.getMeshes().getAsset(meshDraws.handle).data;
+    for (size_t g = 0; g < mesh.geometries.size(); ++g) {
+      commandList.bindDescriptor(pipeline, 3,
+                                 mesh.materials.at(g)->getDescriptor());
+
+      // Instance count is written by culling pass
+      auto draw = meshDraws.firstDraw + static_cast<uint32_t>(g);
+      auto offset = mCullingStorage.getDrawCommandOffset(view, draw);
+      if (mCullingStorage.isIndexedDraw(draw)) {
+        commandList.drawIndexedIndirect(drawsBuffer, offset, 1, stride);
+      } else {
+        commandList.drawIndirect(drawsBuffer, offset, 1, stride);
       }
     }
   }
@@ -413,25 +647,35 @@ void SceneRenderer::render(rhi::RenderCommandList &commandList,
 
 void SceneRenderer::renderSkinned(rhi::RenderCommandList &commandList,
                                   rhi::PipelineHandle pipeline,
-                                  bool bindMaterialData) {
+                                  bool bindMaterialData, int32_t lightIndex,
+                                  size_t begin, size_t end) {
   rhi::Descriptor descriptor;
   descriptor.bind(0, mRenderStorage.getSkinnedMeshTransformsBuffer(),
                   rhi::DescriptorType::StorageBuffer);
   descriptor.bind(1, mRenderStorage.getSkeletonsBuffer(),
                   rhi::DescriptorType::StorageBuffer);
+  descriptor.bind(2, mRenderStorage.getSkinnedMeshInstancesBuffer(),
+                  rhi::DescriptorType::StorageBuffer);
   commandList.bindDescriptor(pipeline, 1, descriptor);
 
-  uint32_t index = 0;
+  commandList.bindVertexBuffer(
+      mAssetRegistry.getSkinnedMeshVertexArena().getBuffer());
+  commandList.bindIndexBuffer(mAssetRegistry.getMeshIndexArena().getBuffer(),
+                              VK_INDEX_TYPE_UINT32);
+
+  auto it = std::next(mRenderStorage.getSkinnedMeshGroups().begin(),
+                      static_cast<std::ptrdiff_t>(begin));
+  for (size_t i = begin; i < end; ++i, ++it) {
+    const auto &[handle, meshData] = *it;
+    auto [firstInstance, instanceCount] =
+        getVisibleInstances(meshData, lightIndex);
+    if (instanceCount == 0) {
+      continue;
+    }
 
-  for (auto &[handle, meshData] : mRenderStorage.getSkinnedMeshGroups()) {
     const auto &mesh = mAssetRegistry.getSkinnedMeshes().getAsset(handle).data;
-    for (size_t g = 0; g < mesh.vertexBuffers.size(); ++g) {
-      commandList.bindVertexBuffer(mesh.vertexBuffers.at(g));
-      bool indexed = rhi::isHandleValid(mesh.indexBuffers.at(g));
-      if (indexed) {
-        commandList.bindIndexBuffer(mesh.indexBuffers.at(g),
-                                    VK_INDEX_TYPE_UINT32);
-      }
+    for (size_t g = 0; g < mesh.geometries.size(); ++g) {
+      bool indexed = !mesh.geometries.at(g).indices.empty();
 
       uint32_t indexCount =
           static_cast<uint32_t>(mesh.geometries.at(g).indices.size());
@@ -443,12 +687,15 @@ void SceneRenderer::renderSkinned(rhi::RenderCommandList &commandList,
                                    mesh.materials.at(g)->getDescriptor());
       }
 
-      for (auto index : meshData.indices) {
-        if (indexed) {
-          commandList.drawIndexed(indexCount, 0, 0, 1, index);
-        } else {
-          commandList.draw(vertexCount, 0, 1, index);
-        }
+      // All visible items of the group are drawn at once
+      if (indexed) {
+        commandList.drawIndexed(
+            indexCount, mesh.indexOffsets.at(g),
+            static_cast<int32_t>(mesh.vertexOffsets.at(g)), instanceCount,
+            firstInstance);
+      } else {
+        commandList.draw(vertexCount, mesh.vertexOffsets.at(g), instanceCount,
+                         firstInstance);
       }
     }
   }
@@ -4,6 +4,7 @@
 #include "liquid/rhi/RenderGraph.h"
 #include "liquid/asset/AssetRegistry.h"
 #include "RenderStorage.h"
+#include "CullingStorage.h"
 #include "ShaderLibrary.h"
 
 namespace liquid {
@@ -29,6 +30,11 @@ struct SceneRenderPassData {
 class SceneRenderer {
   static constexpr glm::vec4 DefaultClearColor{0.0f, 0.0f, 0.0f, 1.0f};
 
+  /**
+   * Render items that are visible from camera
+   */
+  static constexpr int32_t CAMERA_VIEW = -1;
+
 public:
   /**
    * @brief Create scene renderer
@@ -48,6 +54,17 @@ public:
    */
   void setClearColor(const glm::vec4 &clearColor);
 
+  /**
+   * @brief Enable or disable GPU driven rendering
+   *
+   * Meshes are culled by a compute pass and
+   * drawn from indirect draw commands. Must
+   * be set before attaching passes.
+   *
+   * @param enabled GPU driven rendering is enabled
+   */
+  void setGpuDrivenRendering(bool enabled);
+
   /**
    * @brief Attach passes to render graph
    *
@@ -79,9 +96,27 @@ private:
    * @param commandList Command list
    * @param pipeline Pipeline handle
    * @param bindMaterialData Bind material data
+   * @param lightIndex Light index for shadows or camera view
+   * @param begin First mesh group
+   * @param end Mesh group after the last one
    */
   void render(rhi::RenderCommandList &commandList, rhi::PipelineHandle pipeline,
-              bool bindMaterialData = false);
+              bool bindMaterialData, int32_t lightIndex, size_t begin,
+              size_t end);
+
+  /**
+   * @brief Render meshes from indirect draw commands
+   *
+   * @param commandList Command list
+   * @param pipeline Pipeline handle
+   * @param bindMaterialData Bind material data
+   * @param view Culling view index
+   * @param begin First mesh group
+   * @param end Mesh group after the last one
+   */
+  void renderIndirect(rhi::RenderCommandList &commandList,
+                      rhi::PipelineHandle pipeline, bool bindMaterialData,
+                      uint32_t view, size_t begin, size_t end);
 
   /**
    * @brief Render skinned meshes
@@ -89,10 +124,13 @@ private:
    * @param commandList Command list
    * @param pipeline Pipeline handle
    * @param bindMaterialData Bind material data
+   * @param lightIndex Light index for shadows or camera view
+   * @param begin First skinned mesh group
+   * @param end Skinned mesh group after the last one
    */
   void renderSkinned(rhi::RenderCommandList &commandList,
-                     rhi::PipelineHandle pipeline,
-                     bool bindMaterialData = true);
+                     rhi::PipelineHandle pipeline, bool bindMaterialData,
+                     int32_t lightIndex, size_t begin, size_t end);
 
   /**
    * @brief Render texts
@@ -108,6 +146,8 @@ private:
   ShaderLibrary &mShaderLibrary;
   rhi::ResourceRegistry &mRegistry;
   RenderStorage mRenderStorage;
+  CullingStorage mCullingStorage;
+  bool mGpuDriven = false;
   AssetRegistry &mAssetRegistry;
 };
 
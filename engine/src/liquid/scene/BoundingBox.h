@@ -0,0 +1,55 @@
+#pragma once
+
+namespace liquid {
+
+/**
+ * @brief Axis aligned bounding box
+ */
+struct BoundingBox {
+  /**
+   * Minimum corner
+   */
+  glm::vec3 min{0.0f};
+
+  /**
+   * Maximum corner
+   */
+  glm::vec3 max{0.0f};
+
+  /**
+   * @brief Transform bounding box
+   *
+   * Returns the smallest axis aligned box
+   * that contains the transformed box
+   *
+   * @param transform Transform matrix
+   * @return Transformed bounding box
+   */
+  BoundingBox transform(const glm::mat4 &transform) const {
+    glm::vec3 center = (min + max) * 0.5f;
+    glm::vec3 extent = (max - min) * 0.5f;
+
+    glm::vec3 newCenter{transform * glm::vec4(center, 1.0f)};
+
+    // Every axis of the box adds its transformed
+    // extent to the extent of the new box
+    glm::vec3 newExtent{0.0f};
+    for (glm::length_t i = 0; i < 3; ++i) {
+      newExtent += glm::abs(glm::vec3(transform[i])) * extent[i];
+    }
+
+    return BoundingBox{newCenter - newExtent, newCenter + newExtent};
+  }
+
+  /**
+   * @brief Extend bounding box with point
+   *
+   * @param point Point
+   */
+  void extend(const glm::vec3 &point) {
+    min = glm::min(min, point);
+    max = glm::max(max, point);
+  }
+};
+
+} // namespace liquid
@@ -12,9 +12,15 @@ void CameraAspectRatioUpdater::update(EntityDatabase &entityDatabase) {
 
   entityDatabase
       .iterateEntities<PerspectiveLensComponent, AutoAspectRatioComponent>(
-          [&size](auto entity, auto &lens, auto &_) {
-            lens.aspectRatio =
+          [&size, &entityDatabase](auto entity, auto &lens, auto &_) {
+            float aspectRatio =
                 static_cast<float>(size.x) / static_cast<float>(size.y);
+
+            if (lens.aspectRatio != aspectRatio) {
+              lens.aspectRatio = aspectRatio;
+              entityDatabase.markComponentChanged<PerspectiveLensComponent>(
+                  entity);
+            }
           });
 }
 
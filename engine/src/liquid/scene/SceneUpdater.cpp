@@ -3,57 +3,305 @@
 
 namespace liquid {
 
+/**
+ * Minimum number of transforms
+ * that are updated in one job
+ */
+static constexpr size_t TRANSFORM_MIN_CHUNK_SIZE = 256;
+
+SceneUpdater::SceneUpdater(JobSystem &jobSystem) : mJobSystem(jobSystem) {}
+
 void SceneUpdater::update(EntityDatabase &entityDatabase) {
   LIQUID_PROFILE_EVENT("SceneUpdater::update");
-  updateTransforms(entityDatabase);
-  updateCameras(entityDatabase);
-  updateLights(entityDatabase);
+  size_t since = mLastVersion;
+
+  updateTransforms(entityDatabase, since);
+  updateCameras(entityDatabase, since);
+  updateLights(entityDatabase, since);
+
+  mLastVersion = EntityDatabase::getLastVersion();
 }
 
-void SceneUpdater::updateTransforms(EntityDatabase &entityDatabase) {
+void SceneUpdater::updateTransforms(EntityDatabase &entityDatabase,
+                                    size_t since) {
   LIQUID_PROFILE_EVENT("SceneUpdater::updateTransforms");
 
+  updateTransformHierarchy(entityDatabase);
+
+  // Transforms in the same level do not depend
+  // on each other; so, they are updated in parallel
+  for (auto &level : mTransformLevels) {
+    mJobSystem.parallelFor(
+        level.size(), TRANSFORM_MIN_CHUNK_SIZE,
+        [this, &entityDatabase, &level, since](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i) {
+            updateTransform(entityDatabase, level.at(i), since);
+          }
+        });
+  }
+}
+
+void SceneUpdater::updateTransform(EntityDatabase &entityDatabase,
+                                   Entity entity, size_t since) {
+  auto &node = getTransformNode(entity);
+
+  bool changed =
+      node.moved ||
+      entityDatabase.getComponentVersion<LocalTransformComponent>(entity) >
+          since;
+
+  if (node.parent != EntityNull) {
+    changed = changed || getTransformNode(node.parent).changed;
+  }
+
+  node.moved = 0;
+  node.changed = changed;
+  if (!changed) {
+    return;
+  }
+
+  const auto &local =
+      entityDatabase.getComponent<LocalTransformComponent>(entity);
+  auto &world = entityDatabase.getComponent<WorldTransformComponent>(entity);
+
+  glm::mat4 identity{1.0f};
+  glm::mat4 localTransform = glm::translate(identity, local.localPosition) *
+                             glm::toMat4(local.localRotation) *
+                             glm::scale(identity, local.localScale);
+
+  if (node.parent == EntityNull) {
+    world.worldTransform = localTransform;
+  } else {
+    const auto &parentWorld =
+        entityDatabase.getComponent<WorldTransformComponent>(node.parent);
+    world.worldTransform = parentWorld.worldTransform * localTransform;
+  }
+
+  entityDatabase.markComponentChanged<WorldTransformComponent>(entity);
+}
+
+void SceneUpdater::updateTransformHierarchy(EntityDatabase &entityDatabase) {
+  // Setting transforms does not change the hierarchy;
+  // so, only adding or deleting transforms and
+  // changing parents trigger an update
+  std::array<size_t, 3> versions{
+      entityDatabase.getComponentPoolOrderVersion<LocalTransformComponent>(),
+      entityDatabase.getComponentPoolOrderVersion<WorldTransformComponent>(),
+      entityDatabase.getComponentPoolVersion<ParentComponent>()};
+
+  if (versions == mTransformHierarchyVersions) {
+    return;
+  }
+
+  LIQUID_PROFILE_EVENT("SceneUpdater::updateTransformHierarchy");
+  bool transformsChanged =
+      versions.at(0) != mTransformHierarchyVersions.at(0) ||
+      versions.at(1) != mTransformHierarchyVersions.at(1);
+  mTransformHierarchyVersions = versions;
+
+  auto isTransform = [&entityDatabase](Entity entity) {
+    return entityDatabase.hasComponent<LocalTransformComponent>(entity) &&
+           entityDatabase.hasComponent<WorldTransformComponent>(entity);
+  };
+
+  // Parents without transforms are ignored
+  auto getParent = [&entityDatabase, &isTransform](Entity entity) {
+    if (!entityDatabase.hasComponent<ParentComponent>(entity)) {
+      return EntityNull;
+    }
+
+    Entity parent = entityDatabase.getComponent<ParentComponent>(entity).parent;
+    return isTransform(parent) ? parent : EntityNull;
+  };
+
+  if (transformsChanged) {
+    std::vector<Entity> deleted;
+    for (const auto &level : mTransformLevels) {
+      for (auto entity : level) {
+        if (!isTransform(entity)) {
+          deleted.push_back(entity);
+        }
+      }
+    }
+
+    for (auto entity : deleted) {
+      removeTransformNode(entity);
+    }
+
+    // New transforms are added as roots
+    // and attached to their parents below
+    entityDatabase
+        .iterateEntities<LocalTransformComponent, WorldTransformComponent>(
+            [this](auto entity, auto &, auto &) {
+              uint32_t index = getEntityIndex(entity);
+              if (index >= mTransformNodes.size() ||
+                  mTransformNodes.at(index).entity != entity) {
+                addTransformNode(entity);
+              }
+            });
+  }
+
+  // Changed transforms are detached from their old
+  // parents before any of them is attached to a new
+  // parent, so that old parents never create cycles
+  std::vector<std::pair<Entity, Entity>> reparented;
   entityDatabase
       .iterateEntities<LocalTransformComponent, WorldTransformComponent>(
-          [this, &entityDatabase](auto entity, LocalTransformComponent &local,
-                                  WorldTransformComponent &world) {
-            if (entityDatabase.hasComponent<ParentComponent>(entity))
-              return;
+          [this, &getParent, &reparented](auto entity, auto &, auto &) {
+            Entity parent = getParent(entity);
+            if (getTransformNode(entity).parent != parent) {
+              setTransformParent(entity, EntityNull);
+              reparented.push_back({entity, parent});
+            }
+          });
 
-            glm::mat4 identity{1.0f};
-            glm::mat4 localTransform =
-                glm::translate(identity, local.localPosition) *
-                glm::toMat4(local.localRotation) *
-                glm::scale(identity, local.localScale);
+  for (auto [entity, parent] : reparented) {
+    setTransformParent(entity, parent);
+  }
 
-            world.worldTransform = localTransform;
-          });
+  while (!mTransformLevels.empty() && mTransformLevels.back().empty()) {
+    mTransformLevels.pop_back();
+  }
+}
 
-  entityDatabase.iterateEntities<LocalTransformComponent,
-                                 WorldTransformComponent, ParentComponent>(
-      [this, &entityDatabase](auto entity, LocalTransformComponent &local,
-                              WorldTransformComponent &world,
-                              const ParentComponent &parent) {
-        auto &parentTransform =
-            entityDatabase.getComponent<WorldTransformComponent>(parent.parent);
-
-        glm::mat4 identity{1.0f};
-        glm::mat4 localTransform =
-            glm::translate(identity, local.localPosition) *
-            glm::toMat4(local.localRotation) *
-            glm::scale(identity, local.localScale);
-
-        world.worldTransform = parentTransform.worldTransform * localTransform;
-      });
+void SceneUpdater::addTransformNode(Entity entity) {
+  uint32_t index = getEntityIndex(entity);
+  if (index >= mTransformNodes.size()) {
+    mTransformNodes.resize(static_cast<size_t>(index) + 1);
+  }
+
+  auto &node = mTransformNodes.at(index);
+  node = TransformNode{};
+  node.entity = entity;
+  node.moved = 1;
+
+  insertIntoTransformLevel(entity, 0);
+}
+
+void SceneUpdater::removeTransformNode(Entity entity) {
+  auto &node = getTransformNode(entity);
+  while (node.firstChild != EntityNull) {
+    setTransformParent(node.firstChild, EntityNull);
+  }
+
+  setTransformParent(entity, EntityNull);
+  removeFromTransformLevel(entity);
+  node = TransformNode{};
+}
+
+void SceneUpdater::setTransformParent(Entity entity, Entity parent) {
+  for (Entity current = parent; current != EntityNull;
+       current = getTransformNode(current).parent) {
+    if (current == entity) {
+      parent = EntityNull;
+      break;
+    }
+  }
+
+  auto &node = getTransformNode(entity);
+  if (node.parent == parent) {
+    return;
+  }
+
+  // Unlink from siblings of old parent
+  if (node.previousSibling != EntityNull) {
+    getTransformNode(node.previousSibling).nextSibling = node.nextSibling;
+  } else if (node.parent != EntityNull) {
+    getTransformNode(node.parent).firstChild = node.nextSibling;
+  }
+
+  if (node.nextSibling != EntityNull) {
+    getTransformNode(node.nextSibling).previousSibling = node.previousSibling;
+  }
+
+  node.parent = parent;
+  node.previousSibling = EntityNull;
+  node.nextSibling = EntityNull;
+  node.moved = 1;
+
+  uint32_t depth = 0;
+  if (parent != EntityNull) {
+    auto &parentNode = getTransformNode(parent);
+    if (parentNode.firstChild != EntityNull) {
+      getTransformNode(parentNode.firstChild).previousSibling = entity;
+    }
+
+    node.nextSibling = parentNode.firstChild;
+    parentNode.firstChild = entity;
+    depth = parentNode.depth + 1;
+  }
+
+  moveTransformSubtree(entity, depth);
 }
 
-void SceneUpdater::updateCameras(EntityDatabase &entityDatabase) {
+void SceneUpdater::moveTransformSubtree(Entity entity, uint32_t depth) {
+  uint32_t oldDepth = getTransformNode(entity).depth;
+  if (oldDepth == depth) {
+    return;
+  }
+
+  // Descendants keep their depth
+  // relative to the moved transform
+  std::vector<Entity> stack{entity};
+  while (!stack.empty()) {
+    Entity current = stack.back();
+    stack.pop_back();
+
+    auto &node = getTransformNode(current);
+    uint32_t newDepth = node.depth - oldDepth + depth;
+    removeFromTransformLevel(current);
+    insertIntoTransformLevel(current, newDepth);
+
+    for (Entity child = node.firstChild; child != EntityNull;
+         child = getTransformNode(child).nextSibling) {
+      stack.push_back(child);
+    }
+  }
+}
+
+void SceneUpdater::insertIntoTransformLevel(Entity entity, uint32_t depth) {
+  if (mTransformLevels.size() <= depth) {
+    mTransformLevels.resize(static_cast<size_t>(depth) + 1);
+  }
+
+  auto &level = mTransformLevels.at(depth);
+  auto &node = getTransformNode(entity);
+  node.depth = depth;
+  node.position = static_cast<uint32_t>(level.size());
+  level.push_back(entity);
+}
+
+void SceneUpdater::removeFromTransformLevel(Entity entity) {
+  const auto &node = getTransformNode(entity);
+  auto &level = mTransformLevels.at(node.depth);
+
+  // Last transform of the level takes
+  // the place of the removed transform
+  Entity last = level.back();
+  level.at(node.position) = last;
+  getTransformNode(last).position = node.position;
+  level.pop_back();
+}
+
+void SceneUpdater::updateCameras(EntityDatabase &entityDatabase,
+                                 size_t since) {
   LIQUID_PROFILE_EVENT("SceneUpdater::updateCameras");
 
   entityDatabase.iterateEntities<PerspectiveLensComponent,
                                  WorldTransformComponent, CameraComponent>(
-      [](auto entity, const PerspectiveLensComponent &lens,
-         const WorldTransformComponent &world, CameraComponent &camera) {
+      [&entityDatabase, since](auto entity,
+                               const PerspectiveLensComponent &lens,
+                               const WorldTransformComponent &world,
+                               CameraComponent &camera) {
+        if (entityDatabase.getComponentVersion<PerspectiveLensComponent>(
+                entity) <= since &&
+            entityDatabase.getComponentVersion<WorldTransformComponent>(
+                entity) <= since &&
+            entityDatabase.getComponentVersion<CameraComponent>(entity) <=
+                since) {
+          return;
+        }
+
         camera.projectionMatrix =
             glm::perspective(lens.fovY, lens.aspectRatio, lens.near, lens.far);
 
@@ -65,13 +313,22 @@ void SceneUpdater::updateCameras(EntityDatabase &entityDatabase) {
       });
 }
 
-void SceneUpdater::updateLights(EntityDatabase &entityDatabase) {
+void SceneUpdater::updateLights(EntityDatabase &entityDatabase,
+                                size_t since) {
   LIQUID_PROFILE_EVENT("SceneUpdater::updateLights");
 
   entityDatabase
       .iterateEntities<WorldTransformComponent, DirectionalLightComponent>(
-          [](auto entity, const WorldTransformComponent &world,
-             DirectionalLightComponent &light) {
+          [&entityDatabase, since](auto entity,
+                                   const WorldTransformComponent &world,
+                                   DirectionalLightComponent &light) {
+            if (entityDatabase.getComponentVersion<WorldTransformComponent>(
+                    entity) <= since &&
+                entityDatabase.getComponentVersion<DirectionalLightComponent>(
+                    entity) <= since) {
+              return;
+            }
+
             glm::quat rotation;
             glm::vec3 empty3;
             glm::vec4 empty4;
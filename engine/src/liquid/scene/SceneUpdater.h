@@ -2,6 +2,7 @@
 
 #include "liquid/entity/Entity.h"
 #include "liquid/entity/EntityDatabase.h"
+#include "liquid/core/JobSystem.h"
 
 namespace liquid {
 
@@ -10,34 +11,210 @@ namespace liquid {
  */
 class SceneUpdater {
 public:
+  /**
+   * @brief Create scene updater
+   *
+   * @param jobSystem Job system
+   */
+  SceneUpdater(JobSystem &jobSystem);
+
   /**
    * @brief Updates scene
    *
+   * Only recalculates transforms, cameras,
+   * and lights whose inputs have changed
+   * since the last update
+   *
    * @param entityDatabase Entity database
    */
   void update(EntityDatabase &entityDatabase);
 
 private:
   /**
-   * @brief Update all transforms
+   * @brief Update changed transforms
+   *
+   * Updates transforms with changed local
+   * transforms and all their descendants
+   *
+   * @param entityDatabase Entity database
+   * @param since Version of last update
+   */
+  void updateTransforms(EntityDatabase &entityDatabase, size_t since);
+
+  /**
+   * @brief Update transform if it is changed
+   *
+   * @param entityDatabase Entity database
+   * @param entity Entity
+   * @param since Version of last update
+   */
+  void updateTransform(EntityDatabase &entityDatabase, Entity entity,
+                       size_t since);
+
+  /**
+   * @brief Update transform hierarchy
+   *
+   * Adds new transforms, removes deleted
+   * transforms, and moves transforms whose
+   * parents changed together with their
+   * descendants. Other transforms keep their
+   * place in the hierarchy. Hierarchy is only
+   * updated when transforms are added or
+   * deleted or parents change.
    *
    * @param entityDatabase Entity database
    */
-  void updateTransforms(EntityDatabase &entityDatabase);
+  void updateTransformHierarchy(EntityDatabase &entityDatabase);
+
+  /**
+   * @brief Add transform to hierarchy as root
+   *
+   * @param entity Entity
+   */
+  void addTransformNode(Entity entity);
+
+  /**
+   * @brief Remove transform from hierarchy
+   *
+   * Children of the transform become roots
+   *
+   * @param entity Entity
+   */
+  void removeTransformNode(Entity entity);
+
+  /**
+   * @brief Set parent of transform
+   *
+   * Moves the transform and its descendants
+   * to levels that match the new parent. If
+   * the parent is a descendant of the transform,
+   * the transform becomes a root instead.
+   *
+   * @param entity Entity
+   * @param parent Parent entity
+   */
+  void setTransformParent(Entity entity, Entity parent);
+
+  /**
+   * @brief Move transform and its descendants
+   *
+   * @param entity Entity
+   * @param depth New depth of the transform
+   */
+  void moveTransformSubtree(Entity entity, uint32_t depth);
+
+  /**
+   * @brief Insert transform into level
+   *
+   * @param entity Entity
+   * @param depth Level depth
+   */
+  void insertIntoTransformLevel(Entity entity, uint32_t depth);
+
+  /**
+   * @brief Remove transform from its level
+   *
+   * @param entity Entity
+   */
+  void removeFromTransformLevel(Entity entity);
 
   /**
-   * @brief Update all cameras using transforms
+   * @brief Update changed cameras using transforms
    *
    * @param entityDatabase Entity database
+   * @param since Version of last update
    */
-  void updateCameras(EntityDatabase &entityDatabase);
+  void updateCameras(EntityDatabase &entityDatabase, size_t since);
 
   /**
-   * @brief Update all lights using transforms
+   * @brief Update changed lights using transforms
    *
    * @param entityDatabase Entity database
+   * @param since Version of last update
+   */
+  void updateLights(EntityDatabase &entityDatabase, size_t since);
+
+private:
+  /**
+   * @brief Transform hierarchy node
+   */
+  struct TransformNode {
+    /**
+     * Entity
+     *
+     * Null if the node is not in hierarchy
+     */
+    Entity entity = EntityNull;
+
+    /**
+     * Parent entity
+     */
+    Entity parent = EntityNull;
+
+    /**
+     * First child entity
+     */
+    Entity firstChild = EntityNull;
+
+    /**
+     * Previous sibling entity
+     */
+    Entity previousSibling = EntityNull;
+
+    /**
+     * Next sibling entity
+     */
+    Entity nextSibling = EntityNull;
+
+    /**
+     * Depth of node in hierarchy
+     */
+    uint32_t depth = 0;
+
+    /**
+     * Position of node in its level
+     */
+    uint32_t position = 0;
+
+    /**
+     * World transform changed in last update
+     */
+    uint8_t changed = 0;
+
+    /**
+     * Node is added or its parent changed
+     *
+     * World transform is recalculated
+     * in the next update
+     */
+    uint8_t moved = 0;
+  };
+
+  /**
+   * @brief Get transform hierarchy node
+   *
+   * @param entity Entity
+   * @return Transform hierarchy node
    */
-  void updateLights(EntityDatabase &entityDatabase);
+  inline TransformNode &getTransformNode(Entity entity) {
+    return mTransformNodes.at(getEntityIndex(entity));
+  }
+
+private:
+  JobSystem &mJobSystem;
+
+  /**
+   * Hierarchy nodes indexed by entity index
+   */
+  std::vector<TransformNode> mTransformNodes;
+
+  /**
+   * Entities of every depth in hierarchy
+   */
+  std::vector<std::vector<Entity>> mTransformLevels;
+
+  std::array<size_t, 3> mTransformHierarchyVersions{0, 0, 0};
+  size_t mLastVersion = 0;
 };
 
 } // namespace liquid
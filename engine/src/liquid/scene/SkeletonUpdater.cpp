@@ -3,11 +3,14 @@
 
 namespace liquid {
 
+SkeletonUpdater::SkeletonUpdater(JobSystem &jobSystem)
+    : mJobSystem(jobSystem) {}
+
 void SkeletonUpdater::update(EntityDatabase &entityDatabase) {
   {
     LIQUID_PROFILE_EVENT("SkeletonUpdater::update");
-    entityDatabase.iterateEntities<SkeletonComponent>(
-        [](auto entity, SkeletonComponent &skeleton) {
+    entityDatabase.parallelIterateEntities<SkeletonComponent>(
+        mJobSystem, [](auto entity, SkeletonComponent &skeleton) {
           for (uint32_t i = 0; i < skeleton.numJoints; ++i) {
             glm::mat4 identity{1.0f};
             auto localTransform =
@@ -30,7 +33,9 @@ void SkeletonUpdater::update(EntityDatabase &entityDatabase) {
 
   {
     LIQUID_PROFILE_EVENT("SkeletonUpdater::updateDebug");
-    entityDatabase.iterateEntities<SkeletonComponent, SkeletonDebugComponent>(
+    entityDatabase.parallelIterateEntities<SkeletonComponent,
+                                           SkeletonDebugComponent>(
+        mJobSystem,
         [](auto entity, SkeletonComponent &skeleton,
            SkeletonDebugComponent &debug) {
           LIQUID_ASSERT(
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "liquid/entity/EntityDatabase.h"
+#include "liquid/core/JobSystem.h"
 
 namespace liquid {
 
@@ -11,6 +12,13 @@ namespace liquid {
  */
 class SkeletonUpdater {
 public:
+  /**
+   * @brief Create skeleton updater
+   *
+   * @param jobSystem Job system
+   */
+  SkeletonUpdater(JobSystem &jobSystem);
+
   /**
    * @brief Update skeletons
    *
@@ -20,6 +28,9 @@ public:
    * @param entityDatabase Entity database
    */
   void update(EntityDatabase &entityDatabase);
+
+private:
+  JobSystem &mJobSystem;
 };
 
 } // namespace liquid
@@ -62,6 +62,7 @@ int TransformScriptingInterface::LuaInterface::setPosition(void *state) {
   auto &transform =
       entityDatabase.getComponent<LocalTransformComponent>(entity);
   transform.localPosition = newPosition;
+  entityDatabase.markComponentChanged<LocalTransformComponent>(entity);
 
   return 0;
 }
@@ -121,6 +122,7 @@ int TransformScriptingInterface::LuaInterface::setScale(void *state) {
   auto &transform =
       entityDatabase.getComponent<LocalTransformComponent>(entity);
   transform.localScale = newScale;
+  entityDatabase.markComponentChanged<LocalTransformComponent>(entity);
 
   return 0;
 }
@@ -6,11 +6,12 @@
 class AnimationSystemTest : public ::testing::Test {
 public:
   liquid::EntityDatabase entityDatabase;
+  liquid::JobSystem jobSystem;
   liquid::AnimationSystem system;
   liquid::AssetRegistry assetRegistry;
   liquid::rhi::ResourceRegistry registry;
 
-  AnimationSystemTest() : system(assetRegistry) {}
+  AnimationSystemTest() : system(assetRegistry, jobSystem) {}
 
   liquid::Entity createEntity(
       bool loop,
@@ -6,6 +6,8 @@
 #include "liquid/asset/AssetFileHeader.h"
 #include "liquid/asset/InputBinaryStream.h"
 
+#include <vulkan/vulkan.h>
+
 #include "liquid-tests/Testing.h"
 
 class AssetManagerTest : public ::testing::Test {
@@ -37,6 +39,7 @@ TEST_F(AssetManagerTest, LoadsTexture2D) {
   EXPECT_EQ(asset.data.width, 1);
   EXPECT_EQ(asset.data.height, 1);
   EXPECT_EQ(asset.data.layers, 1);
+  EXPECT_EQ(asset.data.levels.size(), 1);
   EXPECT_NE(asset.data.data, nullptr);
 }
 
@@ -52,3 +55,108 @@ TEST_F(AssetManagerTest, LoadsTextureCubemap) {
   EXPECT_EQ(asset.data.layers, 6);
   EXPECT_NE(asset.data.data, nullptr);
 }
+
+TEST_F(AssetManagerTest, CreatesTextureWithMipLevelsFromAsset) {
+  std::vector<uint8_t> pixels(4 * 2 * 4, 255);
+
+  liquid::AssetData<liquid::TextureAsset> asset{};
+  asset.name = "mip-texture";
+  asset.size = pixels.size();
+  asset.data.data = pixels.data();
+  asset.data.width = 4;
+  asset.data.height = 2;
+
+  manager.setTextureFormatSupport([](uint32_t) { return false; });
+  auto path = manager.createTextureFromAsset(asset);
+  EXPECT_TRUE(path.hasData());
+
+  auto texture = manager.loadTextureFromFile(path.getData());
+  EXPECT_TRUE(texture.hasData());
+
+  const auto &loaded =
+      manager.getRegistry().getTextures().getAsset(texture.getData());
+
+  ASSERT_EQ(loaded.data.levels.size(), 3);
+  EXPECT_EQ(loaded.data.levels.at(0).width, 4);
+  EXPECT_EQ(loaded.data.levels.at(0).height, 2);
+  EXPECT_EQ(loaded.data.levels.at(1).width, 2);
+  EXPECT_EQ(loaded.data.levels.at(1).height, 1);
+  EXPECT_EQ(loaded.data.levels.at(2).width, 1);
+  EXPECT_EQ(loaded.data.levels.at(2).height, 1);
+  EXPECT_EQ(loaded.size, (8 + 2 + 1) * 4);
+}
+
+/**
+ * @brief Create 4x4 texture asset with usage
+ *
+ * @param pixels Pixels
+ * @param usage Texture usage
+ * @return Texture asset
+ */
+static liquid::AssetData<liquid::TextureAsset>
+createTextureAsset(std::vector<uint8_t> &pixels,
+                   liquid::TextureAssetUsage usage) {
+  pixels.resize(4 * 4 * 4, 255);
+
+  liquid::AssetData<liquid::TextureAsset> asset{};
+  asset.name = "compressed-texture";
+  asset.size = pixels.size();
+  asset.data.data = pixels.data();
+  asset.data.width = 4;
+  asset.data.height = 4;
+  asset.data.usage = usage;
+  return asset;
+}
+
+TEST_F(AssetManagerTest, TranscodesTexturesToBlockCompressedFormatsOfUsage) {
+  std::vector<std::pair<liquid::TextureAssetUsage, VkFormat>> formats{
+      {liquid::TextureAssetUsage::Color, VK_FORMAT_BC7_SRGB_BLOCK},
+      {liquid::TextureAssetUsage::Normal, VK_FORMAT_BC5_UNORM_BLOCK},
+      {liquid::TextureAssetUsage::Data, VK_FORMAT_BC1_RGB_UNORM_BLOCK}};
+
+  for (auto [usage, format] : formats) {
+    std::vector<uint8_t> pixels;
+    auto path =
+        manager.createTextureFromAsset(createTextureAsset(pixels, usage));
+    EXPECT_TRUE(path.hasData());
+
+    auto handle = manager.loadTextureFromFile(path.getData());
+    EXPECT_TRUE(handle.hasData());
+
+    const auto &texture =
+        manager.getRegistry().getTextures().getAsset(handle.getData());
+    EXPECT_EQ(texture.data.format, format);
+    EXPECT_EQ(texture.data.usage, usage);
+    EXPECT_EQ(texture.data.levels.size(), 3);
+  }
+}
+
+TEST_F(AssetManagerTest,
+       TranscodesTexturesToRGBAIfBlockCompressedFormatsAreNotSupported) {
+  manager.setTextureFormatSupport([](uint32_t format) {
+    return format != VK_FORMAT_BC7_SRGB_BLOCK &&
+           format != VK_FORMAT_BC5_UNORM_BLOCK &&
+           format != VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+  });
+
+  std::vector<std::pair<liquid::TextureAssetUsage, VkFormat>> formats{
+      {liquid::TextureAssetUsage::Color, VK_FORMAT_R8G8B8A8_SRGB},
+      {liquid::TextureAssetUsage::Normal, VK_FORMAT_R8G8B8A8_UNORM},
+      {liquid::TextureAssetUsage::Data, VK_FORMAT_R8G8B8A8_UNORM}};
+
+  for (auto [usage, format] : formats) {
+    std::vector<uint8_t> pixels;
+    auto path =
+        manager.createTextureFromAsset(createTextureAsset(pixels, usage));
+    EXPECT_TRUE(path.hasData());
+
+    auto handle = manager.loadTextureFromFile(path.getData());
+    EXPECT_TRUE(handle.hasData());
+
+    const auto &texture =
+        manager.getRegistry().getTextures().getAsset(handle.getData());
+    EXPECT_EQ(texture.data.format, format);
+    EXPECT_EQ(texture.data.usage, usage);
+    EXPECT_EQ(texture.size, (16 + 4 + 1) * 4);
+  }
+}
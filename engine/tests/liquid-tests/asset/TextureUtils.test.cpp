@@ -0,0 +1,81 @@
+#include "liquid/core/Base.h"
+#include "liquid/asset/TextureUtils.h"
+
+#include "liquid-tests/Testing.h"
+
+TEST(TextureUtilsTest, CalculatesMipLevelCountFromLargestSide) {
+  EXPECT_EQ(liquid::getMipLevelCount(1, 1), 1);
+  EXPECT_EQ(liquid::getMipLevelCount(2, 2), 2);
+  EXPECT_EQ(liquid::getMipLevelCount(256, 256), 9);
+  EXPECT_EQ(liquid::getMipLevelCount(256, 16), 9);
+  EXPECT_EQ(liquid::getMipLevelCount(5, 3), 3);
+}
+
+TEST(TextureUtilsTest, GeneratesLevelsUntilOnePixel) {
+  std::vector<uint8_t> data(8 * 2 * 4, 255);
+  std::vector<liquid::TextureAssetLevel> levels;
+
+  auto pixels = liquid::generateMipmaps(data.data(), 8, 2, true, levels);
+
+  ASSERT_EQ(levels.size(), 4);
+  std::vector<std::pair<uint32_t, uint32_t>> sizes{
+      {8, 2}, {4, 1}, {2, 1}, {1, 1}};
+
+  size_t offset = 0;
+  for (size_t i = 0; i < levels.size(); ++i) {
+    EXPECT_EQ(levels.at(i).width, sizes.at(i).first);
+    EXPECT_EQ(levels.at(i).height, sizes.at(i).second);
+    EXPECT_EQ(levels.at(i).offset, offset);
+    EXPECT_EQ(levels.at(i).size, sizes.at(i).first * sizes.at(i).second * 4);
+    offset += levels.at(i).size;
+  }
+
+  EXPECT_EQ(pixels.size(), offset);
+  EXPECT_TRUE(std::all_of(pixels.begin(), pixels.end(),
+                          [](uint8_t value) { return value == 255; }));
+}
+
+TEST(TextureUtilsTest, AveragesColorsInLinearSpace) {
+  // Black and white checkerboard with
+  // fully opaque and transparent alpha
+  std::vector<uint8_t> data{0,   0,   0,   255, 255, 255, 255, 0,
+                            255, 255, 255, 0,   0,   0,   0,   255};
+  std::vector<liquid::TextureAssetLevel> levels;
+
+  auto pixels = liquid::generateMipmaps(data.data(), 2, 2, true, levels);
+
+  ASSERT_EQ(levels.size(), 2);
+  const uint8_t *level = pixels.data() + levels.at(1).offset;
+
+  // Half of linear intensity is 188 in sRGB
+  EXPECT_EQ(level[0], 188);
+  EXPECT_EQ(level[1], 188);
+  EXPECT_EQ(level[2], 188);
+  EXPECT_EQ(level[3], 128);
+}
+
+TEST(TextureUtilsTest, AveragesLinearColorsAsIs) {
+  std::vector<uint8_t> data{0,   0,   0,   255, 255, 255, 255, 0,
+                            255, 255, 255, 0,   0,   0,   0,   255};
+  std::vector<liquid::TextureAssetLevel> levels;
+
+  auto pixels = liquid::generateMipmaps(data.data(), 2, 2, false, levels);
+
+  ASSERT_EQ(levels.size(), 2);
+  const uint8_t *level = pixels.data() + levels.at(1).offset;
+
+  EXPECT_EQ(level[0], 128);
+  EXPECT_EQ(level[1], 128);
+  EXPECT_EQ(level[2], 128);
+  EXPECT_EQ(level[3], 128);
+}
+
+TEST(TextureUtilsTest, KeepsBaseLevelUnchanged) {
+  std::vector<uint8_t> data{10, 20, 30, 40, 50, 60, 70, 80};
+  std::vector<liquid::TextureAssetLevel> levels;
+
+  auto pixels = liquid::generateMipmaps(data.data(), 2, 1, true, levels);
+
+  ASSERT_EQ(levels.size(), 2);
+  EXPECT_EQ(std::vector<uint8_t>(pixels.begin(), pixels.begin() + 8), data);
+}
@@ -0,0 +1,97 @@
+#include "liquid/core/Base.h"
+#include "liquid/core/FreeListAllocator.h"
+
+#include "liquid-tests/Testing.h"
+
+class FreeListAllocatorTest : public ::testing::Test {
+public:
+  liquid::FreeListAllocator allocator{100};
+};
+
+using FreeListAllocatorDeathTest = FreeListAllocatorTest;
+
+TEST_F(FreeListAllocatorTest, AllocatesRangesNextToEachOther) {
+  EXPECT_EQ(allocator.allocate(10), 0);
+  EXPECT_EQ(allocator.allocate(20), 10);
+  EXPECT_EQ(allocator.allocate(30), 30);
+
+  EXPECT_EQ(allocator.getNumAllocations(), 3);
+  EXPECT_EQ(allocator.getUsedSize(), 60);
+  EXPECT_EQ(allocator.getEnd(), 60);
+  EXPECT_EQ(allocator.getLargestFreeBlock(), 40);
+}
+
+TEST_F(FreeListAllocatorTest, FailsIfRangeDoesNotFit) {
+  EXPECT_EQ(allocator.allocate(60), 0);
+  EXPECT_EQ(allocator.allocate(50),
+            liquid::FreeListAllocator::INVALID_OFFSET);
+  EXPECT_EQ(allocator.getNumAllocations(), 1);
+}
+
+TEST_F(FreeListAllocatorTest, AllocatesFromSmallestFreeBlockThatFits) {
+  allocator.allocate(10);
+  auto large = allocator.allocate(30);
+  allocator.allocate(10);
+  auto small = allocator.allocate(10);
+  allocator.allocate(35);
+
+  allocator.free(large);
+  allocator.free(small);
+
+  EXPECT_EQ(allocator.allocate(8), small);
+  EXPECT_EQ(allocator.allocate(25), large);
+}
+
+TEST_F(FreeListAllocatorTest, MergesNeighbouringFreeBlocks) {
+  auto a = allocator.allocate(10);
+  auto b = allocator.allocate(10);
+  auto c = allocator.allocate(10);
+  allocator.allocate(70);
+
+  allocator.free(a);
+  allocator.free(c);
+  EXPECT_EQ(allocator.getNumFreeBlocks(), 2);
+
+  allocator.free(b);
+  EXPECT_EQ(allocator.getNumFreeBlocks(), 1);
+  EXPECT_EQ(allocator.getLargestFreeBlock(), 30);
+  EXPECT_EQ(allocator.allocate(30), 0);
+}
+
+TEST_F(FreeListAllocatorTest, CalculatesFragmentationFromFreeBlocks) {
+  EXPECT_EQ(allocator.getFragmentation(), 0.0f);
+
+  auto a = allocator.allocate(25);
+  allocator.allocate(25);
+  allocator.allocate(25);
+  allocator.free(a);
+
+  // Half of free space is not in the largest block
+  EXPECT_FLOAT_EQ(allocator.getFragmentation(), 0.5f);
+}
+
+TEST_F(FreeListAllocatorTest, GrowingExtendsLastFreeBlock) {
+  allocator.allocate(90);
+  allocator.grow(200);
+
+  EXPECT_EQ(allocator.getCapacity(), 200);
+  EXPECT_EQ(allocator.getNumFreeBlocks(), 1);
+  EXPECT_EQ(allocator.allocate(110), 90);
+}
+
+TEST_F(FreeListAllocatorTest, GrowingAddsFreeBlockIfSpaceIsFull) {
+  allocator.allocate(100);
+  allocator.grow(150);
+
+  EXPECT_EQ(allocator.getLargestFreeBlock(), 50);
+  EXPECT_EQ(allocator.allocate(50), 100);
+}
+
+TEST_F(FreeListAllocatorDeathTest, FreeingFailsIfRangeIsNotAllocated) {
+  allocator.allocate(10);
+  EXPECT_DEATH(allocator.free(5), ".*");
+}
+
+TEST_F(FreeListAllocatorDeathTest, GrowingFailsIfCapacityIsSmaller) {
+  EXPECT_DEATH(allocator.grow(50), ".*");
+}
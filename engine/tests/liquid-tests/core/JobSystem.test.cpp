@@ -0,0 +1,123 @@
+#include "liquid/core/Base.h"
+#include "liquid/core/JobSystem.h"
+
+#include "liquid-tests/Testing.h"
+
+class JobSystemTest : public ::testing::Test {
+public:
+  liquid::JobSystem jobSystem{3};
+};
+
+TEST_F(JobSystemTest, CreatesWorkers) {
+  EXPECT_EQ(jobSystem.getWorkerCount(), 3);
+}
+
+TEST_F(JobSystemTest, DoesNothingIfRangeIsEmpty) {
+  bool called = false;
+  jobSystem.parallelFor(0, 1, [&called](size_t, size_t) { called = true; });
+
+  EXPECT_FALSE(called);
+}
+
+TEST_F(JobSystemTest, ProcessesEveryItemOnce) {
+  std::vector<std::atomic<uint32_t>> counts(1000);
+  for (auto &count : counts) {
+    count = 0;
+  }
+
+  jobSystem.parallelFor(counts.size(), 8, [&counts](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      counts.at(i)++;
+    }
+  });
+
+  for (auto &count : counts) {
+    EXPECT_EQ(count, 1);
+  }
+}
+
+TEST_F(JobSystemTest, RunsRangeInOneChunkIfSmallerThanMinChunkSize) {
+  std::atomic<uint32_t> numChunks{0};
+  jobSystem.parallelFor(10, 100, [&numChunks](size_t begin, size_t end) {
+    EXPECT_EQ(begin, 0);
+    EXPECT_EQ(end, 10);
+    numChunks++;
+  });
+
+  EXPECT_EQ(numChunks, 1);
+}
+
+TEST_F(JobSystemTest, RunsNestedParallelFor) {
+  std::atomic<size_t> sum{0};
+  jobSystem.parallelFor(8, 1, [this, &sum](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      jobSystem.parallelFor(100, 1, [&sum](size_t begin, size_t end) {
+        sum += end - begin;
+      });
+    }
+  });
+
+  EXPECT_EQ(sum, 800);
+}
+
+TEST_F(JobSystemTest, WaitsForSubmittedJobs) {
+  std::atomic<size_t> remaining{100};
+  std::atomic<size_t> sum{0};
+
+  for (size_t i = 0; i < 100; ++i) {
+    jobSystem.submit([&remaining, &sum, i]() {
+      sum += i;
+      remaining--;
+    });
+  }
+
+  jobSystem.wait(remaining);
+  EXPECT_EQ(sum, 4950);
+}
+
+TEST_F(JobSystemTest, WaitsForJobsSubmittedFromJobs) {
+  std::atomic<size_t> remaining{10};
+
+  for (size_t i = 0; i < 10; ++i) {
+    remaining += 10;
+    jobSystem.submit([this, &remaining]() {
+      for (size_t j = 0; j < 10; ++j) {
+        jobSystem.submit([&remaining]() { remaining--; });
+      }
+      remaining--;
+    });
+  }
+
+  jobSystem.wait(remaining);
+  EXPECT_EQ(remaining, 0);
+}
+
+TEST_F(JobSystemTest, WaitsForJobsThatAreRunByOtherThreads) {
+  std::atomic<size_t> remaining{1};
+  std::atomic<bool> released{false};
+
+  jobSystem.submit([&remaining, &released]() {
+    while (!released) {
+      std::this_thread::yield();
+    }
+    remaining--;
+  });
+
+  std::thread releaser([&released]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    released = true;
+  });
+
+  jobSystem.wait(remaining);
+  releaser.join();
+  EXPECT_EQ(remaining, 0);
+}
+
+TEST(JobSystemNoWorkersTest, RunsJobsOnCallingThread) {
+  liquid::JobSystem jobSystem(0);
+  auto threadId = std::this_thread::get_id();
+
+  jobSystem.parallelFor(100, 1, [threadId](size_t, size_t) {
+    EXPECT_EQ(std::this_thread::get_id(), threadId);
+  });
+}
@@ -0,0 +1,133 @@
+#include "liquid/core/Base.h"
+#include "liquid/core/TaskGraph.h"
+
+#include "liquid-tests/Testing.h"
+
+// Task graph only uses component types; so,
+// any components in entity database work
+using ComponentA = liquid::ForceComponent;
+using ComponentB = liquid::TorqueComponent;
+
+using Graph = liquid::TaskGraph;
+
+class TaskGraphTest : public ::testing::Test {
+public:
+  liquid::EntityDatabase entityDatabase;
+  liquid::TaskGraph graph;
+
+  static void noop(float, liquid::EntityDatabase &) {}
+};
+
+TEST_F(TaskGraphTest, TaskDependsOnPreviousTaskThatWritesItsReads) {
+  auto writer = graph.addTask("Writer", Graph::Reads<>{},
+                              Graph::Writes<ComponentA>{}, noop);
+  auto reader = graph.addTask("Reader", Graph::Reads<ComponentA>{},
+                              Graph::Writes<ComponentB>{}, noop);
+
+  EXPECT_TRUE(graph.dependsOn(reader, writer));
+  EXPECT_FALSE(graph.dependsOn(writer, reader));
+}
+
+TEST_F(TaskGraphTest, TaskDependsOnPreviousTaskThatReadsItsWrites) {
+  auto reader = graph.addTask("Reader", Graph::Reads<ComponentA>{},
+                              Graph::Writes<ComponentB>{}, noop);
+  auto writer = graph.addTask("Writer", Graph::Reads<>{},
+                              Graph::Writes<ComponentA>{}, noop);
+
+  EXPECT_TRUE(graph.dependsOn(writer, reader));
+}
+
+TEST_F(TaskGraphTest, TasksThatOnlyReadSameComponentsDoNotDependOnEachOther) {
+  auto first = graph.addTask("First", Graph::Reads<ComponentA>{},
+                             Graph::Writes<>{}, noop);
+  auto second = graph.addTask("Second", Graph::Reads<ComponentA>{},
+                              Graph::Writes<>{}, noop);
+
+  EXPECT_FALSE(graph.dependsOn(second, first));
+}
+
+TEST_F(TaskGraphTest, TasksThatWriteDifferentComponentsDoNotDependOnEachOther) {
+  auto first = graph.addTask("First", Graph::Reads<>{},
+                             Graph::Writes<ComponentA>{}, noop);
+  auto second = graph.addTask("Second", Graph::Reads<>{},
+                              Graph::Writes<ComponentB>{}, noop);
+
+  EXPECT_FALSE(graph.dependsOn(second, first));
+}
+
+TEST_F(TaskGraphTest, ExclusiveTaskDependsOnAllPreviousTasks) {
+  auto first = graph.addTask("First", Graph::Reads<>{},
+                             Graph::Writes<ComponentA>{}, noop);
+  auto second = graph.addTask("Second", Graph::Reads<>{},
+                              Graph::Writes<ComponentB>{}, noop);
+  auto exclusive = graph.addTask("Exclusive", noop);
+  auto third = graph.addTask("Third", Graph::Reads<>{},
+                             Graph::Writes<ComponentB>{}, noop);
+
+  EXPECT_TRUE(graph.dependsOn(exclusive, first));
+  EXPECT_TRUE(graph.dependsOn(exclusive, second));
+  EXPECT_TRUE(graph.dependsOn(third, exclusive));
+}
+
+TEST_F(TaskGraphTest, ExecutesTasksInOrderOfAdditionWithoutJobSystem) {
+  std::vector<size_t> order;
+  for (size_t i = 0; i < 5; ++i) {
+    graph.addTask("Task", Graph::Reads<>{}, Graph::Writes<ComponentA>{},
+                  [&order, i](float, liquid::EntityDatabase &) {
+                    order.push_back(i);
+                  });
+  }
+
+  graph.execute(0.0f, entityDatabase);
+
+  EXPECT_EQ(order, std::vector<size_t>({0, 1, 2, 3, 4}));
+}
+
+TEST_F(TaskGraphTest, ExecutesTasksInOrderOfAdditionIfJobSystemHasNoWorkers) {
+  liquid::JobSystem jobSystem(0);
+
+  std::vector<size_t> order;
+  for (size_t i = 0; i < 5; ++i) {
+    graph.addTask("Task", Graph::Reads<>{},
+                  Graph::Writes<ComponentA, ComponentB>{},
+                  [&order, i](float, liquid::EntityDatabase &) {
+                    order.push_back(i);
+                  });
+  }
+
+  graph.execute(0.0f, entityDatabase, jobSystem);
+
+  EXPECT_EQ(order, std::vector<size_t>({0, 1, 2, 3, 4}));
+}
+
+TEST_F(TaskGraphTest, ExecutesDependentsAfterDependencies) {
+  liquid::JobSystem jobSystem(3);
+  auto entity = entityDatabase.createEntity();
+  entityDatabase.setComponent<ComponentA>(entity, {glm::vec3{0.0f}});
+  entityDatabase.setComponent<ComponentB>(entity, {glm::vec3{0.0f}});
+
+  graph.addTask("WriteA", Graph::Reads<>{}, Graph::Writes<ComponentA>{},
+                [entity](float, liquid::EntityDatabase &db) {
+                  db.getComponent<ComponentA>(entity).force.x++;
+                });
+  graph.addTask("WriteB", Graph::Reads<>{}, Graph::Writes<ComponentB>{},
+                [entity](float, liquid::EntityDatabase &db) {
+                  db.getComponent<ComponentB>(entity).torque.x++;
+                });
+  graph.addTask("CopyAToB", Graph::Reads<ComponentA>{},
+                Graph::Writes<ComponentB>{},
+                [entity](float, liquid::EntityDatabase &db) {
+                  db.getComponent<ComponentB>(entity).torque.x +=
+                      db.getComponent<ComponentA>(entity).force.x;
+                });
+
+  for (int i = 1; i <= 100; ++i) {
+    graph.execute(0.0f, entityDatabase, jobSystem);
+
+    // B = B + 1 + A on every execution
+    EXPECT_EQ(entityDatabase.getComponent<ComponentA>(entity).force.x,
+              static_cast<float>(i));
+    EXPECT_EQ(entityDatabase.getComponent<ComponentB>(entity).torque.x,
+              static_cast<float>(i + i * (i + 1) / 2));
+  }
+}
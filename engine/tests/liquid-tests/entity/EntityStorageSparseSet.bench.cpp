@@ -0,0 +1,141 @@
+#include "liquid/core/Base.h"
+#include "liquid/entity/EntityStorageSparseSet.h"
+
+#include <benchmark/benchmark.h>
+
+struct PositionComponent {
+  glm::vec3 value{0.0f};
+};
+
+struct VelocityComponent {
+  glm::vec3 value{1.0f};
+};
+
+using BenchmarkStorage =
+    liquid::EntityStorageSparseSet<PositionComponent, VelocityComponent>;
+
+/**
+ * @brief Fill storage with entities
+ *
+ * Every entity gets both components. If pools
+ * are not aligned, velocities are added in
+ * reverse order, so that every component
+ * needs an index lookup.
+ *
+ * @param storage Storage
+ * @param count Number of entities
+ * @param aligned Add components in the same order
+ */
+static void fillStorage(BenchmarkStorage &storage, size_t count,
+                        bool aligned) {
+  std::vector<liquid::Entity> entities(count);
+  for (auto &entity : entities) {
+    entity = storage.createEntity();
+    storage.setComponent<PositionComponent>(entity, {});
+  }
+
+  if (!aligned) {
+    std::reverse(entities.begin(), entities.end());
+  }
+
+  for (auto entity : entities) {
+    storage.setComponent<VelocityComponent>(entity, {});
+  }
+}
+
+static void BM_IterateFunction(benchmark::State &state) {
+  BenchmarkStorage storage;
+  fillStorage(storage, static_cast<size_t>(state.range(0)),
+              state.range(1) != 0);
+
+  // Type erased callback that cannot be inlined
+  std::function<void(liquid::Entity, PositionComponent &,
+                     VelocityComponent &)>
+      iterFn = [](liquid::Entity, PositionComponent &position,
+                  VelocityComponent &velocity) {
+        position.value = position.value + velocity.value;
+      };
+
+  for (auto _ : state) {
+    storage.iterateEntities<PositionComponent, VelocityComponent>(iterFn);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_IterateViewEach(benchmark::State &state) {
+  BenchmarkStorage storage;
+  fillStorage(storage, static_cast<size_t>(state.range(0)),
+              state.range(1) != 0);
+
+  for (auto _ : state) {
+    storage.view<PositionComponent, VelocityComponent>().each(
+        [](liquid::Entity, PositionComponent &position,
+           VelocityComponent &velocity) {
+          position.value = position.value + velocity.value;
+        });
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_IterateViewRange(benchmark::State &state) {
+  BenchmarkStorage storage;
+  fillStorage(storage, static_cast<size_t>(state.range(0)),
+              state.range(1) != 0);
+
+  for (auto _ : state) {
+    for (auto [entity, position, velocity] :
+         storage.view<PositionComponent, VelocityComponent>()) {
+      position.value = position.value + velocity.value;
+    }
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_CreateEntitiesOneByOne(benchmark::State &state) {
+  auto count = static_cast<size_t>(state.range(0));
+
+  for (auto _ : state) {
+    BenchmarkStorage storage;
+    for (size_t i = 0; i < count; ++i) {
+      auto entity = storage.createEntity();
+      storage.setComponent<PositionComponent>(entity, {});
+      storage.setComponent<VelocityComponent>(entity, {});
+    }
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_CreateEntitiesInBatch(benchmark::State &state) {
+  auto count = static_cast<size_t>(state.range(0));
+  std::vector<PositionComponent> positions(count);
+  std::vector<VelocityComponent> velocities(count);
+
+  for (auto _ : state) {
+    BenchmarkStorage storage;
+    auto entities = storage.createEntities(count);
+    storage.setComponents(entities, positions);
+    storage.setComponents(entities, velocities);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_CreateEntitiesOneByOne)->Arg(10000)->Arg(100000);
+BENCHMARK(BM_CreateEntitiesInBatch)->Arg(10000)->Arg(100000);
+
+// Arguments: number of entities, pools aligned
+#define LIQUID_ITERATION_BENCHMARK(fn)                                         \
+  BENCHMARK(fn)->ArgsProduct({{10000, 100000, 1000000}, {0, 1}})
+
+LIQUID_ITERATION_BENCHMARK(BM_IterateFunction);
+LIQUID_ITERATION_BENCHMARK(BM_IterateViewEach);
+LIQUID_ITERATION_BENCHMARK(BM_IterateViewRange);
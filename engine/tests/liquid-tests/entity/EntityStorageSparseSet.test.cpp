@@ -179,7 +179,8 @@ TEST(EntityStorageSparseSetTests, UseRecyclesEntity) {
   auto recycledEntity = storage.createEntity();
   EXPECT_EQ(storage.getEntityCount(), 3);
   EXPECT_TRUE(storage.hasEntity(recycledEntity));
-  EXPECT_EQ(recycledEntity, e2);
+  EXPECT_EQ(liquid::getEntityIndex(recycledEntity), liquid::getEntityIndex(e2));
+  EXPECT_NE(recycledEntity, e2);
   EXPECT_FALSE(storage.hasComponent<IntComponent>(recycledEntity));
   EXPECT_FALSE(storage.hasComponent<FloatComponent>(recycledEntity));
 
@@ -190,6 +191,159 @@ TEST(EntityStorageSparseSetTests, UseRecyclesEntity) {
   EXPECT_EQ(storage.getComponent<IntComponent>(recycledEntity).value, 6);
 }
 
+TEST(EntityStorageSparseSetTests, DeletedEntityHandleDoesNotReferToNewEntity) {
+  liquid::EntityStorageSparseSet<IntComponent> storage;
+  auto deletedEntity = storage.createEntity();
+  storage.deleteEntity(deletedEntity);
+
+  auto entity = storage.createEntity();
+  storage.setComponent<IntComponent>(entity, {5});
+
+  EXPECT_TRUE(storage.hasEntity(entity));
+  EXPECT_TRUE(storage.hasComponent<IntComponent>(entity));
+  EXPECT_FALSE(storage.hasEntity(deletedEntity));
+  EXPECT_FALSE(storage.hasComponent<IntComponent>(deletedEntity));
+}
+
+TEST(EntityStorageSparseSetTests, RecyclesEntitiesInOrderOfDeletion) {
+  liquid::EntityStorageSparseSet<IntComponent> storage;
+  auto e1 = storage.createEntity();
+  auto e2 = storage.createEntity();
+  auto e3 = storage.createEntity();
+
+  storage.deleteEntity(e3);
+  storage.deleteEntity(e1);
+
+  EXPECT_EQ(liquid::getEntityIndex(storage.createEntity()),
+            liquid::getEntityIndex(e3));
+  EXPECT_EQ(liquid::getEntityIndex(storage.createEntity()),
+            liquid::getEntityIndex(e1));
+  EXPECT_EQ(liquid::getEntityIndex(storage.createEntity()),
+            liquid::getEntityIndex(e2) + 2);
+  EXPECT_EQ(storage.getEntityCount(), 4);
+}
+
+TEST(EntityStorageSparseSetTests, DoesNotDeleteEntityTwice) {
+  liquid::EntityStorageSparseSet<IntComponent> storage;
+  auto entity = storage.createEntity();
+  storage.deleteEntity(entity);
+  storage.deleteEntity(entity);
+
+  EXPECT_EQ(storage.getEntityCount(), 0);
+
+  auto e1 = storage.createEntity();
+  auto e2 = storage.createEntity();
+  EXPECT_NE(liquid::getEntityIndex(e1), liquid::getEntityIndex(e2));
+}
+
+TEST(EntityStorageSparseSetTests, CreatesMultipleEntities) {
+  liquid::EntityStorageSparseSet<IntComponent> storage;
+  auto deleted = storage.createEntity();
+  storage.createEntity();
+  storage.deleteEntity(deleted);
+
+  auto entities = storage.createEntities(5);
+  EXPECT_EQ(entities.size(), 5);
+  EXPECT_EQ(storage.getEntityCount(), 6);
+
+  // Reuses deleted entity first
+  EXPECT_EQ(liquid::getEntityIndex(entities.at(0)),
+            liquid::getEntityIndex(deleted));
+
+  for (auto entity : entities) {
+    EXPECT_TRUE(storage.hasEntity(entity));
+  }
+
+  std::set<liquid::Entity> unique(entities.begin(), entities.end());
+  EXPECT_EQ(unique.size(), entities.size());
+}
+
+TEST(EntityStorageSparseSetTests, SetsComponentsOfMultipleEntities) {
+  liquid::EntityStorageSparseSet<IntComponent> storage;
+  auto existing = storage.createEntity();
+  storage.setComponent<IntComponent>(existing, {-1});
+
+  std::vector<liquid::Entity> entities = storage.createEntities(100);
+  entities.push_back(existing);
+
+  std::vector<IntComponent> values(entities.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    values.at(i).value = static_cast<int>(i);
+  }
+
+  auto version = storage.getComponentPoolVersion<IntComponent>();
+  storage.setComponents(entities, values);
+
+  EXPECT_GT(storage.getComponentPoolVersion<IntComponent>(), version);
+  EXPECT_EQ(storage.getEntityCountForComponent<IntComponent>(), 101);
+  for (size_t i = 0; i < entities.size(); ++i) {
+    EXPECT_EQ(storage.getComponent<IntComponent>(entities.at(i)).value,
+              static_cast<int>(i));
+  }
+}
+
+TEST(EntityStorageSparseSetTests, DeletesMultipleEntitiesAndTheirComponents) {
+  liquid::EntityStorageSparseSet<IntComponent, FloatComponent> storage;
+  auto entities = storage.createEntities(10);
+  for (size_t i = 0; i < entities.size(); ++i) {
+    storage.setComponent<IntComponent>(entities.at(i), {static_cast<int>(i)});
+    if (i % 2 == 0) {
+      storage.setComponent<FloatComponent>(entities.at(i), {0.0f});
+    }
+  }
+
+  auto staleEntity = entities.at(9);
+  storage.deleteEntity(staleEntity);
+  auto reusedEntity = storage.createEntity();
+  storage.setComponent<IntComponent>(reusedEntity, {100});
+
+  // Deleted and duplicate entities are skipped
+  storage.deleteEntities({entities.at(1), entities.at(4), entities.at(4),
+                          entities.at(8), staleEntity});
+
+  EXPECT_EQ(storage.getEntityCount(), 7);
+  EXPECT_EQ(storage.getEntityCountForComponent<IntComponent>(), 7);
+  EXPECT_EQ(storage.getEntityCountForComponent<FloatComponent>(), 3);
+
+  for (size_t i : {1, 4, 8}) {
+    EXPECT_FALSE(storage.hasEntity(entities.at(i)));
+    EXPECT_FALSE(storage.hasComponent<IntComponent>(entities.at(i)));
+  }
+
+  for (size_t i : {0, 2, 3, 5, 6, 7}) {
+    EXPECT_TRUE(storage.hasEntity(entities.at(i)));
+    EXPECT_EQ(storage.getComponent<IntComponent>(entities.at(i)).value,
+              static_cast<int>(i));
+  }
+
+  EXPECT_TRUE(storage.hasEntity(reusedEntity));
+  EXPECT_EQ(storage.getComponent<IntComponent>(reusedEntity).value, 100);
+}
+
+TEST(EntityStorageSparseSetTests,
+     SparseMemoryDoesNotGrowWithLargestEntityIndex) {
+  liquid::EntityStorageSparseSet<IntComponent, FloatComponent> storage;
+  auto entities = storage.createEntities(100000);
+  storage.setComponent<IntComponent>(entities.back(), {10});
+
+  auto usages = storage.getMemoryUsage();
+  EXPECT_EQ(usages.size(), 2);
+
+  const auto &intUsage = usages.at(0);
+  EXPECT_EQ(intUsage.name, typeid(IntComponent).name());
+  EXPECT_EQ(intUsage.size, 1);
+  EXPECT_GE(intUsage.sparseMemory,
+            liquid::EntityStorageSparseSetSparseArray::PageSize *
+                sizeof(uint32_t));
+  EXPECT_LT(intUsage.sparseMemory, 100000 * sizeof(uint32_t) / 10);
+  EXPECT_GT(intUsage.denseMemory, 0);
+
+  const auto &floatUsage = usages.at(1);
+  EXPECT_EQ(floatUsage.size, 0);
+  EXPECT_EQ(floatUsage.sparseMemory, 0);
+  EXPECT_EQ(floatUsage.denseMemory, 0);
+}
+
 TEST(EntityStorageSparseSetTests, DoesNotDeleteNonExistentEntity) {
   liquid::EntityStorageSparseSet<IntComponent, FloatComponent> storage;
   storage.deleteEntity(liquid::EntityNull);
@@ -310,6 +464,114 @@ TEST(EntityStorageSparseSetTests, IterateEntities) {
       });
 }
 
+TEST(EntityStorageSparseSetTests, IteratesEntitiesInView) {
+  liquid::EntityStorageSparseSet<IntComponent, FloatComponent> storage;
+  auto e1 = storage.createEntity();
+  auto e2 = storage.createEntity();
+  auto e3 = storage.createEntity();
+  storage.setComponent<IntComponent>(e1, {10});
+  storage.setComponent<IntComponent>(e2, {20});
+  storage.setComponent<FloatComponent>(e3, {30.0f});
+  storage.setComponent<IntComponent>(e3, {30});
+  storage.setComponent<FloatComponent>(e1, {10.0f});
+
+  auto view = storage.view<IntComponent, FloatComponent>();
+  EXPECT_FALSE(view.isAligned());
+
+  std::vector<liquid::Entity> entities;
+  for (auto [entity, intValue, floatValue] : view) {
+    EXPECT_EQ(static_cast<float>(intValue.value), floatValue.value);
+    intValue.value++;
+    entities.push_back(entity);
+  }
+
+  EXPECT_EQ(entities, std::vector<liquid::Entity>({e3, e1}));
+  EXPECT_EQ(storage.getComponent<IntComponent>(e1).value, 11);
+  EXPECT_EQ(storage.getComponent<IntComponent>(e2).value, 20);
+  EXPECT_EQ(storage.getComponent<IntComponent>(e3).value, 31);
+}
+
+TEST(EntityStorageSparseSetTests, IteratesAlignedPoolsInView) {
+  liquid::EntityStorageSparseSet<IntComponent, FloatComponent> storage;
+  for (int i = 0; i < 10; ++i) {
+    auto entity = storage.createEntity();
+    storage.setComponent<IntComponent>(entity, {i});
+    storage.setComponent<FloatComponent>(entity, {static_cast<float>(i)});
+  }
+
+  auto view = storage.view<IntComponent, FloatComponent>();
+  EXPECT_TRUE(view.isAligned());
+
+  size_t count = 0;
+  view.each([&count](liquid::Entity entity, const IntComponent &intValue,
+                     const FloatComponent &floatValue) {
+    EXPECT_EQ(static_cast<float>(intValue.value), floatValue.value);
+    count++;
+  });
+
+  EXPECT_EQ(count, 10);
+}
+
+TEST(EntityStorageSparseSetTests, UpdatesAlignmentWhenOrderOfPoolChanges) {
+  liquid::EntityStorageSparseSet<IntComponent, FloatComponent> storage;
+  std::vector<liquid::Entity> entities;
+  for (int i = 0; i < 10; ++i) {
+    auto entity = storage.createEntity();
+    storage.setComponent<IntComponent>(entity, {i});
+    storage.setComponent<FloatComponent>(entity, {static_cast<float>(i)});
+    entities.push_back(entity);
+  }
+
+  EXPECT_TRUE((storage.view<IntComponent, FloatComponent>().isAligned()));
+
+  // Replacing components does not change order
+  storage.setComponent<IntComponent>(entities.at(2), {20});
+  EXPECT_TRUE((storage.view<IntComponent, FloatComponent>().isAligned()));
+
+  // Deleted component is replaced by the last one
+  storage.deleteComponent<IntComponent>(entities.at(2));
+  storage.setComponent<IntComponent>(entities.at(2), {2});
+  EXPECT_FALSE((storage.view<IntComponent, FloatComponent>().isAligned()));
+
+  // Same changes in the other pool align pools again
+  storage.deleteComponent<FloatComponent>(entities.at(2));
+  storage.setComponent<FloatComponent>(entities.at(2), {2.0f});
+  EXPECT_TRUE((storage.view<IntComponent, FloatComponent>().isAligned()));
+
+  storage.destroyComponents<FloatComponent>();
+  storage.setComponent<FloatComponent>(entities.at(0), {0.0f});
+  EXPECT_FALSE((storage.view<IntComponent, FloatComponent>().isAligned()));
+}
+
+TEST(EntityStorageSparseSetTests, IteratesEntitiesInParallel) {
+  liquid::EntityStorageSparseSet<IntComponent, FloatComponent> storage;
+  liquid::JobSystem jobSystem(3);
+
+  // Skip every third entity to make pools unaligned
+  for (int i = 0; i < 1000; ++i) {
+    auto entity = storage.createEntity();
+    storage.setComponent<IntComponent>(entity, {i});
+    if (i % 3 != 0) {
+      storage.setComponent<FloatComponent>(entity, {0.0f});
+    }
+  }
+
+  std::atomic<size_t> count{0};
+  storage.parallelIterateEntities<IntComponent, FloatComponent>(
+      jobSystem, [&count](liquid::Entity entity, const IntComponent &intValue,
+                          FloatComponent &floatValue) {
+        floatValue.value = static_cast<float>(intValue.value);
+        count++;
+      });
+
+  EXPECT_EQ(count, 666);
+  storage.iterateEntities<IntComponent, FloatComponent>(
+      [](liquid::Entity entity, const IntComponent &intValue,
+         const FloatComponent &floatValue) {
+        EXPECT_EQ(static_cast<float>(intValue.value), floatValue.value);
+      });
+}
+
 TEST(EntityStorageSparseSetTests, DestroysOneComponent) {
   liquid::EntityStorageSparseSet<IntComponent, FloatComponent, StringComponent>
       storage;
@@ -387,7 +649,7 @@ TEST(EntityStorageSparseSetTests, DeletesOnlyNeededComponents) {
 
   // This entity is going to fill up the space of old one
   auto newE1 = storage.createEntity();
-  EXPECT_EQ(e1, newE1);
+  EXPECT_EQ(liquid::getEntityIndex(e1), liquid::getEntityIndex(newE1));
 
   // Set component for the entity
   storage.setComponent<StringComponent>(newE1, {"Hello World"});
@@ -419,3 +681,186 @@ TEST(EntityStorageSparseSetTests, DeletesMultipleComponents) {
   storage.deleteComponent<IntComponent>(e5);
   storage.deleteComponent<IntComponent>(e6);
 }
+
+TEST(EntityStorageSparseSetTests, ChangesPoolVersionWhenComponentsChange) {
+  liquid::EntityStorageSparseSet<IntComponent, StringComponent> storage;
+  auto e1 = storage.createEntity();
+
+  auto version = storage.getComponentPoolVersion<IntComponent>();
+  storage.setComponent<IntComponent>(e1, {10});
+  EXPECT_NE(storage.getComponentPoolVersion<IntComponent>(), version);
+
+  version = storage.getComponentPoolVersion<IntComponent>();
+  storage.setComponent<StringComponent>(e1, {"Hello"});
+  storage.getComponent<IntComponent>(e1).value = 20;
+  EXPECT_EQ(storage.getComponentPoolVersion<IntComponent>(), version);
+
+  storage.setComponent<IntComponent>(e1, {30});
+  EXPECT_NE(storage.getComponentPoolVersion<IntComponent>(), version);
+
+  version = storage.getComponentPoolVersion<IntComponent>();
+  storage.deleteComponent<IntComponent>(e1);
+  EXPECT_NE(storage.getComponentPoolVersion<IntComponent>(), version);
+
+  storage.setComponent<IntComponent>(e1, {30});
+  version = storage.getComponentPoolVersion<IntComponent>();
+  storage.deleteEntity(e1);
+  EXPECT_NE(storage.getComponentPoolVersion<IntComponent>(), version);
+}
+
+TEST(EntityStorageSparseSetTests,
+     ChangesPoolOrderVersionOnlyWhenEntitiesAreAddedOrDeleted) {
+  liquid::EntityStorageSparseSet<IntComponent> storage;
+  auto e1 = storage.createEntity();
+  auto e2 = storage.createEntity();
+
+  auto version = storage.getComponentPoolOrderVersion<IntComponent>();
+  storage.setComponent<IntComponent>(e1, {10});
+  EXPECT_NE(storage.getComponentPoolOrderVersion<IntComponent>(), version);
+
+  version = storage.getComponentPoolOrderVersion<IntComponent>();
+  storage.setComponent<IntComponent>(e1, {20});
+  storage.markComponentChanged<IntComponent>(e1);
+  EXPECT_EQ(storage.getComponentPoolOrderVersion<IntComponent>(), version);
+
+  storage.setComponent<IntComponent>(e2, {30});
+  EXPECT_NE(storage.getComponentPoolOrderVersion<IntComponent>(), version);
+
+  version = storage.getComponentPoolOrderVersion<IntComponent>();
+  storage.deleteComponent<IntComponent>(e1);
+  EXPECT_NE(storage.getComponentPoolOrderVersion<IntComponent>(), version);
+
+  version = storage.getComponentPoolOrderVersion<IntComponent>();
+  storage.deleteEntity(e2);
+  EXPECT_NE(storage.getComponentPoolOrderVersion<IntComponent>(), version);
+}
+
+TEST(EntityStorageSparseSetTests, ChangesComponentVersionWhenMarkedAsChanged) {
+  liquid::EntityStorageSparseSet<IntComponent> storage;
+  auto e1 = storage.createEntity();
+  auto e2 = storage.createEntity();
+  storage.setComponent<IntComponent>(e1, {10});
+  storage.setComponent<IntComponent>(e2, {20});
+
+  auto since = storage.getLastVersion();
+  EXPECT_LE(storage.getComponentVersion<IntComponent>(e1), since);
+  EXPECT_LE(storage.getComponentVersion<IntComponent>(e2), since);
+
+  storage.getComponent<IntComponent>(e2).value = 30;
+  storage.markComponentChanged<IntComponent>(e2);
+  EXPECT_LE(storage.getComponentVersion<IntComponent>(e1), since);
+  EXPECT_GT(storage.getComponentVersion<IntComponent>(e2), since);
+
+  // Deleting moves version with the component
+  auto e2Version = storage.getComponentVersion<IntComponent>(e2);
+  storage.deleteComponent<IntComponent>(e1);
+  EXPECT_EQ(storage.getComponentVersion<IntComponent>(e2), e2Version);
+}
+
+TEST(EntityStorageSparseSetTests, DuplicatesEntitiesAndComponents) {
+  liquid::EntityStorageSparseSet<IntComponent, StringComponent> storage;
+  auto e1 = storage.createEntity();
+  auto e2 = storage.createEntity();
+  storage.setComponent<IntComponent>(e1, {10});
+  storage.setComponent<StringComponent>(e2, {"Hello"});
+  storage.deleteEntity(e1);
+
+  liquid::EntityStorageSparseSet<IntComponent, StringComponent> duplicate;
+  duplicate.createEntity();
+  storage.duplicate(duplicate);
+
+  EXPECT_FALSE(duplicate.hasEntity(e1));
+  EXPECT_TRUE(duplicate.hasEntity(e2));
+  EXPECT_EQ(duplicate.getEntityCount(), 1);
+  EXPECT_EQ(duplicate.getComponent<StringComponent>(e2).value, "Hello");
+  EXPECT_EQ(duplicate.getEntityCountForComponent<IntComponent>(), 0);
+
+  // Duplicate reuses deleted entity slots in the same order
+  EXPECT_EQ(duplicate.createEntity(), storage.createEntity());
+}
+
+TEST(EntityStorageSparseSetTests, SharesPoolsWithDuplicateUntilWritten) {
+  liquid::EntityStorageSparseSet<IntComponent, StringComponent> storage;
+  auto e1 = storage.createEntity();
+  storage.setComponent<IntComponent>(e1, {10});
+  storage.setComponent<StringComponent>(e1, {"Hello"});
+
+  liquid::EntityStorageSparseSet<IntComponent, StringComponent> duplicate;
+  storage.duplicate(duplicate);
+
+  // Reading does not copy pools
+  const auto &constDuplicate = duplicate;
+  EXPECT_EQ(constDuplicate.getComponent<IntComponent>(e1).value, 10);
+  duplicate.iterateEntities<const IntComponent, const StringComponent>(
+      [](liquid::Entity entity, const IntComponent &intValue,
+         const StringComponent &stringValue) {
+        EXPECT_EQ(intValue.value, 10);
+        EXPECT_EQ(stringValue.value, "Hello");
+      });
+
+  EXPECT_TRUE(duplicate.getMemoryUsage().at(0).shared);
+  EXPECT_TRUE(duplicate.getMemoryUsage().at(1).shared);
+
+  duplicate.getComponent<IntComponent>(e1).value = 20;
+
+  EXPECT_FALSE(duplicate.getMemoryUsage().at(0).shared);
+  EXPECT_TRUE(duplicate.getMemoryUsage().at(1).shared);
+  EXPECT_FALSE(storage.getMemoryUsage().at(0).shared);
+  EXPECT_EQ(storage.getComponent<IntComponent>(e1).value, 10);
+  EXPECT_EQ(duplicate.getComponent<IntComponent>(e1).value, 20);
+
+  // Writing to original storage does not change duplicate
+  storage.deleteEntity(e1);
+  EXPECT_FALSE(storage.hasComponent<StringComponent>(e1));
+  EXPECT_TRUE(duplicate.hasComponent<StringComponent>(e1));
+  EXPECT_EQ(duplicate.getComponent<StringComponent>(e1).value, "Hello");
+  EXPECT_FALSE(duplicate.getMemoryUsage().at(1).shared);
+}
+
+TEST(EntityStorageSparseSetTests, ReusesMemoryOfDuplicateWhenDuplicatedAgain) {
+  liquid::EntityStorageSparseSet<IntComponent> storage;
+  auto entities = storage.createEntities(100);
+  storage.setComponents<IntComponent>(entities,
+                                      std::vector<IntComponent>(100, {10}));
+
+  liquid::EntityStorageSparseSet<IntComponent> duplicate;
+  storage.duplicate(duplicate);
+  duplicate.getComponent<IntComponent>(entities.at(0)).value = 20;
+  const auto *component = &duplicate.getComponent<IntComponent>(entities.at(0));
+
+  storage.duplicate(duplicate);
+  EXPECT_EQ(duplicate.getComponent<IntComponent>(entities.at(0)).value, 10);
+  duplicate.getComponent<IntComponent>(entities.at(0)).value = 30;
+
+  EXPECT_EQ(&duplicate.getComponent<IntComponent>(entities.at(0)), component);
+  EXPECT_EQ(storage.getComponent<IntComponent>(entities.at(0)).value, 10);
+}
+
+TEST(EntityStorageSparseSetTests, CopiesSharedPoolOnceWhenWrittenInParallel) {
+  liquid::EntityStorageSparseSet<IntComponent, FloatComponent> storage;
+  liquid::JobSystem jobSystem(3);
+
+  auto entities = storage.createEntities(1000);
+  storage.setComponents<IntComponent>(entities,
+                                      std::vector<IntComponent>(1000, {1}));
+  storage.setComponents<FloatComponent>(
+      entities, std::vector<FloatComponent>(1000, {0.0f}));
+
+  liquid::EntityStorageSparseSet<IntComponent, FloatComponent> duplicate;
+  storage.duplicate(duplicate);
+
+  // Float pool is not picked; so, it is copied by workers
+  duplicate.parallelIterateEntities<const IntComponent>(
+      jobSystem,
+      [&duplicate](liquid::Entity entity, const IntComponent &intValue) {
+        duplicate.getComponent<FloatComponent>(entity).value =
+            static_cast<float>(intValue.value);
+      });
+
+  EXPECT_TRUE(duplicate.getMemoryUsage().at(0).shared);
+  EXPECT_FALSE(duplicate.getMemoryUsage().at(1).shared);
+  for (auto entity : entities) {
+    EXPECT_EQ(duplicate.getComponent<FloatComponent>(entity).value, 1.0f);
+    EXPECT_EQ(storage.getComponent<FloatComponent>(entity).value, 0.0f);
+  }
+}
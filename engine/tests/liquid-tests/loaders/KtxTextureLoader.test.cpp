@@ -38,6 +38,7 @@ TEST_F(KtxTextureLoaderTest, LoadsTexture2D) {
   EXPECT_EQ(description.width, 1);
   EXPECT_EQ(description.height, 1);
   EXPECT_EQ(description.layers, 1);
+  EXPECT_EQ(description.levels.size(), 1);
   EXPECT_NE(description.data, nullptr);
   EXPECT_EQ(description.format, 43);
 }
@@ -0,0 +1,134 @@
+#include "liquid/core/Base.h"
+#include "liquid/renderer/CullingStorage.h"
+
+#include "liquid-tests/Testing.h"
+
+class CullingStorageTest : public ::testing::Test {
+public:
+  CullingStorageTest() {
+    mesh.boundingBox = {glm::vec3{-0.5f}, glm::vec3{0.5f}};
+    mesh.geometries.resize(2);
+    mesh.geometries.at(0).vertices.resize(4);
+    mesh.geometries.at(0).indices.resize(6);
+    mesh.geometries.at(1).vertices.resize(3);
+    mesh.vertexOffsets = {10, 20};
+    mesh.indexOffsets = {30, 0};
+  }
+
+  liquid::CullingStorage storage{10};
+  liquid::rhi::ResourceRegistry registry;
+  liquid::MeshAsset mesh;
+  liquid::Frustum cameraFrustum{
+      glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f)};
+};
+
+TEST_F(CullingStorageTest, CreatesDrawCommandsForEveryGeometryInEveryView) {
+  storage.addView(cameraFrustum);
+  storage.addView(liquid::Frustum{});
+  storage.addMesh(liquid::MeshAssetHandle{1}, mesh, {0, 1, 2});
+  storage.addMesh(liquid::MeshAssetHandle{2}, mesh, {3});
+  storage.updateBuffers(registry);
+
+  EXPECT_EQ(storage.getNumViews(), 2);
+  EXPECT_EQ(storage.getNumInstances(), 4);
+  EXPECT_EQ(storage.getNumDraws(), 4);
+  EXPECT_EQ(storage.getMeshDraws().at(1).firstDraw, 2);
+  EXPECT_TRUE(storage.isIndexedDraw(2));
+  EXPECT_FALSE(storage.isIndexedDraw(3));
+
+  const auto &draws = storage.getDrawCommands();
+  EXPECT_EQ(draws.size(), 8);
+  for (uint32_t view = 0; view < 2; ++view) {
+    const auto *viewDraws = draws.data() + view * 4;
+
+    // Indexed geometry
+    EXPECT_EQ(viewDraws[0].indexCount, 6);
+    EXPECT_EQ(viewDraws[0].instanceCount, 0);
+    EXPECT_EQ(viewDraws[0].firstIndex, 30);
+    EXPECT_EQ(viewDraws[0].vertexOffset, 10);
+    EXPECT_EQ(viewDraws[0].firstInstance, view * 4);
+
+    // Non-indexed geometry stores first vertex in place
+    // of first index and first instance in place of
+    // vertex offset
+    EXPECT_EQ(viewDraws[1].indexCount, 3);
+    EXPECT_EQ(viewDraws[1].firstIndex, 20);
+    EXPECT_EQ(viewDraws[1].vertexOffset, view * 4);
+
+    EXPECT_EQ(viewDraws[2].firstInstance, view * 4 + 3);
+    EXPECT_EQ(viewDraws[3].vertexOffset, view * 4 + 3);
+  }
+
+  const auto &description =
+      registry.getBufferMap().getDescription(storage.getDrawsBuffer());
+  EXPECT_EQ(description.type, liquid::rhi::BufferType::Indirect);
+  EXPECT_EQ(description.dataSize,
+            sizeof(liquid::CullingStorage::DrawCommand) * 8);
+  EXPECT_TRUE(description.dynamic);
+
+  EXPECT_EQ(storage.getDrawCommandOffset(1, 2),
+            sizeof(liquid::CullingStorage::DrawCommand) * 6);
+}
+
+TEST_F(CullingStorageTest, DoesNotUploadVisibleInstances) {
+  storage.addView(cameraFrustum);
+  storage.addMesh(liquid::MeshAssetHandle{1}, mesh, {0, 1, 2});
+  storage.updateBuffers(registry);
+
+  const auto &description = registry.getBufferMap().getDescription(
+      storage.getVisibleInstancesBuffer());
+  EXPECT_EQ(description.data, nullptr);
+  EXPECT_EQ(description.dataSize, 0);
+  EXPECT_FALSE(description.dynamic);
+}
+
+TEST_F(CullingStorageTest, CullsInstancesOfEveryView) {
+  // Second view only sees the area
+  // at the right side of the origin
+  liquid::Frustum rightFrustum{
+      glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f) *
+      glm::translate(glm::mat4{1.0f}, glm::vec3{-10.0f, 0.0f, 0.0f})};
+
+  storage.addView(cameraFrustum);
+  storage.addView(rightFrustum);
+
+  std::vector<glm::mat4> transforms{
+      glm::translate(glm::mat4{1.0f}, {0.0f, 0.0f, -5.0f}),
+      glm::translate(glm::mat4{1.0f}, {0.0f, 0.0f, 5.0f}),
+      glm::translate(glm::mat4{1.0f}, {0.0f, 0.0f, -10.0f}),
+      glm::translate(glm::mat4{1.0f}, {10.0f, 0.0f, 0.0f})};
+
+  storage.addMesh(liquid::MeshAssetHandle{1}, mesh, {0, 1, 3});
+  storage.addMesh(liquid::MeshAssetHandle{2}, mesh, {2});
+  storage.cull(transforms);
+
+  const auto &draws = storage.getDrawCommands();
+  const auto &visible = storage.getVisibleInstances();
+  EXPECT_EQ(visible.size(), 8);
+
+  // Camera
+  EXPECT_EQ(draws.at(0).instanceCount, 1);
+  EXPECT_EQ(draws.at(1).instanceCount, 1);
+  EXPECT_EQ(visible.at(0), 0);
+  EXPECT_EQ(draws.at(2).instanceCount, 1);
+  EXPECT_EQ(draws.at(3).instanceCount, 1);
+  EXPECT_EQ(visible.at(3), 2);
+
+  // Right view
+  EXPECT_EQ(draws.at(4).instanceCount, 1);
+  EXPECT_EQ(draws.at(5).instanceCount, 1);
+  EXPECT_EQ(visible.at(4), 3);
+  EXPECT_EQ(draws.at(6).instanceCount, 0);
+  EXPECT_EQ(draws.at(7).instanceCount, 0);
+}
+
+TEST_F(CullingStorageTest, ClearsViewsAndMeshes) {
+  storage.addView(cameraFrustum);
+  storage.addMesh(liquid::MeshAssetHandle{1}, mesh, {0, 1, 2});
+  storage.clear();
+
+  EXPECT_EQ(storage.getNumViews(), 0);
+  EXPECT_EQ(storage.getNumInstances(), 0);
+  EXPECT_EQ(storage.getNumDraws(), 0);
+  EXPECT_TRUE(storage.getMeshDraws().empty());
+}
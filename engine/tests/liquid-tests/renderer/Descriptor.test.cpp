@@ -39,21 +39,48 @@ TEST_F(DescriptorTest, AddsUniformBufferBinding) {
   EXPECT_EQ(data, buffer);
 }
 
-TEST_F(DescriptorTest, CreatesHashFromBindings) {
-  liquid::rhi::Descriptor descriptor;
+TEST_F(DescriptorTest, CreatesEqualHashesFromEqualBindings) {
   liquid::rhi::TextureHandle tex1{1}, tex2{2};
   liquid::rhi::BufferHandle buffer1{1}, buffer2{2};
 
-  descriptor.bind(0, {tex1, tex2},
-                  liquid::rhi::DescriptorType::CombinedImageSampler);
-  descriptor.bind(1, buffer1, liquid::rhi::DescriptorType::UniformBuffer);
-  descriptor.bind(2, buffer2, liquid::rhi::DescriptorType::StorageBuffer);
+  liquid::rhi::Descriptor descriptor1, descriptor2;
+  for (auto *descriptor : {&descriptor1, &descriptor2}) {
+    descriptor->bind(0, {tex1, tex2},
+                     liquid::rhi::DescriptorType::CombinedImageSampler);
+    descriptor->bind(1, buffer1, liquid::rhi::DescriptorType::UniformBuffer);
+    descriptor->bind(2, buffer2, liquid::rhi::DescriptorType::StorageBuffer);
+  }
+
+  EXPECT_NE(descriptor1.getHashCode(), 0);
+  EXPECT_EQ(descriptor1.getHashCode(), descriptor2.getHashCode());
+}
+
+TEST_F(DescriptorTest, CreatesDifferentHashesFromDifferentBindings) {
+  liquid::rhi::TextureHandle tex1{1}, tex2{2};
+  liquid::rhi::BufferHandle buffer1{1}, buffer2{2};
+
+  liquid::rhi::Descriptor base;
+  base.bind(0, buffer1, liquid::rhi::DescriptorType::UniformBuffer);
+
+  liquid::rhi::Descriptor differentBuffer;
+  differentBuffer.bind(0, buffer2, liquid::rhi::DescriptorType::UniformBuffer);
+
+  liquid::rhi::Descriptor differentBinding;
+  differentBinding.bind(1, buffer1, liquid::rhi::DescriptorType::UniformBuffer);
+
+  liquid::rhi::Descriptor differentType;
+  differentType.bind(0, buffer1, liquid::rhi::DescriptorType::StorageBuffer);
 
-  std::stringstream ss;
-  ss << "b:0;t:2;d:" << 1 << ";d:" << 2 << ";|b:1;t:0;d:" << 1
-     << "|b:2;t:1;d:" << 2 << "|";
+  liquid::rhi::Descriptor textures1, textures2;
+  textures1.bind(0, {tex1, tex2},
+                 liquid::rhi::DescriptorType::CombinedImageSampler);
+  textures2.bind(0, {tex2, tex1},
+                 liquid::rhi::DescriptorType::CombinedImageSampler);
 
-  EXPECT_EQ(descriptor.getHashCode(), ss.str());
+  EXPECT_NE(base.getHashCode(), differentBuffer.getHashCode());
+  EXPECT_NE(base.getHashCode(), differentBinding.getHashCode());
+  EXPECT_NE(base.getHashCode(), differentType.getHashCode());
+  EXPECT_NE(textures1.getHashCode(), textures2.getHashCode());
 }
 
 TEST_F(DescriptorDeathTest, FailsIfBufferIsUsedForCombinedImageSampler) {
@@ -0,0 +1,68 @@
+#include "liquid/core/Base.h"
+#include "liquid/renderer/Frustum.h"
+
+#include "liquid-tests/Testing.h"
+
+class FrustumTest : public ::testing::Test {
+public:
+  liquid::Frustum frustum{
+      glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f)};
+};
+
+TEST_F(FrustumTest, DefaultFrustumIntersectsEverything) {
+  liquid::Frustum frustum;
+
+  EXPECT_TRUE(frustum.intersects({glm::vec3{1000.0f}, glm::vec3{1001.0f}}));
+  EXPECT_TRUE(frustum.intersects({glm::vec3{-1001.0f}, glm::vec3{-1000.0f}}));
+}
+
+TEST_F(FrustumTest, IntersectsBoxesInsideFrustum) {
+  EXPECT_TRUE(frustum.intersects(
+      {glm::vec3{-1.0f, -1.0f, -11.0f}, glm::vec3{1.0f, 1.0f, -9.0f}}));
+}
+
+TEST_F(FrustumTest, IntersectsBoxesThatCrossFrustumPlanes) {
+  // Near plane
+  EXPECT_TRUE(frustum.intersects(
+      {glm::vec3{-1.0f, -1.0f, -1.0f}, glm::vec3{1.0f, 1.0f, 1.0f}}));
+
+  // Right plane
+  EXPECT_TRUE(frustum.intersects(
+      {glm::vec3{9.0f, -1.0f, -11.0f}, glm::vec3{11.0f, 1.0f, -9.0f}}));
+
+  // Far plane
+  EXPECT_TRUE(frustum.intersects(
+      {glm::vec3{-1.0f, -1.0f, -101.0f}, glm::vec3{1.0f, 1.0f, -99.0f}}));
+}
+
+TEST_F(FrustumTest, DoesNotIntersectBoxesOutsideFrustum) {
+  // Behind camera
+  EXPECT_FALSE(frustum.intersects(
+      {glm::vec3{-1.0f, -1.0f, 9.0f}, glm::vec3{1.0f, 1.0f, 11.0f}}));
+
+  // Left of camera
+  EXPECT_FALSE(frustum.intersects(
+      {glm::vec3{-14.0f, -1.0f, -11.0f}, glm::vec3{-12.0f, 1.0f, -9.0f}}));
+
+  // Above camera
+  EXPECT_FALSE(frustum.intersects(
+      {glm::vec3{-1.0f, 12.0f, -11.0f}, glm::vec3{1.0f, 14.0f, -9.0f}}));
+
+  // Beyond far plane
+  EXPECT_FALSE(frustum.intersects(
+      {glm::vec3{-1.0f, -1.0f, -120.0f}, glm::vec3{1.0f, 1.0f, -110.0f}}));
+}
+
+TEST_F(FrustumTest, TransformsBoundingBoxToWorldSpace) {
+  liquid::BoundingBox box{glm::vec3{0.0f}, glm::vec3{2.0f, 1.0f, 0.0f}};
+
+  // Rotate 90 degrees around Z axis and translate
+  glm::mat4 transform{1.0f};
+  transform[0] = glm::vec4{0.0f, 1.0f, 0.0f, 0.0f};
+  transform[1] = glm::vec4{-1.0f, 0.0f, 0.0f, 0.0f};
+  transform[3] = glm::vec4{5.0f, 0.0f, -3.0f, 1.0f};
+
+  auto transformed = box.transform(transform);
+  EXPECT_EQ(transformed.min, glm::vec3(4.0f, 0.0f, -3.0f));
+  EXPECT_EQ(transformed.max, glm::vec3(5.0f, 2.0f, -3.0f));
+}
@@ -0,0 +1,158 @@
+#include "liquid/core/Base.h"
+#include "liquid/renderer/MeshArena.h"
+
+#include "liquid-tests/Testing.h"
+
+class MeshArenaTest : public ::testing::Test {
+public:
+  liquid::MeshArena arena{liquid::rhi::BufferType::Index, sizeof(uint32_t),
+                          8};
+  liquid::rhi::ResourceRegistry registry;
+
+  std::vector<uint32_t> getUploadedData() {
+    const auto &description =
+        registry.getBufferMap().getDescription(arena.getBuffer());
+    const auto *data = static_cast<uint8_t *>(description.data);
+
+    std::vector<uint32_t> uploaded;
+    for (const auto &range : description.uploadRanges) {
+      const auto *start =
+          reinterpret_cast<const uint32_t *>(data + range.dataOffset);
+      uploaded.insert(uploaded.end(), start,
+                      start + range.size / sizeof(uint32_t));
+    }
+    return uploaded;
+  }
+};
+
+TEST_F(MeshArenaTest, CreatesBufferWithAllocatedData) {
+  std::vector<uint32_t> first{1, 2, 3};
+  std::vector<uint32_t> second{4, 5};
+  EXPECT_EQ(arena.allocate(first.data(), first.size()), 0);
+  EXPECT_EQ(arena.allocate(second.data(), second.size()), 3);
+  arena.updateBuffer(registry);
+
+  const auto &description =
+      registry.getBufferMap().getDescription(arena.getBuffer());
+  EXPECT_EQ(description.type, liquid::rhi::BufferType::Index);
+  EXPECT_EQ(description.size, sizeof(uint32_t) * 8);
+  EXPECT_TRUE(description.keepContents);
+  EXPECT_FALSE(description.dynamic);
+  EXPECT_EQ(description.uploadRanges.size(), 1);
+  EXPECT_EQ(description.uploadRanges.at(0).bufferOffset, 0);
+  EXPECT_EQ(getUploadedData(), std::vector<uint32_t>({1, 2, 3, 4, 5}));
+}
+
+TEST_F(MeshArenaTest, UploadsOnlyNewDataAfterDeviceSync) {
+  std::vector<uint32_t> data{1, 2, 3};
+  arena.allocate(data.data(), data.size());
+  arena.updateBuffer(registry);
+  auto buffer = arena.getBuffer();
+  registry.getBufferMap().clearStagedResources();
+
+  std::vector<uint32_t> newData{4, 5};
+  arena.allocate(newData.data(), newData.size());
+  arena.updateBuffer(registry);
+
+  const auto &description = registry.getBufferMap().getDescription(buffer);
+  EXPECT_EQ(arena.getBuffer(), buffer);
+  EXPECT_EQ(description.uploadRanges.size(), 1);
+  EXPECT_EQ(description.uploadRanges.at(0).bufferOffset,
+            sizeof(uint32_t) * 3);
+  EXPECT_EQ(getUploadedData(), newData);
+}
+
+TEST_F(MeshArenaTest, MergesUploadsThatAreNotSyncedWithDevice) {
+  std::vector<uint32_t> data{1, 2, 3};
+  arena.allocate(data.data(), data.size());
+  arena.updateBuffer(registry);
+  registry.getBufferMap().clearStagedResources();
+
+  arena.allocate(data.data(), 1);
+  arena.updateBuffer(registry);
+  arena.allocate(data.data(), 2);
+  arena.updateBuffer(registry);
+
+  const auto &description =
+      registry.getBufferMap().getDescription(arena.getBuffer());
+  EXPECT_EQ(description.uploadRanges.size(), 1);
+  EXPECT_EQ(description.uploadRanges.at(0).bufferOffset,
+            sizeof(uint32_t) * 3);
+  EXPECT_EQ(getUploadedData(), std::vector<uint32_t>({1, 1, 2}));
+}
+
+TEST_F(MeshArenaTest, DoesNotUpdateBufferIfNothingIsAllocated) {
+  arena.updateBuffer(registry);
+  registry.getBufferMap().clearStagedResources();
+
+  arena.updateBuffer(registry);
+  EXPECT_TRUE(registry.getBufferMap().getStagedResources().empty());
+}
+
+TEST_F(MeshArenaTest, GrowsBufferAndKeepsContentsIfAllocationDoesNotFit) {
+  std::vector<uint32_t> data{1, 2, 3, 4, 5, 6};
+  arena.allocate(data.data(), data.size());
+  arena.updateBuffer(registry);
+  auto buffer = arena.getBuffer();
+  registry.getBufferMap().clearStagedResources();
+
+  std::vector<uint32_t> newData{7, 8, 9, 10, 11};
+  EXPECT_EQ(arena.allocate(newData.data(), newData.size()), 6);
+  arena.updateBuffer(registry);
+
+  const auto &description = registry.getBufferMap().getDescription(buffer);
+  EXPECT_EQ(arena.getBuffer(), buffer);
+  EXPECT_EQ(description.size, sizeof(uint32_t) * 16);
+  EXPECT_TRUE(description.keepContents);
+  EXPECT_EQ(description.uploadRanges.size(), 1);
+  EXPECT_EQ(description.uploadRanges.at(0).bufferOffset,
+            sizeof(uint32_t) * 6);
+  EXPECT_EQ(getUploadedData(), newData);
+  EXPECT_EQ(arena.getAllocator().getNumAllocations(), 2);
+}
+
+TEST_F(MeshArenaTest, ReleasesUploadedDataAfterDeviceSync) {
+  std::vector<uint32_t> data{1, 2, 3};
+  arena.allocate(data.data(), data.size());
+  arena.updateBuffer(registry);
+  registry.getBufferMap().clearStagedResources();
+
+  arena.updateBuffer(registry);
+  EXPECT_TRUE(registry.getBufferMap().getStagedResources().empty());
+
+  std::vector<uint32_t> newData{4};
+  arena.allocate(newData.data(), newData.size());
+  arena.updateBuffer(registry);
+  EXPECT_EQ(getUploadedData(), newData);
+}
+
+TEST_F(MeshArenaTest, UploadsOnlyLatestDataOfOverwrittenRanges) {
+  std::vector<uint32_t> first{1, 2, 3};
+  std::vector<uint32_t> second{4, 5, 6, 7};
+  auto offset = arena.allocate(first.data(), first.size());
+  arena.allocate(second.data(), second.size());
+  arena.free(offset);
+
+  std::vector<uint32_t> third{8, 9};
+  EXPECT_EQ(arena.allocate(third.data(), third.size()), offset);
+  arena.updateBuffer(registry);
+
+  const auto &description =
+      registry.getBufferMap().getDescription(arena.getBuffer());
+  EXPECT_EQ(description.uploadRanges.size(), 2);
+  EXPECT_EQ(description.uploadRanges.at(0).bufferOffset,
+            sizeof(uint32_t) * 2);
+  EXPECT_EQ(description.uploadRanges.at(1).bufferOffset, 0);
+  EXPECT_EQ(getUploadedData(),
+            std::vector<uint32_t>({3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST_F(MeshArenaTest, ReusesFreedRanges) {
+  std::vector<uint32_t> data{1, 2, 3};
+  auto offset = arena.allocate(data.data(), data.size());
+  arena.allocate(data.data(), data.size());
+  arena.free(offset);
+
+  EXPECT_EQ(arena.allocate(data.data(), data.size()), offset);
+  EXPECT_EQ(arena.getAllocator().getUsedSize(), 6);
+}
@@ -0,0 +1,221 @@
+#include "liquid/core/Base.h"
+#include "liquid/renderer/RenderStorage.h"
+
+#include "liquid-tests/Testing.h"
+
+class RenderStorageTest : public ::testing::Test {
+public:
+  liquid::RenderStorage storage{10};
+  liquid::rhi::ResourceRegistry registry;
+};
+
+TEST_F(RenderStorageTest, UploadsOnlyAddedData) {
+  for (size_t i = 0; i < 3; ++i) {
+    storage.addMesh(liquid::MeshAssetHandle{1}, glm::mat4{1.0f}, {});
+  }
+  storage.updateBuffers(registry);
+
+  const auto &description = registry.getBufferMap().getDescription(
+      storage.getMeshTransformsBuffer());
+  EXPECT_EQ(description.size, sizeof(glm::mat4) * 10);
+  EXPECT_EQ(description.dataSize, sizeof(glm::mat4) * 3);
+  EXPECT_NE(description.data, nullptr);
+}
+
+TEST_F(RenderStorageTest, DoesNotUploadEmptyBuffers) {
+  storage.updateBuffers(registry);
+
+  const auto &description = registry.getBufferMap().getDescription(
+      storage.getSkinnedMeshTransformsBuffer());
+  EXPECT_EQ(description.size, sizeof(glm::mat4) * 10);
+  EXPECT_EQ(description.dataSize, 0);
+  EXPECT_EQ(description.data, nullptr);
+}
+
+TEST_F(RenderStorageTest, GrowsBuffersWhenDataDoesNotFit) {
+  for (size_t i = 0; i < 25; ++i) {
+    storage.addMesh(liquid::MeshAssetHandle{1}, glm::mat4{1.0f}, {});
+  }
+  storage.updateBuffers(registry);
+
+  auto buffer = storage.getMeshTransformsBuffer();
+  EXPECT_EQ(registry.getBufferMap().getDescription(buffer).size,
+            sizeof(glm::mat4) * 40);
+  EXPECT_EQ(registry.getBufferMap().getDescription(buffer).dataSize,
+            sizeof(glm::mat4) * 25);
+
+  // Buffer does not shrink
+  storage.clear();
+  storage.addMesh(liquid::MeshAssetHandle{1}, glm::mat4{1.0f}, {});
+  storage.updateBuffers(registry);
+
+  EXPECT_EQ(storage.getMeshTransformsBuffer(), buffer);
+  EXPECT_EQ(registry.getBufferMap().getDescription(buffer).size,
+            sizeof(glm::mat4) * 40);
+  EXPECT_EQ(registry.getBufferMap().getDescription(buffer).dataSize,
+            sizeof(glm::mat4));
+}
+
+TEST_F(RenderStorageTest, ReservesMaximumNumberOfJointsForEverySkeleton) {
+  std::vector<glm::mat4> joints(3, glm::mat4{1.0f});
+  storage.addSkinnedMesh(liquid::SkinnedMeshAssetHandle{1}, glm::mat4{1.0f},
+                         joints, {});
+  storage.addSkinnedMesh(liquid::SkinnedMeshAssetHandle{1}, glm::mat4{1.0f},
+                         joints, {});
+  storage.updateBuffers(registry);
+
+  const auto &description =
+      registry.getBufferMap().getDescription(storage.getSkeletonsBuffer());
+  EXPECT_EQ(description.dataSize, sizeof(glm::mat4) *
+                                      liquid::RenderStorage::MAX_NUM_JOINTS *
+                                      2);
+}
+
+TEST_F(RenderStorageTest, CreatesDynamicBuffersForPerFrameData) {
+  storage.addMesh(liquid::MeshAssetHandle{1}, glm::mat4{1.0f}, {});
+  storage.updateBuffers(registry);
+
+  for (auto buffer :
+       {storage.getMeshTransformsBuffer(), storage.getLightsBuffer(),
+        storage.getActiveCameraBuffer(), storage.getSceneBuffer()}) {
+    EXPECT_TRUE(registry.getBufferMap().getDescription(buffer).dynamic);
+  }
+}
+
+TEST_F(RenderStorageTest, SkipsMeshesThatAreNotVisible) {
+  liquid::CameraComponent camera{};
+  camera.projectionViewMatrix =
+      glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+  storage.setCameraData(camera);
+
+  liquid::BoundingBox bounds{glm::vec3{-0.5f}, glm::vec3{0.5f}};
+  storage.addMesh(liquid::MeshAssetHandle{1},
+                  glm::translate(glm::mat4{1.0f}, {0.0f, 0.0f, -5.0f}), bounds);
+  storage.addMesh(liquid::MeshAssetHandle{1},
+                  glm::translate(glm::mat4{1.0f}, {0.0f, 0.0f, 5.0f}), bounds);
+  storage.addMesh(liquid::MeshAssetHandle{2},
+                  glm::translate(glm::mat4{1.0f}, {0.0f, 0.0f, 5.0f}), bounds);
+  storage.updateBuffers(registry);
+
+  EXPECT_EQ(storage.getMeshGroups().size(), 1);
+  EXPECT_EQ(storage.getMeshGroups().at(liquid::MeshAssetHandle{1}).indices,
+            std::vector<uint32_t>{0});
+  EXPECT_EQ(registry.getBufferMap()
+                .getDescription(storage.getMeshTransformsBuffer())
+                .dataSize,
+            sizeof(glm::mat4));
+}
+
+TEST_F(RenderStorageTest, CullsSkinnedMeshesUsingPosedBounds) {
+  liquid::CameraComponent camera{};
+  camera.projectionViewMatrix =
+      glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+  storage.setCameraData(camera);
+
+  // Bind pose bounds are behind the camera
+  liquid::BoundingBox bounds{glm::vec3{-0.5f}, glm::vec3{0.5f}};
+  auto transform = glm::translate(glm::mat4{1.0f}, {0.0f, 0.0f, 5.0f});
+
+  std::vector<glm::mat4> bindPose(2, glm::mat4{1.0f});
+  storage.addSkinnedMesh(liquid::SkinnedMeshAssetHandle{1}, transform,
+                         bindPose, bounds);
+  EXPECT_TRUE(storage.getSkinnedMeshGroups().empty());
+
+  // One joint moves the mesh in front of the camera
+  std::vector<glm::mat4> pose{
+      glm::mat4{1.0f}, glm::translate(glm::mat4{1.0f}, {0.0f, 0.0f, -10.0f})};
+  storage.addSkinnedMesh(liquid::SkinnedMeshAssetHandle{1}, transform, pose,
+                         bounds);
+
+  EXPECT_EQ(storage.getSkinnedMeshGroups()
+                .at(liquid::SkinnedMeshAssetHandle{1})
+                .indices,
+            std::vector<uint32_t>{0});
+}
+
+TEST_F(RenderStorageTest, AddsMeshesThatAreOnlyVisibleFromLightsToShadows) {
+  liquid::CameraComponent camera{};
+  camera.projectionViewMatrix =
+      glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+  storage.setCameraData(camera);
+
+  liquid::DirectionalLightComponent light{};
+  light.direction = glm::vec3{0.0f, 0.0f, -1.0f};
+  storage.addLight(light);
+
+  liquid::BoundingBox bounds{glm::vec3{-0.5f}, glm::vec3{0.5f}};
+  storage.addMesh(liquid::MeshAssetHandle{1},
+                  glm::translate(glm::mat4{1.0f}, {15.0f, 0.0f, -5.0f}),
+                  bounds);
+  storage.addMesh(liquid::MeshAssetHandle{1},
+                  glm::translate(glm::mat4{1.0f}, {100.0f, 0.0f, -5.0f}),
+                  bounds);
+
+  const auto &data = storage.getMeshGroups().at(liquid::MeshAssetHandle{1});
+  EXPECT_TRUE(data.indices.empty());
+  EXPECT_EQ(data.shadowIndices.size(), 1);
+  EXPECT_EQ(data.shadowIndices.at(0), std::vector<uint32_t>{0});
+}
+
+TEST_F(RenderStorageTest, StoresInstancesOfEveryMeshContiguously) {
+  liquid::DirectionalLightComponent light{};
+  light.direction = glm::vec3{0.0f, 0.0f, -1.0f};
+  storage.addLight(light);
+
+  // Camera without data sees everything and
+  // light sees meshes at the origin
+  storage.addMesh(liquid::MeshAssetHandle{1}, glm::mat4{1.0f}, {});
+  storage.addMesh(liquid::MeshAssetHandle{2}, glm::mat4{1.0f}, {});
+  storage.addMesh(liquid::MeshAssetHandle{1}, glm::mat4{1.0f}, {});
+  storage.addMesh(liquid::MeshAssetHandle{2}, glm::mat4{1.0f}, {});
+  storage.addMesh(liquid::MeshAssetHandle{1}, glm::mat4{1.0f}, {});
+  storage.updateBuffers(registry);
+
+  const auto &description = registry.getBufferMap().getDescription(
+      storage.getMeshInstancesBuffer());
+  EXPECT_EQ(description.dataSize, sizeof(uint32_t) * 10);
+  const auto *instances = static_cast<uint32_t *>(description.data);
+
+  for (const auto &[handle, data] : storage.getMeshGroups()) {
+    std::vector<uint32_t> cameraInstances(
+        instances + data.firstInstance,
+        instances + data.firstInstance + data.indices.size());
+    EXPECT_EQ(cameraInstances, data.indices);
+
+    auto firstShadowInstance = data.shadowFirstInstances.at(0);
+    std::vector<uint32_t> shadowInstances(
+        instances + firstShadowInstance,
+        instances + firstShadowInstance + data.shadowIndices.at(0).size());
+    EXPECT_EQ(shadowInstances, data.shadowIndices.at(0));
+  }
+
+  EXPECT_EQ(storage.getMeshGroups().at(liquid::MeshAssetHandle{1}).indices,
+            std::vector<uint32_t>({0, 2, 4}));
+  EXPECT_EQ(storage.getMeshGroups().at(liquid::MeshAssetHandle{2}).indices,
+            std::vector<uint32_t>({1, 3}));
+}
+
+TEST_F(RenderStorageTest, AddsEveryMeshToCameraListIfMeshesAreCulledOnGpu) {
+  liquid::CameraComponent camera{};
+  camera.projectionViewMatrix =
+      glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+  storage.setCameraData(camera);
+
+  liquid::DirectionalLightComponent light{};
+  light.direction = glm::vec3{0.0f, 0.0f, -1.0f};
+  storage.addLight(light);
+
+  storage.setGpuMeshCulling(true);
+
+  liquid::BoundingBox bounds{glm::vec3{-0.5f}, glm::vec3{0.5f}};
+  storage.addMesh(liquid::MeshAssetHandle{1},
+                  glm::translate(glm::mat4{1.0f}, {0.0f, 0.0f, -5.0f}), bounds);
+  storage.addMesh(liquid::MeshAssetHandle{1},
+                  glm::translate(glm::mat4{1.0f}, {0.0f, 0.0f, 500.0f}),
+                  bounds);
+
+  const auto &data = storage.getMeshGroups().at(liquid::MeshAssetHandle{1});
+  EXPECT_EQ(data.indices, std::vector<uint32_t>({0, 1}));
+  EXPECT_TRUE(data.shadowIndices.empty());
+  EXPECT_EQ(storage.getLightFrustums().size(), 1);
+}
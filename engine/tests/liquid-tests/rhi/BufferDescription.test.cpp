@@ -0,0 +1,27 @@
+#include "liquid/core/Base.h"
+#include "liquid/rhi/BufferDescription.h"
+
+#include "liquid-tests/Testing.h"
+
+using BufferType = liquid::rhi::BufferType;
+
+TEST(BufferDescriptionTest, StaticBuffersAreDeviceLocal) {
+  for (auto type : {BufferType::Vertex, BufferType::Index, BufferType::Uniform,
+                    BufferType::Storage, BufferType::Indirect}) {
+    liquid::rhi::BufferDescription description{type, 10};
+    EXPECT_TRUE(liquid::rhi::isDeviceLocalBuffer(description));
+  }
+}
+
+TEST(BufferDescriptionTest, DynamicBuffersAreHostVisible) {
+  for (auto type : {BufferType::Vertex, BufferType::Index, BufferType::Uniform,
+                    BufferType::Storage, BufferType::Indirect}) {
+    liquid::rhi::BufferDescription description{type, 10, nullptr, 0, true};
+    EXPECT_FALSE(liquid::rhi::isDeviceLocalBuffer(description));
+  }
+}
+
+TEST(BufferDescriptionTest, TransferBuffersAreHostVisible) {
+  liquid::rhi::BufferDescription description{BufferType::Transfer, 10};
+  EXPECT_FALSE(liquid::rhi::isDeviceLocalBuffer(description));
+}
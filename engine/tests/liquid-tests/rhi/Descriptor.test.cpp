@@ -0,0 +1,69 @@
+#include "liquid/core/Base.h"
+#include "liquid/rhi/Descriptor.h"
+
+#include "liquid-tests/Testing.h"
+
+using Descriptor = liquid::rhi::Descriptor;
+using DescriptorType = liquid::rhi::DescriptorType;
+
+class DescriptorTest : public ::testing::Test {
+public:
+  static Descriptor createDescriptor() {
+    Descriptor descriptor;
+    descriptor.bind(0, liquid::rhi::BufferHandle{1},
+                    DescriptorType::UniformBuffer);
+    descriptor.bind(1,
+                    {liquid::rhi::TextureHandle{2},
+                     liquid::rhi::TextureHandle{3}},
+                    DescriptorType::CombinedImageSampler);
+    return descriptor;
+  }
+};
+
+TEST_F(DescriptorTest, HashIsEqualForEqualDescriptors) {
+  EXPECT_EQ(createDescriptor().getHashCode(),
+            createDescriptor().getHashCode());
+}
+
+TEST_F(DescriptorTest, DescriptorsWithEqualBindingsAreEqual) {
+  EXPECT_TRUE(createDescriptor() == createDescriptor());
+  EXPECT_TRUE(Descriptor{} == Descriptor{});
+}
+
+TEST_F(DescriptorTest, DescriptorsWithDifferentBindingsAreNotEqual) {
+  auto descriptor = createDescriptor();
+
+  auto otherBuffer = Descriptor{}
+                         .bind(0, liquid::rhi::BufferHandle{4},
+                               DescriptorType::UniformBuffer)
+                         .bind(1,
+                               {liquid::rhi::TextureHandle{2},
+                                liquid::rhi::TextureHandle{3}},
+                               DescriptorType::CombinedImageSampler);
+  EXPECT_FALSE(descriptor == otherBuffer);
+
+  auto otherType = Descriptor{}
+                       .bind(0, liquid::rhi::BufferHandle{1},
+                             DescriptorType::StorageBuffer)
+                       .bind(1,
+                             {liquid::rhi::TextureHandle{2},
+                              liquid::rhi::TextureHandle{3}},
+                             DescriptorType::CombinedImageSampler);
+  EXPECT_FALSE(descriptor == otherType);
+
+  auto fewerTextures = Descriptor{}
+                           .bind(0, liquid::rhi::BufferHandle{1},
+                                 DescriptorType::UniformBuffer)
+                           .bind(1, {liquid::rhi::TextureHandle{2}},
+                                 DescriptorType::CombinedImageSampler);
+  EXPECT_FALSE(descriptor == fewerTextures);
+
+  auto otherBinding = Descriptor{}
+                          .bind(2, liquid::rhi::BufferHandle{1},
+                                DescriptorType::UniformBuffer)
+                          .bind(1,
+                                {liquid::rhi::TextureHandle{2},
+                                 liquid::rhi::TextureHandle{3}},
+                                DescriptorType::CombinedImageSampler);
+  EXPECT_FALSE(descriptor == otherBinding);
+}
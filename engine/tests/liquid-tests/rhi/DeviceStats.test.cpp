@@ -17,6 +17,16 @@ TEST_F(DeviceStatsTest, AddsDrawCalls) {
   EXPECT_EQ(stats.getCommandCallsCount(), 2);
 }
 
+TEST_F(DeviceStatsTest, AddsInstancedDrawCalls) {
+  stats.addDrawCall(80, 5);
+  stats.addDrawCall(125, 1);
+
+  EXPECT_EQ(stats.getDrawCallsCount(), 2);
+  EXPECT_EQ(stats.getSavedDrawCallsCount(), 4);
+  EXPECT_EQ(stats.getDrawnPrimitivesCount(), 525);
+  EXPECT_EQ(stats.getCommandCallsCount(), 2);
+}
+
 TEST_F(DeviceStatsTest, AddCommandCalls) {
   stats.addCommandCall();
   stats.addCommandCall();
@@ -28,11 +38,26 @@ TEST_F(DeviceStatsTest, AddCommandCalls) {
 
 TEST_F(DeviceStatsTest, ResetsCalls) {
   stats.addDrawCall(80);
-  stats.addDrawCall(125);
+  stats.addDrawCall(125, 3);
   stats.addCommandCall();
 
   stats.resetCalls();
   EXPECT_EQ(stats.getDrawCallsCount(), 0);
+  EXPECT_EQ(stats.getSavedDrawCallsCount(), 0);
   EXPECT_EQ(stats.getDrawnPrimitivesCount(), 0);
   EXPECT_EQ(stats.getCommandCallsCount(), 0);
 }
+
+TEST_F(DeviceStatsTest, AddsCallsOfOtherStats) {
+  stats.addDrawCall(80);
+
+  liquid::rhi::DeviceStats other;
+  other.addDrawCall(125, 3);
+  other.addCommandCall();
+
+  stats.addCalls(other);
+  EXPECT_EQ(stats.getDrawCallsCount(), 2);
+  EXPECT_EQ(stats.getSavedDrawCallsCount(), 2);
+  EXPECT_EQ(stats.getDrawnPrimitivesCount(), 455);
+  EXPECT_EQ(stats.getCommandCallsCount(), 3);
+}
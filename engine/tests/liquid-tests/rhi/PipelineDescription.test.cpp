@@ -0,0 +1,102 @@
+#include "liquid/core/Base.h"
+#include "liquid/rhi/PipelineDescription.h"
+
+#include "liquid-tests/Testing.h"
+
+using PipelineDescription = liquid::rhi::PipelineDescription;
+
+class PipelineDescriptionTest : public ::testing::Test {
+public:
+  static PipelineDescription createDescription() {
+    PipelineDescription description{};
+    description.vertexShader = liquid::rhi::ShaderHandle{1};
+    description.fragmentShader = liquid::rhi::ShaderHandle{2};
+    description.renderPass = liquid::rhi::RenderPassHandle{3};
+    description.inputLayout =
+        liquid::rhi::PipelineVertexInputLayout::create<liquid::Vertex>();
+    description.rasterizer.cullMode = liquid::rhi::CullMode::Back;
+
+    liquid::rhi::PipelineColorBlendAttachment attachment{};
+    attachment.enabled = true;
+    attachment.srcColor = liquid::rhi::BlendFactor::SrcAlpha;
+    attachment.dstColor = liquid::rhi::BlendFactor::OneMinusSrcAlpha;
+    description.colorBlend.attachments.push_back(attachment);
+    return description;
+  }
+};
+
+TEST_F(PipelineDescriptionTest, HashIsEqualForEqualDescriptions) {
+  auto description = createDescription();
+  auto other = createDescription();
+
+  // Capacity of vectors does not affect the hash
+  other.inputLayout.attributes.reserve(100);
+  other.colorBlend.attachments.reserve(100);
+
+  EXPECT_EQ(liquid::rhi::getPipelineDescriptionHash(description),
+            liquid::rhi::getPipelineDescriptionHash(other));
+  EXPECT_EQ(liquid::rhi::getPipelineDescriptionHash(description),
+            liquid::rhi::getPipelineDescriptionHash(description));
+}
+
+TEST_F(PipelineDescriptionTest, HashChangesWhenDescriptionChanges) {
+  auto description = createDescription();
+  auto hash = liquid::rhi::getPipelineDescriptionHash(description);
+
+  auto otherShader = createDescription();
+  otherShader.fragmentShader = liquid::rhi::ShaderHandle{4};
+  EXPECT_NE(liquid::rhi::getPipelineDescriptionHash(otherShader), hash);
+
+  auto otherCullMode = createDescription();
+  otherCullMode.rasterizer.cullMode = liquid::rhi::CullMode::Front;
+  EXPECT_NE(liquid::rhi::getPipelineDescriptionHash(otherCullMode), hash);
+
+  auto otherBlend = createDescription();
+  otherBlend.colorBlend.attachments.at(0).enabled = false;
+  EXPECT_NE(liquid::rhi::getPipelineDescriptionHash(otherBlend), hash);
+
+  auto otherAttributes = createDescription();
+  auto &attributes = otherAttributes.inputLayout.attributes;
+  std::swap(attributes.at(0), attributes.at(1));
+  EXPECT_NE(liquid::rhi::getPipelineDescriptionHash(otherAttributes), hash);
+}
+
+TEST_F(PipelineDescriptionTest, DescriptionsWithEqualStatesAreEqual) {
+  EXPECT_TRUE(createDescription() == createDescription());
+  EXPECT_TRUE(PipelineDescription{} == PipelineDescription{});
+}
+
+TEST_F(PipelineDescriptionTest, DescriptionsWithDifferentStatesAreNotEqual) {
+  auto description = createDescription();
+
+  auto otherComputeShader = createDescription();
+  otherComputeShader.computeShader = liquid::rhi::ShaderHandle{5};
+  EXPECT_FALSE(description == otherComputeShader);
+
+  auto otherRenderPass = createDescription();
+  otherRenderPass.renderPass = liquid::rhi::RenderPassHandle{5};
+  EXPECT_FALSE(description == otherRenderPass);
+
+  auto otherTopology = createDescription();
+  otherTopology.inputAssembly.primitiveTopology =
+      liquid::rhi::PrimitiveTopology::LineList;
+  EXPECT_FALSE(description == otherTopology);
+
+  auto otherFrontFace = createDescription();
+  otherFrontFace.rasterizer.frontFace =
+      liquid::rhi::FrontFace::CounterClockwise;
+  EXPECT_FALSE(description == otherFrontFace);
+
+  auto otherBinding = createDescription();
+  otherBinding.inputLayout.bindings.at(0).stride = 4;
+  EXPECT_FALSE(description == otherBinding);
+
+  auto fewerAttributes = createDescription();
+  fewerAttributes.inputLayout.attributes.pop_back();
+  EXPECT_FALSE(description == fewerAttributes);
+
+  auto otherBlendOp = createDescription();
+  otherBlendOp.colorBlend.attachments.at(0).alphaOp =
+      liquid::rhi::BlendOp::Max;
+  EXPECT_FALSE(description == otherBlendOp);
+}
@@ -1,5 +1,6 @@
 #include "liquid/core/Base.h"
 #include "liquid/rhi/RenderGraph.h"
+#include "liquid/rhi/RenderGraphEvaluator.h"
 
 #include "liquid-tests/Testing.h"
 
@@ -260,15 +261,18 @@ TEST_F(RenderGraphTest, SetsPassBarrierForColorOutput) {
   {
     const auto &preBarrier = graph.getCompiledPasses().at(0).getPreBarrier();
     const auto &postBarrier = graph.getCompiledPasses().at(0).getPostBarrier();
-    EXPECT_FALSE(preBarrier.enabled);
-    EXPECT_TRUE(postBarrier.enabled);
-    EXPECT_EQ(postBarrier.srcStage,
+    // Writes wait for writes of previous frame
+    EXPECT_TRUE(preBarrier.enabled);
+    EXPECT_FALSE(postBarrier.enabled);
+    EXPECT_EQ(preBarrier.srcStage,
               VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
-    EXPECT_EQ(postBarrier.dstStage,
+    EXPECT_EQ(preBarrier.dstStage,
               VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
-    EXPECT_EQ(postBarrier.memoryBarriers.at(0).srcAccess,
+    EXPECT_TRUE(preBarrier.imageBarriers.empty());
+    EXPECT_EQ(preBarrier.memoryBarriers.size(), 1);
+    EXPECT_EQ(preBarrier.memoryBarriers.at(0).srcAccess,
               VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
-    EXPECT_EQ(postBarrier.memoryBarriers.at(0).dstAccess,
+    EXPECT_EQ(preBarrier.memoryBarriers.at(0).dstAccess,
               VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
                   VK_ACCESS_COLOR_ATTACHMENT_READ_BIT);
   }
@@ -292,18 +296,20 @@ TEST_F(RenderGraphTest, SetsPassBarrierForDepthOutput) {
   {
     const auto &preBarrier = graph.getCompiledPasses().at(0).getPreBarrier();
     const auto &postBarrier = graph.getCompiledPasses().at(0).getPostBarrier();
-    EXPECT_FALSE(preBarrier.enabled);
-    EXPECT_TRUE(postBarrier.enabled);
+    EXPECT_TRUE(preBarrier.enabled);
+    EXPECT_FALSE(postBarrier.enabled);
 
-    EXPECT_EQ(postBarrier.srcStage,
+    EXPECT_EQ(preBarrier.srcStage,
               VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
                   VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT);
-    EXPECT_EQ(postBarrier.dstStage,
+    EXPECT_EQ(preBarrier.dstStage,
               VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
                   VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT);
-    EXPECT_EQ(postBarrier.memoryBarriers.at(0).srcAccess,
+    EXPECT_TRUE(preBarrier.imageBarriers.empty());
+    EXPECT_EQ(preBarrier.memoryBarriers.size(), 1);
+    EXPECT_EQ(preBarrier.memoryBarriers.at(0).srcAccess,
               VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
-    EXPECT_EQ(postBarrier.memoryBarriers.at(0).dstAccess,
+    EXPECT_EQ(preBarrier.memoryBarriers.at(0).dstAccess,
               VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
                   VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT);
   }
@@ -330,26 +336,27 @@ TEST_F(RenderGraphTest, SetsBothBarriersFromOutputs) {
   {
     const auto &preBarrier = graph.getCompiledPasses().at(0).getPreBarrier();
     const auto &postBarrier = graph.getCompiledPasses().at(0).getPostBarrier();
-    EXPECT_FALSE(preBarrier.enabled);
-    EXPECT_TRUE(postBarrier.enabled);
+    EXPECT_TRUE(preBarrier.enabled);
+    EXPECT_FALSE(postBarrier.enabled);
 
-    EXPECT_EQ(postBarrier.srcStage,
+    EXPECT_EQ(preBarrier.srcStage,
               VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
                   VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
                   VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT);
-    EXPECT_EQ(postBarrier.dstStage,
+    EXPECT_EQ(preBarrier.dstStage,
               VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
                   VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
                   VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT);
-    EXPECT_EQ(postBarrier.memoryBarriers.at(0).srcAccess,
-              VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
-    EXPECT_EQ(postBarrier.memoryBarriers.at(0).dstAccess,
+
+    // Memory barriers are merged into one
+    EXPECT_EQ(preBarrier.memoryBarriers.size(), 1);
+    EXPECT_EQ(preBarrier.memoryBarriers.at(0).srcAccess,
               VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
-                  VK_ACCESS_COLOR_ATTACHMENT_READ_BIT);
-    EXPECT_EQ(postBarrier.memoryBarriers.at(1).srcAccess,
-              VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
-    EXPECT_EQ(postBarrier.memoryBarriers.at(1).dstAccess,
-              VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                  VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+    EXPECT_EQ(preBarrier.memoryBarriers.at(0).dstAccess,
+              VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                  VK_ACCESS_COLOR_ATTACHMENT_READ_BIT |
+                  VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
                   VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT);
   }
 }
@@ -371,6 +378,7 @@ TEST_F(RenderGraphTest, SetsPassBarrierFromColorInput) {
     pass.read(colorTexture);
   }
 
+  // Passes without outputs are compute passes
   graph.compile(resourceRegistry);
 
   {
@@ -380,7 +388,7 @@ TEST_F(RenderGraphTest, SetsPassBarrierFromColorInput) {
 
     EXPECT_EQ(preBarrier.srcStage,
               VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
-    EXPECT_EQ(preBarrier.dstStage, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    EXPECT_EQ(preBarrier.dstStage, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
     EXPECT_TRUE(preBarrier.memoryBarriers.empty());
     EXPECT_EQ(preBarrier.imageBarriers.size(), 1);
     EXPECT_EQ(preBarrier.imageBarriers.at(0).texture, colorTexture);
@@ -394,7 +402,7 @@ TEST_F(RenderGraphTest, SetsPassBarrierFromColorInput) {
               VK_ACCESS_SHADER_READ_BIT);
 
     EXPECT_TRUE(postBarrier.enabled);
-    EXPECT_EQ(postBarrier.srcStage, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    EXPECT_EQ(postBarrier.srcStage, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
     EXPECT_EQ(postBarrier.dstStage,
               VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
     EXPECT_TRUE(postBarrier.memoryBarriers.empty());
@@ -428,6 +436,7 @@ TEST_F(RenderGraphTest, SetsPassBarrierFromDepthInput) {
     pass.read(depthTexture);
   }
 
+  // Passes without outputs are compute passes
   graph.compile(resourceRegistry);
 
   {
@@ -438,7 +447,7 @@ TEST_F(RenderGraphTest, SetsPassBarrierFromDepthInput) {
     EXPECT_EQ(preBarrier.srcStage,
               VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
                   VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT);
-    EXPECT_EQ(preBarrier.dstStage, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    EXPECT_EQ(preBarrier.dstStage, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
     EXPECT_TRUE(preBarrier.memoryBarriers.empty());
     EXPECT_EQ(preBarrier.imageBarriers.size(), 1);
     EXPECT_EQ(preBarrier.imageBarriers.at(0).texture, depthTexture);
@@ -452,7 +461,7 @@ TEST_F(RenderGraphTest, SetsPassBarrierFromDepthInput) {
               VK_ACCESS_SHADER_READ_BIT);
 
     EXPECT_TRUE(postBarrier.enabled);
-    EXPECT_EQ(postBarrier.srcStage, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    EXPECT_EQ(postBarrier.srcStage, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
     EXPECT_EQ(postBarrier.dstStage,
               VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
                   VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT);
@@ -492,6 +501,7 @@ TEST_F(RenderGraphTest, SetsPassBarrierFromBothColorAndDepthInputs) {
     pass.read(depthTexture);
   }
 
+  // Passes without outputs are compute passes
   graph.compile(resourceRegistry);
 
   {
@@ -503,7 +513,7 @@ TEST_F(RenderGraphTest, SetsPassBarrierFromBothColorAndDepthInputs) {
               VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
                   VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
                   VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT);
-    EXPECT_EQ(preBarrier.dstStage, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    EXPECT_EQ(preBarrier.dstStage, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
     EXPECT_TRUE(preBarrier.memoryBarriers.empty());
     EXPECT_EQ(preBarrier.imageBarriers.size(), 2);
     EXPECT_EQ(preBarrier.imageBarriers.at(0).texture, colorTexture);
@@ -527,7 +537,7 @@ TEST_F(RenderGraphTest, SetsPassBarrierFromBothColorAndDepthInputs) {
               VK_ACCESS_SHADER_READ_BIT);
 
     EXPECT_TRUE(postBarrier.enabled);
-    EXPECT_EQ(postBarrier.srcStage, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    EXPECT_EQ(postBarrier.srcStage, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
     EXPECT_EQ(postBarrier.dstStage,
               VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
                   VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
@@ -595,8 +605,23 @@ TEST_F(RenderGraphTest, MergesInputAndOutputBarriers) {
               VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
                   VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
                   VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT);
-    EXPECT_EQ(preBarrier.dstStage, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
-    EXPECT_TRUE(preBarrier.memoryBarriers.empty());
+    EXPECT_EQ(preBarrier.dstStage,
+              VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+                  VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                  VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                  VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT);
+
+    // Outputs wait for writes of previous frame
+    EXPECT_EQ(preBarrier.memoryBarriers.size(), 1);
+    EXPECT_EQ(preBarrier.memoryBarriers.at(0).srcAccess,
+              VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                  VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+    EXPECT_EQ(preBarrier.memoryBarriers.at(0).dstAccess,
+              VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                  VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                  VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                  VK_ACCESS_COLOR_ATTACHMENT_READ_BIT);
+
     EXPECT_EQ(preBarrier.imageBarriers.size(), 2);
     EXPECT_EQ(preBarrier.imageBarriers.at(0).texture, colorTexture1);
     EXPECT_EQ(preBarrier.imageBarriers.at(0).srcLayout,
@@ -619,11 +644,7 @@ TEST_F(RenderGraphTest, MergesInputAndOutputBarriers) {
               VK_ACCESS_SHADER_READ_BIT);
 
     EXPECT_TRUE(postBarrier.enabled);
-    EXPECT_EQ(postBarrier.srcStage,
-              VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
-                  VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
-                  VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
-                  VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT);
+    EXPECT_EQ(postBarrier.srcStage, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
     EXPECT_EQ(postBarrier.dstStage,
               VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
                   VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
@@ -649,18 +670,659 @@ TEST_F(RenderGraphTest, MergesInputAndOutputBarriers) {
     EXPECT_EQ(postBarrier.imageBarriers.at(1).dstAccess,
               VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
 
-    EXPECT_EQ(postBarrier.memoryBarriers.size(), 2);
-    EXPECT_EQ(postBarrier.memoryBarriers.at(0).srcAccess,
-              VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
-    EXPECT_EQ(postBarrier.memoryBarriers.at(0).dstAccess,
-              VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
-                  VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT);
-    EXPECT_EQ(postBarrier.memoryBarriers.at(1).srcAccess,
-              VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
-    EXPECT_EQ(postBarrier.memoryBarriers.at(1).dstAccess,
+    EXPECT_TRUE(postBarrier.memoryBarriers.empty());
+  }
+}
+
+TEST_F(RenderGraphTest, DoesNotSetBarriersForReadsAfterReads) {
+  using TextureDescription = liquid::rhi::TextureDescription;
+  using TextureUsage = liquid::rhi::TextureUsage;
+  TextureDescription colorDescription{};
+  colorDescription.usage = TextureUsage::Color;
+  auto colorTexture = resourceRegistry.setTexture(colorDescription);
+
+  graph.addPass("A").write(colorTexture, glm::vec4{});
+  graph.addPass("B").read(colorTexture);
+  graph.addPass("C").read(colorTexture);
+
+  // Passes without outputs are compute passes
+  graph.compile(resourceRegistry);
+
+  const auto &passes = graph.getCompiledPasses();
+  ASSERT_EQ(passes.size(), 3);
+  EXPECT_EQ(passes.at(2).getName(), "C");
+
+  EXPECT_TRUE(passes.at(1).getPreBarrier().enabled);
+  EXPECT_EQ(passes.at(1).getPreBarrier().imageBarriers.size(), 1);
+  EXPECT_FALSE(passes.at(1).getPostBarrier().enabled);
+  EXPECT_FALSE(passes.at(2).getPreBarrier().enabled);
+
+  // Texture is returned to attachment
+  // layout once after all reads
+  const auto &postBarrier = passes.at(2).getPostBarrier();
+  EXPECT_TRUE(postBarrier.enabled);
+  EXPECT_EQ(postBarrier.srcStage, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+  EXPECT_EQ(postBarrier.dstStage,
+            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+  EXPECT_EQ(postBarrier.imageBarriers.size(), 1);
+  EXPECT_EQ(postBarrier.imageBarriers.at(0).texture, colorTexture);
+  EXPECT_EQ(postBarrier.imageBarriers.at(0).srcLayout,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+  EXPECT_EQ(postBarrier.imageBarriers.at(0).dstLayout,
+            VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+}
+
+TEST_F(RenderGraphTest, SetsBarrierForTextureReadsInOtherStages) {
+  using TextureDescription = liquid::rhi::TextureDescription;
+  using TextureUsage = liquid::rhi::TextureUsage;
+  TextureDescription colorDescription{};
+  colorDescription.usage = TextureUsage::Color;
+  auto colorTexture = resourceRegistry.setTexture(colorDescription);
+  auto finalTexture = resourceRegistry.setTexture(colorDescription);
+
+  graph.addPass("A").write(colorTexture, glm::vec4{});
+
+  {
+    auto &pass = graph.addPass("B");
+    pass.read(colorTexture);
+    pass.write(finalTexture, glm::vec4{});
+  }
+
+  {
+    auto &pass = graph.addPass("C");
+    pass.read(colorTexture);
+    pass.read(finalTexture);
+  }
+
+  graph.compile(resourceRegistry);
+
+  const auto &passes = graph.getCompiledPasses();
+  ASSERT_EQ(passes.size(), 3);
+  EXPECT_EQ(passes.at(2).getName(), "C");
+
+  // Compute pass is not in the destination
+  // scope of the barrier of fragment shader
+  const auto &preBarrier = passes.at(2).getPreBarrier();
+  EXPECT_TRUE(preBarrier.enabled);
+  EXPECT_EQ(preBarrier.srcStage,
+            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+  EXPECT_EQ(preBarrier.dstStage, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+  EXPECT_EQ(preBarrier.memoryBarriers.size(), 1);
+  EXPECT_EQ(preBarrier.memoryBarriers.at(0).srcAccess,
+            VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+  EXPECT_EQ(preBarrier.memoryBarriers.at(0).dstAccess,
+            VK_ACCESS_SHADER_READ_BIT);
+  EXPECT_EQ(preBarrier.imageBarriers.size(), 1);
+  EXPECT_EQ(preBarrier.imageBarriers.at(0).texture, finalTexture);
+}
+
+TEST_F(RenderGraphTest, SetsBarrierForBufferReadsInOtherStages) {
+  using TextureDescription = liquid::rhi::TextureDescription;
+  using TextureUsage = liquid::rhi::TextureUsage;
+  TextureDescription colorDescription{};
+  colorDescription.usage = TextureUsage::Color;
+  auto colorTexture = resourceRegistry.setTexture(colorDescription);
+  auto buffer = resourceRegistry.setBuffer({});
+
+  graph.addPass("A").write(buffer);
+
+  {
+    auto &pass = graph.addPass("B");
+    pass.read(buffer);
+    pass.write(colorTexture, glm::vec4{});
+  }
+
+  {
+    auto &pass = graph.addPass("C");
+    pass.read(buffer);
+    pass.read(colorTexture);
+  }
+
+  graph.compile(resourceRegistry);
+
+  const auto &passes = graph.getCompiledPasses();
+  ASSERT_EQ(passes.size(), 3);
+  EXPECT_EQ(passes.at(2).getName(), "C");
+
+  const auto &preBarrier = passes.at(2).getPreBarrier();
+  EXPECT_TRUE(preBarrier.enabled);
+  EXPECT_EQ(preBarrier.dstStage, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+  EXPECT_EQ(preBarrier.srcStage & (VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT |
+                                   VK_PIPELINE_STAGE_VERTEX_SHADER_BIT),
+            VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT |
+                VK_PIPELINE_STAGE_VERTEX_SHADER_BIT);
+  EXPECT_EQ(preBarrier.memoryBarriers.size(), 1);
+  EXPECT_EQ(preBarrier.memoryBarriers.at(0).srcAccess,
+            VK_ACCESS_SHADER_WRITE_BIT);
+  EXPECT_EQ(preBarrier.memoryBarriers.at(0).dstAccess,
+            VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT);
+}
+
+TEST_F(RenderGraphTest, SetsSplitBarrierForDependencyOnEarlierPass) {
+  using TextureDescription = liquid::rhi::TextureDescription;
+  using TextureUsage = liquid::rhi::TextureUsage;
+  TextureDescription colorDescription{};
+  colorDescription.usage = TextureUsage::Color;
+  auto colorTexture1 = resourceRegistry.setTexture(colorDescription);
+  auto colorTexture2 = resourceRegistry.setTexture(colorDescription);
+
+  graph.addPass("A").write(colorTexture1, glm::vec4{});
+  graph.addPass("B").write(colorTexture2, glm::vec4{});
+  graph.addPass("C").read(colorTexture1);
+
+  // Passes without outputs are compute passes
+  graph.compile(resourceRegistry);
+
+  const auto &passes = graph.getCompiledPasses();
+  ASSERT_EQ(passes.size(), 3);
+  EXPECT_EQ(passes.at(0).getName(), "A");
+  EXPECT_EQ(passes.at(1).getName(), "B");
+  EXPECT_EQ(passes.at(2).getName(), "C");
+
+  EXPECT_EQ(passes.at(0).getSignalStage(),
+            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+  EXPECT_EQ(passes.at(1).getSignalStage(), VK_PIPELINE_STAGE_NONE_KHR);
+  EXPECT_EQ(passes.at(2).getSignalStage(), VK_PIPELINE_STAGE_NONE_KHR);
+
+  // Pass in between does not wait for the event
+  EXPECT_TRUE(passes.at(1).getPreBarrier().events.empty());
+
+  const auto &preBarrier = passes.at(2).getPreBarrier();
+  EXPECT_TRUE(preBarrier.enabled);
+  EXPECT_EQ(preBarrier.events, std::vector<size_t>{0});
+  EXPECT_EQ(preBarrier.srcStage,
+            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+  EXPECT_EQ(preBarrier.dstStage, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+  EXPECT_EQ(preBarrier.imageBarriers.size(), 1);
+  EXPECT_EQ(preBarrier.imageBarriers.at(0).texture, colorTexture1);
+}
+
+TEST_F(RenderGraphTest, MergesSplitBarrierIntoPipelineBarrier) {
+  using TextureDescription = liquid::rhi::TextureDescription;
+  using TextureUsage = liquid::rhi::TextureUsage;
+  TextureDescription colorDescription{};
+  colorDescription.usage = TextureUsage::Color;
+  auto colorTexture1 = resourceRegistry.setTexture(colorDescription);
+  auto colorTexture2 = resourceRegistry.setTexture(colorDescription);
+
+  graph.addPass("A").write(colorTexture1, glm::vec4{});
+  graph.addPass("B").write(colorTexture2, glm::vec4{});
+
+  {
+    auto &pass = graph.addPass("C");
+    pass.read(colorTexture1);
+    pass.read(colorTexture2);
+  }
+
+  graph.compile(resourceRegistry);
+
+  const auto &passes = graph.getCompiledPasses();
+  ASSERT_EQ(passes.size(), 3);
+  EXPECT_EQ(passes.at(2).getName(), "C");
+  EXPECT_EQ(passes.at(0).getSignalStage(), VK_PIPELINE_STAGE_NONE_KHR);
+
+  // Pass waits for the previous pass anyway
+  const auto &preBarrier = passes.at(2).getPreBarrier();
+  EXPECT_TRUE(preBarrier.enabled);
+  EXPECT_TRUE(preBarrier.events.empty());
+  EXPECT_EQ(preBarrier.srcStage,
+            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+  EXPECT_EQ(preBarrier.imageBarriers.size(), 2);
+}
+
+TEST_F(RenderGraphTest, MinimizesBarriersOfPassChain) {
+  using TextureDescription = liquid::rhi::TextureDescription;
+  using TextureUsage = liquid::rhi::TextureUsage;
+  TextureDescription colorDescription{};
+  colorDescription.usage = TextureUsage::Color;
+  auto sceneTexture = resourceRegistry.setTexture(colorDescription);
+  auto bloomTexture = resourceRegistry.setTexture(colorDescription);
+  auto finalTexture = resourceRegistry.setTexture(colorDescription);
+
+  graph.addPass("Scene").write(sceneTexture, glm::vec4{});
+
+  {
+    auto &pass = graph.addPass("Bloom");
+    pass.read(sceneTexture);
+    pass.write(bloomTexture, glm::vec4{});
+  }
+
+  {
+    auto &pass = graph.addPass("Final");
+    pass.read(sceneTexture);
+    pass.read(bloomTexture);
+    pass.write(finalTexture, glm::vec4{});
+  }
+
+  graph.compile(resourceRegistry);
+
+  size_t barrierCount = 0;
+  size_t imageBarrierCount = 0;
+  size_t memoryBarrierCount = 0;
+  for (const auto &pass : graph.getCompiledPasses()) {
+    for (const auto *barrier :
+         {&pass.getPreBarrier(), &pass.getPostBarrier()}) {
+      barrierCount += barrier->enabled ? 1 : 0;
+      imageBarrierCount += barrier->imageBarriers.size();
+      memoryBarrierCount += barrier->memoryBarriers.size();
+    }
+  }
+
+  // Bloom and final passes transition their inputs,
+  // final pass waits for the previous frame, and
+  // inputs are restored after the final pass
+  EXPECT_EQ(barrierCount, 3);
+  EXPECT_EQ(imageBarrierCount, 4);
+  EXPECT_EQ(memoryBarrierCount, 1);
+  EXPECT_FALSE(graph.getCompiledPasses().at(0).getPreBarrier().enabled);
+  EXPECT_FALSE(graph.getCompiledPasses().at(0).getPostBarrier().enabled);
+  EXPECT_FALSE(graph.getCompiledPasses().at(1).getPostBarrier().enabled);
+}
+
+TEST_F(RenderGraphTest, SortsPassesThatDependOnBuffers) {
+  using TextureDescription = liquid::rhi::TextureDescription;
+  using TextureUsage = liquid::rhi::TextureUsage;
+  TextureDescription colorDescription{};
+  colorDescription.usage = TextureUsage::Color;
+  auto colorTexture = resourceRegistry.setTexture(colorDescription);
+  auto buffer = resourceRegistry.setBuffer({});
+
+  {
+    auto &pass = graph.addPass("A");
+    pass.read(buffer);
+    pass.write(colorTexture, glm::vec4{});
+  }
+
+  graph.addPass("B").write(buffer);
+
+  graph.compile(resourceRegistry);
+
+  EXPECT_EQ(graph.getCompiledPasses().size(), 2);
+  EXPECT_EQ(graph.getCompiledPasses().at(0).getName(), "B");
+  EXPECT_TRUE(graph.getCompiledPasses().at(0).isCompute());
+  EXPECT_EQ(graph.getCompiledPasses().at(1).getName(), "A");
+  EXPECT_FALSE(graph.getCompiledPasses().at(1).isCompute());
+}
+
+TEST_F(RenderGraphTest, SetsPassBarriersForBufferDependencies) {
+  using TextureDescription = liquid::rhi::TextureDescription;
+  using TextureUsage = liquid::rhi::TextureUsage;
+  TextureDescription colorDescription{};
+  colorDescription.usage = TextureUsage::Color;
+  auto colorTexture = resourceRegistry.setTexture(colorDescription);
+  auto buffer = resourceRegistry.setBuffer({});
+
+  graph.addPass("A").write(buffer);
+
+  {
+    auto &pass = graph.addPass("B");
+    pass.read(buffer);
+    pass.write(colorTexture, glm::vec4{});
+  }
+
+  graph.compile(resourceRegistry);
+
+  {
+    // Writes wait for reads of previous frame
+    const auto &preBarrier = graph.getCompiledPasses().at(0).getPreBarrier();
+    EXPECT_TRUE(preBarrier.enabled);
+    EXPECT_EQ(preBarrier.srcStage, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT |
+                                       VK_PIPELINE_STAGE_VERTEX_SHADER_BIT);
+    EXPECT_EQ(preBarrier.dstStage, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+    EXPECT_TRUE(preBarrier.memoryBarriers.empty());
+    EXPECT_TRUE(preBarrier.imageBarriers.empty());
+  }
+
+  {
+    // Buffer barrier is merged with barrier
+    // of color attachment from previous frame
+    const auto &preBarrier = graph.getCompiledPasses().at(1).getPreBarrier();
+    EXPECT_TRUE(preBarrier.enabled);
+    EXPECT_EQ(preBarrier.srcStage,
+              VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT |
+                  VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+    EXPECT_EQ(preBarrier.dstStage,
+              VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT |
+                  VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+                  VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+    EXPECT_EQ(preBarrier.memoryBarriers.size(), 1);
+    EXPECT_EQ(preBarrier.memoryBarriers.at(0).srcAccess,
+              VK_ACCESS_SHADER_WRITE_BIT |
+                  VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+    EXPECT_EQ(preBarrier.memoryBarriers.at(0).dstAccess,
+              VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT |
+                  VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                  VK_ACCESS_COLOR_ATTACHMENT_READ_BIT);
+  }
+}
+
+TEST_F(RenderGraphTest, DoesNotSetBarriersForBuffersThatAreNotWrittenByPasses) {
+  using TextureDescription = liquid::rhi::TextureDescription;
+  using TextureUsage = liquid::rhi::TextureUsage;
+  TextureDescription colorDescription{};
+  colorDescription.usage = TextureUsage::Color;
+  auto colorTexture = resourceRegistry.setTexture(colorDescription);
+  auto buffer = resourceRegistry.setBuffer({});
+
+  {
+    auto &pass = graph.addPass("A");
+    pass.read(buffer);
+    pass.write(colorTexture, glm::vec4{});
+  }
+
+  graph.compile(resourceRegistry);
+
+  // Only color attachment needs a barrier
+  const auto &preBarrier = graph.getCompiledPasses().at(0).getPreBarrier();
+  EXPECT_EQ(preBarrier.srcStage,
+            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+  EXPECT_EQ(preBarrier.dstStage,
+            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+  EXPECT_EQ(preBarrier.memoryBarriers.size(), 1);
+  EXPECT_EQ(preBarrier.memoryBarriers.at(0).srcAccess,
+            VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+}
+
+TEST_F(RenderGraphTest, AliasesTexturesWithNonOverlappingLifetimes) {
+  using TextureDescription = liquid::rhi::TextureDescription;
+  using TextureUsage = liquid::rhi::TextureUsage;
+  TextureDescription hdrDescription{};
+  hdrDescription.usage = TextureUsage::Color | TextureUsage::Sampled;
+  hdrDescription.width = 64;
+  hdrDescription.height = 64;
+  hdrDescription.format = VK_FORMAT_R16G16B16A16_SFLOAT;
+  auto hdrTexture = resourceRegistry.setTexture(hdrDescription);
+
+  TextureDescription colorDescription{};
+  colorDescription.usage = TextureUsage::Color | TextureUsage::Sampled;
+  colorDescription.width = 64;
+  colorDescription.height = 64;
+  colorDescription.format = VK_FORMAT_R8G8B8A8_UNORM;
+  auto colorTexture = resourceRegistry.setTexture(colorDescription);
+  auto postTexture = resourceRegistry.setTexture(colorDescription);
+
+  graph.addPass("hdr").write(hdrTexture, glm::vec4{});
+
+  {
+    auto &pass = graph.addPass("tonemap");
+    pass.read(hdrTexture);
+    pass.write(colorTexture, glm::vec4{});
+  }
+
+  {
+    auto &pass = graph.addPass("post");
+    pass.read(colorTexture);
+    pass.write(postTexture, glm::vec4{});
+  }
+
+  graph.compile(resourceRegistry);
+
+  const auto &textures = resourceRegistry.getTextureMap();
+  auto hdrGroup = textures.getDescription(hdrTexture).aliasGroup;
+  EXPECT_NE(hdrGroup, 0);
+  EXPECT_EQ(textures.getDescription(postTexture).aliasGroup, hdrGroup);
+  EXPECT_EQ(textures.getDescription(colorTexture).aliasGroup, 0);
+
+  size_t hdrSize = 64 * 64 * 8;
+  size_t colorSize = 64 * 64 * 4;
+  EXPECT_EQ(graph.getTransientMemorySize(), hdrSize + colorSize * 2);
+  EXPECT_EQ(graph.getAliasedTransientMemorySize(), hdrSize + colorSize);
+}
+
+TEST_F(RenderGraphTest, DoesNotAliasTexturesWithDifferentUsages) {
+  using TextureDescription = liquid::rhi::TextureDescription;
+  using TextureUsage = liquid::rhi::TextureUsage;
+  TextureDescription shadowDescription{};
+  shadowDescription.usage = TextureUsage::Depth | TextureUsage::Sampled;
+  shadowDescription.width = 64;
+  shadowDescription.height = 64;
+  shadowDescription.layers = 4;
+  shadowDescription.format = VK_FORMAT_D16_UNORM;
+  auto shadowTexture = resourceRegistry.setTexture(shadowDescription);
+
+  TextureDescription colorDescription{};
+  colorDescription.usage = TextureUsage::Color | TextureUsage::Sampled;
+  colorDescription.width = 64;
+  colorDescription.height = 64;
+  colorDescription.format = VK_FORMAT_R8G8B8A8_UNORM;
+  auto colorTexture = resourceRegistry.setTexture(colorDescription);
+  auto postTexture = resourceRegistry.setTexture(colorDescription);
+
+  graph.addPass("shadow").write(shadowTexture, glm::vec4{});
+
+  {
+    auto &pass = graph.addPass("mesh");
+    pass.read(shadowTexture);
+    pass.write(colorTexture, glm::vec4{});
+  }
+
+  {
+    auto &pass = graph.addPass("post");
+    pass.read(colorTexture);
+    pass.write(postTexture, glm::vec4{});
+  }
+
+  graph.compile(resourceRegistry);
+
+  // Depth and color attachments can require
+  // different memory types
+  const auto &textures = resourceRegistry.getTextureMap();
+  EXPECT_EQ(textures.getDescription(shadowTexture).aliasGroup, 0);
+  EXPECT_EQ(textures.getDescription(colorTexture).aliasGroup, 0);
+  EXPECT_EQ(textures.getDescription(postTexture).aliasGroup, 0);
+  EXPECT_EQ(graph.getAliasedTransientMemorySize(),
+            graph.getTransientMemorySize());
+}
+
+TEST_F(RenderGraphTest, DoesNotRestoreLayoutsOfAliasedTextures) {
+  using TextureDescription = liquid::rhi::TextureDescription;
+  using TextureUsage = liquid::rhi::TextureUsage;
+  TextureDescription colorDescription{};
+  colorDescription.usage = TextureUsage::Color | TextureUsage::Sampled;
+  colorDescription.width = 64;
+  colorDescription.height = 64;
+  colorDescription.format = VK_FORMAT_R8G8B8A8_UNORM;
+  auto sceneTexture = resourceRegistry.setTexture(colorDescription);
+  auto bloomTexture = resourceRegistry.setTexture(colorDescription);
+  auto finalTexture = resourceRegistry.setTexture(colorDescription);
+
+  graph.addPass("scene").write(sceneTexture, glm::vec4{});
+
+  {
+    auto &pass = graph.addPass("bloom");
+    pass.read(sceneTexture);
+    pass.write(bloomTexture, glm::vec4{});
+  }
+
+  {
+    auto &pass = graph.addPass("final");
+    pass.read(bloomTexture);
+    pass.write(finalTexture, glm::vec4{});
+  }
+
+  graph.compile(resourceRegistry);
+
+  const auto &textures = resourceRegistry.getTextureMap();
+  ASSERT_NE(textures.getDescription(sceneTexture).aliasGroup, 0);
+  ASSERT_EQ(textures.getDescription(finalTexture).aliasGroup,
+            textures.getDescription(sceneTexture).aliasGroup);
+  ASSERT_EQ(textures.getDescription(bloomTexture).aliasGroup, 0);
+
+  // Only bloom texture is restored; memory of
+  // scene texture is written by final texture
+  const auto &postBarrier = graph.getCompiledPasses().at(2).getPostBarrier();
+  EXPECT_TRUE(postBarrier.enabled);
+  EXPECT_EQ(postBarrier.imageBarriers.size(), 1);
+  EXPECT_EQ(postBarrier.imageBarriers.at(0).texture, bloomTexture);
+}
+
+TEST_F(RenderGraphTest, DoesNotAliasTexturesWithOverlappingLifetimes) {
+  using TextureDescription = liquid::rhi::TextureDescription;
+  using TextureUsage = liquid::rhi::TextureUsage;
+  TextureDescription colorDescription{};
+  colorDescription.usage = TextureUsage::Color | TextureUsage::Sampled;
+  colorDescription.width = 64;
+  colorDescription.height = 64;
+  colorDescription.format = VK_FORMAT_R8G8B8A8_UNORM;
+  auto colorTexture = resourceRegistry.setTexture(colorDescription);
+  auto otherTexture = resourceRegistry.setTexture(colorDescription);
+  auto finalTexture = resourceRegistry.setTexture(colorDescription);
+
+  {
+    auto &pass = graph.addPass("A");
+    pass.write(colorTexture, glm::vec4{});
+    pass.write(otherTexture, glm::vec4{});
+  }
+
+  {
+    auto &pass = graph.addPass("B");
+    pass.read(colorTexture);
+    pass.read(otherTexture);
+    pass.write(finalTexture, glm::vec4{});
+  }
+
+  graph.compile(resourceRegistry);
+
+  const auto &textures = resourceRegistry.getTextureMap();
+  EXPECT_EQ(textures.getDescription(colorTexture).aliasGroup, 0);
+  EXPECT_EQ(textures.getDescription(otherTexture).aliasGroup, 0);
+  EXPECT_EQ(textures.getDescription(finalTexture).aliasGroup, 0);
+
+  EXPECT_EQ(graph.getTransientMemorySize(), 64 * 64 * 4 * 3);
+  EXPECT_EQ(graph.getAliasedTransientMemorySize(), 64 * 64 * 4 * 3);
+}
+
+TEST_F(RenderGraphTest, TexturesThatAreNotReadLiveUntilLastPass) {
+  using TextureDescription = liquid::rhi::TextureDescription;
+  using TextureUsage = liquid::rhi::TextureUsage;
+  TextureDescription colorDescription{};
+  colorDescription.usage = TextureUsage::Color;
+  colorDescription.width = 64;
+  colorDescription.height = 64;
+  colorDescription.format = VK_FORMAT_R8G8B8A8_UNORM;
+  auto colorTexture = resourceRegistry.setTexture(colorDescription);
+  auto otherTexture = resourceRegistry.setTexture(colorDescription);
+
+  graph.addPass("A").write(colorTexture, glm::vec4{});
+  graph.addPass("B").write(otherTexture, glm::vec4{});
+
+  graph.compile(resourceRegistry);
+
+  const auto &textures = resourceRegistry.getTextureMap();
+  EXPECT_EQ(textures.getDescription(colorTexture).aliasGroup, 0);
+  EXPECT_EQ(textures.getDescription(otherTexture).aliasGroup, 0);
+  EXPECT_EQ(graph.getAliasedTransientMemorySize(),
+            graph.getTransientMemorySize());
+}
+
+TEST_F(RenderGraphTest, CalculatesFramebufferRelativeSizesFromExtent) {
+  using TextureDescription = liquid::rhi::TextureDescription;
+  using TextureUsage = liquid::rhi::TextureUsage;
+  TextureDescription colorDescription{};
+  colorDescription.usage = TextureUsage::Color;
+  colorDescription.sizeMethod =
+      liquid::rhi::TextureSizeMethod::FramebufferRatio;
+  colorDescription.width = 50;
+  colorDescription.height = 100;
+  colorDescription.format = VK_FORMAT_R16G16B16A16_SFLOAT;
+  auto colorTexture = resourceRegistry.setTexture(colorDescription);
+
+  graph.setFramebufferExtent({200, 100});
+  graph.addPass("A").write(colorTexture, glm::vec4{});
+
+  graph.compile(resourceRegistry);
+
+  EXPECT_EQ(graph.getTransientMemorySize(), 100 * 100 * 8);
+}
+
+TEST_F(RenderGraphTest, DoesNotAliasTexturesWithUnknownFormats) {
+  auto texture = resourceRegistry.setTexture({});
+  auto otherTexture = resourceRegistry.setTexture({});
+
+  graph.addPass("A").write(texture, glm::vec4{});
+  {
+    auto &pass = graph.addPass("B");
+    pass.read(texture);
+    pass.write(otherTexture, glm::vec4{});
+  }
+
+  graph.addPass("C").read(otherTexture);
+
+  graph.compile(resourceRegistry);
+
+  const auto &textures = resourceRegistry.getTextureMap();
+  EXPECT_EQ(textures.getDescription(texture).aliasGroup, 0);
+  EXPECT_EQ(textures.getDescription(otherTexture).aliasGroup, 0);
+  EXPECT_EQ(graph.getTransientMemorySize(), 0);
+}
+
+TEST_F(RenderGraphTest, SetsPassBarrierForFirstUseOfAliasedTexture) {
+  using TextureDescription = liquid::rhi::TextureDescription;
+  using TextureUsage = liquid::rhi::TextureUsage;
+  TextureDescription colorDescription{};
+  colorDescription.usage = TextureUsage::Color | TextureUsage::Sampled;
+  colorDescription.width = 64;
+  colorDescription.height = 64;
+  colorDescription.format = VK_FORMAT_R8G8B8A8_UNORM;
+  auto firstTexture = resourceRegistry.setTexture(colorDescription);
+  auto secondTexture = resourceRegistry.setTexture(colorDescription);
+  auto thirdTexture = resourceRegistry.setTexture(colorDescription);
+
+  graph.addPass("A").write(firstTexture, glm::vec4{});
+
+  {
+    auto &pass = graph.addPass("B");
+    pass.read(firstTexture);
+    pass.write(secondTexture, glm::vec4{});
+  }
+
+  {
+    auto &pass = graph.addPass("C");
+    pass.read(secondTexture);
+    pass.write(thirdTexture, glm::vec4{});
+  }
+
+  graph.compile(resourceRegistry);
+
+  const auto &textures = resourceRegistry.getTextureMap();
+  EXPECT_NE(textures.getDescription(firstTexture).aliasGroup, 0);
+  EXPECT_EQ(textures.getDescription(thirdTexture).aliasGroup,
+            textures.getDescription(firstTexture).aliasGroup);
+
+  {
+    // Waits for previous frame
+    const auto &preBarrier = graph.getCompiledPasses().at(0).getPreBarrier();
+    EXPECT_TRUE(preBarrier.enabled);
+    EXPECT_EQ(preBarrier.srcStage,
+              VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                  VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                  VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
+                  VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    EXPECT_EQ(preBarrier.dstStage,
+              VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+    ASSERT_EQ(preBarrier.memoryBarriers.size(), 1);
+    EXPECT_EQ(preBarrier.memoryBarriers.at(0).srcAccess,
+              VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                  VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+    EXPECT_EQ(preBarrier.memoryBarriers.at(0).dstAccess,
               VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
                   VK_ACCESS_COLOR_ATTACHMENT_READ_BIT);
   }
+
+  {
+    // Second texture is not aliased
+    const auto &preBarrier = graph.getCompiledPasses().at(1).getPreBarrier();
+    EXPECT_TRUE(preBarrier.memoryBarriers.empty());
+  }
+
+  {
+    const auto &preBarrier = graph.getCompiledPasses().at(2).getPreBarrier();
+    ASSERT_EQ(preBarrier.memoryBarriers.size(), 1);
+    EXPECT_EQ(preBarrier.memoryBarriers.at(0).srcAccess,
+              VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                  VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+  }
 }
 
 TEST_F(RenderGraphDeathTest, FailsIfPassReadsFromNonWrittenTexture) {
@@ -692,6 +1354,141 @@ TEST_F(RenderGraphTest, CompilationRemovesLonelyNodes) {
   EXPECT_EQ(graph.getPasses().size(), 4);
 }
 
+TEST_F(RenderGraphTest, CompilationKeepsNodesAfterLonelyNodes) {
+  liquid::rhi::TextureHandle handle = resourceRegistry.setTexture({});
+
+  graph.addPass("A").write(handle, glm::vec4());
+  graph.addPass("B");
+  graph.addPass("C").read(handle);
+
+  graph.compile(resourceRegistry);
+
+  ASSERT_EQ(graph.getCompiledPasses().size(), 2);
+  EXPECT_EQ(graph.getCompiledPasses().at(0).getName(), "A");
+  EXPECT_EQ(graph.getCompiledPasses().at(1).getName(), "C");
+}
+
+TEST_F(RenderGraphTest, RecompilationDoesNotDuplicatePasses) {
+  liquid::rhi::TextureHandle handle = resourceRegistry.setTexture({});
+
+  graph.addPass("A").write(handle, glm::vec4());
+  graph.addPass("B").read(handle);
+
+  graph.compile(resourceRegistry);
+  graph.setFramebufferExtent({800, 600});
+  graph.compile(resourceRegistry);
+
+  EXPECT_EQ(graph.getCompiledPasses().size(), 2);
+}
+
+TEST_F(RenderGraphTest, CullsPassesThatDoNotContributeToOutput) {
+  auto sceneTexture = resourceRegistry.setTexture({});
+  auto debugTexture = resourceRegistry.setTexture({});
+  auto outputTexture = resourceRegistry.setTexture({});
+  auto sceneBuffer = resourceRegistry.setBuffer({});
+  auto debugBuffer = resourceRegistry.setBuffer({});
+
+  graph.addPass("Culling").write(sceneBuffer);
+  graph.addPass("DebugCulling").write(debugBuffer);
+
+  {
+    auto &pass = graph.addPass("Scene");
+    pass.read(sceneBuffer);
+    pass.write(sceneTexture, glm::vec4{});
+  }
+
+  {
+    auto &pass = graph.addPass("Debug");
+    pass.read(sceneTexture);
+    pass.write(debugTexture, glm::vec4{});
+  }
+
+  {
+    auto &pass = graph.addPass("Output");
+    pass.read(sceneTexture);
+    pass.write(outputTexture, glm::vec4{});
+  }
+
+  graph.setOutput(outputTexture);
+  graph.compile(resourceRegistry);
+
+  const auto &passes = graph.getCompiledPasses();
+  ASSERT_EQ(passes.size(), 3);
+  EXPECT_EQ(passes.at(0).getName(), "Culling");
+  EXPECT_EQ(passes.at(1).getName(), "Scene");
+  EXPECT_EQ(passes.at(2).getName(), "Output");
+}
+
+TEST_F(RenderGraphTest, DoesNotCullPassesIfOutputIsNotSet) {
+  auto sceneTexture = resourceRegistry.setTexture({});
+  auto debugTexture = resourceRegistry.setTexture({});
+
+  graph.addPass("Scene").write(sceneTexture, glm::vec4{});
+  graph.addPass("Debug").write(debugTexture, glm::vec4{});
+
+  graph.compile(resourceRegistry);
+
+  EXPECT_EQ(graph.getOutput(), liquid::rhi::TextureHandle::Invalid);
+  EXPECT_EQ(graph.getCompiledPasses().size(), 2);
+}
+
+TEST_F(RenderGraphTest, DoesNotCompileDisabledPasses) {
+  auto sceneTexture = resourceRegistry.setTexture({});
+  auto debugTexture = resourceRegistry.setTexture({});
+
+  graph.addPass("Scene").write(sceneTexture, glm::vec4{});
+  {
+    auto &pass = graph.addPass("Debug");
+    pass.read(sceneTexture);
+    pass.write(debugTexture, glm::vec4{});
+  }
+
+  graph.setPassEnabled("Debug", false);
+  graph.compile(resourceRegistry);
+
+  EXPECT_FALSE(graph.getPasses().at(1).isEnabled());
+  ASSERT_EQ(graph.getCompiledPasses().size(), 1);
+  EXPECT_EQ(graph.getCompiledPasses().at(0).getName(), "Scene");
+}
+
+TEST_F(RenderGraphTest, ReusesCompiledPassesWhenPassIsEnabledAgain) {
+  liquid::rhi::RenderGraphEvaluator evaluator(resourceRegistry);
+  auto sceneTexture = resourceRegistry.setTexture({});
+  auto debugTexture = resourceRegistry.setTexture({});
+
+  graph.addPass("Scene").write(sceneTexture, glm::vec4{});
+  {
+    auto &pass = graph.addPass("Debug");
+    pass.read(sceneTexture);
+    pass.write(debugTexture, glm::vec4{});
+  }
+
+  graph.compile(resourceRegistry);
+  evaluator.build(graph);
+  ASSERT_EQ(graph.getCompiledPasses().size(), 2);
+  auto sceneFramebuffer = graph.getCompiledPasses().at(0).getFramebuffer();
+  auto debugFramebuffer = graph.getCompiledPasses().at(1).getFramebuffer();
+  EXPECT_FALSE(graph.isDirty());
+
+  graph.setPassEnabled("Debug", false);
+  EXPECT_TRUE(graph.isDirty());
+  graph.compile(resourceRegistry);
+  evaluator.build(graph);
+  ASSERT_EQ(graph.getCompiledPasses().size(), 1);
+
+  graph.setPassEnabled("Debug", true);
+  graph.compile(resourceRegistry);
+  evaluator.build(graph);
+  ASSERT_EQ(graph.getCompiledPasses().size(), 2);
+
+  // Passes of the first compilation are not built again
+  EXPECT_EQ(graph.getCompiledPasses().at(0).getFramebuffer(),
+            sceneFramebuffer);
+  EXPECT_EQ(graph.getCompiledPasses().at(1).getFramebuffer(),
+            debugFramebuffer);
+  EXPECT_EQ(resourceRegistry.getFramebufferMap().getDescriptions().size(), 3);
+}
+
 TEST_F(RenderGraphDeathTest, CompilationFailsIfMultipleNodesHaveTheSameName) {
   liquid::rhi::TextureHandle handle{2};
 
@@ -48,6 +48,30 @@ TEST_F(RenderGraphPassTest, AddsHandleToInputOnRead) {
   EXPECT_EQ(pass.getInputs().at(0).texture, handle);
 }
 
+TEST_F(RenderGraphPassTest, AddsBuffersToInputsAndOutputs) {
+  liquid::rhi::RenderGraphPass pass("Test");
+  liquid::rhi::BufferHandle input{2};
+  liquid::rhi::BufferHandle output{3};
+
+  pass.read(input);
+  pass.write(output);
+  EXPECT_EQ(pass.getBufferInputs(),
+            std::vector<liquid::rhi::BufferHandle>{input});
+  EXPECT_EQ(pass.getBufferOutputs(),
+            std::vector<liquid::rhi::BufferHandle>{output});
+  EXPECT_TRUE(pass.getInputs().empty());
+  EXPECT_TRUE(pass.getOutputs().empty());
+}
+
+TEST_F(RenderGraphPassTest, PassWithoutOutputTexturesIsComputePass) {
+  liquid::rhi::RenderGraphPass pass("Test");
+  pass.write(liquid::rhi::BufferHandle{2});
+  EXPECT_TRUE(pass.isCompute());
+
+  pass.write(liquid::rhi::TextureHandle{2}, glm::vec4());
+  EXPECT_FALSE(pass.isCompute());
+}
+
 TEST_F(RenderGraphPassTest, AddsPipeline) {
   liquid::rhi::RenderGraphPass pass("Test");
   liquid::rhi::PipelineHandle handle{3};
@@ -56,3 +80,34 @@ TEST_F(RenderGraphPassTest, AddsPipeline) {
   EXPECT_EQ(pass.getPipelines().size(), 1);
   EXPECT_EQ(pass.getPipelines().at(0), handle);
 }
+
+TEST_F(RenderGraphPassTest, ExecutesPassWithExecutorAsSingleItem) {
+  liquid::rhi::RenderGraphPass pass("Test");
+  size_t calls = 0;
+  pass.setExecutor([&calls](liquid::rhi::RenderCommandList &) { calls++; });
+
+  liquid::rhi::RenderCommandList commandList;
+  EXPECT_EQ(pass.getItemCount(), 1);
+  pass.execute(commandList);
+  EXPECT_EQ(calls, 1);
+}
+
+TEST_F(RenderGraphPassTest, ExecutesRangesOfPassWithRangeExecutor) {
+  liquid::rhi::RenderGraphPass pass("Test");
+  std::vector<std::pair<size_t, size_t>> ranges;
+  pass.setRangeExecutor(
+      []() -> size_t { return 10; },
+      [&ranges](liquid::rhi::RenderCommandList &, size_t begin, size_t end) {
+        ranges.push_back({begin, end});
+      });
+
+  liquid::rhi::RenderCommandList commandList;
+  EXPECT_EQ(pass.getItemCount(), 10);
+
+  pass.execute(commandList, 2, 5);
+  pass.execute(commandList);
+
+  ASSERT_EQ(ranges.size(), 2);
+  EXPECT_EQ(ranges.at(0), std::make_pair(size_t{2}, size_t{5}));
+  EXPECT_EQ(ranges.at(1), std::make_pair(size_t{0}, size_t{10}));
+}
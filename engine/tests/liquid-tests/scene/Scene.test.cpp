@@ -6,7 +6,8 @@
 class SceneUpdaterTest : public ::testing::Test {
 public:
   liquid::EntityDatabase entityDatabase;
-  liquid::SceneUpdater sceneUpdater;
+  liquid::JobSystem jobSystem;
+  liquid::SceneUpdater sceneUpdater{jobSystem};
 };
 
 glm::mat4 getLocalTransform(const liquid::LocalTransformComponent &transform) {
@@ -80,6 +81,260 @@ TEST_F(SceneUpdaterTest, CalculatesWorldTransformFromParentWorldTransform) {
                 getLocalTransform(child2Transform));
 }
 
+TEST_F(SceneUpdaterTest,
+       CalculatesWorldTransformIfChildIsCreatedBeforeParent) {
+  liquid::LocalTransformComponent transform{};
+  transform.localPosition = glm::vec3(1.0f, 0.5f, 2.5f);
+  transform.localRotation = glm::quat(-0.361f, 0.697f, -0.391f, 0.481f);
+  transform.localScale = glm::vec3(0.2f, 0.5f, 1.5f);
+
+  auto child2 = entityDatabase.createEntity();
+  auto child1 = entityDatabase.createEntity();
+  auto parent = entityDatabase.createEntity();
+
+  // parent -> child1 -> child2
+  for (auto entity : {child2, child1, parent}) {
+    entityDatabase.setComponent(entity, transform);
+    entityDatabase.setComponent<liquid::WorldTransformComponent>(entity, {});
+  }
+  entityDatabase.setComponent<liquid::ParentComponent>(child2, {child1});
+  entityDatabase.setComponent<liquid::ParentComponent>(child1, {parent});
+
+  sceneUpdater.update(entityDatabase);
+
+  auto local = getLocalTransform(transform);
+  EXPECT_EQ(entityDatabase.getComponent<liquid::WorldTransformComponent>(child2)
+                .worldTransform,
+            local * local * local);
+}
+
+TEST_F(SceneUpdaterTest, RecalculatesHierarchyWhenParentChanges) {
+  liquid::LocalTransformComponent transform{};
+  transform.localPosition = glm::vec3(1.0f, 0.5f, 2.5f);
+
+  auto parent1 = entityDatabase.createEntity();
+  auto parent2 = entityDatabase.createEntity();
+  auto child = entityDatabase.createEntity();
+
+  for (auto entity : {parent1, parent2, child}) {
+    entityDatabase.setComponent(entity, transform);
+    entityDatabase.setComponent<liquid::WorldTransformComponent>(entity, {});
+  }
+  entityDatabase.setComponent<liquid::ParentComponent>(parent2, {parent1});
+  entityDatabase.setComponent<liquid::ParentComponent>(child, {parent1});
+
+  sceneUpdater.update(entityDatabase);
+
+  auto local = getLocalTransform(transform);
+  EXPECT_EQ(entityDatabase.getComponent<liquid::WorldTransformComponent>(child)
+                .worldTransform,
+            local * local);
+
+  entityDatabase.setComponent<liquid::ParentComponent>(child, {parent2});
+  sceneUpdater.update(entityDatabase);
+
+  EXPECT_EQ(entityDatabase.getComponent<liquid::WorldTransformComponent>(child)
+                .worldTransform,
+            local * local * local);
+
+  entityDatabase.deleteComponent<liquid::ParentComponent>(child);
+  sceneUpdater.update(entityDatabase);
+
+  EXPECT_EQ(entityDatabase.getComponent<liquid::WorldTransformComponent>(child)
+                .worldTransform,
+            local);
+}
+
+TEST_F(SceneUpdaterTest,
+       RecalculatesHierarchyWhenTransformsAreAddedOrDeleted) {
+  liquid::LocalTransformComponent transform{};
+  transform.localPosition = glm::vec3(1.0f, 0.5f, 2.5f);
+
+  auto parent = entityDatabase.createEntity();
+  auto child = entityDatabase.createEntity();
+  entityDatabase.setComponent(child, transform);
+  entityDatabase.setComponent<liquid::WorldTransformComponent>(child, {});
+  entityDatabase.setComponent<liquid::ParentComponent>(child, {parent});
+
+  sceneUpdater.update(entityDatabase);
+
+  auto local = getLocalTransform(transform);
+  EXPECT_EQ(entityDatabase.getComponent<liquid::WorldTransformComponent>(child)
+                .worldTransform,
+            local);
+
+  entityDatabase.setComponent(parent, transform);
+  entityDatabase.setComponent<liquid::WorldTransformComponent>(parent, {});
+  sceneUpdater.update(entityDatabase);
+
+  EXPECT_EQ(entityDatabase.getComponent<liquid::WorldTransformComponent>(child)
+                .worldTransform,
+            local * local);
+
+  // Parent without local transform is not a transform
+  entityDatabase.deleteComponent<liquid::LocalTransformComponent>(parent);
+  sceneUpdater.update(entityDatabase);
+
+  EXPECT_EQ(entityDatabase.getComponent<liquid::WorldTransformComponent>(child)
+                .worldTransform,
+            local);
+}
+
+TEST_F(SceneUpdaterTest, MovesDescendantsWhenParentChanges) {
+  liquid::LocalTransformComponent transform{};
+  transform.localPosition = glm::vec3(1.0f, 0.5f, 2.5f);
+
+  // root1 -> root2 -> root3 and parent -> child -> grandchild
+  auto root1 = entityDatabase.createEntity();
+  auto root2 = entityDatabase.createEntity();
+  auto root3 = entityDatabase.createEntity();
+  auto parent = entityDatabase.createEntity();
+  auto child = entityDatabase.createEntity();
+  auto grandchild = entityDatabase.createEntity();
+
+  for (auto entity : {root1, root2, root3, parent, child, grandchild}) {
+    entityDatabase.setComponent(entity, transform);
+    entityDatabase.setComponent<liquid::WorldTransformComponent>(entity, {});
+  }
+  entityDatabase.setComponent<liquid::ParentComponent>(root2, {root1});
+  entityDatabase.setComponent<liquid::ParentComponent>(root3, {root2});
+  entityDatabase.setComponent<liquid::ParentComponent>(child, {parent});
+  entityDatabase.setComponent<liquid::ParentComponent>(grandchild, {child});
+
+  sceneUpdater.update(entityDatabase);
+
+  auto local = getLocalTransform(transform);
+  EXPECT_EQ(
+      entityDatabase.getComponent<liquid::WorldTransformComponent>(grandchild)
+          .worldTransform,
+      local * local * local);
+
+  // Subtree moves deeper
+  entityDatabase.setComponent<liquid::ParentComponent>(parent, {root3});
+  sceneUpdater.update(entityDatabase);
+
+  EXPECT_EQ(
+      entityDatabase.getComponent<liquid::WorldTransformComponent>(grandchild)
+          .worldTransform,
+      local * local * local * local * local * local);
+
+  // Subtree moves back to root
+  entityDatabase.deleteEntity(root3);
+  auto root1Version =
+      entityDatabase.getComponentVersion<liquid::WorldTransformComponent>(
+          root1);
+  sceneUpdater.update(entityDatabase);
+
+  EXPECT_EQ(
+      entityDatabase.getComponent<liquid::WorldTransformComponent>(grandchild)
+          .worldTransform,
+      local * local * local);
+
+  // Transforms that are not moved are not recalculated
+  EXPECT_EQ(entityDatabase.getComponentVersion<liquid::WorldTransformComponent>(
+                root1),
+            root1Version);
+}
+
+TEST_F(SceneUpdaterTest, TreatsTransformsWhoseParentsFormCycleAsRoots) {
+  liquid::LocalTransformComponent transform{};
+  transform.localPosition = glm::vec3(1.0f, 0.5f, 2.5f);
+
+  auto self = entityDatabase.createEntity();
+  auto first = entityDatabase.createEntity();
+  auto second = entityDatabase.createEntity();
+
+  for (auto entity : {self, first, second}) {
+    entityDatabase.setComponent(entity, transform);
+    entityDatabase.setComponent<liquid::WorldTransformComponent>(entity, {});
+  }
+  entityDatabase.setComponent<liquid::ParentComponent>(self, {self});
+  entityDatabase.setComponent<liquid::ParentComponent>(first, {second});
+  entityDatabase.setComponent<liquid::ParentComponent>(second, {first});
+
+  sceneUpdater.update(entityDatabase);
+
+  auto local = getLocalTransform(transform);
+  EXPECT_EQ(entityDatabase.getComponent<liquid::WorldTransformComponent>(self)
+                .worldTransform,
+            local);
+
+  // One transform of the cycle is attached to the other
+  const auto &firstWorld =
+      entityDatabase.getComponent<liquid::WorldTransformComponent>(first)
+          .worldTransform;
+  const auto &secondWorld =
+      entityDatabase.getComponent<liquid::WorldTransformComponent>(second)
+          .worldTransform;
+  EXPECT_TRUE((firstWorld == local && secondWorld == local * local) ||
+              (firstWorld == local * local && secondWorld == local));
+
+  // Breaking the cycle attaches the other transform
+  entityDatabase.deleteComponent<liquid::ParentComponent>(first);
+  sceneUpdater.update(entityDatabase);
+
+  EXPECT_EQ(entityDatabase.getComponent<liquid::WorldTransformComponent>(first)
+                .worldTransform,
+            local);
+  EXPECT_EQ(entityDatabase.getComponent<liquid::WorldTransformComponent>(second)
+                .worldTransform,
+            local * local);
+}
+
+TEST_F(SceneUpdaterTest, OnlyRecalculatesChangedTransformsAndDescendants) {
+  liquid::LocalTransformComponent transform{};
+  transform.localPosition = glm::vec3(1.0f, 0.5f, 2.5f);
+
+  auto parent = entityDatabase.createEntity();
+  auto child = entityDatabase.createEntity();
+  auto other = entityDatabase.createEntity();
+
+  for (auto entity : {parent, child, other}) {
+    entityDatabase.setComponent(entity, transform);
+    entityDatabase.setComponent<liquid::WorldTransformComponent>(entity, {});
+  }
+  entityDatabase.setComponent<liquid::ParentComponent>(child, {parent});
+
+  sceneUpdater.update(entityDatabase);
+
+  auto local = getLocalTransform(transform);
+  auto newPosition = glm::vec3(2.0f, 1.0f, 3.0f);
+
+  // Change without marking is not picked up
+  entityDatabase.getComponent<liquid::LocalTransformComponent>(other)
+      .localPosition = newPosition;
+  sceneUpdater.update(entityDatabase);
+  EXPECT_EQ(entityDatabase.getComponent<liquid::WorldTransformComponent>(other)
+                .worldTransform,
+            local);
+
+  entityDatabase.markComponentChanged<liquid::LocalTransformComponent>(other);
+  sceneUpdater.update(entityDatabase);
+  EXPECT_EQ(entityDatabase.getComponent<liquid::WorldTransformComponent>(other)
+                .worldTransform,
+            getLocalTransform(
+                entityDatabase.getComponent<liquid::LocalTransformComponent>(
+                    other)));
+
+  // Changing parent recalculates its children
+  auto &parentTransform =
+      entityDatabase.getComponent<liquid::LocalTransformComponent>(parent);
+  parentTransform.localPosition = newPosition;
+  entityDatabase.markComponentChanged<liquid::LocalTransformComponent>(parent);
+
+  auto childVersion =
+      entityDatabase.getComponentVersion<liquid::WorldTransformComponent>(
+          child);
+  sceneUpdater.update(entityDatabase);
+
+  EXPECT_GT(entityDatabase.getComponentVersion<liquid::WorldTransformComponent>(
+                child),
+            childVersion);
+  EXPECT_EQ(entityDatabase.getComponent<liquid::WorldTransformComponent>(child)
+                .worldTransform,
+            getLocalTransform(parentTransform) * local);
+}
+
 TEST_F(SceneUpdaterTest, UpdatesCameraBasedOnTransformAndPerspectiveLens) {
   auto entity = entityDatabase.createEntity();
 
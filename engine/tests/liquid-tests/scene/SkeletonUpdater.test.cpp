@@ -6,7 +6,8 @@
 struct SkeletonUpdaterTest : public ::testing::Test {
   liquid::SkeletonAssetHandle handle{2};
   liquid::EntityDatabase entityDatabase;
-  liquid::SkeletonUpdater skeletonUpdater;
+  liquid::JobSystem jobSystem;
+  liquid::SkeletonUpdater skeletonUpdater{jobSystem};
 
   std::tuple<liquid::SkeletonComponent &, liquid::SkeletonDebugComponent &,
              liquid::Entity>